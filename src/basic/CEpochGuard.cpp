@@ -0,0 +1,412 @@
+/** @file
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CEpochGuard.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/* ===============================================
+ * === Internal epoch structures               ===
+ * ===============================================
+*/
+
+namespace {
+
+
+const uint32_t retireBatch = 64; //!< Retirements between two reclamation attempts
+
+
+/// @internal One retired pointer and the epoch it was retired in
+struct sRetired {
+	void*           ptr;
+	epoch_reclaim_t reclaim;
+	void*           ctx;
+	uint64_t        epoch;
+};
+
+
+/** @internal What a thread announces to the others
+  *
+  * Records are never freed. When a thread ends, its record is released
+  * and can be taken over by a new thread. The retired list is only ever
+  * touched by the thread owning the record.
+**/
+struct alignas( 64 ) sRecord {
+	std::atomic<uint64_t>   epoch { 0 };    //!< Epoch the thread is reading in, 0 if it is not reading
+	std::atomic_bool        inUse { true }; //!< Whether a thread owns this record
+	sRecord*                next  = nullptr; //!< Next record, never changes once published
+	std::vector< sRetired > retired;        //!< Retired by the owner, sorted by epoch
+};
+
+
+/// @internal The global state all threads share
+struct sDomain {
+	std::atomic<uint64_t>   epoch      { 1 };
+	std::atomic<sRecord*>   records    { nullptr };
+	std::atomic_bool        hasOrphans { false };
+	std::mutex              lock;    //!< Protects orphans
+	std::vector< sRetired > orphans; //!< Left behind by ended threads
+};
+
+
+/// @internal The state of the current thread
+struct sLocal {
+	sRecord* record;
+	uint32_t nesting;      //!< Depth of nested guards
+	uint32_t sinceReclaim; //!< Retirements since the last reclamation attempt
+	bool     reclaiming;   //!< Set while reclaim functions run, they might retire more
+	bool     finished;     //!< Set when the thread ends, retirements go to the orphans then
+};
+
+
+/// @internal Releases the record of the current thread when it ends
+struct sRecordReleaser {
+	~sRecordReleaser() noexcept;
+};
+
+
+thread_local sLocal local; // Zero initialized and trivially destructible
+
+
+/** @internal The domain is created on first use and never destroyed.
+  * Elements that are static or thread local objects might be
+  * deleted after all static destructors have been run.
+**/
+sDomain& domain() {
+	static sDomain* the_domain = new sDomain();
+	return *the_domain;
+}
+
+
+/// @internal Make sure the current thread releases its record when it ends
+void register_releaser() noexcept {
+	static thread_local sRecordReleaser releaser;
+	( void )releaser;
+}
+
+
+/// @internal Get the record of the current thread, take over a released one if possible
+sRecord* own_record() noexcept {
+	if ( local.record )
+		return local.record;
+
+	sDomain &dom = domain();
+	sRecord* rec = dom.records.load( std::memory_order_acquire );
+
+	for ( ; rec ; rec = rec->next ) {
+		bool expected = false;
+		if ( !rec->inUse.load( std::memory_order_relaxed )
+		  && rec->inUse.compare_exchange_strong( expected, true, std::memory_order_acq_rel ) )
+			break;
+	}
+
+	if ( nullptr == rec ) {
+		rec       = new sRecord();
+		rec->next = dom.records.load( std::memory_order_relaxed );
+		while ( !dom.records.compare_exchange_weak( rec->next, rec, std::memory_order_acq_rel ) ) { }
+	}
+
+	local.record = rec;
+
+	// A finished thread keeps its new record, it can not be released any more.
+	if ( !local.finished )
+		register_releaser();
+
+	return rec;
+}
+
+
+/// @internal Advance the global epoch if every reading thread is in the current one, return the epoch
+uint64_t try_advance( sDomain &dom ) noexcept {
+	uint64_t curr = dom.epoch.load( std::memory_order_seq_cst );
+
+	for ( sRecord* rec = dom.records.load( std::memory_order_acquire ) ; rec ; rec = rec->next ) {
+		uint64_t announced = rec->epoch.load( std::memory_order_seq_cst );
+		if ( announced && ( announced != curr ) )
+			return curr;
+	}
+
+	if ( dom.epoch.compare_exchange_strong( curr, curr + 1, std::memory_order_seq_cst ) )
+		return curr + 1;
+	return curr; // Somebody else advanced it, curr was reloaded
+}
+
+
+/// @internal Run the reclaim functions of @a count items, collecting more retirements meanwhile is fine
+void run_reclaim( sRetired const* items, size_t count ) noexcept {
+	for ( size_t i = 0 ; i < count ; ++i )
+		items[i].reclaim( items[i].ptr, items[i].ctx );
+}
+
+
+/// @internal Free what was retired before @a safe - 1, or everything if @a all is set
+void reclaim_orphans( sDomain &dom, uint64_t safe, bool all ) noexcept {
+	if ( !dom.hasOrphans.load( std::memory_order_acquire ) )
+		return;
+
+	std::vector< sRetired > ready;
+	{
+		std::unique_lock< std::mutex > guard( dom.lock, std::try_to_lock );
+		if ( !guard.owns_lock() )
+			return;
+
+		try {
+			if ( all )
+				ready.swap( dom.orphans );
+			else {
+				size_t kept = 0;
+				for ( size_t i = 0 ; i < dom.orphans.size() ; ++i ) {
+					if ( dom.orphans[i].epoch + 2 <= safe )
+						ready.push_back( dom.orphans[i] );
+					else
+						dom.orphans[kept++] = dom.orphans[i];
+				}
+				dom.orphans.resize( kept );
+			}
+		} catch ( ... ) {
+			return; // Nothing is lost, everything not in ready is still kept
+		}
+		dom.hasOrphans.store( !dom.orphans.empty(), std::memory_order_release );
+	}
+
+	run_reclaim( ready.data(), ready.size() );
+}
+
+
+/// @internal Free what the current thread retired before @a safe - 1, or everything if @a all is set
+void reclaim_own( sRecord* rec, uint64_t safe, bool all ) noexcept {
+	size_t done = 0;
+
+	// Reclaim functions may retire more, which is appended, so use indices.
+	while ( ( done < rec->retired.size() ) && ( all || ( rec->retired[done].epoch + 2 <= safe ) ) ) {
+		sRetired item = rec->retired[done++];
+		item.reclaim( item.ptr, item.ctx );
+	}
+
+	rec->retired.erase( rec->retired.begin(), rec->retired.begin() + static_cast<std::ptrdiff_t>( done ) );
+}
+
+
+/// @internal Try to advance the epoch and free whatever is safe
+void collect( sRecord* rec ) noexcept {
+	sDomain &dom  = domain();
+	uint64_t safe = try_advance( dom );
+
+	local.reclaiming = true;
+	if ( rec )
+		reclaim_own( rec, safe, false );
+	reclaim_orphans( dom, safe, false );
+	local.reclaiming = false;
+}
+
+
+/** @internal Free @a item as soon as no other thread can hold it any more
+  *
+  * This is the fallback if @a item can not be stored. It waits for every
+  * other thread that entered its guard before @a item was retired to
+  * leave it.
+**/
+void reclaim_now( sRecord* own, sRetired const &item ) noexcept {
+	for ( sRecord* rec = domain().records.load( std::memory_order_acquire ) ; rec ; rec = rec->next ) {
+		if ( rec == own )
+			continue;
+		for ( uint64_t announced = rec->epoch.load( std::memory_order_seq_cst ) ;
+		                announced && ( announced <= item.epoch ) ;
+		                announced = rec->epoch.load( std::memory_order_seq_cst ) )
+			std::this_thread::yield();
+	}
+
+	item.reclaim( item.ptr, item.ctx );
+}
+
+
+/// @internal Hand @a item over to the orphans, return false if that is not possible
+bool add_orphan( sRetired const &item ) noexcept {
+	sDomain &dom = domain();
+	std::lock_guard< std::mutex > guard( dom.lock );
+	try {
+		dom.orphans.push_back( item );
+		dom.hasOrphans.store( true, std::memory_order_release );
+	} catch ( ... ) {
+		return false;
+	}
+	return true;
+}
+
+
+sRecordReleaser::~sRecordReleaser() noexcept {
+	sRecord* rec = local.record;
+
+	if ( rec ) {
+		collect( rec );
+
+		for ( sRetired const &item : rec->retired ) {
+			if ( !add_orphan( item ) )
+				reclaim_now( rec, item );
+		}
+		std::vector< sRetired >().swap( rec->retired );
+
+		rec->epoch.store( 0, std::memory_order_seq_cst );
+		rec->inUse.store( false, std::memory_order_release );
+	}
+
+	local.record   = nullptr;
+	local.finished = true;
+}
+
+
+} // anonymous namespace
+
+
+/* ===============================================
+ * === CEpochGuard                             ===
+ * ===============================================
+*/
+
+CEpochGuard::CEpochGuard() noexcept {
+	if ( local.nesting++ )
+		return;
+
+	sDomain &dom  = domain();
+	sRecord* rec  = own_record();
+	uint64_t curr = dom.epoch.load( std::memory_order_seq_cst );
+
+	// Announce until the announcement is current, so it can not lag behind
+	// an epoch in which something this thread will see was retired.
+	rec->epoch.store( curr, std::memory_order_seq_cst );
+	for ( uint64_t now = dom.epoch.load( std::memory_order_seq_cst ) ; now != curr ;
+	                now = dom.epoch.load( std::memory_order_seq_cst ) ) {
+		curr = now;
+		rec->epoch.store( curr, std::memory_order_seq_cst );
+	}
+}
+
+
+CEpochGuard::~CEpochGuard() noexcept {
+	if ( 0 == --local.nesting )
+		local.record->epoch.store( 0, std::memory_order_release );
+}
+
+
+/* ===============================================
+ * === Free functions                          ===
+ * ===============================================
+*/
+
+void epoch_retire( void* ptr, epoch_reclaim_t reclaim, void* ctx ) noexcept {
+	if ( nullptr == ptr )
+		return;
+
+	sRetired item = { ptr, reclaim, ctx, domain().epoch.load( std::memory_order_seq_cst ) };
+
+	if ( local.finished ) {
+		if ( !add_orphan( item ) )
+			reclaim_now( local.record, item );
+		return;
+	}
+
+	sRecord* rec = own_record();
+	try {
+		rec->retired.push_back( item );
+	} catch ( ... ) {
+		reclaim_now( rec, item );
+		return;
+	}
+
+	if ( !local.reclaiming && ( ++local.sinceReclaim >= retireBatch ) ) {
+		local.sinceReclaim = 0;
+		collect( rec );
+	}
+}
+
+
+void epoch_free( void* ptr, epoch_reclaim_t reclaim, void* ctx ) noexcept {
+	if ( nullptr == ptr )
+		return;
+
+	// The caller might still hold ptr inside its own guard.
+	if ( local.nesting ) {
+		epoch_retire( ptr, reclaim, ctx );
+		return;
+	}
+
+	// ptr is already unlinked. A thread entering a guard after this fence
+	// can not reach it, so only announcements seen now are of interest.
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	for ( sRecord* rec = domain().records.load( std::memory_order_acquire ) ; rec ; rec = rec->next ) {
+		if ( rec->epoch.load( std::memory_order_seq_cst ) ) {
+			epoch_retire( ptr, reclaim, ctx );
+			return;
+		}
+	}
+
+	reclaim( ptr, ctx );
+}
+
+
+void epoch_reclaim() noexcept {
+	if ( !local.reclaiming )
+		collect( local.record );
+}
+
+
+void epoch_drain() noexcept {
+	if ( local.reclaiming )
+		return;
+
+	sDomain &dom = domain();
+	sRecord* rec = local.record;
+
+	// Reclaim functions might retire more, so repeat until nothing is left
+	local.reclaiming = true;
+	while ( ( rec && !rec->retired.empty() ) || dom.hasOrphans.load( std::memory_order_acquire ) ) {
+		try_advance( dom );
+		if ( rec )
+			reclaim_own( rec, 0, true );
+		reclaim_orphans( dom, 0, true );
+	}
+	local.reclaiming = false;
+}
+
+
+} // namespace pwx
@@ -0,0 +1,190 @@
+#ifndef PWX_LIBPWX_PWX_BASIC_CEPOCHGUARD_H_INCLUDED
+#define PWX_LIBPWX_PWX_BASIC_CEPOCHGUARD_H_INCLUDED 1
+#pragma once
+
+/** @file CEpochGuard.h
+  *
+  * @brief Epoch based reclamation of memory that readers might still hold
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/// @brief Function that frees a retired pointer, @a ctx is what was given to `epoch_retire()`
+typedef void ( * epoch_reclaim_t )( void* ptr, void* ctx );
+
+
+/** @class CEpochGuard PEpochGuard <PEpochGuard>
+  * @brief RAII guard marking the calling thread as a reader of shared memory
+  *
+  * Lock-free readers can not prevent a writer from unlinking what they
+  * are looking at. So writers do not free unlinked memory directly, but
+  * hand it to `epoch_retire()`. The memory is freed once every thread
+  * that was inside a `CEpochGuard` when it was retired has left its
+  * guard. Anything reached while holding a guard therefore stays valid
+  * until the guard ends.
+  *
+  * There is one global epoch counter. A guard announces the epoch it
+  * started in, and the counter can only advance when all announced
+  * epochs are the current one. Memory retired in epoch `e` is freed
+  * when the counter has reached `e + 2`.
+  *
+  * Guards can be nested, only the outermost one counts. They are cheap,
+  * but a thread that stays inside a guard holds back the reclamation of
+  * everything retired meanwhile, so keep them short.
+  *
+  * Memory retired by a thread that ends is handed over to the threads
+  * that continue.
+**/
+class PWX_API CEpochGuard {
+public:
+
+	/* ===============================================
+	 * === Public constructors and destructors     ===
+	 * ===============================================
+	*/
+
+	/// @brief enter the current epoch
+	CEpochGuard() noexcept;
+
+	/// @brief leave the epoch entered by the constructor
+	~CEpochGuard() noexcept;
+
+	CEpochGuard( CEpochGuard const& ) PWX_DELETE;
+	CEpochGuard( CEpochGuard && ) PWX_DELETE;
+
+
+	/* ===============================================
+	 * === Public operators                        ===
+	 * ===============================================
+	*/
+
+	CEpochGuard& operator=( CEpochGuard const& ) PWX_DELETE;
+	CEpochGuard& operator=( CEpochGuard && ) PWX_DELETE;
+};
+
+
+/** @brief retire @a ptr, to be freed with @a reclaim once no reader can hold it
+  *
+  * @a ptr must already be unreachable for threads that enter a guard
+  * from now on. @a reclaim is called with @a ptr and @a ctx later, by
+  * whichever thread finds it safe. It must therefore not depend on the
+  * object that retired @a ptr still being alive.
+  *
+  * If no bookkeeping memory can be allocated, the calling thread waits
+  * until every other thread that might hold @a ptr has left its guard,
+  * and frees it then.
+  *
+  * @param[in] ptr the pointer to retire. `nullptr` is ignored.
+  * @param[in] reclaim the function that frees @a ptr.
+  * @param[in] ctx any value @a reclaim needs besides @a ptr.
+**/
+void epoch_retire( void* ptr, epoch_reclaim_t reclaim, void* ctx ) noexcept PWX_API;
+
+
+/** @brief free @a ptr at once if no thread is inside a guard, retire it otherwise
+  *
+  * This is what containers use for memory that is only retired for the
+  * sake of guarded readers. As long as no thread reads inside a
+  * `CEpochGuard`, nothing is deferred.
+  *
+  * @param[in] ptr the pointer to free. `nullptr` is ignored.
+  * @param[in] reclaim the function that frees @a ptr.
+  * @param[in] ctx any value @a reclaim needs besides @a ptr.
+**/
+void epoch_free( void* ptr, epoch_reclaim_t reclaim, void* ctx ) noexcept PWX_API;
+
+
+/// @internal Reclaim function deleting a @a ptr of type @a T
+template< typename T >
+void epoch_reclaim_delete( void* ptr, void* ) noexcept {
+	delete static_cast<T*>( ptr );
+}
+
+
+/// @internal Reclaim function handing a @a ptr of type @a T to the destroy function @a ctx
+template< typename T >
+void epoch_reclaim_destroy( void* ptr, void* ctx ) noexcept {
+	reinterpret_cast<void ( * )( T* )>( ctx )( static_cast<T*>( ptr ) );
+}
+
+
+/** @brief retire @a ptr, to be deleted once no reader can hold it
+  * @param[in] ptr the pointer to retire. `nullptr` is ignored.
+**/
+template< typename T >
+void epoch_retire( T* ptr ) noexcept {
+	epoch_retire( ptr, epoch_reclaim_delete<T>, nullptr );
+}
+
+
+/** @brief retire @a ptr, to be handed to @a destroy once no reader can hold it
+  *
+  * If @a destroy is `nullptr`, @a ptr is deleted instead.
+  *
+  * @param[in] ptr the pointer to retire. `nullptr` is ignored.
+  * @param[in] destroy the function that destroys @a ptr.
+**/
+template< typename T >
+void epoch_retire( T* ptr, void ( * destroy )( T* ) ) noexcept {
+	if ( destroy )
+		epoch_retire( ptr, epoch_reclaim_destroy<T>, reinterpret_cast<void*>( destroy ) );
+	else
+		epoch_retire( ptr, epoch_reclaim_delete<T>, nullptr );
+}
+
+
+/** @brief try to advance the epoch and free what the calling thread retired
+  *
+  * This is done automatically every few retirements. Call it if a
+  * thread retired something and then stops using the containers for
+  * a while.
+**/
+void epoch_reclaim() noexcept PWX_API;
+
+
+/** @brief free everything retired by the calling thread and by ended threads
+  *
+  * **Important**: No other thread may be inside a `CEpochGuard` or
+  * retire anything while this runs. `pwx::finish()` calls it.
+**/
+void epoch_drain() noexcept PWX_API;
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_BASIC_CEPOCHGUARD_H_INCLUDED
@@ -91,12 +91,88 @@ void CLockGuard::reset( CLockable* objA, CLockable* objB, CLockable* objC ) noex
 	l_b = objB;
 	l_c = objC;
 
+	// Objects this thread holds shared must be upgraded with a blocking lock(),
+	// as try_lock() fails with other readers present. Two readers upgrading the
+	// same object would otherwise wait for each other forever.
+	bool upA = l_a && l_a->shared_lock_count();
+	bool upB = l_b && l_b->shared_lock_count();
+	bool upC = l_c && l_c->shared_lock_count();
+	if ( upA ) l_a->lock();
+	if ( upB ) l_b->lock();
+	if ( upC ) l_c->lock();
+
 	while ( !try_locks( l_a, l_b, l_c ) ) {
 		std::this_thread::yield();
 		if ( l_a && l_a->destroyed() ) l_a = nullptr;
 		if ( l_b && l_b->destroyed() ) l_b = nullptr;
 		if ( l_c && l_c->destroyed() ) l_c = nullptr;
 	}
+
+	// The upgrading locks are counted twice now
+	if ( upA && l_a ) l_a->unlock();
+	if ( upB && l_b ) l_b->unlock();
+	if ( upC && l_c ) l_c->unlock();
+}
+
+
+CSharedLockGuard::CSharedLockGuard( CLockable* objA ) noexcept {
+	reset( objA, nullptr, nullptr );
+}
+
+CSharedLockGuard::CSharedLockGuard( CLockable* objA, CLockable* objB ) noexcept {
+	reset( objA, objB, nullptr );
+}
+
+CSharedLockGuard::CSharedLockGuard( CLockable* objA, CLockable* objB, CLockable* objC ) noexcept {
+	reset( objA, objB, objC );
+}
+
+CSharedLockGuard::CSharedLockGuard( CSharedLockGuard &src ) noexcept {
+	l_a = src.l_a;
+	l_b = src.l_b;
+	l_c = src.l_c;
+	src.reset( NULL_LOCK, NULL_LOCK, NULL_LOCK );  // Causes it to unlock
+	reset( l_a, l_b, l_c );
+}
+
+CSharedLockGuard::~CSharedLockGuard() noexcept {
+	reset( NULL_LOCK, NULL_LOCK, NULL_LOCK );
+}
+
+CSharedLockGuard &CSharedLockGuard::operator=( CSharedLockGuard &&src ) noexcept {
+	if ( &src != this ) {
+		l_a = src.l_a;
+		l_b = src.l_b;
+		l_c = src.l_c;
+		src.reset( NULL_LOCK, NULL_LOCK, NULL_LOCK );  // Causes it to unlock
+		reset( l_a, l_b, l_c );
+	}
+	return *this;
+}
+
+void CSharedLockGuard::reset( CLockable* objA ) noexcept {
+	reset( objA, l_b, l_c );
+}
+
+void CSharedLockGuard::reset( CLockable* objA, CLockable* objB ) noexcept {
+	reset( objA, objB, l_c );
+}
+
+void CSharedLockGuard::reset( CLockable* objA, CLockable* objB, CLockable* objC ) noexcept {
+	if ( l_a ) l_a->unlock_shared();
+	if ( l_b ) l_b->unlock_shared();
+	if ( l_c ) l_c->unlock_shared();
+
+	l_a = objA;
+	l_b = objB;
+	l_c = objC;
+
+	while ( !try_shared_locks( l_a, l_b, l_c ) ) {
+		std::this_thread::yield();
+		if ( l_a && l_a->destroyed() ) l_a = nullptr;
+		if ( l_b && l_b->destroyed() ) l_b = nullptr;
+		if ( l_c && l_c->destroyed() ) l_c = nullptr;
+	}
 }
 
 
@@ -198,6 +198,161 @@
     PWX_NAMED_TRIPLE_LOCK_GUARD_RESET(PWX_FUNC, objA, objB, objC)
 
 
+/** @brief Create a shared lock guard on the given object, that is locked shared and unlocked when leaving the current scope
+  *
+  * Note: If you only need exactly one shared lock guard in your function/method, you can
+  *       use `PWX_SHARED_LOCK_GUARD()` instead. It will use the function name.
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+  * @param object pointer to the object to lock shared
+**/
+#define PWX_NAMED_SHARED_LOCK_GUARD( Name, object ) ::pwx::CSharedLockGuard pwx_libpwx_shared_lock_guard_##Name(object)
+
+
+/** @brief Create a shared lock guard on the given object, that is locked shared and unlocked when leaving the current scope
+  *
+  * Note: If you need more than one shared lock guard, you have to use
+  *       `PWX_NAMED_SHARED_LOCK_GUARD()` for any additional ones instead.
+  *
+  * @param object pointer to the object to lock shared
+**/
+#define PWX_SHARED_LOCK_GUARD( object ) PWX_NAMED_SHARED_LOCK_GUARD(PWX_FUNC, object)
+
+
+/** @brief Clear a named shared lock guard, unlocking all currently locked objects
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+**/
+#define PWX_NAMED_SHARED_LOCK_GUARD_CLEAR( Name ) pwx_libpwx_shared_lock_guard_##Name.reset(NULL_LOCK, NULL_LOCK, NULL_LOCK)
+
+
+/// @brief Clear the shared lock guard named after the enclosing function, unlocking all currently held objects
+#define PWX_SHARED_LOCK_GUARD_CLEAR() PWX_NAMED_SHARED_LOCK_GUARD_CLEAR(PWX_FUNC)
+
+
+/** @brief Reset a shared lock guard to a new value
+  *
+  * **Important**: Do not use nullptr or NULL for @a object! Use `PWX_NAMED_SHARED_LOCK_GUARD_CLEAR()` instead!
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+  * @param object pointer to the object to reset the lock guard to
+**/
+#define PWX_NAMED_SHARED_LOCK_GUARD_RESET( Name, object ) pwx_libpwx_shared_lock_guard_##Name.reset(object)
+
+
+/** @brief Reset a shared lock guard to a new value
+  *
+  * **Important**: Do not use nullptr or NULL for @a object! Use `PWX_SHARED_LOCK_GUARD_CLEAR()` instead!
+  *
+  * @param object pointer to the object to reset the lock guard to
+**/
+#define PWX_SHARED_LOCK_GUARD_RESET( object ) PWX_NAMED_SHARED_LOCK_GUARD_RESET(PWX_FUNC, object)
+
+
+/** @brief Create a shared lock guard on two given objects, which are locked shared and unlocked when leaving the current scope
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+  * @param objA pointer to the first object to lock shared
+  * @param objB pointer to the second object to lock shared
+**/
+#define PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD( Name, objA, objB ) \
+    ::pwx::CSharedLockGuard pwx_libpwx_double_shared_lock_guard_##Name(objA, objB)
+
+
+/** @brief Create a shared lock guard on two given objects, which are locked shared and unlocked when leaving the current scope
+  *
+  * @param objA pointer to the first object to lock shared
+  * @param objB pointer to the second object to lock shared
+**/
+#define PWX_DOUBLE_SHARED_LOCK_GUARD( objA, objB ) PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD(PWX_FUNC, objA, objB)
+
+
+/** @brief Clear a named double shared lock guard, unlocking all currently locked objects
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+**/
+#define PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD_CLEAR( Name ) \
+    pwx_libpwx_double_shared_lock_guard_##Name.reset(NULL_LOCK, NULL_LOCK, NULL_LOCK)
+
+
+
+/// @brief Clear the double shared lock guard named after the enclosing function, unlocking all currently held objects
+#define PWX_DOUBLE_SHARED_LOCK_GUARD_CLEAR() PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD_CLEAR(PWX_FUNC)
+
+
+/** @brief Reset a double shared lock guard to two new values
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+  * @param objA pointer to the first object to reset the lock guard to
+  * @param objB pointer to the second object to reset the lock guard to
+**/
+#define PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD_RESET( Name, objA, objB ) \
+    pwx_libpwx_double_shared_lock_guard_##Name.reset(objA, objB)
+
+
+/** @brief Reset a double shared lock guard to two new values
+  *
+  * @param objA pointer to the first object to reset the lock guard to
+  * @param objB pointer to the second object to reset the lock guard to
+**/
+#define PWX_DOUBLE_SHARED_LOCK_GUARD_RESET( objA, objB ) \
+    PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD_RESET(PWX_FUNC, objA, objB)
+
+
+/** @brief Create a shared lock guard on three given objects, which are locked shared and unlocked when leaving the current scope
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+  * @param objA pointer to the first object to lock shared
+  * @param objB pointer to the second object to lock shared
+  * @param objC pointer to the second object to lock shared
+**/
+#define PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD( Name, objA, objB, objC )    \
+    ::pwx::CSharedLockGuard pwx_libpwx_triple_shared_lock_guard_##Name(objA, objB, objC)
+
+
+/** @brief Create a shared lock guard on three given objects, which are locked shared and unlocked when leaving the current scope
+  *
+  * @param objA pointer to the first object to lock shared
+  * @param objB pointer to the second object to lock shared
+  * @param objC pointer to the second object to lock shared
+**/
+#define PWX_TRIPLE_SHARED_LOCK_GUARD( objA, objB, objC ) \
+    PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD(PWX_FUNC, objA, objB, objC)
+
+
+/** @brief Clear a named triple shared lock guard, unlocking all currently locked objects
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+**/
+#define PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD_CLEAR( Name ) \
+    pwx_libpwx_triple_shared_lock_guard_##Name.reset(NULL_LOCK, NULL_LOCK, NULL_LOCK)
+
+
+/// @brief Clear the triple shared lock guard named after the enclosing function, unlocking all currently held objects
+#define PWX_TRIPLE_SHARED_LOCK_GUARD_CLEAR() PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD_CLEAR(PWX_FUNC)
+
+
+/** @brief Reset a triple shared lock guard to two new values
+  *
+  * @param Name a string to add to the local variable name to be able to use more than one guard
+  * @param objA pointer to the first object to reset the lock guard to
+  * @param objB pointer to the second object to reset the lock guard to
+  * @param objC pointer to the third object to reset the lock guard to
+**/
+#define PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD_RESET( Name, objA, objB, objC ) \
+    pwx_libpwx_triple_shared_lock_guard_##Name.reset(objA, objB, objC)
+
+
+/** @brief Reset a triple shared lock guard to two new values
+  *
+  * @param objA pointer to the first object to reset the lock guard to
+  * @param objB pointer to the second object to reset the lock guard to
+  * @param objC pointer to the third object to reset the lock guard to
+**/
+#define PWX_TRIPLE_SHARED_LOCK_GUARD_RESET( objA, objB, objC ) \
+    PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD_RESET(PWX_FUNC, objA, objB, objC)
+
+
 /// @namespace pwx
 namespace pwx {
 
@@ -441,6 +596,248 @@ private:
 };
 
 
+/** @class CSharedLockGuard PSharedLockGuard <PLockGuard>
+  * @brief Basic RAII lock guard to lock/unlock one, two or three objects shared within its ctor/dtor
+  *
+  * This is the same as pwx::CLockGuard, but uses `lock_shared()` and
+  * `unlock_shared()`. Use it for methods that only read.
+  *
+  * There are the following advantages when using this class instead of
+  * doing shared locks directly:
+  *  1. Locking is done in the ctor, unlocking in the dtor automatically.
+  *  2. The class is exception free and can handle null pointers.
+  *  3. The guard can be assigned or copied, making overlapping locks easy to do.
+  *  4. If it is not possible to wait for the destructor, the lock(s) can be unlocked
+  * by resetting to nullptr.
+**/
+class PWX_API CSharedLockGuard {
+public:
+
+	/* ===============================================
+	 * === Public constructors and destructors     ===
+	 * ===============================================
+	*/
+
+	/** @brief One object locking constructor
+	  *
+	  * RAII constructor that returns once @a objA is locked shared.
+	  * **Important**: @a objA must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Pointer to the object that is to be locked shared.
+	**/
+	explicit
+	CSharedLockGuard( CLockable* objA ) noexcept;
+
+
+	/** @brief One object locking constructor via reference
+	  *
+	  * RAII constructor that returns once @a objA is locked shared.
+	  * **Important**: @a objA must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Reference to the object that is to be locked shared.
+	**/
+	explicit
+	CSharedLockGuard( CLockable &objA ) noexcept
+		  : CSharedLockGuard( &objA ) {}
+
+
+	/** @brief One object locking constructor ; const wrapper
+	  *
+	  * RAII constructor that returns once @a objA is locked shared.
+	  * **Important**: @a objA must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Const pointer to the object that is to be locked shared.
+	**/
+	explicit
+	CSharedLockGuard( CLockable const* objA ) noexcept
+		  : CSharedLockGuard( const_cast<CLockable*>( objA ) ) {}
+
+
+	/** @brief Two objects locking constructor
+	  *
+	  * RAII constructor that returns once @a objA and @a objB are locked shared.
+	  * **Important**: @a objA and @a objB must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Pointer to the second object that is to be locked shared.
+	**/
+	CSharedLockGuard( CLockable* objA, CLockable* objB ) noexcept;
+
+
+	/** @brief Two objects locking constructor via reference
+	  *
+	  * RAII constructor that returns once @a objA and @a objB are locked shared.
+	  * **Important**: @a objA and @a objB must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Reference to the first object that is to be locked shared.
+	  * @param[in,out] objB Reference to the second object that is to be locked shared.
+	**/
+	CSharedLockGuard( CLockable &objA, CLockable &objB ) noexcept
+		  : CSharedLockGuard( &objA, &objB ) {}
+
+
+	/** @brief Two objects locking constructor ; const wrapper
+	  *
+	  * RAII constructor that returns once @a objA and @a objB are locked shared.
+	  * **Important**: @a objA and @a objB must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Const pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Const pointer to the second object that is to be locked shared.
+	**/
+	CSharedLockGuard( CLockable const* objA, CLockable const* objB ) noexcept
+		  : CSharedLockGuard( const_cast<CLockable*>( objA ), const_cast<CLockable*>( objB ) ) {}
+
+
+	/** @brief Three objects locking constructor
+	  *
+	  * RAII constructor that returns once @a objA, @a objB and @a objC are locked shared.
+	  * **Important**: @a objA, @a objB and @a objC must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Pointer to the second object that is to be locked shared.
+	  * @param[in,out] objC Pointer to the third object that is to be locked shared.
+	**/
+	CSharedLockGuard( CLockable* objA, CLockable* objB, CLockable* objC ) noexcept;
+
+
+	/** @brief Three objects locking constructor via reference
+	  *
+	  * RAII constructor that returns once @a objA, @a objB and @a objC are locked shared.
+	  * **Important**: @a objA, @a objB and @a objC must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Reference to the first object that is to be locked shared.
+	  * @param[in,out] objB Reference to the second object that is to be locked shared.
+	  * @param[in,out] objC Reference to the third object that is to be locked shared.
+	**/
+	CSharedLockGuard( CLockable &objA, CLockable &objB, CLockable &objC ) noexcept
+		  : CSharedLockGuard( &objA, &objB, &objC ) {}
+
+
+	/** @brief Three objects locking constructor ; const wrapper
+	  *
+	  * RAII constructor that returns once @a objA, @a objB and @a objC are locked shared.
+	  * **Important**: @a objA, @a objB and @a objC must be derived from pwx::CLockable !
+	  *
+	  * @param[in,out] objA Const pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Const pointer to the second object that is to be locked shared.
+	  * @param[in,out] objC Const pointer to the third object that is to be locked shared.
+	**/
+	CSharedLockGuard( CLockable const* objA, CLockable const* objB, CLockable const* objC ) noexcept
+		  : CSharedLockGuard( const_cast<CLockable*>( objA ), const_cast<CLockable*>( objB ), const_cast<CLockable*>( objC ) ) {}
+
+
+	/** @brief Copy constructor that takes over the locks from another CSharedLockGuard instance
+	  *
+	  * Before the objects can be locked, they have to be unlocked by @a src, which
+	  * means that there is a tiny window in which another thread might lock any of
+	  * these objects.
+	  *
+	  * @param[in,out] src Reference to the source to copy.
+	**/
+	CSharedLockGuard( CSharedLockGuard &src ) noexcept;
+
+
+	/** @brief Copy constructor that takes over the locks from another CSharedLockGuard instance ; const wrapper
+	  *
+	  * Before the objects can be locked, they have to be unlocked by @a src, which
+	  * means that there is a tiny window in which another thread might lock any of
+	  * these objects.
+	  *
+	  * @param[in,out] src Const reference to the source to copy.
+	**/
+	CSharedLockGuard( CSharedLockGuard const &src ) noexcept
+		  : CSharedLockGuard( const_cast<CSharedLockGuard &>( src ) ) {}
+
+
+	/// @brief The default destructor unlocks all objects currently held locked shared.
+	~CSharedLockGuard() noexcept;
+
+	// No empty ctor
+	CSharedLockGuard() PWX_DELETE;
+
+
+	/* ===============================================
+	 * === Public operators                        ===
+	 * ===============================================
+	*/
+
+	/** @brief The assignment operator takes over the locks from another CSharedLockGuard instance
+	  *
+	  * Before the objects can be locked, they have to be unlocked by @a src, which
+	  * means that there is a tiny window in which another thread might lock any of
+	  * these objects.
+	  *
+	  * @param[in,out] src Reference to the source to take over from.
+	**/
+	CSharedLockGuard &operator=( CSharedLockGuard &&src ) noexcept;
+
+
+	/* ===============================================
+	 * === Public Methods                          ===
+	 * ===============================================
+	*/
+
+	/** @brief Unlock all objects, and switch to lock shared only @a objA instead.
+	  * @param[in,out] objA Pointer to the object that is to be locked shared.
+	**/
+	void reset( CLockable* objA ) noexcept;
+
+
+	/** @brief Unlock all objects, and switch to lock shared only @a objA instead ; const wrapper.
+	  * @param[in,out] objA Const pointer to the object that is to be locked shared.
+	**/
+	void reset( CLockable const* objA ) noexcept {
+		this->reset( const_cast<CLockable*>( objA ) );
+	}
+
+
+	/** @brief Unlock all objects, and switch to lock shared @a objA and @a objB instead.
+	  * @param[in,out] objA Pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Pointer to the second object that is to be locked shared.
+	**/
+	void reset( CLockable* objA, CLockable* objB ) noexcept;
+
+
+	/** @brief Unlock all objects, and switch to lock shared @a objA and @a objB instead ; const wrapper.
+	  * @param[in,out] objA Const pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Const pointer to the second object that is to be locked shared.
+	**/
+	void reset( CLockable const* objA, CLockable const* objB ) noexcept {
+		this->reset( const_cast<CLockable*>( objA ), const_cast<CLockable*>( objB ) );
+	}
+
+
+	/** @brief Unlock all objects, and switch to lock shared only @a objA, @a objB and @a objC instead.
+	  * @param[in,out] objA Pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Pointer to the second object that is to be locked shared.
+	  * @param[in,out] objC Pointer to the third object that is to be locked shared.
+	**/
+	void reset( CLockable* objA, CLockable* objB, CLockable* objC ) noexcept;
+
+
+	/** @brief Unlock all objects, and switch to lock shared only @a objA, @a objB and @a objC instead ; const wrapper.
+	  * @param[in,out] objA Const pointer to the first object that is to be locked shared.
+	  * @param[in,out] objB Const pointer to the second object that is to be locked shared.
+	  * @param[in,out] objC Const pointer to the third object that is to be locked shared.
+	**/
+	void reset( CLockable const* objA, CLockable const* objB, CLockable const* objC ) noexcept {
+		this->reset( const_cast<CLockable*>( objA ), const_cast<CLockable*>( objB ), const_cast<CLockable*>( objC ) );
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private Members                         ===
+	 * ===============================================
+	*/
+
+	CLockable* l_a = nullptr;
+	CLockable* l_b = nullptr;
+	CLockable* l_c = nullptr;
+};
+
+
 } // namespace pwx
 
 #endif // PWX_LIBPWX_PWX_TYPES_CLOCKGUARD_H_INCLUDED
@@ -30,11 +30,19 @@
 **/
 
 
+#include <algorithm>
 #include <thread>
+#include <vector>
 
 #include "basic/compiler.h"
 #include "basic/macros.h"
 
+#if PWX_IS_LINUX
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif // PWX_IS_LINUX
+
 #include "basic/CLockable.h"
 
 
@@ -54,11 +62,20 @@ namespace pwx {
  * ---                 load in acquire memory order.                                                 ---
  * --- CL_Lock         The lock, if using a spinlock, must be cleared in release memory order to be  ---
  * ---                 sure that a waiting thread does not waste a cycle by a superfluous yield().   ---
+ * --- CL_Lock_Mode    Like CL_Do_Locking this is set once after object creation. But a thread that  ---
+ * ---                 waited for the lock of the old mode must see the change once it gets the old  ---
+ * ---                 lock. So it is stored in release and loaded in acquire memory order.          ---
+ * --- CL_Park_State   The adaptive lock word. It is the lock itself, so acquiring it needs acquire, ---
+ * ---                 and releasing it needs release memory order.                                  ---
+ * --- CL_Spin_Limit   Only a hint for the spinning phase of the adaptive lock. Relaxed is enough.   ---
  * --- CL_Lock_Count   This is a value that is only used by the currently owning thread. There is no ---
  * ---                 reason why any access shouldn't be in relaxed memory order.                   ---
  * --- CL_Thread_ID    The same applies for the stored thread id. Whether a thread sets it to its own---
  * ---                 id during locking, or sets it to 0x0 during unlocking, it will always be      ---
  * ---                 different to not owning threads.                                              ---
+ * --- CL_Readers      Readers increase this and then check CL_Writer, writers set CL_Writer and     ---
+ * --- CL_Writer       then check CL_Readers. Both sides must see the store of the other one, which  ---
+ * ---                 is only guaranteed with sequentially consistent memory order.                 ---
  * --- About memOrdLoad and memOrdStore:                                                             ---
  * --- As the memory order is an enum, that can be used directly, both should not be used inside the ---
  * --- implementation, unless it would require to question CL_Do_Locking otherwise. It does mean     ---
@@ -66,6 +83,149 @@ namespace pwx {
  * ---------------------------------------------------------------------------------------------------*/
 
 
+/* --------------------------------------------------------------------
+ * --- Tuning values and helpers for the adaptive (LM_ADAPTIVE) mode ---
+ * ------------------------------------------------------------------ */
+static const uint32_t adaptiveSpinInit = 1024;  // Initial spins before parking a waiting thread
+static const uint32_t adaptiveSpinMin  = 16;    // Never spin less than this before parking
+static const uint32_t adaptiveSpinMax  = 16384; // Never spin more than this before parking
+static const uint32_t adaptiveBackMax  = 64;    // Maximum number of pause instructions per backoff step
+
+
+/// @internal Tell the CPU that we are in a spin-wait loop.
+static inline void cpu_relax() noexcept {
+#if PWX_IS_MSVC
+	YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	asm volatile( "yield" ::: "memory" );
+#else
+	std::atomic_signal_fence( std::memory_order_seq_cst );
+#endif // Architecture
+}
+
+
+/// @internal Park the calling thread while @a word still equals @a expected.
+static inline void park_thread( std::atomic_uint32_t* word, uint32_t expected ) noexcept {
+#if PWX_IS_LINUX
+	syscall( SYS_futex, reinterpret_cast<uint32_t*>( word ), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0 );
+#else
+	if ( expected == word->load( std::memory_order_relaxed ) ) {
+		std::this_thread::yield();
+	}
+#endif // PWX_IS_LINUX
+}
+
+
+/* ----------------------------------------------------------------------
+ * --- Shared locks held by the current thread. Each object this thread ---
+ * --- has locked shared gets one entry counting its shared locks, so a ---
+ * --- thread counts only once in CL_Readers, no matter how often it    ---
+ * --- locked shared, and recursive shared locks never block.           ---
+ * --- The first sharedHoldSlots entries live in a fixed array, so      ---
+ * --- recording a hold does not allocate in the common case. Only a    ---
+ * --- thread holding more objects at once spills into a vector, and    ---
+ * --- if that fails, add_shared_hold() reports sharedHoldFailed.       ---
+ * -------------------------------------------------------------------- */
+struct sSharedHold {
+	CLockable const* object; //!< The object locked shared
+	uint32_t         count;  //!< How many shared locks this thread holds on it
+};
+static const uint32_t sharedHoldSlots  = 16;
+static const uint32_t sharedHoldFailed = 0xffffffff;
+static thread_local sSharedHold              sharedHolds[sharedHoldSlots]; // Zero initialized
+static thread_local uint32_t                 sharedHoldsUsed = 0;
+static thread_local std::vector<sSharedHold> sharedHoldsMore;
+
+
+/// @internal Return the entry of @a object or nullptr if the current thread holds no shared lock on it.
+static sSharedHold* find_shared_hold( CLockable const* object ) noexcept {
+	for ( uint32_t i = 0; i < sharedHoldsUsed; ++i ) {
+		if ( sharedHolds[i].object == object ) {
+			return &sharedHolds[i];
+		}
+	}
+	for ( auto &hold : sharedHoldsMore ) {
+		if ( hold.object == object ) {
+			return &hold;
+		}
+	}
+	return nullptr;
+}
+
+
+/// @internal Return the number of shared locks the current thread holds on @a object.
+static uint32_t get_shared_holds( CLockable const* object ) noexcept {
+	sSharedHold* hold = find_shared_hold( object );
+	return hold ? hold->count : 0;
+}
+
+
+/** @internal Count one more shared lock on @a object, return the number of shared locks held before.
+  * If no memory is left to record the first shared lock on @a object, sharedHoldFailed is returned.
+**/
+static uint32_t add_shared_hold( CLockable const* object ) noexcept {
+	sSharedHold* hold = find_shared_hold( object );
+	if ( hold ) {
+		return hold->count++;
+	}
+
+	if ( sharedHoldsUsed < sharedHoldSlots ) {
+		sharedHolds[sharedHoldsUsed++] = { object, 1 };
+		return 0;
+	}
+
+	try {
+		sharedHoldsMore.push_back( { object, 1 } );
+	} catch ( ... ) {
+		return sharedHoldFailed;
+	}
+	return 0;
+}
+
+
+/// @internal Count one shared lock less on @a object, return the number of shared locks held before.
+static uint32_t drop_shared_hold( CLockable const* object ) noexcept {
+	sSharedHold* hold = find_shared_hold( object );
+	if ( nullptr == hold ) {
+		return 0;
+	}
+
+	uint32_t count = hold->count--;
+	if ( 0 == hold->count ) {
+		// Fill the gap with the last entry, moving a spilled one back into the slots
+		if ( ( hold >= sharedHolds ) && ( hold < sharedHolds + sharedHoldsUsed ) ) {
+			*hold = sharedHolds[--sharedHoldsUsed];
+			if ( !sharedHoldsMore.empty() ) {
+				sharedHolds[sharedHoldsUsed++] = sharedHoldsMore.back();
+				sharedHoldsMore.pop_back();
+			}
+		} else {
+			*hold = sharedHoldsMore.back();
+			sharedHoldsMore.pop_back();
+		}
+	}
+	return count;
+}
+
+
+/// @internal Forget all shared locks the current thread holds on @a object.
+static void forget_shared_holds( CLockable const* object ) noexcept {
+	while ( drop_shared_hold( object ) > 1 ) { /* drop them all */ }
+}
+
+
+/// @internal Wake up one thread parked on @a word.
+static inline void unpark_thread( std::atomic_uint32_t* word ) noexcept {
+#if PWX_IS_LINUX
+	syscall( SYS_futex, reinterpret_cast<uint32_t*>( word ), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+#else
+	( void )word; // The parked threads are yielding, and will notice by themselves.
+#endif // PWX_IS_LINUX
+}
+
+
 CLockable::CLockable() noexcept PWX_DEFAULT;
 
 
@@ -73,11 +233,12 @@ CLockable::CLockable( CLockable const &src ) noexcept
 	  : memOrdLoad( src.memOrdLoad ), memOrdStore( src.memOrdStore ), CL_Do_Locking(
 	  src.CL_Do_Locking
 	     .load( std::memory_order_relaxed )
-) { /* --- nothing to do here. ---*/ }
+), CL_Lock_Mode( src.CL_Lock_Mode.load( std::memory_order_relaxed ) ) { /* --- nothing to do here. ---*/ }
 
 
 CLockable::~CLockable() noexcept {
 	isDestroyed.store( true, memOrdStore );
+	forget_shared_holds( this );
 #if PWX_USE_FLAGSPIN
 	// Simply move the id to this thread:
 	CL_Thread_ID.store( CURRENT_THREAD_ID, std::memory_order_relaxed );
@@ -93,6 +254,7 @@ CLockable::~CLockable() noexcept {
 
 CLockable &CLockable::operator=( CLockable const &src ) noexcept {
 	do_locking( src.CL_Do_Locking.load( std::memory_order_relaxed ) );
+	set_lock_mode( src.CL_Lock_Mode.load( std::memory_order_relaxed ) );
 	return *this;
 }
 
@@ -119,11 +281,8 @@ bool CLockable::clear_locks() noexcept {
 			CL_Lock_Count.store( 0, std::memory_order_relaxed );
 			CL_Thread_ID.store( 0, std::memory_order_relaxed );
 			CL_Is_Locked.store( false, std::memory_order_relaxed );
-#if PWX_USE_FLAGSPIN
-			CL_Lock.clear( memOrdStore ); // This *must* be last!
-#else
-			CL_Lock.unlock();
-#endif // PWX_USE_FLAGSPIN
+			// This *must* be last!
+			privReleaseWriter( memOrdStore );
 		} // End of trying from within the right thread
 		else {
 			return false;
@@ -159,31 +318,22 @@ void CLockable::do_locking( bool doLock ) noexcept {
 			 * thread must be the exclusive user.
 			 */
 			if ( CL_Thread_ID.load( std::memory_order_relaxed ) != CURRENT_THREAD_ID ) {
-				/* Sorry for the code doubling, but lock() would listen
-				 * to CL_Do_Locking and that has to be false by now.
+				/* Note: lock() would listen to CL_Do_Locking,
+				 * and that has to be false by now.
 				 */
 				std::this_thread::yield(); // to be sure this thread is last
-#if PWX_USE_FLAGSPIN
-				while ( CL_Lock.test_and_set() ) {
-# if PWX_USE_FLAGSPIN_YIELD
-					std::this_thread::yield();
-# endif // PWX_USE_FLAGSPIN_YIELD
-				}
-#else
-				CL_Lock.lock();
-#endif // PWX_USE_FLAGSPIN
+				privAcquire();
 			} // end of having to gain the lock
 
 			// Nuke all data:
 			CL_Thread_ID.store( 0, std::memory_order_relaxed );
 			CL_Lock_Count.store( 0, std::memory_order_relaxed );
-#if PWX_USE_FLAGSPIN
-			// Note: Here it is in order to clear relaxed, as no
+			CL_Readers.store( 0, std::memory_order_relaxed );
+			CL_Writer.store( false, std::memory_order_relaxed );
+			forget_shared_holds( this );
+			// Note: Here it is in order to release relaxed, as no
 			//       other thread should be waitng right now.
-			CL_Lock.clear( std::memory_order_relaxed );
-#else
-			CL_Lock.unlock();
-#endif // PWX_USE_FLAGSPIN
+			privRelease( CL_Lock_Mode.load( std::memory_order_relaxed ), std::memory_order_relaxed );
 			CL_Is_Locked.store( false, std::memory_order_release );
 			// The memory order is relaxed last
 			memOrdLoad  = std::memory_order_relaxed;
@@ -218,16 +368,14 @@ void CLockable::lock() noexcept {
 		// is only taken if this object is not already
 		// locked by this thread
 		if ( ctid != CL_Thread_ID.load( std::memory_order_relaxed ) ) {
-			CL_Waiting++;
-#if PWX_USE_FLAGSPIN
-			while ( CL_Lock.test_and_set() ) {
-# if PWX_USE_FLAGSPIN_YIELD
-				std::this_thread::yield();
-# endif // PWX_USE_FLAGSPIN_YIELD
+			// A reader has to step back first, or it would wait for itself.
+			if ( get_shared_holds( this ) ) {
+				CL_Readers.fetch_sub( 1, std::memory_order_seq_cst );
 			}
-#else
-			CL_Lock.lock();
-#endif // PWX_USE_FLAGSPIN
+
+			CL_Waiting++;
+			privAcquire();
+			privWaitForReaders();
 
 			// Got it now, so note it:
 			CL_Is_Locked.store( true, std::memory_order_release );
@@ -251,6 +399,82 @@ uint32_t CLockable::lock_count() const noexcept {
 }
 
 
+PWX_NODISCARD_SIMPLE
+eLockMode CLockable::lock_mode() const noexcept {
+	return CL_Lock_Mode.load( std::memory_order_relaxed );
+}
+
+
+void CLockable::lock_shared() noexcept {
+	// return at once if this object is in destruction
+	if ( isDestroyed.load( memOrdLoad ) ) {
+		return;
+	}
+
+	if ( CL_Do_Locking.load( std::memory_order_relaxed ) ) {
+		// Only the first shared lock of a thread that is not
+		// the exclusive owner has to wait for anything.
+		uint32_t held = add_shared_hold( this );
+
+		// If the hold can not be recorded, wait for memory like for any other resource.
+		while ( sharedHoldFailed == held ) {
+			std::this_thread::yield();
+			held = add_shared_hold( this );
+		}
+
+		if ( ( 0 == held )
+		     && ( CURRENT_THREAD_ID != CL_Thread_ID.load( std::memory_order_relaxed ) ) ) {
+			privAcquireShared();
+		}
+	} // End of doing locking
+}
+
+
+PWX_NODISCARD_SIMPLE
+uint32_t CLockable::readers() const noexcept {
+	return CL_Readers.load( memOrdLoad );
+}
+
+
+void CLockable::set_lock_mode( eLockMode mode ) noexcept {
+	if ( mode == CL_Lock_Mode.load( std::memory_order_relaxed ) ) {
+		return;
+	}
+
+	// Without locking there are no waiting threads to care about
+	if ( !CL_Do_Locking.load( std::memory_order_relaxed ) ) {
+		CL_Lock_Mode.store( mode, std::memory_order_release );
+		return;
+	}
+
+	// Get the lock in the current mode, so this thread is the owner
+	lock();
+
+	eLockMode oldMode = CL_Lock_Mode.load( std::memory_order_relaxed );
+	if ( mode != oldMode ) {
+		// Get the new lock as well. Nobody uses it, so this does not block.
+		if ( LM_ADAPTIVE == mode ) {
+			privLockAdaptive();
+		} else {
+			privLockDefault();
+		}
+
+		// Switch, then let go of the old lock. Threads waiting for it
+		// will notice the change and retry with the new mode.
+		CL_Lock_Mode.store( mode, std::memory_order_release );
+		privRelease( oldMode, std::memory_order_release );
+	}
+
+	unlock();
+}
+
+
+PWX_NODISCARD_SIMPLE
+uint32_t CLockable::shared_lock_count() const noexcept {
+	return get_shared_holds( this );
+}
+
+
 PWX_NODISCARD_SIMPLE
 bool CLockable::try_lock() noexcept {
 	// return at once if this object is in destruction
@@ -265,11 +489,24 @@ bool CLockable::try_lock() noexcept {
 		// not already own the lock
 		if ( ctid != CL_Thread_ID.load( std::memory_order_relaxed ) ) {
 			CL_Waiting++;
-#if PWX_USE_FLAGSPIN
-			if ( !CL_Lock.test_and_set() ) {
-#else
-				if ( CL_Lock.try_lock() ) {
-#endif // PWX_USE_FLAGSPIN
+			if ( privTryAcquire() ) {
+				bool isReader = get_shared_holds( this ) > 0;
+				if ( isReader ) {
+					CL_Readers.fetch_sub( 1, std::memory_order_seq_cst );
+				}
+				CL_Writer.store( true, std::memory_order_seq_cst );
+
+				// Other readers make this fail, waiting for them would block.
+				if ( CL_Readers.load( std::memory_order_seq_cst ) ) {
+					if ( isReader ) {
+						CL_Readers.fetch_add( 1, std::memory_order_seq_cst );
+					}
+					CL_Writer.store( false, std::memory_order_release );
+					privRelease( CL_Lock_Mode.load( std::memory_order_relaxed ), std::memory_order_release );
+					CL_Waiting--;
+					return false;
+				}
+
 				// Got it now, so note it:
 				CL_Is_Locked.store( true, std::memory_order_release );
 				CL_Thread_ID.store( ctid, std::memory_order_relaxed );
@@ -290,6 +527,38 @@ bool CLockable::try_lock() noexcept {
 }
 
 
+PWX_NODISCARD_SIMPLE
+bool CLockable::try_lock_shared() noexcept {
+	// return at once if this object is in destruction
+	if ( isDestroyed.load( memOrdLoad ) ) {
+		return false;
+	}
+
+	if ( CL_Do_Locking.load( std::memory_order_relaxed ) ) {
+		// Same as with lock_shared(): Only the first shared lock of
+		// a thread that is not the exclusive owner must be checked.
+		// Record the hold first, so a failure leaves nothing to undo but the hold itself.
+		uint32_t held = add_shared_hold( this );
+		if ( sharedHoldFailed == held ) {
+			return false; // No memory to record the shared lock.
+		}
+
+		if ( ( 0 == held )
+		     && ( CURRENT_THREAD_ID != CL_Thread_ID.load( std::memory_order_relaxed ) ) ) {
+			CL_Readers.fetch_add( 1, std::memory_order_seq_cst );
+			if ( CL_Writer.load( std::memory_order_seq_cst ) ) {
+				CL_Readers.fetch_sub( 1, std::memory_order_seq_cst );
+				drop_shared_hold( this );
+				return false; // A writer is in charge.
+			}
+		}
+	}
+
+	// return true otherwise, we are fine.
+	return true;
+}
+
+
 void CLockable::unlock() noexcept {
 	if ( CL_Do_Locking.load( std::memory_order_relaxed )
 	     && ( CURRENT_THREAD_ID == CL_Thread_ID.load( std::memory_order_relaxed ) ) ) {
@@ -298,12 +567,212 @@ void CLockable::unlock() noexcept {
 			// The lock will go away now:
 			CL_Thread_ID.store( 0, std::memory_order_relaxed );
 			CL_Is_Locked.store( false, std::memory_order_relaxed );
+			privReleaseWriter( std::memory_order_release );
+		} // end of reducing the lock count
+	}
+}
+
+
+void CLockable::unlock_shared() noexcept {
+	if ( CL_Do_Locking.load( std::memory_order_relaxed )
+	     && ( 1 == drop_shared_hold( this ) )
+	     && ( CURRENT_THREAD_ID != CL_Thread_ID.load( std::memory_order_relaxed ) ) ) {
+		// That was the last shared lock of this thread
+		CL_Readers.fetch_sub( 1, std::memory_order_seq_cst );
+	}
+}
+
+
+// =======================================
+// === Private methods implementation ====
+// =======================================
+
+
+/* Acquire the lock of the current mode. If the mode was switched while
+ * this thread was waiting, the lock of the old mode is given back, and
+ * the thread tries again with the new one.
+ */
+void CLockable::privAcquire() noexcept {
+	eLockMode mode = CL_Lock_Mode.load( std::memory_order_acquire );
+
+	while ( true ) {
+		if ( LM_ADAPTIVE == mode ) {
+			privLockAdaptive();
+		} else {
+			privLockDefault();
+		}
+
+		eLockMode curMode = CL_Lock_Mode.load( std::memory_order_acquire );
+		if ( curMode == mode ) {
+			return;
+		}
+
+		privRelease( mode, std::memory_order_release );
+		mode = curMode;
+	}
+}
+
+
+/* A reader announces itself first, and then checks whether there is
+ * a writer. If there is one, the reader steps back and waits until
+ * the writer is gone. As a writer does it the other way round, one of
+ * both will always see the other.
+ */
+void CLockable::privAcquireShared() noexcept {
+	while ( true ) {
+		CL_Readers.fetch_add( 1, std::memory_order_seq_cst );
+		if ( !CL_Writer.load( std::memory_order_seq_cst ) ) {
+			return;
+		}
+
+		CL_Readers.fetch_sub( 1, std::memory_order_seq_cst );
+		while ( CL_Writer.load( std::memory_order_acquire ) ) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+
+/* The adaptive lock is a three state futex word (see Ulrich Drepper,
+ * "Futexes Are Tricky"): 0 = free, 1 = locked, 2 = locked with parked
+ * waiters. Before a thread parks, it spins with an exponential backoff.
+ * The spin limit is a moving average of what was needed recently, and
+ * is shortened by the number of threads that wait at the same time, as
+ * they would only burn their cores spinning against each other.
+ */
+void CLockable::privLockAdaptive() noexcept {
+	uint32_t state = 0;
+
+	// Fast path: The lock is free
+	if ( CL_Park_State.compare_exchange_strong( state, 1, std::memory_order_acquire, std::memory_order_relaxed ) ) {
+		return;
+	}
+
+	uint32_t limit = CL_Spin_Limit.load( std::memory_order_relaxed );
+	if ( 0 == limit ) {
+		limit = adaptiveSpinInit;
+	}
+	uint32_t waiting = CL_Waiting.load( std::memory_order_relaxed );
+	uint32_t maxSpin = waiting > 1 ? limit / waiting : limit;
+	uint32_t spins   = 0;
+	uint32_t backoff = 1;
+
+	// Phase 1: Spin with exponential backoff
+	while ( spins < maxSpin ) {
+		for ( uint32_t i = 0; i < backoff; ++i ) {
+			cpu_relax();
+		}
+		spins += backoff;
+		if ( backoff < adaptiveBackMax ) {
+			backoff <<= 1;
+		}
+
+		state = 0;
+		if ( ( 0 == CL_Park_State.load( std::memory_order_relaxed ) )
+		     && CL_Park_State.compare_exchange_weak( state, 1, std::memory_order_acquire, std::memory_order_relaxed ) ) {
+			// Success, let the limit move towards twice what was needed.
+			int64_t diff = ( static_cast<int64_t>( spins ) * 2 - static_cast<int64_t>( limit ) ) / 8;
+			CL_Spin_Limit.store( static_cast<uint32_t>(
+				std::clamp<int64_t>( limit + diff, adaptiveSpinMin, adaptiveSpinMax ) ), std::memory_order_relaxed );
+			return;
+		}
+	}
+
+	// Spinning was in vain, so shrink the limit before parking.
+	CL_Spin_Limit.store( std::max( adaptiveSpinMin, limit - limit / 8 ), std::memory_order_relaxed );
+
+	// Phase 2: Park until the lock is handed over
+	state = CL_Park_State.exchange( 2, std::memory_order_acquire );
+	while ( 0 != state ) {
+		park_thread( &CL_Park_State, 2 );
+		state = CL_Park_State.exchange( 2, std::memory_order_acquire );
+	}
+}
+
+
+void CLockable::privLockDefault() noexcept {
 #if PWX_USE_FLAGSPIN
-			CL_Lock.clear( std::memory_order_release );
+	while ( CL_Lock.test_and_set() ) {
+# if PWX_USE_FLAGSPIN_YIELD
+		std::this_thread::yield();
+# endif // PWX_USE_FLAGSPIN_YIELD
+	}
 #else
-			CL_Lock.unlock();
+	CL_Lock.lock();
 #endif // PWX_USE_FLAGSPIN
-		} // end of reducing the lock count
+}
+
+
+void CLockable::privRelease( eLockMode mode, mord_t order ) noexcept {
+	if ( LM_ADAPTIVE == mode ) {
+		// Note: The exchange must at least release, or the next owner
+		//       might not see what this thread did under the lock.
+		if ( 2 == CL_Park_State.exchange( 0, std::memory_order_release ) ) {
+			unpark_thread( &CL_Park_State );
+		}
+		return;
+	}
+#if PWX_USE_FLAGSPIN
+	CL_Lock.clear( order );
+#else
+	( void )order;
+	CL_Lock.unlock();
+#endif // PWX_USE_FLAGSPIN
+}
+
+
+/* Give up the exclusive lock. If the releasing thread held shared locks
+ * before it upgraded, it becomes a reader again while it still holds
+ * the exclusive lock, so no other writer can get in between.
+ */
+void CLockable::privReleaseWriter( mord_t order ) noexcept {
+	if ( get_shared_holds( this ) ) {
+		CL_Readers.fetch_add( 1, std::memory_order_seq_cst );
+	}
+	CL_Writer.store( false, std::memory_order_seq_cst );
+	privRelease( CL_Lock_Mode.load( std::memory_order_relaxed ), order );
+}
+
+
+PWX_NODISCARD_SIMPLE
+bool CLockable::privTryAcquire() noexcept {
+	eLockMode mode = CL_Lock_Mode.load( std::memory_order_acquire );
+	bool      got  = LM_ADAPTIVE == mode ? privTryLockAdaptive() : privTryLockDefault();
+
+	// If the mode was switched meanwhile, this is no lock at all.
+	if ( got && ( mode != CL_Lock_Mode.load( std::memory_order_acquire ) ) ) {
+		privRelease( mode, std::memory_order_release );
+		got = false;
+	}
+
+	return got;
+}
+
+
+PWX_NODISCARD_SIMPLE
+bool CLockable::privTryLockAdaptive() noexcept {
+	uint32_t state = 0;
+	return CL_Park_State.compare_exchange_strong( state, 1, std::memory_order_acquire, std::memory_order_relaxed );
+}
+
+
+PWX_NODISCARD_SIMPLE
+bool CLockable::privTryLockDefault() noexcept {
+#if PWX_USE_FLAGSPIN
+	return !CL_Lock.test_and_set();
+#else
+	return CL_Lock.try_lock();
+#endif // PWX_USE_FLAGSPIN
+}
+
+
+/* Called by the new owner of the exclusive lock. New readers are held off
+ * by CL_Writer, the current readers only have to finish their business.
+ */
+void CLockable::privWaitForReaders() noexcept {
+	CL_Writer.store( true, std::memory_order_seq_cst );
+	while ( CL_Readers.load( std::memory_order_seq_cst ) ) {
+		std::this_thread::yield();
 	}
 }
 
@@ -402,6 +871,66 @@ bool try_locks( CLockable const &objA, CLockable const &objB, CLockable const &o
 }
 
 
+PWX_NODISCARD_SIMPLE
+bool try_shared_locks( CLockable const* objA, CLockable const* objB ) noexcept {
+	auto xObjA = const_cast<CLockable*>( objA );
+	auto xObjB = const_cast<CLockable*>( objB );
+
+	bool lockedA = nullptr == xObjA;
+	bool lockedB = nullptr == xObjB;
+
+	if ( !lockedA || !lockedB ) {
+		if ( xObjA ) lockedA = xObjA->try_lock_shared();
+		if ( xObjB ) lockedB = xObjB->try_lock_shared();
+
+		if ( !lockedA || !lockedB ) {
+			if ( xObjA && lockedA ) xObjA->unlock_shared();
+			if ( xObjB && lockedB ) xObjB->unlock_shared();
+		}
+	}
+
+	return lockedA && lockedB;
+}
+
+
+PWX_NODISCARD_SIMPLE
+bool try_shared_locks( CLockable const &objA, CLockable const &objB ) noexcept {
+	return try_shared_locks( &objA, &objB );
+}
+
+
+PWX_NODISCARD_SIMPLE
+bool try_shared_locks( CLockable const* objA, CLockable const* objB, CLockable const* objC ) noexcept {
+	auto xObjA = const_cast<CLockable*>( objA );
+	auto xObjB = const_cast<CLockable*>( objB );
+	auto xObjC = const_cast<CLockable*>( objC );
+
+	bool lockedA = nullptr == xObjA;
+	bool lockedB = nullptr == xObjB;
+	bool lockedC = nullptr == xObjC;
+
+	if ( !lockedA || !lockedB || !lockedC ) {
+		if ( xObjA ) lockedA = xObjA->try_lock_shared();
+		if ( xObjB ) lockedB = xObjB->try_lock_shared();
+		if ( xObjC ) lockedC = xObjC->try_lock_shared();
+
+		if ( !lockedA || !lockedB || !lockedC ) {
+			if ( xObjA && lockedA ) xObjA->unlock_shared();
+			if ( xObjB && lockedB ) xObjB->unlock_shared();
+			if ( xObjC && lockedC ) xObjC->unlock_shared();
+		}
+	}
+
+	return lockedA && lockedB && lockedC;
+}
+
+
+PWX_NODISCARD_SIMPLE
+bool try_shared_locks( CLockable const &objA, CLockable const &objB, CLockable const &objC ) noexcept {
+	return try_shared_locks( &objA, &objB, &objC );
+}
+
+
 bool unlock_all( CLockable const* objA, CLockable const* objB ) noexcept {
 	if ( are_locked( objA, objB ) ) {
 		if ( objA ) const_cast<CLockable*>( objA )->unlock();
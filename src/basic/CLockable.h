@@ -111,6 +111,15 @@ if (object) {               \
 namespace pwx {
 
 
+/** @enum eLockMode
+  * @brief Determine how a CLockable derived object waits for its lock.
+**/
+enum eLockMode {
+	LM_DEFAULT  = 0, //!< Use the build time default, either an atomic_flag spinlock or a std::mutex.
+	LM_ADAPTIVE = 1  //!< Spin with exponential backoff first, then park the waiting thread.
+};
+
+
 /** @class CLockable PLockable <PLockable>
   *
   * @brief Base class to make objects lockable via atomic_flag and lock counting.
@@ -127,12 +136,23 @@ namespace pwx {
   * | `is_locking()`       | returns true if the locking mechanism is turned on         |
   * | `lock()`             | acquire lock for the current thread. (Blocking)            |
   * | `lock_count()`       | return the number of locks the current thread has          |
+  * | `lock_mode()`        | returns the currently used pwx::eLockMode                  |
+  * | `lock_shared()`      | acquire a shared lock for the current thread (3)           |
+  * | `readers()`          | return the number of threads holding a shared lock         |
+  * | `set_lock_mode(mode)`| switch the locking strategy to @a mode (2)                 |
+  * | `shared_lock_count()`| return the number of shared locks the current thread has   |
   * | `try_lock()`         | try to acquire lock for the current thread. (Not blocking) |
+  * | `try_lock_shared()`  | try to acquire a shared lock. (Not blocking)               |
   * | `unlock()`           | release lock for the current thread if it holds one        |
+  * | `unlock_shared()`    | release one shared lock of the current thread              |
   *
   * (1) This is useful if you use anything derived from `CLockable` in a single
   * threaded environment. The default is to do locking.
   *
+  * (2) See "Adaptive locking" below.
+  *
+  * (3) See "Shared locking" below.
+  *
   *
   * If the owning thread destroys the CLockable instance, the destructor will
   * unlock completely before going away. If another thread waits for a lock in
@@ -171,6 +191,37 @@ namespace pwx {
   * If you wish to use the full `std::mutex` for doing the locking then you can
   * set this value to `OFF` and compare the outcome.
   *
+  * #### Adaptive locking ####
+  * Both build time variants have their weak spots. Heavily contended objects
+  * burn whole cores with yielding spinlocks, while lightly contended objects
+  * pay the full mutex overhead. With `set_lock_mode(pwx::LM_ADAPTIVE)` an object
+  * can be switched to a third strategy at runtime: Waiting threads spin with an
+  * exponential backoff using the CPU pause instruction first, and are parked
+  * (using a futex on Linux) if the lock could not be acquired in time.
+  * The number of spins allowed before parking adapts itself to how long the
+  * lock was needed to be waited for, and shrinks with the number of threads
+  * that are waiting at the same time.
+  * Like with `do_locking()` it is recommended to switch the mode directly after
+  * instantiating your object.
+  *
+  * #### Shared locking ####
+  * Methods that only read can use `lock_shared()` and `unlock_shared()`
+  * instead, which allows any number of threads to hold a shared lock at the
+  * same time. The names follow the standard, so `std::shared_lock` works, and
+  * pwx::CSharedLockGuard offers the same as pwx::CLockGuard for shared locks.
+  * An exclusive lock waits until all readers are gone, while new readers wait
+  * as long as a thread holds, or is about to hold, the exclusive lock.
+  * Shared locks are counted per thread, so they are recursive as well:
+  *  - A thread holding a shared lock may lock again shared without blocking,
+  *    even if another thread is already waiting for the exclusive lock.
+  *  - A thread holding the exclusive lock may lock shared, too. This just
+  *    counts as a further shared lock that must be unlocked again.
+  *  - A thread holding a shared lock may call `lock()`. This upgrade is
+  *    *not* atomic: The shared lock is stepped back from before the exclusive
+  *    lock is acquired, so another writer might get in first. Once the
+  *    exclusive lock is released, the thread is a reader again.
+  * `is_locked()` and `lock_count()` only consider the exclusive lock.
+  *
   * #### Thread debugging versus spinlocks ####
   * If you enable annotations with the `-DWITH_ANNOTATIONS=ON` configuration
   * option, `std::mutex` is enforced. Using spinlocks here would lead to an
@@ -278,6 +329,10 @@ public:
 	bool is_locking() const noexcept PWX_WARNUNUSED;
 
 
+	/// @return the pwx::eLockMode this object currently uses.
+	eLockMode lock_mode() const noexcept PWX_WARNUNUSED;
+
+
 	/** @brief Lock this object for the current thread if locking is enabled.
 	  *
 	  * This is a blocking method that returns once the lock is acquired.
@@ -290,6 +345,19 @@ public:
 	uint32_t lock_count() const noexcept PWX_WARNUNUSED;
 
 
+	/** @brief Lock this object shared for the current thread if locking is enabled.
+	  *
+	  * This is a blocking method that returns once no other thread holds or
+	  * waits for an exclusive lock. If this thread already holds a shared or
+	  * an exclusive lock, the shared lock count is just raised.
+	**/
+	void lock_shared() noexcept;
+
+
+	/// @return the number of threads currently holding a shared lock on this object
+	uint32_t readers() const noexcept PWX_WARNUNUSED;
+
+
 	/** @brief Try to lock this object.
 	  *
 	  * This is a non-blocking method that returns immediately.
@@ -300,6 +368,32 @@ public:
 	bool try_lock() noexcept PWX_WARNUNUSED;
 
 
+	/** @brief switch the locking strategy to @a mode.
+	  *
+	  * The calling thread acquires the lock in the current mode first,
+	  * so threads already waiting for a lock are not left behind. They
+	  * simply retry with the new mode once they got hold of the old one.
+	  *
+	  * @param[in] mode The pwx::eLockMode to use from now on.
+	**/
+	void set_lock_mode( eLockMode mode ) noexcept;
+
+
+	/// @return the number of shared locks on this object *this* thread has
+	uint32_t shared_lock_count() const noexcept PWX_WARNUNUSED;
+
+
+	/** @brief Try to lock this object shared.
+	  *
+	  * This is a non-blocking method that returns immediately.
+	  * If this thread already holds a shared or an exclusive lock,
+	  * the shared lock count is just raised.
+	  *
+	  * @return true if the object could be locked shared, false otherwise.
+	**/
+	bool try_lock_shared() noexcept PWX_WARNUNUSED;
+
+
 	/** @brief unlock one held lock
 	  *
 	  * If locking is disabled or if the current thread does not hold
@@ -311,6 +405,15 @@ public:
 	void unlock() noexcept;
 
 
+	/** @brief unlock one held shared lock
+	  *
+	  * If locking is disabled or if the current thread does not hold
+	  * a shared lock, nothing happens. Otherwise the last shared lock
+	  * is released.
+	**/
+	void unlock_shared() noexcept;
+
+
 	/** @brief How many threads are waiting for a lock.
 	  * @return The number of threads currently waiting for a lock.
 	**/
@@ -347,6 +450,23 @@ protected:
 
 private:
 
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	void privAcquire() noexcept PWX_LOCAL;
+	void privAcquireShared() noexcept PWX_LOCAL;
+	void privLockAdaptive() noexcept PWX_LOCAL;
+	void privLockDefault() noexcept PWX_LOCAL;
+	void privRelease( eLockMode mode, mord_t order ) noexcept PWX_LOCAL;
+	void privReleaseWriter( mord_t order ) noexcept PWX_LOCAL;
+	bool privTryAcquire() noexcept PWX_WARNUNUSED PWX_LOCAL;
+	bool privTryLockAdaptive() noexcept PWX_WARNUNUSED PWX_LOCAL;
+	bool privTryLockDefault() noexcept PWX_WARNUNUSED PWX_LOCAL;
+	void privWaitForReaders() noexcept PWX_LOCAL;
+
+
 	/* ===============================================
 	 * === Private members                         ===
 	 * ===============================================
@@ -361,9 +481,16 @@ private:
 	lock_t CL_Lock;                                   //!< Use standard mutex to handle locking
 #endif // PWX_USE_FLAGSPIN
 
+	std::atomic<eLockMode> CL_Lock_Mode  = ATOMIC_VAR_INIT( LM_DEFAULT ); //!< Strategy used to wait for the lock.
+	std::atomic_uint32_t   CL_Park_State = ATOMIC_VAR_INIT( 0 );  //!< LM_ADAPTIVE: 0 free, 1 locked, 2 locked with parked waiters.
+	aui32_t                CL_Spin_Limit = ATOMIC_VAR_INIT( 0 );  //!< LM_ADAPTIVE: Current spins before parking, 0 for initial.
+
 	aui32_t CL_Lock_Count = ATOMIC_VAR_INIT( 0 );     //!< How many times the current thread has locked.
 	asize_t CL_Thread_ID  = ATOMIC_VAR_INIT( 0 );     //!< The owning thread of a lock
 	aui32_t CL_Waiting    = ATOMIC_VAR_INIT( 0 );     //!< How many threads are waiting for a lock.
+
+	aui32_t CL_Readers    = ATOMIC_VAR_INIT( 0 );     //!< How many threads are holding a shared lock.
+	abool_t CL_Writer     = ATOMIC_VAR_INIT( false ); //!< Set while a thread holds or awaits the exclusive lock.
 }; // class CLockable
 
 
@@ -506,6 +633,66 @@ bool try_locks( CLockable const* objA, CLockable const* objB, CLockable const* o
 bool try_locks( CLockable const &objA, CLockable const &objB, CLockable const &objC ) noexcept PWX_WARNUNUSED PWX_API;
 
 
+/** @brief try to lock two objects shared at once
+  *
+  * This function tries to lock two objects shared at once, returning
+  * true if both could be locked. If any can not be locked, the other
+  * is unlocked again if necessary and false is returned.
+  *
+  * This function can handle nullptr arguments, assuming nullptr to
+  * be locked; It can't be manipulated anyway.
+  *
+  * @param[in] objA Pointer to the first object to lock shared
+  * @param[in] objB Pointer to the second object to lock shared
+  * @return true if both could be locked shared, false if at least one lock failed
+**/
+bool try_shared_locks( CLockable const* objA, CLockable const* objB ) noexcept PWX_WARNUNUSED PWX_API;
+
+
+/** @brief try to lock two objects shared at once
+  *
+  * This function tries to lock two objects shared at once, returning
+  * true if both could be locked. If any can not be locked, the other
+  * is unlocked again if necessary and false is returned.
+  *
+  * @param[in] objA The first object to lock shared
+  * @param[in] objB The second object to lock shared
+  * @return true if both could be locked shared, false if at least one lock failed
+**/
+bool try_shared_locks( CLockable const &objA, CLockable const &objB ) noexcept PWX_WARNUNUSED PWX_API;
+
+
+/** @brief try to lock three objects shared at once
+  *
+  * This function tries to lock three objects shared at once, returning
+  * true if all three could be locked. If any can not be locked, the
+  * others are unlocked again if necessary and false is returned.
+  *
+  * This function can handle nullptr arguments, assuming nullptr to
+  * be locked; It can't be manipulated anyway.
+  *
+  * @param[in] objA Pointer to the first object to lock shared
+  * @param[in] objB Pointer to the second object to lock shared
+  * @param[in] objC Pointer to the third object to lock shared
+  * @return true if all three could be locked shared, false if at least one lock failed
+**/
+bool try_shared_locks( CLockable const* objA, CLockable const* objB, CLockable const* objC ) noexcept PWX_WARNUNUSED PWX_API;
+
+
+/** @brief try to lock three objects shared at once
+  *
+  * This function tries to lock three objects shared at once, returning
+  * true if all three could be locked. If any can not be locked, the
+  * others are unlocked again if necessary and false is returned.
+  *
+  * @param[in] objA The first object to lock shared
+  * @param[in] objB The second object to lock shared
+  * @param[in] objC The third object to lock shared
+  * @return true if all three could be locked shared, false if at least one lock failed
+**/
+bool try_shared_locks( CLockable const &objA, CLockable const &objB, CLockable const &objC ) noexcept PWX_WARNUNUSED PWX_API;
+
+
 /** @brief unlock two objects if both are currently locked.
   *
   * This function unlocks two objects if both are currently
@@ -78,6 +78,7 @@
 #  define PWX_LIKELY(x)       (x)
 #  define PWX_UNLIKELY(x)     (x)
 #  define PWX_WARNUNUSED      _Check_return_
+#  define PWX_PREFETCH(x)     ((void)(x))
 // Functions
 #  define strcasecmp          _stricmp
 #  define strdup              _strdup
@@ -96,6 +97,7 @@
 #  define PWX_LIKELY( x )   (__builtin_expect(!!(x),1))
 #  define PWX_UNLIKELY( x ) (__builtin_expect(!!(x),0))
 #  define PWX_WARNUNUSED  __attribute__ ((warn_unused_result))
+#  define PWX_PREFETCH( x ) __builtin_prefetch( x )
 #endif // Macros only for gcc/clang
 
 
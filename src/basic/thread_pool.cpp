@@ -0,0 +1,236 @@
+/** @file
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/thread_pool.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/* ===============================================
+ * === Internal pool structures                ===
+ * ===============================================
+*/
+
+namespace {
+
+
+/** @internal One call of thread_pool_run(), it lives on the stack of the caller
+  *
+  * Task numbers are taken from `next`, so every task runs exactly once,
+  * no matter which thread takes it. `users` counts the pool threads that
+  * might still touch the job, the caller waits for it to drop to zero.
+**/
+struct sJob {
+	thread_task_t         task;
+	void*                 ctx;
+	uint32_t              count;
+	std::atomic<uint32_t> next  { 0 };
+	uint32_t              users = 0;       //!< Protected by the pool lock
+	std::exception_ptr    error;           //!< The first exception, protected by the pool lock
+	sJob*                 later = nullptr; //!< The job queued after this one
+};
+
+
+/// @internal The pool all parallel functions share
+struct sPool {
+	std::mutex               lock;
+	std::condition_variable  wake;    //!< Signaled when a job is queued or the pool stops
+	std::condition_variable  idle;    //!< Signaled when a job loses its last user
+	sJob*                    first   = nullptr;
+	sJob*                    last    = nullptr;
+	bool                     stopping = false;
+	std::vector<std::thread> threads;
+};
+
+
+/** @internal The pool is created on first use and never destroyed.
+  * Its threads may still wait for work while static destructors run.
+**/
+sPool& pool() {
+	static sPool* the_pool = new sPool();
+	return *the_pool;
+}
+
+
+/// @internal Remove @a job from the queue if it is still in there, the pool lock must be held
+void unqueue( sPool &pl, sJob* job ) noexcept {
+	sJob* prev = nullptr;
+	for ( sJob* curr = pl.first ; curr ; prev = curr, curr = curr->later ) {
+		if ( curr == job ) {
+			if ( prev )
+				prev->later = curr->later;
+			else
+				pl.first = curr->later;
+			if ( pl.last == curr )
+				pl.last = prev;
+			curr->later = nullptr;
+			return;
+		}
+	}
+}
+
+
+/// @internal Run tasks of @a job until none are left
+void run_tasks( sPool &pl, sJob &job ) noexcept {
+	for ( uint32_t nr = job.next.fetch_add( 1 ) ; nr < job.count ; nr = job.next.fetch_add( 1 ) ) {
+		try {
+			job.task( nr, job.ctx );
+		} catch ( ... ) {
+			std::lock_guard<std::mutex> guard( pl.lock );
+			if ( !job.error )
+				job.error = std::current_exception();
+		}
+	}
+}
+
+
+/// @internal What each pool thread does until the pool stops
+void pool_thread() noexcept {
+	sPool &pl = pool();
+	std::unique_lock<std::mutex> guard( pl.lock );
+
+	while ( !pl.stopping ) {
+		sJob* job = pl.first;
+
+		if ( nullptr == job ) {
+			pl.wake.wait( guard );
+			continue;
+		}
+
+		// A job with no tasks left is done with the queue
+		if ( job->next.load() >= job->count ) {
+			unqueue( pl, job );
+			continue;
+		}
+
+		++job->users;
+		guard.unlock();
+		run_tasks( pl, *job );
+		guard.lock();
+
+		unqueue( pl, job );
+		if ( 0 == --job->users )
+			pl.idle.notify_all();
+	}
+}
+
+
+} // anonymous namespace
+
+
+/* ===============================================
+ * === Public functions                        ===
+ * ===============================================
+*/
+
+
+void thread_pool_run( uint32_t count, thread_task_t task, void* ctx ) {
+	if ( ( 0 == count ) || ( nullptr == task ) )
+		return;
+
+	if ( 1 == count ) {
+		task( 0, ctx );
+		return;
+	}
+
+	sJob job;
+	job.task  = task;
+	job.ctx   = ctx;
+	job.count = count;
+
+	sPool &pl = pool();
+
+	{
+		uint32_t wanted = std::min( count - 1, threadPoolMax );
+		std::lock_guard<std::mutex> guard( pl.lock );
+
+		try {
+			while ( pl.threads.size() < wanted )
+				pl.threads.emplace_back( pool_thread );
+		} catch ( ... ) {
+			// The threads that are there will do, the calling thread runs the rest anyway.
+		}
+
+		if ( pl.last )
+			pl.last->later = &job;
+		else
+			pl.first = &job;
+		pl.last = &job;
+		pl.wake.notify_all();
+	}
+
+	run_tasks( pl, job );
+
+	{
+		std::unique_lock<std::mutex> guard( pl.lock );
+		unqueue( pl, &job );
+		pl.idle.wait( guard, [&job]() { return 0 == job.users; } );
+	}
+
+	if ( job.error )
+		std::rethrow_exception( job.error );
+}
+
+
+void thread_pool_stop() noexcept {
+	sPool &pl = pool();
+	std::vector<std::thread> threads;
+
+	{
+		std::lock_guard<std::mutex> guard( pl.lock );
+		pl.stopping = true;
+		threads.swap( pl.threads );
+		pl.wake.notify_all();
+	}
+
+	for ( auto &thr : threads )
+		thr.join();
+
+	std::lock_guard<std::mutex> guard( pl.lock );
+	pl.stopping = false;
+}
+
+
+} // namespace pwx
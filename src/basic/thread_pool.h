@@ -0,0 +1,105 @@
+#ifndef PWX_PWXLIB_SRC_BASIC_THREAD_POOL_H_INCLUDED
+#define PWX_PWXLIB_SRC_BASIC_THREAD_POOL_H_INCLUDED 1
+#pragma once
+
+
+/** @file thread_pool.h
+  *
+  * @brief Shared pool of worker threads for the parallel functions
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <cstdint>
+#include <type_traits>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/// @brief Function run by the pool, @a nr is the task number, @a ctx what was given to `thread_pool_run()`
+typedef void ( * thread_task_t )( uint32_t nr, void* ctx );
+
+
+/// @brief The pool never holds more threads than this, more tasks just wait for a free one
+const uint32_t threadPoolMax = 64;
+
+
+/** @brief run @a task( nr, @a ctx ) for every nr from 0 to @a count - 1 and wait for all of them
+  *
+  * The tasks are handed to a pool of worker threads that is shared by all
+  * parallel functions of the library. The threads are started when they
+  * are first needed and then wait for the next call, so repeated calls do
+  * not start new threads. The pool grows to @a count - 1 threads, but not
+  * beyond `threadPoolMax`.
+  *
+  * The calling thread runs tasks, too, until none are left. So all tasks
+  * are done even if no thread can be started, and a task may call this
+  * function again. Tasks must therefore not wait for each other.
+  *
+  * If tasks throw, the first exception is thrown further after all tasks
+  * have ended.
+  *
+  * @param[in] count number of tasks to run.
+  * @param[in] task the function to run.
+  * @param[in] ctx any value @a task needs besides the task number.
+**/
+void thread_pool_run( uint32_t count, thread_task_t task, void* ctx ) PWX_API;
+
+
+/** @brief run @a func( nr ) for every nr from 0 to @a count - 1 on the shared pool and wait for all of them
+  * @see thread_pool_run( uint32_t, thread_task_t, void* )
+**/
+template< typename func_t >
+void thread_pool_run( uint32_t count, func_t &&func ) {
+	typedef typename std::remove_reference<func_t>::type fn_t;
+	thread_pool_run( count, []( uint32_t nr, void* ctx ) {
+		( *static_cast<fn_t*>( ctx ) )( nr );
+	}, const_cast<void*>( static_cast<void const*>( &func ) ) );
+}
+
+
+/** @brief end all threads of the pool
+  *
+  * The pool starts new threads when it is used again afterwards.
+  *
+  * **Important**: No thread may be inside `thread_pool_run()` while this
+  * runs. `pwx::finish()` calls it.
+**/
+void thread_pool_stop() noexcept PWX_API;
+
+
+} // namespace pwx
+
+
+#endif // PWX_PWXLIB_SRC_BASIC_THREAD_POOL_H_INCLUDED
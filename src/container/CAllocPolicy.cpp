@@ -0,0 +1,276 @@
+/** @file
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+
+#include <mutex>
+#include <vector>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "container/CAllocPolicy.h"
+
+
+namespace pwx {
+
+
+/* ===============================================
+ * === Internal pool structures                ===
+ * ===============================================
+*/
+
+namespace {
+
+
+const size_t   poolClasses = CAllocPolicyPool::maxNodeSize / CAllocPolicyPool::nodeGrain;
+const uint32_t poolBatch   = 64; //!< Nodes moved between a thread and the depot at once
+
+
+/// @internal A free node only stores the pointer to the next free node
+struct sFreeNode {
+	sFreeNode* next;
+};
+
+
+/// @internal Singly linked list of free nodes of one size class
+struct sFreeList {
+	sFreeNode* head;
+	uint32_t   count;
+};
+
+
+/// @internal The depot all threads share, protected by its mutex
+struct sDepot {
+	std::mutex           lock;
+	sFreeList            lists[poolClasses] = {};
+	std::vector< void* > slabs; //!< Keeps all slabs reachable
+};
+
+
+/// @internal The free lists of the current thread
+struct sCache {
+	sFreeList lists[poolClasses];
+	bool      finished; //!< Set when the thread ends, everything goes to the depot then
+};
+
+
+/// @internal Hands the free lists of the current thread back to the depot when it ends
+struct sCacheFlusher {
+	~sCacheFlusher() noexcept;
+};
+
+
+thread_local sCache cache; // Zero initialized and trivially destructible
+
+
+/** @internal The depot is created on first use and never destroyed.
+  * Elements that are static or thread local objects might be
+  * deleted after all static destructors have been run.
+**/
+sDepot& depot() {
+	static sDepot* the_depot = new sDepot();
+	return *the_depot;
+}
+
+
+/// @internal Make sure the current thread flushes its free lists when it ends
+void register_flusher() noexcept {
+	static thread_local sCacheFlusher flusher;
+	( void )flusher;
+}
+
+
+/// @internal Move the free list @a from onto the front of the list @a to
+void splice_list( sFreeList &from, sFreeList &to ) noexcept {
+	if ( nullptr == from.head )
+		return;
+
+	sFreeNode* tail = from.head;
+	while ( tail->next )
+		tail = tail->next;
+
+	tail->next = to.head;
+	to.head    = from.head;
+	to.count  += from.count;
+	from.head  = nullptr;
+	from.count = 0;
+}
+
+
+/// @internal Carve a new slab into free nodes of class @a cls, depot must be locked
+void add_slab( sDepot &pool, size_t cls ) {
+	size_t nodeSize = ( cls + 1 ) * CAllocPolicyPool::nodeGrain;
+	char*  slab     = static_cast< char* >( ::operator new( nodeSize * poolBatch ) );
+
+	try {
+		pool.slabs.push_back( slab );
+	} catch ( ... ) {
+		::operator delete( slab );
+		throw;
+	}
+
+	sFreeList &list = pool.lists[cls];
+	for ( uint32_t nr = poolBatch ; nr > 0 ; --nr ) {
+		sFreeNode* node = reinterpret_cast< sFreeNode* >( slab + ( nr - 1 ) * nodeSize );
+		node->next = list.head;
+		list.head  = node;
+	}
+	list.count += poolBatch;
+}
+
+
+/// @internal Refill the empty thread list of class @a cls from the depot
+void refill( sFreeList &list, size_t cls ) {
+	register_flusher();
+
+	sDepot &pool = depot();
+	std::lock_guard< std::mutex > guard( pool.lock );
+	sFreeList &source = pool.lists[cls];
+
+	if ( nullptr == source.head )
+		add_slab( pool, cls );
+
+	// Take up to one batch from the front
+	sFreeNode* last  = source.head;
+	uint32_t   taken = 1;
+	while ( last->next && ( taken < poolBatch ) ) {
+		last = last->next;
+		++taken;
+	}
+
+	list.head     = source.head;
+	list.count    = taken;
+	source.head   = last->next;
+	source.count -= taken;
+	last->next    = nullptr;
+}
+
+
+/// @internal Hand everything above one batch of the thread list @a list back to the depot
+void give_back( sFreeList &list, size_t cls ) noexcept {
+	sFreeNode* last = list.head;
+	for ( uint32_t nr = 1 ; nr < poolBatch ; ++nr )
+		last = last->next;
+
+	sFreeList surplus = { last->next, list.count - poolBatch };
+	last->next = nullptr;
+	list.count = poolBatch;
+
+	sDepot &pool = depot();
+	std::lock_guard< std::mutex > guard( pool.lock );
+	splice_list( surplus, pool.lists[cls] );
+}
+
+
+sCacheFlusher::~sCacheFlusher() noexcept {
+	sDepot &pool = depot();
+	std::lock_guard< std::mutex > guard( pool.lock );
+
+	for ( size_t cls = 0 ; cls < poolClasses ; ++cls )
+		splice_list( cache.lists[cls], pool.lists[cls] );
+	cache.finished = true;
+}
+
+
+} // anonymous namespace
+
+
+/* ===============================================
+ * === CAllocPolicyPool                        ===
+ * ===============================================
+*/
+
+void* CAllocPolicyPool::allocate( size_t size ) {
+	if ( ( 0 == size ) || ( size > maxNodeSize ) )
+		return ::operator new( size );
+
+	size_t     cls  = ( size - 1 ) / nodeGrain;
+	sFreeList &list = cache.lists[cls];
+
+	if ( nullptr == list.head ) {
+		if ( cache.finished ) {
+			// The thread is ending, serve directly from the depot
+			sDepot &pool = depot();
+			std::lock_guard< std::mutex > guard( pool.lock );
+			sFreeList &source = pool.lists[cls];
+			if ( nullptr == source.head )
+				add_slab( pool, cls );
+			sFreeNode* node = source.head;
+			source.head = node->next;
+			--source.count;
+			return node;
+		}
+		refill( list, cls );
+	}
+
+	sFreeNode* node = list.head;
+	list.head = node->next;
+	--list.count;
+
+	return node;
+}
+
+
+void CAllocPolicyPool::deallocate( void* ptr, size_t size ) noexcept {
+	if ( nullptr == ptr )
+		return;
+
+	if ( ( 0 == size ) || ( size > maxNodeSize ) ) {
+		::operator delete( ptr );
+		return;
+	}
+
+	size_t     cls  = ( size - 1 ) / nodeGrain;
+	sFreeNode* node = static_cast< sFreeNode* >( ptr );
+
+	if ( cache.finished ) {
+		sDepot &pool = depot();
+		std::lock_guard< std::mutex > guard( pool.lock );
+		sFreeList &target = pool.lists[cls];
+		node->next = target.head;
+		target.head = node;
+		++target.count;
+		return;
+	}
+
+	sFreeList &list = cache.lists[cls];
+	node->next = list.head;
+	list.head  = node;
+
+	if ( 1 == ++list.count )
+		register_flusher();
+	else if ( list.count > 2 * poolBatch )
+		give_back( list, cls );
+}
+
+
+} // namespace pwx
@@ -0,0 +1,153 @@
+#ifndef PWX_LIBPWX_CONTAINER_CALLOCPOLICY_H_INCLUDED
+#define PWX_LIBPWX_CONTAINER_CALLOCPOLICY_H_INCLUDED 1
+#pragma once
+
+/** @file CAllocPolicy.h
+  *
+  * @brief Allocation policies for the elements of the list based containers
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/** @struct CAllocPolicyNew
+  *
+  * @brief Allocation policy using the global `operator new`
+  *
+  * This is the default policy of `TSingleElement` and `TDoubleElement`.
+  * Every element and every shared data control block is a separate
+  * heap allocation, just like it always was.
+**/
+struct PWX_API CAllocPolicyNew {
+	/// @brief Allocate @a size bytes, throws `std::bad_alloc` on failure
+	static void* allocate( size_t size ) {
+		return ::operator new( size );
+	}
+
+	/// @brief Give back @a ptr that was allocated with @a size bytes
+	static void deallocate( void* ptr, size_t ) noexcept {
+		::operator delete( ptr );
+	}
+};
+
+
+/** @struct CAllocPolicyPool
+  *
+  * @brief Allocation policy using per-thread free lists of fixed size nodes
+  *
+  * Requests of up to `maxNodeSize` bytes are rounded up to the next multiple
+  * of `nodeGrain` bytes and served from a free list of that size class.
+  * Each thread has its own free lists, so neither allocating nor freeing
+  * needs a lock as long as the lists are not empty or overfull.
+  * Empty lists are refilled in batches from a global depot, which in turn
+  * carves new nodes out of big slabs. Overfull lists hand a batch back to
+  * the depot, and so does a thread that ends.
+  *
+  * Memory taken for slabs is never given back to the system. It is reused
+  * for new elements of any thread instead, which is what makes repeated
+  * push/pop cycles cheap. Requests larger than `maxNodeSize` go to the
+  * global `operator new`.
+  *
+  * Elements using this policy can be deleted by any thread, also after the
+  * thread that created them has ended.
+**/
+struct PWX_API CAllocPolicyPool {
+	static const size_t nodeGrain   = 16;  //!< Size classes are multiples of this
+	static const size_t maxNodeSize = 256; //!< Larger requests are not pooled
+
+	/// @brief Allocate @a size bytes, throws `std::bad_alloc` on failure
+	static void* allocate( size_t size );
+
+	/// @brief Give back @a ptr that was allocated with @a size bytes
+	static void deallocate( void* ptr, size_t size ) noexcept;
+};
+
+
+/** @struct TPolicyAllocator
+  *
+  * @brief Standard allocator forwarding to an allocation policy
+  *
+  * This makes it possible to let `std::shared_ptr` place its
+  * control block into memory of the policy @a policy_t.
+**/
+template< typename T, typename policy_t >
+struct TPolicyAllocator {
+	typedef T value_type; //!< Type of the allocated objects
+
+	/// @brief Rebind to another value type using the same policy
+	template< typename U >
+	struct rebind {
+		typedef TPolicyAllocator< U, policy_t > other;
+	};
+
+	TPolicyAllocator() noexcept { }
+
+	template< typename U >
+	TPolicyAllocator( TPolicyAllocator< U, policy_t > const& ) noexcept { }
+
+	/// @brief Allocate memory for @a count objects, throws `std::bad_alloc` on failure
+	T* allocate( size_t count ) {
+		if ( count > std::numeric_limits< size_t >::max() / sizeof( T ) )
+			throw std::bad_alloc();
+		return static_cast< T* >( policy_t::allocate( count * sizeof( T ) ) );
+	}
+
+	/// @brief Give back memory for @a count objects
+	void deallocate( T* ptr, size_t count ) noexcept {
+		policy_t::deallocate( ptr, count * sizeof( T ) );
+	}
+};
+
+/// @brief Allocators using the same policy are interchangeable
+template< typename T, typename U, typename policy_t >
+bool operator==( TPolicyAllocator< T, policy_t > const&, TPolicyAllocator< U, policy_t > const& ) noexcept {
+	return true;
+}
+
+/// @brief Allocators using the same policy are interchangeable
+template< typename T, typename U, typename policy_t >
+bool operator!=( TPolicyAllocator< T, policy_t > const&, TPolicyAllocator< U, policy_t > const& ) noexcept {
+	return false;
+}
+
+
+} // namespace pwx
+
+#endif // PWX_LIBPWX_CONTAINER_CALLOCPOLICY_H_INCLUDED
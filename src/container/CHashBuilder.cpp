@@ -30,6 +30,8 @@
 **/
 
 
+#include <cmath>
+
 #include "basic/compiler.h"
 #include "basic/macros.h"
 #include "basic/debug.h"
@@ -45,32 +47,29 @@ namespace pwx {
 extern CRandom RNG; // [R]andom [N]-Value [G]enerator
 
 
-uint32_t CHashBuilder::getKeyLen() const noexcept {
-	return keyLen;
-}
+/* ===============================================
+ * === CHashPolicyRNG                          ===
+ * ===============================================
+*/
 
-void CHashBuilder::setKeyLen( uint32_t keyLen_ ) noexcept {
-	keyLen = keyLen_;
-}
+uint32_t CHashPolicyRNG::hash( const int16_t* key, uint32_t )      noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const uint16_t* key, uint32_t )     noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const int32_t* key, uint32_t )      noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const uint32_t* key, uint32_t )     noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const int64_t* key, uint32_t )      noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const uint64_t* key, uint32_t )     noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const float* key, uint32_t )        noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const double* key, uint32_t )       noexcept { return RNG.hash( *key ); }
+uint32_t CHashPolicyRNG::hash( const long double* key, uint32_t )  noexcept { return RNG.hash( *key ); }
 
-uint32_t CHashBuilder::hash_rng( const int16_t* key )      const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const uint16_t* key )     const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const int32_t* key )      const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const uint32_t* key )     const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const int64_t* key )      const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const uint64_t* key )     const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const float* key )        const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const double* key )       const noexcept { return RNG.hash( *key ); }
-uint32_t CHashBuilder::hash_rng( const long double* key )  const noexcept { return RNG.hash( *key ); }
-
-uint32_t CHashBuilder::hash_rng( char const* key )  const noexcept {
+uint32_t CHashPolicyRNG::hash( char const* key, uint32_t keyLen )  noexcept {
 	if ( keyLen )
 		return RNG.hash( key, keyLen );
 	else
 		return RNG.hash( key, strlen( key ) );
 }
 
-uint32_t CHashBuilder::hash_rng( const std::string* key ) const noexcept {
+uint32_t CHashPolicyRNG::hash( const std::string* key, uint32_t keyLen ) noexcept {
 	if ( keyLen && ( keyLen > key->size() ) ) {
 		std::string subKey = key->substr( 0, keyLen );
 		return RNG.hash( subKey );
@@ -79,4 +78,268 @@ uint32_t CHashBuilder::hash_rng( const std::string* key ) const noexcept {
 	return 0;
 }
 
+
+/* ===============================================
+ * === Helpers of the fast policies            ===
+ * ===============================================
+*/
+
+namespace {
+
+const uint64_t P64_1 = 0x9e3779b185ebca87ULL;
+const uint64_t P64_2 = 0xc2b2ae3d27d4eb4fULL;
+const uint64_t P64_3 = 0x165667b19e3779f9ULL;
+
+/// Secret constants of the string hashes, taken from the fractional parts of pi
+const uint64_t secret[8] = {
+	0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL, 0xa4093822299f31d0ULL, 0x082efa98ec4e6c89ULL,
+	0x452821e638d01377ULL, 0xbe5466cf34e90c6cULL, 0xc0ac29b7c97c50ddULL, 0x3f84d5b5b5470917ULL
+};
+
+/// Unaligned little endian reads
+inline uint64_t read64( const uint8_t* p ) noexcept {
+	uint64_t v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+inline uint64_t read32( const uint8_t* p ) noexcept {
+	uint32_t v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+/// Multiply @a a and @a b to 128 bits and return the low and high half in @a a and @a b
+inline void mul128( uint64_t &a, uint64_t &b ) noexcept {
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = a;
+	r *= b;
+	a = static_cast<uint64_t>( r );
+	b = static_cast<uint64_t>( r >> 64 );
+#else
+	uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>( a ), lb = static_cast<uint32_t>( b );
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t  = rl + ( rm0 << 32 );
+	uint64_t c  = t < rl;
+	uint64_t lo = t + ( rm1 << 32 );
+	c += lo < t;
+	a = lo;
+	b = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + c;
+#endif
+}
+
+/// Multiply @a a and @a b to 128 bits and fold the result into 64 bits
+inline uint64_t mul_fold( uint64_t a, uint64_t b ) noexcept {
+	mul128( a, b );
+	return a ^ b;
+}
+
+inline uint32_t fold32( uint64_t h ) noexcept {
+	return static_cast<uint32_t>( h ^ ( h >> 32 ) );
+}
+
+/// Byte swap, compilers turn this into a single instruction
+inline uint64_t swap64( uint64_t x ) noexcept {
+	x = ( ( x & 0x00ff00ff00ff00ffULL ) << 8 )  | ( ( x >> 8 )  & 0x00ff00ff00ff00ffULL );
+	x = ( ( x & 0x0000ffff0000ffffULL ) << 16 ) | ( ( x >> 16 ) & 0x0000ffff0000ffffULL );
+	return ( x << 32 ) | ( x >> 32 );
+}
+
+inline uint64_t rotl64( uint64_t x, int r ) noexcept {
+	return ( x << r ) | ( x >> ( 64 - r ) );
+}
+
+/// Length of a C-String, limited to @a keyLen if that is set
+inline size_t c_len( char const* key, uint32_t keyLen ) noexcept {
+	return keyLen ? strnlen( key, keyLen ) : strlen( key );
+}
+
+/// Length of a std::string, limited to @a keyLen if that is set
+inline size_t s_len( const std::string* key, uint32_t keyLen ) noexcept {
+	return ( keyLen && ( keyLen < key->size() ) ) ? keyLen : key->size();
+}
+
+} // anonymous namespace
+
+
+/* ===============================================
+ * === CHashPolicyMix                          ===
+ * ===============================================
+*/
+
+uint32_t CHashPolicyMix::hash( const float* key, uint32_t ) noexcept {
+	float    val = ( *key == 0.f ) ? 0.f : *key;
+	uint32_t bits;
+	memcpy( &bits, &val, sizeof( bits ) );
+	return mix64( bits );
+}
+
+uint32_t CHashPolicyMix::hash( const double* key, uint32_t ) noexcept {
+	double   val = ( *key == 0. ) ? 0. : *key;
+	uint64_t bits;
+	memcpy( &bits, &val, sizeof( bits ) );
+	return mix64( bits );
+}
+
+/// The padding bytes of long double are undefined, so mantissa and exponent are hashed
+uint32_t CHashPolicyMix::hash( const long double* key, uint32_t ) noexcept {
+	if ( *key == 0.L )
+		return mix64( 0 );
+
+	int32_t     exp  = 0;
+	long double frac = std::frexp( *key, &exp );
+	uint64_t    mant = static_cast<uint64_t>( std::fabs( frac ) * 18446744073709551616.0L );
+	uint64_t    sign = frac < 0.L ? 1 : 0;
+	return mix64( mant ^ rotl64( static_cast<uint64_t>( static_cast<int64_t>( exp ) ) << 1 | sign, 40 ) );
+}
+
+
+/* ===============================================
+ * === CHashPolicyWy                           ===
+ * ===============================================
+*/
+
+uint32_t CHashPolicyWy::hash( char const* key, uint32_t keyLen ) noexcept {
+	return fold32( hash64( key, c_len( key, keyLen ) ) );
+}
+
+uint32_t CHashPolicyWy::hash( const std::string* key, uint32_t keyLen ) noexcept {
+	return fold32( hash64( key->data(), s_len( key, keyLen ) ) );
+}
+
+uint64_t CHashPolicyWy::hash64( const void* data, size_t len ) noexcept {
+	const uint8_t* p    = static_cast<const uint8_t*>( data );
+	uint64_t       seed = mul_fold( secret[0] ^ secret[1], secret[2] );
+	uint64_t       a    = 0;
+	uint64_t       b    = 0;
+
+	if ( len <= 16 ) {
+		if ( len >= 4 ) {
+			size_t off = ( len >> 3 ) << 2;
+			a = ( read32( p ) << 32 ) | read32( p + off );
+			b = ( read32( p + len - 4 ) << 32 ) | read32( p + len - 4 - off );
+		} else if ( len > 0 ) {
+			a = ( static_cast<uint64_t>( p[0] ) << 16 )
+			  | ( static_cast<uint64_t>( p[len >> 1] ) << 8 )
+			  |   static_cast<uint64_t>( p[len - 1] );
+		}
+	} else {
+		size_t i = len;
+
+		// Three independent lanes for long keys
+		if ( i > 48 ) {
+			uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = mul_fold( read64( p )      ^ secret[1], read64( p + 8 )  ^ seed );
+				see1 = mul_fold( read64( p + 16 ) ^ secret[2], read64( p + 24 ) ^ see1 );
+				see2 = mul_fold( read64( p + 32 ) ^ secret[3], read64( p + 40 ) ^ see2 );
+				p += 48;
+				i -= 48;
+			} while ( i > 48 );
+			seed ^= see1 ^ see2;
+		}
+
+		while ( i > 16 ) {
+			seed = mul_fold( read64( p ) ^ secret[1], read64( p + 8 ) ^ seed );
+			p += 16;
+			i -= 16;
+		}
+
+		// The last 16 bytes, overlapping with the previous block if needed
+		a = read64( p + i - 16 );
+		b = read64( p + i - 8 );
+	}
+
+	a ^= secret[1];
+	b ^= seed;
+	mul128( a, b );
+
+	return mul_fold( a ^ secret[0] ^ len, b ^ secret[1] );
+}
+
+
+/* ===============================================
+ * === CHashPolicyXX                           ===
+ * ===============================================
+*/
+
+namespace {
+
+inline uint64_t xx_avalanche( uint64_t h ) noexcept {
+	h ^= h >> 37;
+	h *= 0x165667919e3779f9ULL;
+	h ^= h >> 32;
+	return h;
+}
+
+inline uint64_t xx64_avalanche( uint64_t h ) noexcept {
+	h ^= h >> 33;
+	h *= P64_2;
+	h ^= h >> 29;
+	h *= P64_3;
+	h ^= h >> 32;
+	return h;
+}
+
+inline uint64_t xx_rrmxmx( uint64_t h, uint64_t len ) noexcept {
+	h ^= rotl64( h, 49 ) ^ rotl64( h, 24 );
+	h *= 0x9fb21c651e98df25ULL;
+	h ^= ( h >> 35 ) + len;
+	h *= 0x9fb21c651e98df25ULL;
+	return h ^ ( h >> 28 );
+}
+
+inline uint64_t xx_mix16( const uint8_t* p, uint64_t s0, uint64_t s1 ) noexcept {
+	return mul_fold( read64( p ) ^ s0, read64( p + 8 ) ^ s1 );
+}
+
+} // anonymous namespace
+
+
+uint32_t CHashPolicyXX::hash( char const* key, uint32_t keyLen ) noexcept {
+	return fold32( hash64( key, c_len( key, keyLen ) ) );
+}
+
+uint32_t CHashPolicyXX::hash( const std::string* key, uint32_t keyLen ) noexcept {
+	return fold32( hash64( key->data(), s_len( key, keyLen ) ) );
+}
+
+uint64_t CHashPolicyXX::hash64( const void* data, size_t len ) noexcept {
+	const uint8_t* p = static_cast<const uint8_t*>( data );
+
+	if ( 0 == len )
+		return xx64_avalanche( secret[0] ^ secret[1] );
+
+	if ( len <= 3 ) {
+		uint32_t combined = ( static_cast<uint32_t>( p[0] ) << 16 )
+		                  | ( static_cast<uint32_t>( p[len >> 1] ) << 24 )
+		                  |   static_cast<uint32_t>( p[len - 1] )
+		                  | ( static_cast<uint32_t>( len ) << 8 );
+		return xx64_avalanche( combined ^ fold32( secret[0] ) );
+	}
+
+	if ( len <= 8 ) {
+		uint64_t input = read32( p + len - 4 ) + ( read32( p ) << 32 );
+		return xx_rrmxmx( input ^ ( secret[1] ^ secret[2] ), len );
+	}
+
+	if ( len <= 16 ) {
+		uint64_t lo  = read64( p )           ^ ( secret[3] ^ secret[4] );
+		uint64_t hi  = read64( p + len - 8 ) ^ ( secret[5] ^ secret[6] );
+		uint64_t acc = len + swap64( lo ) + hi + mul_fold( lo, hi );
+		return xx_avalanche( acc );
+	}
+
+	// Longer keys are consumed in 16 byte stripes, the last one overlapping if needed
+	uint64_t acc    = len * P64_1;
+	size_t   stripe = 0;
+	size_t   pos    = 0;
+
+	for ( ; pos + 16 < len ; pos += 16, stripe += 2 )
+		acc += xx_mix16( p + pos, secret[stripe % 8], secret[( stripe + 1 ) % 8] );
+	acc += xx_mix16( p + len - 16, secret[( stripe + 2 ) % 8], secret[( stripe + 3 ) % 8] );
+
+	return xx_avalanche( acc );
+}
+
 } // namespace pwx
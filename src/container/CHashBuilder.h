@@ -4,7 +4,7 @@
 
 /** @file CHashBuilder.h
   *
-  * @brief Class to get the hash of a value of variable type
+  * @brief Class template to get the hash of a value of variable type
   *
   * (c)  2007 - 2021 PrydeWorX
   * @author Sven Eden, PrydeWorX - Adendorf, Germany
@@ -36,6 +36,7 @@
 
 
 #include <cstring>
+#include <string>
 
 #include "basic/compiler.h"
 #include "basic/macros.h"
@@ -49,33 +50,131 @@
 namespace pwx {
 
 
-/** @class CHashBuilder
+/** @struct CHashPolicyRNG
   *
-  * @brief Simple class to generate hashes out of keys
+  * @brief Hash policy using `RNG.hash()`
   *
-  * The class CHashBuilder can be used to conveniently get the
+  * This is the default policy of the CHashBuilder. It delivers
+  * the same hashes the library always delivered, but hashes
+  * strings one byte at a time.
+**/
+struct PWX_API CHashPolicyRNG {
+	static uint32_t hash( const int16_t*     key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const uint16_t*    key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const int32_t*     key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const uint32_t*    key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const int64_t*     key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const uint64_t*    key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const float*       key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const double*      key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const long double* key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( char const*        key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const std::string* key, uint32_t keyLen ) noexcept;
+};
+
+
+/** @struct CHashPolicyMix
+  *
+  * @brief Base of the fast hash policies, hashing numbers with a 64 bit mixer
+  *
+  * Integers are widened to 64 bit and run through a multiply-xorshift
+  * finalizer. Floating point numbers are hashed by their bit pattern,
+  * with -0.0 mapped to 0.0, so equal keys get equal hashes.
+  * The derived policies add the string hashing.
+**/
+struct PWX_API CHashPolicyMix {
+	static uint32_t hash( const int16_t*     key, uint32_t ) noexcept { return mix64( static_cast<uint64_t>( *key ) ); }
+	static uint32_t hash( const uint16_t*    key, uint32_t ) noexcept { return mix64( *key ); }
+	static uint32_t hash( const int32_t*     key, uint32_t ) noexcept { return mix64( static_cast<uint64_t>( *key ) ); }
+	static uint32_t hash( const uint32_t*    key, uint32_t ) noexcept { return mix64( *key ); }
+	static uint32_t hash( const int64_t*     key, uint32_t ) noexcept { return mix64( static_cast<uint64_t>( *key ) ); }
+	static uint32_t hash( const uint64_t*    key, uint32_t ) noexcept { return mix64( *key ); }
+	static uint32_t hash( const float*       key, uint32_t ) noexcept;
+	static uint32_t hash( const double*      key, uint32_t ) noexcept;
+	static uint32_t hash( const long double* key, uint32_t ) noexcept;
+
+	/// @brief Mix all bits of @a x and fold the result into 32 bits
+	static uint32_t mix64( uint64_t x ) noexcept {
+		x ^= x >> 32;
+		x *= 0xd6e8feb86659fd93ULL;
+		x ^= x >> 32;
+		x *= 0xd6e8feb86659fd93ULL;
+		x ^= x >> 32;
+		return static_cast<uint32_t>( x );
+	}
+};
+
+
+/** @struct CHashPolicyWy
+  *
+  * @brief Fast hash policy using a wyhash style string hash
+  *
+  * Strings are read eight bytes at a time and mixed with 64x64->128 bit
+  * multiplications. The 64 bit result is folded into 32 bits.
+  * The results are *not* compatible with the reference wyhash.
+**/
+struct PWX_API CHashPolicyWy : public CHashPolicyMix {
+	using CHashPolicyMix::hash;
+	static uint32_t hash( char const*        key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const std::string* key, uint32_t keyLen ) noexcept;
+	static uint64_t hash64( const void* data, size_t len ) noexcept;
+};
+
+
+/** @struct CHashPolicyXX
+  *
+  * @brief Fast hash policy using an xxh3 style string hash
+  *
+  * Short strings of up to 16 bytes are handled by dedicated paths,
+  * longer strings are consumed in 16 byte stripes that are each mixed
+  * with a 128 bit multiplication. The 64 bit result is folded into
+  * 32 bits. The results are *not* compatible with the reference XXH3.
+**/
+struct PWX_API CHashPolicyXX : public CHashPolicyMix {
+	using CHashPolicyMix::hash;
+	static uint32_t hash( char const*        key, uint32_t keyLen ) noexcept;
+	static uint32_t hash( const std::string* key, uint32_t keyLen ) noexcept;
+	static uint64_t hash64( const void* data, size_t len ) noexcept;
+};
+
+
+/** @class THashBuilder
+  *
+  * @brief Simple class template to generate hashes out of keys
+  *
+  * The class template THashBuilder can be used to conveniently get the
   * hash value of a value of a variable type.
   * This can be obtained by either providing a hashing function
-  * or, if the type is supported by RNG, using RNG.hash() on
-  * the value to hash.
+  * or by using the hash policy @a policy_t on the value to hash.
+  *
+  * The policies shipped with the library are:
+  *  - CHashPolicyRNG : Uses RNG.hash(). This is the CHashBuilder.
+  *  - CHashPolicyWy  : wyhash style strings, mixed integers.
+  *  - CHashPolicyXX  : xxh3 style strings, mixed integers.
   *
-  * Currently RNG supports 8, 16, 32 and 64 bit signed and unsigned
-  * integers, float, double, C-Strings (char*) and `std::string`.
-  * Further a key length can be set when using either a user defined
-  * hashing function that supports a key length, or when using char*
-  * or `std::string` with `RNG.hash()`.
+  * A policy is a type offering `static uint32_t hash( const key_t* key,
+  * uint32_t keyLen )` overloads for every key type it supports.
+  *
+  * The shipped policies support 16, 32 and 64 bit signed and unsigned
+  * integers, float, double, long double, C-Strings (char*) and
+  * `std::string`. Further a key length can be set when using either a
+  * user defined hashing function that supports a key length, or when
+  * using char* or `std::string` keys.
   *
   * *Note*: You might want to take a look at `std::hash` before
-  * using the `CHashBuilder`.
+  * using the `THashBuilder`.
   *
 **/
-class PWX_API CHashBuilder {
+template<typename policy_t>
+class PWX_API THashBuilder {
 public:
 	/* ===============================================
 	 * === Public types                            ===
 	 * ===============================================
 	*/
 
+	typedef policy_t policy_type; //!< The policy used if no user hash function is given
+
 
 	/* ===============================================
 	 * === Public Constructors and destructors     ===
@@ -86,14 +185,14 @@ public:
 	/** @brief key length constructor
 	  *
 	  * If your key is a C-String or std::string, you can set
-	  * an optional key length. The hashing done by RNG, or
+	  * an optional key length. The hashing done by the policy, or
 	  * a provided hash method, will then be limited to this
 	  * maximum key length; or whatever a provided hash method
 	  * does with the key length.
 	  *
 	  * @param[in] keyLen_ optional key length
 	**/
-	CHashBuilder( uint32_t keyLen_ ) noexcept
+	THashBuilder( uint32_t keyLen_ ) noexcept
 		: keyLen( keyLen_ )
 	{ }
 
@@ -103,21 +202,21 @@ public:
 	  * The empty constructor uses the default constructor to
 	  * set the key length to zero.
 	**/
-	CHashBuilder() noexcept
-		: CHashBuilder( 0 )
+	THashBuilder() noexcept
+		: THashBuilder( 0 )
 	{ }
 
 
 	/** @brief copy constructor copying the key length
 	  * @param[in] src source reference
 	**/
-	CHashBuilder( const CHashBuilder& src )
+	THashBuilder( const THashBuilder& src )
 		: keyLen( src.keyLen )
 	{ }
 
 
 	/// @brief default dtor
-	virtual ~CHashBuilder() noexcept
+	virtual ~THashBuilder() noexcept
 	{ }
 
 
@@ -130,14 +229,18 @@ public:
 	  *
 	  * @return the currently set key length
 	  */
-	uint32_t getKeyLen() const noexcept;
+	uint32_t getKeyLen() const noexcept {
+		return keyLen;
+	}
 
 
 	/** @brief set a new key length
 	  *
 	  * @param[in] keyLen_ the key length to use in the future
 	  */
-	void setKeyLen( uint32_t keyLen_ ) noexcept;
+	void setKeyLen( uint32_t keyLen_ ) noexcept {
+		keyLen = keyLen_;
+	}
 
 
 	/* ===============================================
@@ -148,13 +251,13 @@ public:
 	/** @brief operator() to build a hash from a key
 	  *
 	  * This operator serves as a dispatcher. The default is
-	  * to use RNG.hash() on the provided key, but a user defined
-	  * hashing method can be used instead.
+	  * to use the hash policy on the provided key, but a user
+	  * defined hashing method can be used instead.
 	  *
-	  * Please note that RNG.hash can only handle [u]int16_t,
-	  * [u]int32_t, [u]int64_t, float, double, char* and std::string
-	  * keys. You must provide your own hashing method on any other
-	  * types or the application will be forced to terminate.
+	  * Please note that the shipped policies can only handle [u]int16_t,
+	  * [u]int32_t, [u]int64_t, float, double, long double, char* and
+	  * std::string keys. You must provide your own hashing method on any
+	  * other types or the application will be forced to terminate.
 	  *
 	  * The operator has two optional parameters. The first is a pointer
 	  * to a general hash method, the second to a hash method taking
@@ -186,7 +289,7 @@ protected:
 	 * ===============================================
 	*/
 
-	/** @brief internal hash method for type RNG can handle
+	/** @brief internal hash method for types the policy can handle
 	  *
 	  * If a type not supported is used, an exception is thrown
 	  * triggering `std::terminate()`. This is done because the
@@ -203,46 +306,20 @@ protected:
 		               || isFloatType( key_t )
 		               || isSameType( key_t, char )
 		               || isSameType( key_t, std::string )
-		            ) && "ERROR: unsupported type used in CHashBuilder::hash_pwx(key* key)" );
+		            ) && "ERROR: unsupported type used in THashBuilder::hash_pwx(key* key)" );
 		if ( isIntType( key_t )
 		                || isFloatType( key_t )
 		                || isSameType( key_t, char )
 		                || isSameType( key_t, std::string ) )
-			return this->hash_rng( key );
+			return policy_t::hash( key, keyLen );
 		else
 			PWX_THROW( "abort", "Illegal type in hash_pwx()",
-			           "hash_pwx() was called with a type unsupported by RNG!" );
+			           "hash_pwx() was called with a type unsupported by the hash policy!" );
 	}
 
 
-	/* ===============================================
-	 * === Protected members                       ===
-	 * ===============================================
-	*/
-
-
 private:
 
-	/* ===============================================
-	 * === Private methods                         ===
-	 * ===============================================
-	*/
-
-	uint32_t hash_rng( const int16_t*     key ) const noexcept;
-	uint32_t hash_rng( const uint16_t*    key ) const noexcept;
-	uint32_t hash_rng( const int32_t*     key ) const noexcept;
-	uint32_t hash_rng( const uint32_t*    key ) const noexcept;
-	uint32_t hash_rng( const int64_t*     key ) const noexcept;
-	uint32_t hash_rng( const uint64_t*    key ) const noexcept;
-	uint32_t hash_rng( const float*       key ) const noexcept;
-	uint32_t hash_rng( const double*      key ) const noexcept;
-	uint32_t hash_rng( const long double* key ) const noexcept;
-	uint32_t hash_rng( char const*        key ) const noexcept;
-	uint32_t hash_rng( const std::string* key ) const noexcept;
-	template<typename key_t>
-	uint32_t hash_rng( key_t* key );
-
-
 	/* ===============================================
 	 * === Private members                         ===
 	 * ===============================================
@@ -251,10 +328,15 @@ private:
 	uint32_t keyLen = 0; //!< optional key length for C-String and std::string keys (0 = use strlen() on C-Strings)
 
 
-}; // class CHashBuilder
+}; // class THashBuilder
+
+
+/** @typedef CHashBuilder
+  * @brief The hash builder using RNG.hash(), which all hash containers use.
+**/
+typedef THashBuilder<CHashPolicyRNG> CHashBuilder;
 
 
 } // namespace pwx
 
 #endif // PWX_LIBPWX_PWX_TYPES_THASHBUILDER_H_INCLUDED
-
@@ -41,48 +41,82 @@
 namespace pwx {
 
 
-/** @brief do nothing with the given element
-  * This is just a little "nothing-to-see-here"-function
-  * that is used by the `CThreadElementStore` below as
-  * a deleter for `std::shared_ptr`.
-**/
-static void do_not_destroy( CThreadElementStore::curr_t* ) { /* Don't you dare! */ }
-
-
 /* ===============================================
- * === Public Constructors and destructors     ===
+ * === Thread local cache                      ===
  * ===============================================
 */
 
-CThreadElementStore::CThreadElementStore( uint32_t initial_size ) :
-	  currs( initial_size, do_not_destroy, nullptr, 0.6667, 2.063829787234043 ) {}
+namespace {
 
-/// @brief delegating ctor setting default size of 47
-CThreadElementStore::CThreadElementStore() noexcept: store_t( 47 ) {}
 
+const uint32_t cacheSize = 8; //!< Number of stores a thread can remember elements for
 
-/// @brief default dtor
-CThreadElementStore::~CThreadElementStore() noexcept {
-	invalidating.store( true );
-	PWX_DOUBLE_LOCK_GUARD( this, &currs );
 
-	isDestroyed.store( true );
+/// @internal One cached current element
+struct sCurrSlot {
+	uint64_t                     id;   //!< Id of the store, 0 is unused
+	uint64_t                     gen;  //!< Generation of the store when elem was set
+	CThreadElementStore::curr_t* elem; //!< The current element of the calling thread
+};
 
-	// Reset locks so that other threads may notice that this is gone
-	while ( waiting() ) {
-		PWX_DOUBLE_LOCK_GUARD_RESET( this, &currs );
-	}
 
-	// Now the coast is clear
-	currs.clear();
+/// @internal Source of the unique store ids
+std::atomic<uint64_t> nextId{ 1 };
+
 
+// Zero initialized, slot 0 always holds the most recently set store.
+thread_local sCurrSlot slots[cacheSize];
 
-	invalidating.store( false );
 
-	// Reset locks again before finishing the destructor eventually
-	while ( waiting() ) {
-		PWX_DOUBLE_LOCK_GUARD_RESET( this, &currs );
+/// @internal Return the slot of store @a id, or nullptr if there is none
+sCurrSlot* find_slot( uint64_t id ) noexcept {
+	for ( uint32_t i = 0 ; i < cacheSize ; ++i ) {
+		if ( id == slots[i].id )
+			return &slots[i];
 	}
+	return nullptr;
+}
+
+
+/// @internal Move the slot of store @a id to the front, taking over the last one if it has none
+sCurrSlot* take_slot( uint64_t id ) noexcept {
+	uint32_t pos = 0;
+	while ( ( pos < ( cacheSize - 1 ) ) && ( id != slots[pos].id ) )
+		++pos;
+
+	sCurrSlot slot = slots[pos];
+	for ( ; pos ; --pos )
+		slots[pos] = slots[pos - 1];
+	slots[0]    = slot;
+	slots[0].id = id;
+
+	return &slots[0];
+}
+
+
+} // anonymous namespace
+
+
+/* ===============================================
+ * === Public Constructors and destructors     ===
+ * ===============================================
+*/
+
+CThreadElementStore::CThreadElementStore( uint32_t ) :
+	  id( nextId.fetch_add( 1, std::memory_order_relaxed ) ) {}
+
+/// @brief delegating ctor
+CThreadElementStore::CThreadElementStore() noexcept: store_t( 0 ) {}
+
+
+/// @brief default dtor
+CThreadElementStore::~CThreadElementStore() noexcept {
+	isDestroyed.store( true );
+
+	// The id is never handed out again, so cached elements of
+	// this store can never be mistaken for those of another.
+	generation.fetch_add( 1, std::memory_order_acq_rel );
+	oneCurr = nullptr;
 }
 
 
@@ -93,61 +127,50 @@ CThreadElementStore::~CThreadElementStore() noexcept {
 
 
 void CThreadElementStore::clear() noexcept {
-	if ( beThreadSafe() ) {
-		if ( !currs.empty() && !invalidating.load( memOrdLoad ) ) {
-			invalidating.store( true, memOrdStore );
-			PWX_LOCK_GUARD( this );
-			// Is a clearing still needed?
-			if ( !currs.empty() ) {
-				currs.clear();
-			}
-			invalidating.store( false, memOrdStore );
-		}
-	} else {
+	if ( beThreadSafe() )
+		generation.fetch_add( 1, std::memory_order_acq_rel );
+	else
 		oneCurr = nullptr;
-	}
 }
 
 
 CThreadElementStore::curr_t* CThreadElementStore::curr() const noexcept {
 	if ( beThreadSafe() ) {
-		bool needLock = invalidating.load( memOrdLoad );
-		if ( needLock ) const_cast<CThreadElementStore*>( this )->lock();
-		elem_t* elem = currs.get( CURRENT_THREAD_ID );
-		if ( needLock ) const_cast<CThreadElementStore*>( this )->unlock();
-		return elem ? elem->data.get() : nullptr;
-	} else {
-		return oneCurr;
+		sCurrSlot* slot = find_slot( id );
+		if ( slot && ( slot->gen == generation.load( std::memory_order_acquire ) ) )
+			return slot->elem;
+		return nullptr;
 	}
+	return oneCurr;
 }
 
 
-/// Note: Copied, not called, as these two lines are
+/// Note: Copied, not called, as these few lines are
 ///       too less of a burden to add a const_cast
 ///       calling layer
 CThreadElementStore::curr_t* CThreadElementStore::curr() noexcept {
 	if ( beThreadSafe() ) {
-		bool needLock = invalidating.load( memOrdLoad );
-		if ( needLock ) lock();
-		elem_t* elem = currs.get( CURRENT_THREAD_ID );
-		if ( needLock ) unlock();
-		return elem ? elem->data.get() : nullptr;
-	} else {
-		return oneCurr;
+		sCurrSlot* slot = find_slot( id );
+		if ( slot && ( slot->gen == generation.load( std::memory_order_acquire ) ) )
+			return slot->elem;
+		return nullptr;
 	}
+	return oneCurr;
 }
 
 
 void CThreadElementStore::curr( const CThreadElementStore::curr_t* new_curr ) const noexcept {
 	if ( beThreadSafe() ) {
-		PWX_DOUBLE_LOCK_GUARD( const_cast<CThreadElementStore*>( this ), &currs );
-
-		if ( !isDestroyed.load() && !currs.destroyed() ) {
-			currs.delKey( CURRENT_THREAD_ID );
-			if ( new_curr ) {
-				PWX_TRY( currs.add( CURRENT_THREAD_ID, const_cast<curr_t*>( new_curr ) ) )
-				PWX_CATCH_AND_FORGET( CException )
-			}
+		if ( !isDestroyed.load( memOrdLoad ) ) {
+			/* The generation is loaded before anything else is done. An
+			 * invalidation of new_curr that happens later makes the slot
+			 * stale. One that happened before has already marked new_curr
+			 * as removed, which the caller is able to see now.
+			 */
+			uint64_t   gen  = generation.load( std::memory_order_acquire );
+			sCurrSlot* slot = take_slot( id );
+			slot->gen       = gen;
+			slot->elem      = const_cast<curr_t*>( new_curr );
 		}
 	} else {
 		oneCurr = const_cast<curr_t*>( new_curr );
@@ -156,19 +179,7 @@ void CThreadElementStore::curr( const CThreadElementStore::curr_t* new_curr ) co
 
 
 void CThreadElementStore::curr( CThreadElementStore::curr_t* new_curr ) noexcept {
-	if ( beThreadSafe() ) {
-		PWX_DOUBLE_LOCK_GUARD( this, &currs );
-
-		if ( !isDestroyed.load() && !currs.destroyed() ) {
-			currs.delKey( CURRENT_THREAD_ID );
-			if ( new_curr ) {
-				PWX_TRY( currs.add( CURRENT_THREAD_ID, new_curr ) )
-				PWX_CATCH_AND_FORGET( CException )
-			}
-		}
-	} else {
-		oneCurr = new_curr;
-	}
+	static_cast<store_t const*>( this )->curr( static_cast<curr_t const*>( new_curr ) );
 }
 
 
@@ -182,35 +193,17 @@ void CThreadElementStore::disable_thread_safety() noexcept {
 
 void CThreadElementStore::enable_thread_safety() noexcept {
 	if ( !beThreadSafe() ) {
-		currs.clear();
+		generation.fetch_add( 1, std::memory_order_acq_rel );
 		beThreadSafe( true );
 	}
 }
 
 
 void CThreadElementStore::invalidate( const CThreadElementStore::curr_t* old_curr ) const noexcept {
-	if ( beThreadSafe() ) {
-		// Only do anything if there are any elements stored:
-		if ( !currs.empty() && !invalidating.load( memOrdLoad ) ) {
-			invalidating.store( true, memOrdStore );
-			PWX_LOCK_GUARD( this );
-
-			// Do a double check, maybe the invalidating is no longer needed
-			if ( !currs.empty() ) {
-				uint32_t currSize = currs.sizeMax();
-				elem_t* elem;
-				for ( uint32_t i = 0 ; i < currSize ; ++i ) {
-					elem = currs[i];
-					if ( elem && ( elem->data.get() == old_curr ) ) {
-						currs.delKey( elem->key );
-					}
-				}
-			} // End of having to invalidate
-			invalidating.store( false, memOrdStore );
-		} // End of entry check
-	} else if ( oneCurr && ( oneCurr == old_curr ) ) {
+	if ( beThreadSafe() )
+		generation.fetch_add( 1, std::memory_order_acq_rel );
+	else if ( oneCurr && ( oneCurr == old_curr ) )
 		oneCurr = nullptr;
-	}
 }
 
 
@@ -34,9 +34,13 @@
 **/
 
 
+#include <atomic>
+#include <cstdint>
+
 #include "basic/compiler.h"
 
-#include "container/TOpenHash.h"
+#include "basic/CLockable.h"
+#include "container/VElement.h"
 
 
 /// @namespace pwx
@@ -44,7 +48,7 @@ namespace pwx {
 
 
 /** @class CThreadElementStore
-  * @brief Hash based store for thread individual element handling
+  * @brief Store for thread individual element handling
   *
   * This class is used by all list based containers to store
   * the currently handled element for each thread.
@@ -65,8 +69,21 @@ namespace pwx {
   * stored element for the calling thread and `curr(elem)` which will
   * store a new element for the calling thread.
   *
+  * Each thread keeps its elements in a small thread local cache, keyed
+  * by the unique id every store gets on construction. Together with the
+  * element the cache remembers the generation of the store at the time
+  * the element was stored. `invalidate()` and `clear()` simply raise the
+  * generation, which turns all stored elements of all threads stale at
+  * once. Getting and setting the current element therefore only costs a
+  * few loads and stores, and nothing is locked.
+  *
+  * As the current element is only a starting point for searches, losing
+  * it to the invalidation of another element does no harm. And if more
+  * stores are used by one thread than its cache can hold, the least
+  * recently set entries are simply dropped.
+  *
   * If `beThreadSafe(false)` is called, the storage will no longer
-  * use the internal hash table but simply change/retrieve on general
+  * use the thread local cache but simply change/retrieve on general
   * `curr` pointer. This can be reversed using `beThreadSafe(true)`.
 **/
 class CThreadElementStore final : public CLockable {
@@ -77,11 +94,9 @@ public:
 	 * ===============================================
 	*/
 
-	typedef CLockable                      base_t;  //!< Base type of `CThreadElementStore`
-	typedef CThreadElementStore            store_t; //!< Storage type, thus `CThreadElementStore` itself
-	typedef VElement                       curr_t;  //!< Type of the `curr` element to handle
-	typedef TOpenHash< size_t, curr_t >    hash_t;  //!< Hash container type with `size_t` and `curr_t`
-	typedef THashElement< size_t, curr_t > elem_t;  //!< Hash element type with `size_t` and `curr_t`
+	typedef CLockable           base_t;  //!< Base type of `CThreadElementStore`
+	typedef CThreadElementStore store_t; //!< Storage type, thus `CThreadElementStore` itself
+	typedef VElement            curr_t;  //!< Type of the `curr` element to handle
 
 
 	/* ===============================================
@@ -91,13 +106,10 @@ public:
 
 	/** @brief default ctor
 	  *
-	  * Set the initial size of the used hash table here.
-	  * The default initial size is 47, which is a prime number almost exactly between 2^5 and 2^6.
+	  * The thread local caches have a fixed size, so @a initial_size
+	  * is not needed any more. It is kept for compatibility only.
 	  *
-	  * If you intent to use a different size, please try to find a prime number that is as exactly between
-	  * 2^x and 2^(x+1) as possible.
-	  *
-	  * @param[in] initial_size the size to use for the hash table
+	  * @param[in] initial_size ignored
 	**/
 	explicit
 	CThreadElementStore( uint32_t initial_size ) PWX_API;
@@ -119,7 +131,7 @@ public:
 	 * ===============================================
 	*/
 
-	/// @brief remove all elements
+	/// @brief forget the current elements of all threads
 	void clear() noexcept PWX_API;
 
 	/// @brief return the calling threads current element
@@ -128,22 +140,22 @@ public:
 	/// @brief return the calling threads current element
 	curr_t* curr() noexcept PWX_API;
 
-	/// @brief delete old element and add a new one unless const @a new_curr is nullptr
+	/// @brief set the calling threads current element to const @a new_curr, which may be nullptr
 	void curr( const curr_t* new_curr ) const noexcept PWX_API;
 
-	/// @brief delete old element and add a new one unless @a new_curr is nullptr
+	/// @brief set the calling threads current element to @a new_curr, which may be nullptr
 	void curr( curr_t* new_curr ) noexcept PWX_API;
 
-	/// @brief stop using the hash table, maintain one pointer directly
+	/// @brief stop using the thread local caches, maintain one pointer directly
 	void disable_thread_safety() noexcept PWX_API;
 
-	/// @brief stop maintaining one pointer, use the hash table
+	/// @brief stop maintaining one pointer, use the thread local caches
 	void enable_thread_safety() noexcept PWX_API;
 
-	/// @brief delete all entries that point to const @a old_curr
+	/// @brief make sure that no thread gets const @a old_curr as its current element any more
 	void invalidate( const curr_t* old_curr ) const noexcept PWX_API;
 
-	/// @brief delete all entries that point to @a old_curr
+	/// @brief make sure that no thread gets @a old_curr as its current element any more
 	[[maybe_unused]] void invalidate( curr_t* old_curr ) const noexcept PWX_API;
 
 
@@ -160,9 +172,9 @@ private:
 	 * ===============================================
 	*/
 
-	mutable hash_t  currs;                   //!< Used when thread safety is enabled (default)
-	mutable abool_t invalidating{ false }; //!< If set to true by `invalidate()`, `curr()` will wait for a lock
-	mutable curr_t* oneCurr{ nullptr };      //!< Used when thread safety is disabled
+	mutable std::atomic<uint64_t> generation{ 1 };  //!< Raised by every invalidation
+	const uint64_t                id;               //!< Unique key of this store in the thread local caches
+	mutable curr_t*               oneCurr{ nullptr }; //!< Used when thread safety is disabled
 };
 
 
@@ -170,4 +182,3 @@ private:
 
 
 #endif // PWX_LIBPWX_PWX_INTERNAL_CTHREADELEMENTSTORE_H_INCLUDED
-
@@ -0,0 +1,371 @@
+#ifndef PWX_LIBPWX_PWX_CONTAINER_TBOUNDEDQUEUE_H_INCLUDED
+#define PWX_LIBPWX_PWX_CONTAINER_TBOUNDEDQUEUE_H_INCLUDED
+#pragma once
+
+/** @file TBoundedQueue.h
+  *
+  * @brief Declaration of a lock-free bounded multi producer/multi consumer queue
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CException.h"
+#include "basic/types.h"
+
+
+namespace pwx {
+
+
+/** @class TBoundedQueue PBoundedQueue <PBoundedQueue>
+  *
+  * @brief Lock-free bounded FiFo queue for any number of producers and consumers
+  *
+  * This queue is meant for handing work from producer threads to consumer
+  * threads, where `pwx::TQueue` serializes all threads on its list lock.
+  * It is a ring of a fixed number of cells, following the design of
+  * Dmitry Vyukov: Every cell carries a sequence number that tells
+  * producers and consumers whether it is free or filled for their current
+  * lap. A push or pop claims its position with a single CAS on the
+  * respective counter and only touches the one cell afterwards. There are
+  * no elements, no locks and no memory allocations after construction.
+  *
+  * The capacity is rounded up to the next power of two and never changes.
+  * `push()` waits for a free cell if the queue is full, `try_push()`
+  * returns `false` instead.
+  *
+  * Like in `pwx::TQueue`, the data pointers are taken over on push. Data
+  * that is popped belongs to the caller again. Data still stored when the
+  * queue is cleared or destroyed is destroyed with the destroy method
+  * given to the constructor, or deleted if there is none.
+  *
+  * **Important**: As `nullptr` means "empty" to `try_pop()`, `nullptr`
+  * can not be stored as data.
+**/
+template< typename data_t >
+class PWX_API TBoundedQueue {
+public:
+
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TBoundedQueue< data_t > queue_t; //!< Type of this queue
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+
+	/** @brief full constructor
+	  *
+	  * The capacity is @a capacity_ raised to the next power of two,
+	  * but at least 2.
+	  *
+	  * If the cells can not be allocated, a `pwx::CException` with the
+	  * name "QueueCreationFailed" is thrown.
+	  *
+	  * @param[in] capacity_ The number of data pointers the queue can hold.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	**/
+	TBoundedQueue( uint32_t capacity_, void ( * destroy_ )( data_t* data ) )
+		  : destroy( destroy_ ) {
+		while ( ( capacity < capacity_ ) && ( capacity < 0x80000000 ) )
+			capacity <<= 1;
+		mask = capacity - 1;
+
+		PWX_TRY( cells = new sCell[capacity] )
+		PWX_THROW_STD_FURTHER( "QueueCreationFailed", "The cells of the queue could not be allocated" )
+
+		for ( uint32_t i = 0 ; i < capacity ; ++i )
+			cells[i].seq.store( i, std::memory_order_relaxed );
+	}
+
+
+	/** @brief capacity constructor
+	  *
+	  * @param[in] capacity_ The number of data pointers the queue can hold.
+	**/
+	explicit TBoundedQueue( uint32_t capacity_ )
+		  : TBoundedQueue( capacity_, nullptr )
+	{ }
+
+
+	/** @brief empty constructor
+	  *
+	  * The empty constructor sets the data destroy method to the
+	  * null pointer and the capacity to 1024.
+	**/
+	TBoundedQueue()
+		  : TBoundedQueue( 1024, nullptr )
+	{ }
+
+
+	TBoundedQueue( queue_t const& ) PWX_DELETE;
+	TBoundedQueue( queue_t const&& ) PWX_DELETE;
+	queue_t& operator=( queue_t const& ) PWX_DELETE;
+	queue_t& operator=( queue_t const&& ) PWX_DELETE;
+
+
+	/** @brief default destructor
+	  *
+	  * The destructor must not be called while other threads still
+	  * use the queue. It destroys all remaining data.
+	**/
+	virtual ~TBoundedQueue() noexcept {
+		clear();
+		delete [] cells;
+	}
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+
+	/// @brief return the number of data pointers the queue can hold
+	uint32_t capacity_max() const noexcept {
+		return capacity;
+	}
+
+
+	/** @brief pop and destroy all data
+	  *
+	  * This is safe to call while other threads use the queue, but
+	  * data pushed concurrently might or might not be destroyed.
+	**/
+	void clear() noexcept {
+		data_t* data = try_pop();
+		while ( data ) {
+			privDestroyData( data );
+			data = try_pop();
+		}
+	}
+
+
+	/// @return true if the queue holds no data
+	bool empty() const noexcept {
+		return 0 == size();
+	}
+
+
+	/** @brief pop the first data pointer from the queue
+	  *
+	  * The data is removed from the queue so you have to take
+	  * care of its deletion once you are finished with it.
+	  *
+	  * If there is no data in the queue a pwx::CException with the
+	  * name "OutOfRange" is thrown.
+	  *
+	  * @return the first data pointer in the queue.
+	**/
+	data_t* pop() {
+		data_t* data = try_pop();
+		if ( nullptr == data )
+			PWX_THROW( "OutOfRange", "Queue is empty", "pop() called on an empty TBoundedQueue" )
+		return data;
+	}
+
+
+	/** @brief push a data pointer to the end of the queue
+	  *
+	  * If the queue is full, this method yields until a consumer
+	  * made room.
+	  *
+	  * If @a data is `nullptr`, a `pwx::CException` with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * @param[in] data data pointer to store.
+	  * @return number of data pointers stored after the operation.
+	**/
+	uint32_t push( data_t* data ) {
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "nullptr data",
+			           "TBoundedQueue can not store nullptr as data" )
+
+		while ( !privEnqueue( data ) )
+			std::this_thread::yield();
+
+		return size();
+	}
+
+
+	/** @brief return the number of stored data pointers
+	  *
+	  * While other threads push and pop, this is only a snapshot.
+	**/
+	uint32_t size() const noexcept {
+		uint64_t tail = tailPos.load( std::memory_order_acquire );
+		uint64_t head = headPos.load( std::memory_order_acquire );
+		return tail > head ? static_cast<uint32_t>( tail - head ) : 0;
+	}
+
+
+	/** @brief pop the first data pointer, if any
+	  *
+	  * The data is removed from the queue so you have to take
+	  * care of its deletion once you are finished with it.
+	  *
+	  * @return the first data pointer in the queue or `nullptr` if it is empty.
+	**/
+	data_t* try_pop() noexcept {
+		uint64_t pos  = headPos.load( std::memory_order_relaxed );
+		sCell*   cell = nullptr;
+
+		while ( true ) {
+			cell = &cells[pos & mask];
+			uint64_t seq  = cell->seq.load( std::memory_order_acquire );
+			int64_t  diff = static_cast<int64_t>( seq - ( pos + 1 ) );
+
+			if ( 0 == diff ) {
+				// The cell is filled for this lap, claim it
+				if ( headPos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+					break;
+			} else if ( diff < 0 )
+				return nullptr; // Nothing pushed to this cell, yet.
+			else
+				pos = headPos.load( std::memory_order_relaxed );
+		}
+
+		data_t* data = cell->data;
+		cell->seq.store( pos + mask + 1, std::memory_order_release );
+		return data;
+	}
+
+
+	/** @brief push a data pointer to the end of the queue, if there is room
+	  *
+	  * If @a data is `nullptr`, a `pwx::CException` with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * @param[in] data data pointer to store.
+	  * @return true if the data was stored, false if the queue is full.
+	**/
+	bool try_push( data_t* data ) {
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "nullptr data",
+			           "TBoundedQueue can not store nullptr as data" )
+
+		return privEnqueue( data );
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/** @internal One cell of the ring
+	  *
+	  * A sequence number equal to the position means the cell is free
+	  * for the producer of that position, one more means it is filled
+	  * for the consumer of that position.
+	**/
+	struct sCell {
+		std::atomic<uint64_t> seq { 0 };
+		data_t*               data = nullptr;
+	};
+
+	/// @internal Cache line padded position counter
+	struct alignas( 64 ) sPos : public std::atomic<uint64_t> {
+		sPos() noexcept : std::atomic<uint64_t>( 0 ) { }
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	/// @internal Destroy @a data with the destroy method or delete
+	void privDestroyData( data_t* data ) noexcept PWX_LOCAL {
+		if ( destroy )
+			destroy( data );
+		else
+			delete data;
+	}
+
+
+	/// @internal Store @a data in the next free cell, return false if there is none
+	bool privEnqueue( data_t* data ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint64_t pos  = tailPos.load( std::memory_order_relaxed );
+		sCell*   cell = nullptr;
+
+		while ( true ) {
+			cell = &cells[pos & mask];
+			uint64_t seq  = cell->seq.load( std::memory_order_acquire );
+			int64_t  diff = static_cast<int64_t>( seq - pos );
+
+			if ( 0 == diff ) {
+				// The cell is free for this lap, claim it
+				if ( tailPos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+					break;
+			} else if ( diff < 0 )
+				return false; // The consumer of the last lap is not done, yet.
+			else
+				pos = tailPos.load( std::memory_order_relaxed );
+		}
+
+		cell->data = data;
+		cell->seq.store( pos + 1, std::memory_order_release );
+		return true;
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	void ( * destroy )( data_t* data ) = nullptr;
+
+	uint32_t capacity = 2;       //!< Number of cells, always a power of two
+	sCell*   cells    = nullptr; //!< The ring of cells
+	sPos     headPos;            //!< Position of the next pop
+	uint32_t mask     = 1;       //!< capacity - 1
+	sPos     tailPos;            //!< Position of the next push
+}; // class TBoundedQueue
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_CONTAINER_TBOUNDEDQUEUE_H_INCLUDED
@@ -61,17 +61,20 @@ namespace pwx {
   * The hash algorithms used within the PrydeWorX library already offer a very high
   * level of distribution. For keys not handled by these, or if you think you have
   * a better hash algorithm, you can set your own hash function with the constructor.
+  *
+  * The hash policy @a policy_t decides how keys are turned into hashes,
+  * see THashBuilder. It defaults to CHashPolicyRNG.
 **/
-template<typename key_t, typename data_t, typename elem_t = THashElement<key_t, data_t> >
-class PWX_API TChainHash : public VTHashBase<key_t, data_t, elem_t> {
+template<typename key_t, typename data_t, typename elem_t = THashElement<key_t, data_t>, typename policy_t = CHashPolicyRNG >
+class PWX_API TChainHash : public VTHashBase<key_t, data_t, elem_t, policy_t> {
 public:
 	/* ===============================================
 	 * === Public types                            ===
 	 * ===============================================
 	*/
 
-	typedef VTHashBase<key_t, data_t, elem_t> base_t;     //!< Base type of the hash
-	typedef TChainHash<key_t, data_t, elem_t> hash_t;     //!< Type of this hash
+	typedef VTHashBase<key_t, data_t, elem_t, policy_t> base_t; //!< Base type of the hash
+	typedef TChainHash<key_t, data_t, elem_t, policy_t> hash_t; //!< Type of this hash
 
 
 	/* ===============================================
@@ -158,6 +161,37 @@ public:
 	{ }
 
 
+	/** @brief bulk constructor
+	  *
+	  * Builds the hash from all key/data pairs in [@a first, @a last).
+	  * The table is sized once to hold all pairs with the load factor
+	  * @a maxLoad_, and the pairs are inserted without locking. Large
+	  * ranges are split across threads by bucket range.
+	  *
+	  * The iterators must be forward iterators to `std::pair<key_t, data_t*>`,
+	  * a plain array of pairs works, too. Like with add(), pairs with a key
+	  * that was already inserted are ignored and their data stays with the
+	  * caller.
+	  *
+	  * If the building fails, a pwx::CException is thrown.
+	  *
+	  * @param[in] first iterator to the first pair
+	  * @param[in] last iterator behind the last pair
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
+	  * @param[in] dynGrow_ growth rate applied when the maximum load factor is reached.
+	**/
+	template< typename iter_t, typename = typename base_t::template bulk_iter_t< iter_t > >
+	TChainHash( iter_t first, iter_t last,
+	            void ( *destroy_ ) ( data_t* data ),
+	            uint32_t ( *hash_ ) ( const key_t* key ),
+	            double maxLoad_, double dynGrow_ ) :
+		base_t( base_t::protBulkSize( first, last, maxLoad_ ), destroy_, hash_, maxLoad_, dynGrow_ ) {
+		PWX_TRY_PWX_FURTHER( this->protBulkLoad( first, last ) )
+	}
+
+
 	/** @brief limiting user method constructor
 	  *
 	  * This constructor only takes a destroy method and a hash
@@ -237,6 +271,21 @@ public:
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time.
+	  * @a src keeps its settings and gets a new, empty table.
+	  *
+	  * If that table can not be created, a pwx::CException with
+	  * the name "VTHashBase failure" is thrown.
+	  *
+	  * @param[in] src rvalue reference of the hash to move.
+	**/
+	TChainHash( hash_t&& src ) :
+		base_t( std::move( src ) )
+	{ }
+
+
 	virtual ~TChainHash() noexcept;
 
 
@@ -247,12 +296,17 @@ public:
 
 	using base_t::add;
 	using base_t::clear;
+	using base_t::disable_incremental_grow;
 	using base_t::disable_thread_safety;
 	using base_t::empty;
 	using base_t::exists;
+	using base_t::exists_many;
+	using base_t::enable_incremental_grow;
 	using base_t::enable_thread_safety;
 	using base_t::get;
+	using base_t::get_many;
 	using base_t::getData;
+	using base_t::getHash;
 	using base_t::getHops;
 	using base_t::grow;
 	using base_t::pop;
@@ -272,6 +326,39 @@ public:
 	 * ===============================================
 	*/
 
+	/** @brief assignment operator
+	  *
+	  * Clears this hash and copies all elements from @a rhs into it.
+	  *
+	  * @param[in] rhs reference of the hash to copy.
+	  * @return reference to this.
+	**/
+	hash_t& operator=( hash_t const& rhs ) {
+		PWX_TRY_PWX_FURTHER( base_t::operator=( rhs ) )
+		return *this;
+	}
+
+
+	/** @brief move assignment operator
+	  *
+	  * Clears this hash and takes over all elements of @a rhs in
+	  * constant time. @a rhs keeps its settings and gets the empty
+	  * table of this hash.
+	  *
+	  * @param[in] rhs rvalue reference of the hash to move.
+	  * @return reference to this.
+	**/
+	hash_t& operator=( hash_t&& rhs ) noexcept {
+		if ( &rhs != this ) {
+			PWX_DOUBLE_LOCK_GUARD( this, &rhs );
+			clear();
+			this->beThreadSafe( rhs.beThreadSafe() );
+			protMoveFrom( rhs );
+		}
+		return *this;
+	}
+
+
 	using base_t::operator=;
 	using base_t::operator+=;
 	using base_t::operator-=;
@@ -294,6 +381,8 @@ protected:
 	 */
 
 	using base_t::protGetHash;
+	using base_t::protGetMultIndex;
+	using base_t::protMoveFrom;
 	using base_t::table_get;
 	using base_t::table_set;
 
@@ -339,15 +428,21 @@ private:
 	  * @return the index an element with this key would have in the table
 	**/
 	virtual uint32_t privGetIndex( const key_t& key ) const noexcept {
-		uint32_t xHash = this->protGetHash( &key );
-		uint32_t tabSize = hashSize.load( memOrdLoad );
+		return privGetBaseIndex( this->protGetHash( &key ), hashSize.load( memOrdLoad ), CHMethod );
+	}
 
-		if ( CHM_Division == CHMethod )
+
+	/// @brief bucket index of @a xHash in a table of @a tabSize buckets using @a method
+	virtual uint32_t privGetBaseIndex( uint32_t xHash, uint32_t tabSize, eChainHashMethod method ) const noexcept {
+		if ( CHM_Division == method )
 			return xHash % tabSize;
-		else {
-			double dHash = static_cast<double>( xHash ) * 0.618;
-			return static_cast<uint32_t>( std::floor( ( dHash - std::floor( dHash ) ) * tabSize ) );
-		}
+		return protGetMultIndex( xHash, tabSize );
+	}
+
+
+	/// @brief chained hashes do not probe, all colliding keys are in the base bucket
+	virtual uint32_t privGetStepping( uint32_t, uint32_t, eChainHashMethod ) const noexcept {
+		return 0;
 	}
 
 
@@ -442,8 +537,8 @@ private:
   * This destructor will delete all elements currently stored. There is no
   * need to clean up manually before deleting the hash.
 **/
-template<typename key_t, typename data_t, typename elem_t>
-TChainHash<key_t, data_t, elem_t>::~TChainHash() noexcept
+template<typename key_t, typename data_t, typename elem_t, typename policy_t>
+TChainHash<key_t, data_t, elem_t, policy_t>::~TChainHash() noexcept
 { /* all done in base_t dtor */ }
 
 
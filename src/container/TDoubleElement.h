@@ -35,8 +35,12 @@
 **/
 
 
+#include <memory>
+#include <utility>
+
 #include "basic/compiler.h"
 
+#include "basic/CEpochGuard.h"
 #include "container/TVarDeleter.h"
 #include "container/VElement.h"
 #include "math_helpers/MathHelpers.h"
@@ -59,6 +63,13 @@ namespace pwx {
   * The data pointer itself is wrapped into an `std::shared_ptr`. It is therefore
   * completely safe to copy `TSingleElement` instances.
   *
+  * The optional template parameter @a alloc_t is the allocation policy for the
+  * element itself and for the control block of the shared data pointer. The
+  * default `pwx::CAllocPolicyNew` uses the global `operator new`, while
+  * `pwx::CAllocPolicyPool` recycles the memory of deleted elements, which makes
+  * repeated push/pop cycles a lot cheaper. Elements are deleted with `delete`
+  * either way.
+  *
   * The data pointer itself is public. You can use `foo->data.get()` to access it.
   * Further the `operator*()` is overloaded and `**foo will` result in a reference
   * to the data.
@@ -125,18 +136,19 @@ namespace pwx {
   * </TR>
   * </TABLE>
 **/
-template< typename data_t >
+template< typename data_t, typename alloc_t = CAllocPolicyNew >
 struct PWX_API TDoubleElement : public VElement {
 
 	/* ===============================================
 	 * === Public types                            ===
 	 * ===============================================
 	*/
-	typedef VElement                  base_t;     //!< Base type of this element
-	typedef TDoubleElement< data_t >  elem_t;     //!< Type of this element
-	typedef std::shared_ptr< data_t > share_t;    //!< `data_t` wrapped in `std::shared_ptr`
-	typedef std::atomic< elem_t* >    neighbor_t; //!< `elem_t*` wrapped in `std::atomic`
-	typedef base_t::store_t           store_t;    //!< The element store type to register this element with
+	typedef VElement                          base_t;     //!< Base type of this element
+	typedef TDoubleElement< data_t, alloc_t > elem_t;     //!< Type of this element
+	typedef alloc_t                           alloc_type; //!< Allocation policy of this element
+	typedef std::shared_ptr< data_t >         share_t;    //!< `data_t` wrapped in `std::shared_ptr`
+	typedef std::atomic< elem_t* >            neighbor_t; //!< `elem_t*` wrapped in `std::atomic`
+	typedef base_t::store_t                   store_t;    //!< The element store type to register this element with
 
 
 	/* ===============================================
@@ -152,7 +164,7 @@ struct PWX_API TDoubleElement : public VElement {
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
 	TDoubleElement( data_t* data_, void ( * destroy_ )( data_t* data_ ) ) noexcept
-		  : data( data_, TVarDeleter< data_t >( destroy_ ) ) {}
+		  : data( data_, TVarDeleter< data_t >( destroy_ ), TPolicyAllocator< data_t, alloc_t >() ) {}
 
 
 	/** @brief explicit constructor
@@ -187,6 +199,21 @@ struct PWX_API TDoubleElement : public VElement {
 		  : base_t( src ), data( src.data ) {}
 
 
+	/** @brief move ctor
+	  *
+	  * The move ctor creates a stand-alone element without neighbours,
+	  * taking over the data pointer and destroy method of @a src.
+	  * @a src is left without data and should not be in a container.
+	  *
+	  * **Important**: Whether the element does locking or not
+	  * is *not* copied. It will silently be turned on by default!
+	  *
+	  * @param[in] src rvalue reference to the element to move.
+	**/
+	TDoubleElement( elem_t &&src ) noexcept
+		  : base_t( src ), data( std::move( src.data ) ) {}
+
+
 	virtual ~TDoubleElement() noexcept;
 
 
@@ -523,11 +550,16 @@ struct PWX_API TDoubleElement : public VElement {
 	**/
 	virtual void remove() noexcept {
 		if ( beThreadSafe() ) {
-			base_t::remove();
-
 			// Do an acquiring test before the element is actually locked
 			elem_t* xOldPrev = prev.load( memOrdLoad );
 			elem_t* xOldNext = next.load( memOrdLoad );
+
+			// Readers still holding this element continue with the neighbors
+			// it has now. They are retired after this one, so they stay valid.
+			oldPrev.store( xOldPrev, memOrdStore );
+			oldNext.store( xOldNext, memOrdStore );
+			base_t::remove();
+
 			if ( xOldPrev || xOldNext ) {
 				PWX_TRIPLE_LOCK_GUARD( this, xOldPrev, xOldNext );
 
@@ -544,6 +576,8 @@ struct PWX_API TDoubleElement : public VElement {
 					prevIsPrev = xOldPrev == prev.load( memOrdLoad );
 					nextIsNext = xOldNext == next.load( memOrdLoad );
 				}
+				oldPrev.store( xOldPrev, memOrdStore );
+				oldNext.store( xOldNext, memOrdStore );
 
 
 				// 1: Handle previous neigbor
@@ -628,15 +662,7 @@ struct PWX_API TDoubleElement : public VElement {
 	  * @param[in] new_next target where the next pointer should point at.
 	**/
 	void setNext( elem_t* new_next ) noexcept {
-		if ( beThreadSafe() ) {
-			elem_t* currNext = next.load( memOrdLoad );
-			next.store( new_next, memOrdStore );
-			if ( currNext ) {
-				oldNext.store( currNext, memOrdStore );
-			}
-		} else {
-			next.store( new_next, memOrdStore );
-		}
+		next.store( new_next, memOrdStore );
 	}
 
 
@@ -651,15 +677,7 @@ struct PWX_API TDoubleElement : public VElement {
 	  * @param[in] new_prev target where the prev pointer should point at.
 	**/
 	void setPrev( elem_t* new_prev ) noexcept {
-		if ( beThreadSafe() ) {
-			elem_t* currPrev = prev.load( memOrdLoad );
-			prev.store( new_prev, memOrdStore );
-			if ( currPrev ) {
-				oldPrev.store( currPrev, memOrdStore );
-			}
-		} else {
-			prev.store( new_prev, memOrdStore );
-		}
+		prev.store( new_prev, memOrdStore );
 	}
 
 
@@ -685,6 +703,28 @@ struct PWX_API TDoubleElement : public VElement {
 			}
 			// note: destroy method wrapped in data!
 		}
+		return *this;
+	}
+
+
+	/** @brief move assignment operator
+	  *
+	  * The move assignment operator takes over the data and the
+	  * destroy method of @a src, which is left without data and
+	  * should not be in a container. This element will stay where
+	  * it is, and not change its position.
+	  *
+	  * @param[in] src rvalue reference of the element to move
+	  * @return reference to this element
+	**/
+	elem_t &operator=( elem_t &&src ) noexcept {
+		if ( ( this != &src ) && !destroyed() && !src.destroyed() ) {
+			PWX_DOUBLE_LOCK_GUARD( this, &src );
+			if ( !destroyed() && !src.destroyed() ) {
+				data = std::move( src.data );
+			}
+		}
+		return *this;
 	}
 
 
@@ -744,6 +784,22 @@ struct PWX_API TDoubleElement : public VElement {
 	}
 
 
+	/// @brief elements are allocated using the allocation policy
+	static void* operator new( size_t size ) {
+		return alloc_t::allocate( size );
+	}
+
+
+	/** @brief elements are given back to the allocation policy
+	  *
+	  * Like with `pwx::VElement`, this only happens when no reader inside
+	  * a `pwx::CEpochGuard` can still hold the element.
+	**/
+	static void operator delete( void* ptr, size_t size ) noexcept {
+		protFreeElement( ptr, reclaim_element, reinterpret_cast<void*>( size ) );
+	}
+
+
 	/* ===============================================
 	 * === Public members                          ===
 	 * ===============================================
@@ -766,6 +822,17 @@ protected:
 
 private:
 
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	 */
+
+	/// @internal Give the memory of a retired element back, @a size is the element size
+	static void reclaim_element( void* ptr, void* size ) noexcept {
+		alloc_t::deallocate( ptr, reinterpret_cast<size_t>( size ) );
+	}
+
+
 	/* ===============================================
 	 * === Private members                         ===
 	 * ===============================================
@@ -786,8 +853,8 @@ private:
   * is only done if, and only if, this is the very last element
   * referencing this data.
 **/
-template< typename data_t >
-TDoubleElement< data_t >::~TDoubleElement() noexcept {
+template< typename data_t, typename alloc_t >
+TDoubleElement< data_t, alloc_t >::~TDoubleElement() noexcept {
 	PWX_LOCK_GUARD( this );
 	isDestroyed.store( true );
 
@@ -93,7 +93,7 @@ public:
 	  *
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
-	TDoubleList ( void ( *destroy_ ) ( data_t* ) ) noexcept :
+	TDoubleList ( void ( *destroy_ ) ( data_t* ) ) :
 		base_t ( destroy_ )
 	{ }
 
@@ -103,7 +103,7 @@ public:
 	  * The empty constructor uses the default constructor to set the data
 	  * destroy method to the null pointer.
 	**/
-	TDoubleList() noexcept :
+	TDoubleList() :
 		base_t ( nullptr )
 	{ }
 
@@ -114,13 +114,25 @@ public:
 	  *
 	  * @param[in] src reference of the list to copy.
 	**/
-	TDoubleList ( const list_t& src ) noexcept :
+	TDoubleList ( const list_t& src ) :
 		base_t ( src ) {
 		// No need to do anything. The base ctor copies all elements using
 		// protInsert() which is actually in this class.
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time,
+	  * @a src is left empty.
+	  *
+	  * @param[in] src rvalue reference of the list to move.
+	**/
+	TDoubleList ( list_t&& src ) noexcept :
+		base_t ( std::move( src ) )
+	{ }
+
+
 	virtual ~TDoubleList() noexcept;
 
 
@@ -220,14 +232,18 @@ public:
 	}
 
 
+	using base_t::disable_indexing;
 	using base_t::disable_thread_safety;
 	using base_t::empty;
+	using base_t::enable_indexing;
 	using base_t::enable_thread_safety;
 	using base_t::find;
 	using base_t::get;
 	using base_t::getData;
+	using base_t::insAt;
 	using base_t::insNext;
 	using base_t::insNextElem;
+	using base_t::is_indexed;
 
 
 	/** @brief insert a new data pointer before the specified data
@@ -452,6 +468,20 @@ public:
 	}
 
 
+	/** @brief move assignment operator
+	  *
+	  * Clears this list and takes over all elements
+	  * of @a rhs, which is left empty.
+	  *
+	  * @param[in] rhs rvalue reference of the list to move.
+	  * @return reference to this.
+	**/
+	virtual list_t& operator= ( list_t&& rhs ) noexcept {
+		base_t::operator= ( std::move( rhs ) );
+		return *this;
+	}
+
+
 	/** @brief addition assignment operator
 	  *
 	  * Add all elements from @a rhs to this list.
@@ -496,6 +526,10 @@ protected:
 	using base_t::tail;
 	using base_t::destroy;
 	using base_t::protDelete;
+	using base_t::protIndexGet;
+	using base_t::protCreateStore;
+	using base_t::protIndexInsert;
+	using base_t::protIndexRemove;
 
 
 	/// @brief Search until the current element contains the searched data
@@ -515,38 +549,29 @@ protected:
 		if ( empty() )
 			return nullptr;
 
-		// Rule 1: Lock for the basic tests.
-		const_cast<list_t*>( this )->lock();
-
-		// Exit if the list has been emptied while we waited for the lock
-		if ( empty() ) {
-			const_cast<list_t*>( this )->unlock();
-			return nullptr;
-		}
+		// Rule 2 needs the traversed elements to stay valid.
+		CEpochGuard guard;
 
 		// Quick exit if curr is already what we want:
 		elem_t* xCurr = curr();
 		if ( xCurr && ( xCurr->data.get() == data ) ) {
-			const_cast<list_t*>( this )->unlock();
 			return xCurr;
 		}
 
 		// The next does only make sense if we have more than one element
-		if ( size() > 1 ) {
+		if ( xCurr && ( size() > 1 ) ) {
 
 			// Exit if head is wanted...
 			elem_t* xHead = head();
-			if ( ( xHead != xCurr ) && ( head()->data.get() == data ) ) {
+			if ( xHead && ( xHead != xCurr ) && ( xHead->data.get() == data ) ) {
 				curr( xHead );
-				const_cast<list_t*>( this )->unlock();
 				return xHead;
 			}
 
 			// ...or tail
 			elem_t* xTail = tail();
-			if ( ( xTail != xCurr ) && ( tail()->data.get() == data ) ) {
+			if ( xTail && ( xTail != xCurr ) && ( xTail->data.get() == data ) ) {
 				curr( xTail );
-				const_cast<list_t*>( this )->unlock();
 				return xTail;
 			}
 
@@ -556,12 +581,8 @@ protected:
 
 			xCurr   = oldCurr->getNext(); // curr is already checked.
 
-			// oldCurr must be locked, it must not be removed
-			// or deleted now!
-			PWX_LOCK( oldCurr );
-
-			// This is rule 2: Unlock for traversal
-			const_cast<list_t*>( this )->unlock();
+			// oldCurr needs no lock: The guard keeps it valid, and a
+			// removed element still knows its old neighbours.
 
 			// Move upwards first
 			while ( !result && !isDone && xCurr ) {
@@ -581,7 +602,6 @@ protected:
 			if ( !result ) {
 				xCurr  = oldCurr->getPrev();
 				isDone = false;
-				PWX_UNLOCK( oldCurr );
 
 				while ( !result && !isDone && xCurr ) {
 					// Again, do not spare head.
@@ -594,12 +614,9 @@ protected:
 						xCurr = xCurr->getPrev();
 				}
 				// End of moving downwards
-			} else
-				PWX_UNLOCK( oldCurr );
+			}
 
 		} // End of handling a search with more than one element
-		else
-			const_cast<list_t*>( this )->unlock();
 
 		return result;
 	}
@@ -617,37 +634,28 @@ protected:
 		if ( empty() )
 			return nullptr;
 
-		// Rule 1
-		const_cast<list_t*>( this )->lock();
-
-		if ( empty() ) {
-			const_cast<list_t*>( this )->unlock();
-			return nullptr;
-		}
+		CEpochGuard guard; // Rule 2
 
 		// Quick exit if curr is already what we want:
 		elem_t* xCurr = curr();
-		if ( *xCurr == data ) {
-			const_cast<list_t*>( this )->unlock();
+		if ( xCurr && ( 0 == xCurr->compare( data ) ) ) {
 			return xCurr;
 		}
 
 		// The next does only make sense if we have more than one element
-		if ( size() > 1 ) {
+		if ( xCurr && ( size() > 1 ) ) {
 
 			// Exit if head is wanted...
 			elem_t* xHead = head();
-			if ( ( xHead != xCurr ) && ( *xHead == data ) ) {
+			if ( xHead && ( xHead != xCurr ) && ( 0 == xHead->compare( data ) ) ) {
 				curr( xHead );
-				const_cast<list_t*>( this )->unlock();
 				return xHead;
 			}
 
 			// ...or tail
 			elem_t* xTail = tail();
-			if ( ( xTail != xCurr ) && ( *xTail == data ) ) {
+			if ( xTail && ( xTail != xCurr ) && ( 0 == xTail->compare( data ) ) ) {
 				curr( xTail );
-				const_cast<list_t*>( this )->unlock();
 				return xTail;
 			}
 
@@ -657,12 +665,8 @@ protected:
 
 			xCurr   = oldCurr->getNext(); // curr is already checked.
 
-			// oldCurr must be locked, it must not be removed
-			// or deleted now!
-			PWX_LOCK( oldCurr );
-
-			// This is rule 2: Unlock for traversal
-			const_cast<list_t*>( this )->unlock();
+			// oldCurr needs no lock: The guard keeps it valid, and a
+			// removed element still knows its old neighbours.
 
 			// Move upwards first, unless the search starts with tail
 			if ( oldCurr != tail() ) {
@@ -690,7 +694,6 @@ protected:
 			if ( !result && ( oldCurr != head() ) ) {
 				xCurr  = oldCurr->getPrev();
 				isDone = false;
-				PWX_UNLOCK( oldCurr );
 
 				while ( !result && !isDone && xCurr ) {
 					// Again, do not spare head.
@@ -703,11 +706,8 @@ protected:
 						xCurr = xCurr->getPrev();
 				}
 				// End of moving downwards
-			} else
-				PWX_UNLOCK( oldCurr );
+			}
 		} // End of handling a search with more than one element
-		else
-			const_cast<list_t*>( this )->unlock();
 
 		return result;
 	}
@@ -725,27 +725,21 @@ protected:
 		if ( empty() )
 			return nullptr;
 
-		// Rule 1
-		const_cast<list_t*>( this )->lock();
-
-		if ( empty() ) {
-			const_cast<list_t*>( this )->unlock();
-			return nullptr;
-		}
+		CEpochGuard guard; // Rule 2
 
 		// Quick exit if curr->next is already what we want:
 		elem_t* xCurr = curr();
-		elem_t* xNext = xCurr->getNext(); // Note: xCurr can not be nullptr at this point.
+		if ( nullptr == xCurr )
+			return nullptr; // The list was emptied meanwhile
+		elem_t* xNext = xCurr->getNext();
 		int32_t comp  = xCurr->compare( data );
 		if ( ( comp < 0 ) && ( ( nullptr == xNext ) || ( xNext->compare( data ) > -1 ) ) ) {
-			const_cast<list_t*>( this )->unlock();
 			return xNext ? xNext : nullptr;
 		}
 
 		// Quick exit if curr itself is already what we want:
 		elem_t* xPrev = xCurr->getPrev();
 		if ( ( comp > -1 ) && ( ( nullptr == xPrev ) || ( xPrev->compare( data ) < 0 ) ) ) {
-			const_cast<list_t*>( this )->unlock();
 			return xCurr;
 		}
 
@@ -753,7 +747,6 @@ protected:
 		elem_t* xHead = head();
 		if ( xHead && ( xHead->compare( data ) > -1 ) ) {
 			curr( xHead );
-			const_cast<list_t*>( this )->unlock();
 			return xHead;
 		}
 
@@ -761,7 +754,6 @@ protected:
 		elem_t* xTail = tail();
 		if ( xTail && ( xTail->compare( data ) < 0 ) ) {
 			curr( xTail );
-			const_cast<list_t*>( this )->unlock();
 			return nullptr; // tail is prev of nullptr by definition.
 		}
 
@@ -775,9 +767,6 @@ protected:
 			xPrev = xCurr->getPrev();
 		}
 
-		// Rule 2:
-		const_cast<list_t*>( this )->unlock();
-
 		while ( !result && !isDone && xCurr && ( xNext || xPrev ) ) {
 			// Note: The container is not locked any more,
 			// locking and checks are done on element level
@@ -849,31 +838,38 @@ protected:
 		 * 4: Otherwise insPrev->insertNext() can do the insertion
 		*/
 
+		// A list that was moved from needs a new store first
+		PWX_TRY_PWX_FURTHER( protCreateStore() )
+
+		// An indexed list must update links and index in one go
+		PWX_NAMED_LOCK_GUARD( indexed, isIndexed.load( memOrdLoad ) ? this : NULL_LOCK );
+		PWX_TRY_PWX_FURTHER( protIndexInsert( insPrev, insElem ) )
+
 		curr( insElem ); // always use the new element henceforth
 
 		if ( size() && insPrev && ( tail() != insPrev ) ) {
 			// Case 4: A normal insert
 			this->doRenumber.store( true, memOrdStore );
-			PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, &currStore ) );
+			PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, currStore ) );
 		} else {
 			if ( !size() ) {
 				// Case 1: The list is empty
-				PWX_TRY_PWX_FURTHER( insElem->insertBefore( nullptr, &currStore ) )
+				PWX_TRY_PWX_FURTHER( insElem->insertBefore( nullptr, currStore ) )
 				head( insElem );
 				tail( insElem );
 			} else if ( nullptr == insPrev ) {
 				// Case 2: A new head is to be set
-				PWX_TRY_PWX_FURTHER( head()->insertPrev( insElem, &currStore ) );
+				PWX_TRY_PWX_FURTHER( head()->insertPrev( insElem, currStore ) );
 				head( insElem ); // Does the renumbering already
 			} else if ( insPrev == tail() ) {
 				// Case 3: A new tail is to be set
 				insElem->nr( tail()->nr() + 1 );
-				PWX_TRY_PWX_FURTHER( tail()->insertNext( insElem, &currStore ) );
+				PWX_TRY_PWX_FURTHER( tail()->insertNext( insElem, currStore ) );
 				tail( insElem );
 			} else {
 				// Case 4, but only after acquiring the lock
 				this->doRenumber.store( true, memOrdStore );
-				PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, &currStore ) );
+				PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, currStore ) );
 			}
 		}
 
@@ -892,6 +888,7 @@ protected:
 
 	using base_t::currStore;
 	using base_t::eCount;
+	using base_t::isIndexed;
 	using base_t::memOrdLoad;
 	using base_t::memOrdStore;
 
@@ -958,11 +955,19 @@ private:
 		if ( empty() )
 			return nullptr;
 
+		// The positional index needs no renumbering and no walking
+		const elem_t* result = nullptr;
+		if ( protIndexGet( index, result ) )
+			return result;
+
 		protRenumber();
 
+		// The walk below is not locked, removed elements must stay valid
+		CEpochGuard guard;
+
 		// It is necessary to lock briefly to ensure a consistent
 		// start of the search with a minimum of checks
-		const_cast<list_t*>( this )->lock();
+		const_cast<list_t*>( this )->lock_shared();
 
 		uint32_t locCnt = size();
 
@@ -972,7 +977,7 @@ private:
 			if ( nullptr == xCurr )
 				xCurr = head();
 
-			const_cast<list_t*>( this )->unlock();
+			const_cast<list_t*>( this )->unlock_shared();
 
 			// Mod index into range
 			uint32_t xIdx = static_cast<uint32_t> ( index < 0
@@ -1073,7 +1078,7 @@ private:
 			curr( xCurr );
 			return xCurr;
 		} else
-			const_cast<list_t*>( this )->unlock();
+			const_cast<list_t*>( this )->unlock_shared();
 
 		return nullptr;
 	}
@@ -1224,10 +1229,15 @@ private:
 
 	/// @brief simple method to remove an element from the list.
 	virtual elem_t* privRemove ( elem_t* elem ) noexcept {
+		// An indexed list must update links and index in one go
+		PWX_NAMED_LOCK_GUARD( indexed, isIndexed.load( memOrdLoad ) ? this : NULL_LOCK );
+
 		// return at once if there is no element to remove
 		if ( !elem || elem->removed() || elem->destroyed() )
 			return nullptr;
 
+		protIndexRemove( elem );
+
 		/* The following scenarios are possible:
 		 * 1: elem is head
 		 * 2: elem is tail
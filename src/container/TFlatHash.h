@@ -0,0 +1,562 @@
+#ifndef PWX_LIBPWX_PWX_CONTAINER_TFLATHASH_H_INCLUDED
+#define PWX_LIBPWX_PWX_CONTAINER_TFLATHASH_H_INCLUDED
+#pragma once
+
+/** @file TFlatHash.h
+  *
+  * @brief Declaration of an open hash container storing keys and data inline
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <utility>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CException.h"
+#include "container/CHashBuilder.h"
+
+
+namespace pwx {
+
+
+/** @class TFlatHash PFlatHash <PFlatHash>
+  *
+  * @brief Flat open hash container without any per element overhead
+  *
+  * TOpenHash and TChainHash store pointers to heap allocated THashElement
+  * instances. Each of those carries a lock, an atomic next pointer and the
+  * data wrapped in a `std::shared_ptr`. So a lookup has to follow the table
+  * pointer, then the element and then the control block of the shared pointer.
+  *
+  * This container stores the key, its hash, its number of hops and the data
+  * pointer directly in one contiguous array. There are no elements and no
+  * locks. Collisions are resolved with linear probing and "Robin Hood
+  * Hashing", and removed keys are closed up by shifting their successors
+  * back, so there are no vacated buckets either. The table size is always a
+  * power of two and the table grows when 80% of the buckets are used.
+  *
+  * **Important**: This container is *not* thread safe. It is meant for
+  * single threaded use, or for places where the caller already synchronizes
+  * all access. Pointers returned by get() are valid until the key is removed.
+  *
+  * The key type must be default constructible and movable, as keys are
+  * moved around within the table.
+  *
+  * The hash policy @a policy_t decides how keys are turned into hashes,
+  * see THashBuilder. It defaults to CHashPolicyRNG.
+**/
+template< typename key_t, typename data_t, typename policy_t = CHashPolicyRNG >
+class PWX_API TFlatHash {
+public:
+
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TFlatHash< key_t, data_t, policy_t > hash_t; //!< Type of this hash
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+
+	/** @brief full constructor with key length
+	  *
+	  * The full constructor initializes an empty hash with user defined
+	  * delete method and hashing method with key length. The initial
+	  * size is the @a initSize raised to the next power of two.
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TFlatHash( uint32_t initSize,
+	           void ( * destroy_ )( data_t* data ),
+	           uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
+	           uint32_t keyLen_ )
+		  : destroy( destroy_ )
+		  , hash_limited( hash_ )
+		  , hashBuilder( keyLen_ ) {
+		PWX_TRY_PWX_FURTHER( privCreateTable( initSize ) )
+	}
+
+
+	/** @brief full constructor without key length
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	**/
+	TFlatHash( uint32_t initSize,
+	           void ( * destroy_ )( data_t* data ),
+	           uint32_t ( * hash_ )( const key_t* key ) )
+		  : destroy( destroy_ )
+		  , hash_user( hash_ ) {
+		PWX_TRY_PWX_FURTHER( privCreateTable( initSize ) )
+	}
+
+
+	/** @brief size and key length constructor
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TFlatHash( uint32_t initSize, uint32_t keyLen_ )
+		  : TFlatHash( initSize, nullptr, nullptr, keyLen_ )
+	{ }
+
+
+	/** @brief limiting user method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored and takes an optional keyLen
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TFlatHash( void ( * destroy_ )( data_t* data ),
+	           uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
+	           uint32_t keyLen_ )
+		  : TFlatHash( 128, destroy_, hash_, keyLen_ )
+	{ }
+
+
+	/** @brief user method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	**/
+	TFlatHash( void ( * destroy_ )( data_t* data ),
+	           uint32_t ( * hash_ )( const key_t* key ) )
+		  : TFlatHash( 128, destroy_, hash_ )
+	{ }
+
+
+	/** @brief destroy method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	**/
+	explicit TFlatHash( void ( * destroy_ )( data_t* data ) )
+		  : TFlatHash( 128, destroy_, nullptr, 0 )
+	{ }
+
+
+	/** @brief key length constructor
+	  *
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	explicit TFlatHash( uint32_t keyLen_ )
+		  : TFlatHash( 128, nullptr, nullptr, keyLen_ )
+	{ }
+
+
+	/** @brief empty constructor
+	  *
+	  * The empty constructor sets the data destroy method and the hash
+	  * method to the null pointer and the initial size to 128.
+	**/
+	TFlatHash()
+		  : TFlatHash( 128, nullptr, nullptr, 0 )
+	{ }
+
+
+	TFlatHash( hash_t const& ) PWX_DELETE;
+	TFlatHash( hash_t const&& ) PWX_DELETE;
+	hash_t& operator=( hash_t const& ) PWX_DELETE;
+	hash_t& operator=( hash_t const&& ) PWX_DELETE;
+
+
+	/** @brief default destructor
+	  *
+	  * This destructor will destroy all data currently stored.
+	**/
+	virtual ~TFlatHash() noexcept {
+		clear();
+		delete [] slots;
+		slots = nullptr;
+	}
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+
+	/** @brief add a key-data-pair to the hash
+	  *
+	  * This method adds a new key to the hash if @a key is not present,
+	  * yet. If the key already exists, nothing happens and the ownership
+	  * of @a data stays with the caller.
+	  *
+	  * @param[in] key the key of the new element
+	  * @param[in] data pointer to the data of the new element
+	  * @return the resulting number of stored elements
+	**/
+	uint32_t add( const key_t &key, data_t* data ) {
+		uint32_t hash = privGetHash( key );
+
+		if ( npos == privFind( key, hash ) ) {
+			if ( eCount >= maxCount ) {
+				PWX_TRY_PWX_FURTHER( privRehash( capacity * 2 ) )
+			}
+
+			slot_t entry;
+			entry.hash = hash;
+			entry.dist = 1;
+			entry.data = data;
+			entry.key  = key;
+			privInsert( entry );
+		}
+
+		return eCount;
+	}
+
+
+	/** @brief delete all elements
+	  *
+	  * If a destroy() function was set, it is used for the data
+	  * deletion. Otherwise it is assumed that data_t responds to
+	  * the delete operator.
+	**/
+	void clear() noexcept {
+		for ( uint32_t i = 0 ; eCount && ( i < capacity ) ; ++i ) {
+			if ( slots[i].dist ) {
+				privDestroyData( slots[i].data );
+				privEmpty( slots[i] );
+				--eCount;
+			}
+		}
+	}
+
+
+	/** @brief delete the element with the key @a key
+	  *
+	  * If the hash table does not contain the key @a key,
+	  * nothing happens.
+	  *
+	  * @param key reference to the key to search for
+	  * @return The number of elements after the operation.
+	**/
+	uint32_t delKey( const key_t &key ) noexcept {
+		uint32_t idx = privFind( key, privGetHash( key ) );
+		if ( npos != idx ) {
+			privDestroyData( slots[idx].data );
+			privErase( idx );
+		}
+		return eCount;
+	}
+
+
+	/// @brief return true if the hash is empty
+	bool empty() const noexcept {
+		return 0 == eCount;
+	}
+
+
+	/// @brief return true if the key @a key exists
+	bool exists( const key_t &key ) const noexcept {
+		return npos != privFind( key, privGetHash( key ) );
+	}
+
+
+	/** @brief returns a pointer to the data stored with the key @a key
+	  *
+	  * @param[in] key the key to search for
+	  * @return a pointer to the data or nullptr if the key could not be found.
+	**/
+	data_t* get( const key_t &key ) const noexcept {
+		uint32_t idx = privFind( key, privGetHash( key ) );
+		return npos != idx ? slots[idx].data : nullptr;
+	}
+
+
+	/** @brief returns a reference to the stored data with key @a key
+	  *
+	  * If the key can not be found or its data is `nullptr`, a
+	  * pwx::CException with the name "NullDataException" is thrown.
+	  *
+	  * @param[in] key the key to search for
+	  * @return a read/write reference to the stored data.
+	**/
+	data_t &getData( const key_t &key ) const {
+		data_t* data = get( key );
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "key not found",
+			           "TFlatHash has no data for the given key" )
+		return *data;
+	}
+
+
+	/** @brief return the distance of the key @a key from its home bucket
+	  *
+	  * @param[in] key The key to search for
+	  * @return number of hops, or zero if the key is not found.
+	**/
+	uint32_t getHops( const key_t &key ) const noexcept {
+		uint32_t idx = privFind( key, privGetHash( key ) );
+		return npos != idx ? slots[idx].dist - 1 : 0;
+	}
+
+
+	/** @brief remove the key @a key and return its data
+	  *
+	  * The ownership of the data goes to the caller.
+	  *
+	  * @param[in] key the key to remove
+	  * @return a pointer to the data or nullptr if the key was not found
+	**/
+	data_t* remKey( const key_t &key ) noexcept {
+		uint32_t idx    = privFind( key, privGetHash( key ) );
+		data_t*  result = nullptr;
+		if ( npos != idx ) {
+			result = slots[idx].data;
+			privErase( idx );
+		}
+		return result;
+	}
+
+
+	/** @brief reserve room for at least @a count elements
+	  *
+	  * The table is grown, so that @a count elements fit in without
+	  * another growth. Tables are never shrunk.
+	  *
+	  * @param[in] count number of elements to make room for
+	  * @return the resulting number of buckets
+	**/
+	uint32_t reserve( uint32_t count ) {
+		uint32_t needed = static_cast<uint32_t>( static_cast<uint64_t>( count ) * 5 / 4 ) + 1;
+		if ( needed > capacity ) {
+			PWX_TRY_PWX_FURTHER( privRehash( needed ) )
+		}
+		return capacity;
+	}
+
+
+	/// @brief return the number of stored elements
+	uint32_t size() const noexcept {
+		return eCount;
+	}
+
+
+	/// @brief return the number of buckets of the table
+	uint32_t sizeMax() const noexcept {
+		return capacity;
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal One bucket. The hash is kept to skip most key comparisons and to rehash without hashing.
+	struct slot_t {
+		uint32_t hash = 0;       //!< Hash of the key
+		uint32_t dist = 0;       //!< Distance from the home bucket plus one, zero if the bucket is empty
+		data_t*  data = nullptr; //!< The stored data
+		key_t    key  {};        //!< The stored key
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	/// @internal Create an empty table with at least @a minSize buckets
+	void privCreateTable( uint32_t minSize ) PWX_LOCAL {
+		uint32_t tabSize = 16;
+		while ( ( tabSize < minSize ) && ( tabSize < 0x80000000 ) )
+			tabSize <<= 1;
+
+		try {
+			slots = new slot_t[tabSize];
+		}
+		PWX_THROW_STD_FURTHER( "TableCreationFailed", "The hash table could not be created" )
+
+		capacity = tabSize;
+		mask     = tabSize - 1;
+		maxCount = tabSize - tabSize / 5;
+	}
+
+
+	/// @internal Destroy data with the user defined method or delete
+	void privDestroyData( data_t* data ) noexcept PWX_LOCAL {
+		if ( data ) {
+			if ( destroy )
+				destroy( data );
+			else
+				delete data;
+		}
+	}
+
+
+	/// @internal Reset @a slot to an empty bucket, so no old key is kept alive
+	static void privEmpty( slot_t &slot ) noexcept PWX_LOCAL {
+		slot.hash = 0;
+		slot.dist = 0;
+		slot.data = nullptr;
+		slot.key  = key_t();
+	}
+
+
+	/** @internal Remove the bucket @a idx
+	  *
+	  * All following buckets that are not in their home bucket are
+	  * shifted back by one, so no probe sequence is ever interrupted.
+	**/
+	void privErase( uint32_t idx ) noexcept PWX_LOCAL {
+		uint32_t next = ( idx + 1 ) & mask;
+
+		while ( slots[next].dist > 1 ) {
+			slots[idx] = std::move( slots[next] );
+			--slots[idx].dist;
+			idx  = next;
+			next = ( next + 1 ) & mask;
+		}
+
+		privEmpty( slots[idx] );
+		--eCount;
+	}
+
+
+	/** @internal Find the bucket of @a key with the hash @a hash
+	  *
+	  * The search stops early when a bucket is found that is closer
+	  * to its own home than the key would be. Robin Hood Hashing
+	  * would have placed the key before that bucket.
+	  *
+	  * @return the bucket index or npos if the key is not stored
+	**/
+	uint32_t privFind( const key_t &key, uint32_t hash ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t idx  = hash & mask;
+		uint32_t dist = 1;
+
+		while ( slots[idx].dist >= dist ) {
+			if ( ( slots[idx].hash == hash ) && ( slots[idx].key == key ) ) {
+				return idx;
+			}
+			++dist;
+			idx = ( idx + 1 ) & mask;
+		}
+
+		return npos;
+	}
+
+
+	/** @internal Get the hash of @a key
+	  *
+	  * The final mix makes sure that the lower bits used for the
+	  * bucket index depend on all bits of the built hash.
+	**/
+	uint32_t privGetHash( const key_t &key ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t hash = hashBuilder( &key, hash_user, hash_limited );
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6b;
+		hash ^= hash >> 13;
+		hash *= 0xc2b2ae35;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+
+	/** @internal Insert @a entry using Robin Hood Hashing
+	  * The key must not be stored already, and there must be room left.
+	**/
+	void privInsert( slot_t &entry ) noexcept PWX_LOCAL {
+		uint32_t idx = entry.hash & mask;
+
+		while ( slots[idx].dist ) {
+			// Take the bucket from a richer resident, who moves on instead
+			if ( slots[idx].dist < entry.dist ) {
+				std::swap( entry, slots[idx] );
+			}
+			++entry.dist;
+			idx = ( idx + 1 ) & mask;
+		}
+
+		slots[idx] = std::move( entry );
+		++eCount;
+	}
+
+
+	/// @internal Move all keys into a new table with at least @a minSize buckets
+	void privRehash( uint32_t minSize ) PWX_LOCAL {
+		slot_t*  oldSlots = slots;
+		uint32_t oldSize  = capacity;
+
+		PWX_TRY_PWX_FURTHER( privCreateTable( minSize ) )
+
+		uint32_t count = eCount;
+		eCount = 0;
+
+		for ( uint32_t i = 0 ; count && ( i < oldSize ) ; ++i ) {
+			if ( oldSlots[i].dist ) {
+				oldSlots[i].dist = 1;
+				privInsert( oldSlots[i] );
+				--count;
+			}
+		}
+
+		delete [] oldSlots;
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	static const uint32_t npos = 0xffffffff; //!< privFind() result for keys not found
+
+	void     ( * destroy )( data_t* data ) = nullptr;                      //!< Optional destroy function for the data
+	uint32_t ( * hash_user )( const key_t* key ) = nullptr;                //!< Optional user hash function
+	uint32_t ( * hash_limited )( const key_t* key, uint32_t keyLen ) = nullptr; //!< Optional user hash function with key length
+
+	THashBuilder<policy_t> hashBuilder { 0 }; //!< Builds the hashes of the keys
+	uint32_t     capacity    = 0;       //!< Number of buckets, always a power of two
+	uint32_t     eCount      = 0;       //!< Number of stored keys
+	uint32_t     mask        = 0;       //!< capacity - 1
+	uint32_t     maxCount    = 0;       //!< Number of keys that triggers growing
+	slot_t*      slots       = nullptr; //!< The buckets
+}; // class TFlatHash
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_CONTAINER_TFLATHASH_H_INCLUDED
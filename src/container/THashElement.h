@@ -36,6 +36,8 @@
 
 
 #include <cstring>
+#include <memory>
+#include <utility>
 
 #include "basic/compiler.h"
 #include "basic/debug.h"
@@ -163,6 +165,22 @@ public:
 		  : base_t( src ), key( src.key ), data( src.data ) {}
 
 
+	/** @brief move ctor
+	  *
+	  * The move ctor creates a stand-alone element without neighbors
+	  * taking over the data pointer and the destroy method of @a src.
+	  * The key is copied, so @a src can still be found by it, but it
+	  * is left without data and should not be in a container.
+	  *
+	  * <B>Important</B>: Whether the element does locking or not
+	  * is *not* copied. It will silently be turned on by default!
+	  *
+	  * @param[in] src rvalue reference to the element to move.
+	**/
+	THashElement( elem_t &&src ) noexcept
+		  : base_t( src ), key( src.key ), data( std::move( src.data ) ) {}
+
+
 	virtual ~THashElement() noexcept;
 
 
@@ -448,6 +466,27 @@ public:
 	}
 
 
+	/** @brief move assignment operator
+	  *
+	  * The move assignment operator takes over the data and the
+	  * destroy method of @a src, which is left without data and
+	  * should not be in a container. This element will keep its
+	  * key and stay where it is.
+	  *
+	  * @param[in] src rvalue reference of the element to move
+	  * @return reference to this element
+	**/
+	elem_t &operator=( elem_t &&src ) noexcept {
+		if ( ( this != &src ) && !destroyed() && !src.destroyed() ) {
+			PWX_DOUBLE_LOCK_GUARD( this, &src );
+			if ( !destroyed() && !src.destroyed() ) {
+				data = std::move( src.data );
+			}
+		}
+		return *this;
+	}
+
+
 	/** @brief dereferencing an element returns a reference to the stored data
 	  *
 	  * If the data pointer is nullptr, a pwx::CException with the name
@@ -0,0 +1,407 @@
+#ifndef PWX_LIBPWX_CONTAINER_TLISTINDEX_H_INCLUDED
+#define PWX_LIBPWX_CONTAINER_TLISTINDEX_H_INCLUDED 1
+#pragma once
+
+/** @file TListIndex.h
+  *
+  * @brief Order statistic index for the list based containers
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/** @class TListIndex
+  *
+  * @brief Positional index over the elements of a list
+  *
+  * This is a randomized balanced binary tree (a treap) that is ordered by
+  * the position of the elements in the list and counts the nodes in each
+  * subtree. It answers "which element is at position n" and "at which
+  * position is this element" in O(log n), and an insertion or removal at
+  * any position only touches O(log n) nodes. The list containers use it
+  * when `enable_indexing()` was called on them.
+  *
+  * The nodes are held in one vector and address each other by their number,
+  * node 0 being the empty sentinel. A hash map translates element pointers
+  * into node numbers.
+  *
+  * This class is not thread safe. The owning list must serialize all
+  * modifications and shield lookups with a shared lock.
+**/
+template<typename elem_t>
+class PWX_API TListIndex {
+public:
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TListIndex<elem_t> index_t; //!< Type of this index
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+	/// @brief The default constructor creates an empty index, no memory is allocated
+	explicit TListIndex() noexcept
+	{ }
+
+	TListIndex( index_t const& ) PWX_DELETE;
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+	/// @brief remove all elements and free all memory
+	void clear() noexcept {
+		std::vector<sNode>().swap( nodes );
+		lookup.clear();
+		freeHead = 0;
+		root     = 0;
+	}
+
+
+	/// @return true if no element is indexed
+	bool empty() const noexcept {
+		return 0 == root;
+	}
+
+
+	/** @brief return the element at position @a pos
+	  * @param[in] pos the position, counting from zero.
+	  * @return the element or `nullptr` if @a pos is not lower than `size()`.
+	**/
+	elem_t* get( uint32_t pos ) const noexcept {
+		uint32_t xNode = root;
+
+		while ( xNode ) {
+			sNode const& node = nodes[xNode];
+			uint32_t     lCnt = nodes[node.left].count;
+
+			if ( pos < lCnt )
+				xNode = node.left;
+			else if ( pos == lCnt )
+				return node.elem;
+			else {
+				pos  -= lCnt + 1;
+				xNode = node.right;
+			}
+		}
+
+		return nullptr;
+	}
+
+
+	/** @brief index @a elem as the successor of @a prev
+	  *
+	  * If @a prev is `nullptr` or not indexed, @a elem becomes
+	  * the first element.
+	  *
+	  * If memory can not be allocated, `std::bad_alloc` is thrown
+	  * and the index is left unchanged.
+	  *
+	  * @param[in] prev the indexed element that precedes @a elem.
+	  * @param[in] elem the element to index.
+	**/
+	void insert( elem_t const* prev, elem_t* elem ) {
+		uint32_t prevNode = prev ? privFind( prev ) : 0;
+		uint32_t newNode  = privAlloc( elem );
+		uint32_t parent   = 0;
+		bool     asLeft   = true;
+
+		// Find the leaf slot directly behind prev, or the very first one
+		if ( prevNode ) {
+			if ( nodes[prevNode].right ) {
+				parent = nodes[prevNode].right;
+				while ( nodes[parent].left )
+					parent = nodes[parent].left;
+			} else {
+				parent = prevNode;
+				asLeft = false;
+			}
+		} else if ( root ) {
+			parent = root;
+			while ( nodes[parent].left )
+				parent = nodes[parent].left;
+		}
+
+		nodes[newNode].parent = parent;
+		if ( 0 == parent )
+			root = newNode;
+		else {
+			if ( asLeft )
+				nodes[parent].left  = newNode;
+			else
+				nodes[parent].right = newNode;
+			for ( uint32_t xNode = parent ; xNode ; xNode = nodes[xNode].parent )
+				++nodes[xNode].count;
+		}
+
+		// Restore the heap order of the priorities
+		while ( nodes[newNode].parent
+		                && ( nodes[nodes[newNode].parent].prio < nodes[newNode].prio ) )
+			privRotateUp( newNode );
+	}
+
+
+	/** @brief return the position of @a elem
+	  * @param[in] elem the element to look up.
+	  * @return the position of @a elem or `size()` if it is not indexed.
+	**/
+	uint32_t pos( elem_t const* elem ) const noexcept {
+		uint32_t xNode = privFind( elem );
+
+		if ( 0 == xNode )
+			return size();
+
+		uint32_t result = nodes[nodes[xNode].left].count;
+
+		for ( uint32_t xParent = nodes[xNode].parent ; xParent ;
+		                xNode = xParent, xParent = nodes[xNode].parent ) {
+			if ( nodes[xParent].right == xNode )
+				result += nodes[nodes[xParent].left].count + 1;
+		}
+
+		return result;
+	}
+
+
+	/** @brief remove @a elem from the index
+	  *
+	  * Nothing happens if @a elem is not indexed.
+	  *
+	  * @param[in] elem the element to remove.
+	**/
+	void remove( elem_t const* elem ) noexcept {
+		uint32_t xNode = privFind( elem );
+
+		if ( 0 == xNode )
+			return;
+
+		lookup.erase( elem );
+
+		// Rotate the node down until it is a leaf
+		while ( nodes[xNode].left || nodes[xNode].right ) {
+			uint32_t left  = nodes[xNode].left;
+			uint32_t right = nodes[xNode].right;
+			privRotateUp( ( 0 == left ) || ( right && ( nodes[right].prio > nodes[left].prio ) )
+			              ? right : left );
+		}
+
+		uint32_t parent = nodes[xNode].parent;
+		if ( 0 == parent )
+			root = 0;
+		else {
+			if ( nodes[parent].left == xNode )
+				nodes[parent].left  = 0;
+			else
+				nodes[parent].right = 0;
+			for ( uint32_t xParent = parent ; xParent ; xParent = nodes[xParent].parent )
+				--nodes[xParent].count;
+		}
+
+		// Put the node into the free list, chained via the parent number
+		nodes[xNode].elem   = nullptr;
+		nodes[xNode].parent = freeHead;
+		freeHead            = xNode;
+	}
+
+
+	/** @brief reserve memory for @a count elements
+	  *
+	  * If memory can not be allocated, `std::bad_alloc` is thrown.
+	  *
+	  * @param[in] count the number of elements to prepare for.
+	**/
+	void reserve( uint32_t count ) {
+		nodes.reserve( static_cast<size_t>( count ) + 1 );
+		lookup.reserve( count );
+	}
+
+
+	/// @return the number of indexed elements
+	uint32_t size() const noexcept {
+		return root ? nodes[root].count : 0;
+	}
+
+
+	/// @brief exchange all elements with @a other
+	void swap( index_t& other ) noexcept {
+		std::swap( freeHead, other.freeHead );
+		lookup.swap( other.lookup );
+		nodes.swap( other.nodes );
+		std::swap( prioSeed, other.prioSeed );
+		std::swap( root, other.root );
+	}
+
+
+	/* ===============================================
+	 * === Public operators                        ===
+	 * ===============================================
+	*/
+
+	index_t& operator=( index_t const& ) PWX_DELETE;
+
+
+private:
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal One tree node. Children and parent are node numbers, 0 is none.
+	struct sNode {
+		elem_t*  elem   = nullptr;
+		uint32_t left   = 0;
+		uint32_t right  = 0;
+		uint32_t parent = 0;
+		uint32_t count  = 0; //!< Number of nodes in this subtree
+		uint32_t prio   = 0; //!< Random heap priority, parents are greater than their children
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	/// @internal get a fresh leaf node for @a elem, throws std::bad_alloc
+	uint32_t privAlloc( elem_t* elem ) {
+		uint32_t result = freeHead;
+
+		lookup.emplace( elem, 0 ); // Throws before anything is changed
+		try {
+			if ( nodes.empty() )
+				nodes.emplace_back(); // The sentinel
+			if ( result )
+				freeHead = nodes[result].parent;
+			else {
+				result = static_cast<uint32_t>( nodes.size() );
+				nodes.emplace_back();
+			}
+		} catch ( ... ) {
+			lookup.erase( elem );
+			throw;
+		}
+
+		sNode& node = nodes[result];
+		node.elem   = elem;
+		node.left   = 0;
+		node.right  = 0;
+		node.parent = 0;
+		node.count  = 1;
+		node.prio   = privNextPrio();
+
+		lookup[elem] = result;
+		return result;
+	}
+
+
+	/// @internal return the node number of @a elem or 0 if it is not indexed
+	uint32_t privFind( elem_t const* elem ) const noexcept {
+		auto iter = lookup.find( elem );
+		return iter == lookup.end() ? 0 : iter->second;
+	}
+
+
+	/// @internal xorshift32, the priorities only need to be well spread
+	uint32_t privNextPrio() noexcept {
+		prioSeed ^= prioSeed << 13;
+		prioSeed ^= prioSeed >> 17;
+		prioSeed ^= prioSeed << 5;
+		return prioSeed;
+	}
+
+
+	/// @internal rotate @a xNode above its parent, keeping the order and the counts intact
+	void privRotateUp( uint32_t xNode ) noexcept {
+		sNode&   node   = nodes[xNode];
+		uint32_t parent = node.parent;
+		sNode&   par    = nodes[parent];
+		uint32_t grand  = par.parent;
+
+		if ( par.left == xNode ) {
+			par.left = node.right;
+			if ( node.right )
+				nodes[node.right].parent = parent;
+			node.right = parent;
+		} else {
+			par.right = node.left;
+			if ( node.left )
+				nodes[node.left].parent = parent;
+			node.left = parent;
+		}
+
+		par.parent  = xNode;
+		node.parent = grand;
+
+		if ( 0 == grand )
+			root = xNode;
+		else if ( nodes[grand].left == parent )
+			nodes[grand].left  = xNode;
+		else
+			nodes[grand].right = xNode;
+
+		par.count  = nodes[par.left].count  + nodes[par.right].count  + 1;
+		node.count = nodes[node.left].count + nodes[node.right].count + 1;
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	uint32_t                                    freeHead = 0;          //!< First unused node, chained via parent
+	std::unordered_map<elem_t const*, uint32_t> lookup;                //!< Node number of each indexed element
+	std::vector<sNode>                          nodes;                 //!< All nodes, 0 is the sentinel
+	uint32_t                                    prioSeed = 0x9e3779b9; //!< State of the priority generator
+	uint32_t                                    root     = 0;          //!< Number of the root node
+}; // class TListIndex
+
+
+} // namespace pwx
+
+#endif // PWX_LIBPWX_CONTAINER_TLISTINDEX_H_INCLUDED
@@ -0,0 +1,365 @@
+#ifndef PWX_LIBPWX_CONTAINER_TLISTITERATOR_H_INCLUDED
+#define PWX_LIBPWX_CONTAINER_TLISTITERATOR_H_INCLUDED 1
+#pragma once
+
+/** @file TListIterator.h
+  *
+  * @brief STL compatible iterators and snapshots for the list based containers
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CEpochGuard.h"
+#include "basic/CLockGuard.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+/** @internal Iterator category of the elements of type @a elem_t
+  *
+  * Elements that know their predecessor can be walked in both
+  * directions, all others only forward.
+**/
+template<typename elem_t, typename = void>
+struct list_iterator_category {
+	typedef std::forward_iterator_tag type;
+};
+
+/// @internal Elements with `getPrev()` allow bidirectional iterators
+template<typename elem_t>
+struct list_iterator_category<elem_t, std::void_t<decltype( std::declval<elem_t const&>().getPrev() )> > {
+	typedef std::bidirectional_iterator_tag type;
+};
+
+
+/** @class TListIterator
+  *
+  * @brief STL compatible iterator over the elements of a list or ring
+  *
+  * The iterator walks from the first to the last element of a range and
+  * dereferences to the data of the elements. The element itself is
+  * available via `elem()`.
+  *
+  * Lists of `pwx::TSingleElement` get forward iterators, lists of
+  * `pwx::TDoubleElement` get bidirectional iterators. Either way they
+  * can be used with the algorithms from `<algorithm>`.
+  *
+  * The last element is remembered when the iterator is created, so
+  * rings end there instead of cycling endlessly. Going forward from it,
+  * or from an element leading to nothing or back to the first element,
+  * yields the end iterator.
+  *
+  * Stepping neither locks the elements nor the list. Whether another
+  * thread may change the list meanwhile depends on where the iterator
+  * came from, see `begin()` and `snapshot()` of the lists.
+  *
+  * @tparam elem_t the element type of the list.
+  * @tparam value_t `data_t` for a read/write or `data_t const` for a read only iterator.
+**/
+template<typename elem_t, typename value_t>
+class PWX_API TListIterator {
+public:
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TListIterator<elem_t, value_t>                  iter_t;            //!< Type of this iterator
+	typedef typename list_iterator_category<elem_t>::type   iterator_category; //!< Forward or bidirectional
+	typedef typename std::remove_const<value_t>::type       value_type;        //!< The data type
+	typedef std::ptrdiff_t                                  difference_type;   //!< Distance between two iterators
+	typedef value_t*                                        pointer;           //!< Pointer to the data
+	typedef value_t&                                        reference;         //!< Reference to the data
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+	/// @brief The default constructor creates an end iterator
+	TListIterator() noexcept
+	{ }
+
+
+	/** @brief create an iterator positioned on @a curr_
+	  * @param[in] curr_ the current element, `nullptr` for the end.
+	  * @param[in] first_ the first element of the range.
+	  * @param[in] last_ the last element of the range.
+	**/
+	TListIterator( elem_t* curr_, elem_t* first_, elem_t* last_ ) noexcept
+		: curr( curr_ ), first( first_ ), last( last_ )
+	{ }
+
+
+	/// @brief read/write iterators convert into read only iterators
+	template<typename other_t, typename = typename std::enable_if<
+	                 std::is_same<other_t const, value_t>::value && !std::is_same<other_t, value_t>::value>::type>
+	TListIterator( TListIterator<elem_t, other_t> const& src ) noexcept
+		: curr( src.elem() ), first( src.front() ), last( src.back() )
+	{ }
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+	/// @return the last element of the range
+	elem_t* back() const noexcept {
+		return last;
+	}
+
+
+	/// @return the current element, `nullptr` for the end iterator
+	elem_t* elem() const noexcept {
+		return curr;
+	}
+
+
+	/// @return the first element of the range
+	elem_t* front() const noexcept {
+		return first;
+	}
+
+
+	/* ===============================================
+	 * === Public operators                        ===
+	 * ===============================================
+	*/
+
+	/** @brief return the data of the current element
+	  *
+	  * Unlike the element dereferencing, this does neither lock nor
+	  * check the element. Do not dereference the end iterator.
+	**/
+	reference operator*() const noexcept {
+		return *curr->data;
+	}
+
+
+	/// @brief access the data of the current element
+	pointer operator->() const noexcept {
+		return curr->data.get();
+	}
+
+
+	/// @brief move to the next element or to the end
+	iter_t& operator++() noexcept {
+		if ( curr == last )
+			curr = nullptr;
+		else {
+			elem_t* xNext = curr->getNext();
+			curr = ( xNext == first ) ? nullptr : xNext;
+		}
+		return *this;
+	}
+
+
+	/// @brief move to the next element or to the end, return the previous position
+	iter_t operator++( int ) noexcept {
+		iter_t result( *this );
+		++( *this );
+		return result;
+	}
+
+
+	/// @brief move to the previous element, the end moves to the last element
+	iter_t& operator--() noexcept {
+		static_assert( std::is_same<iterator_category, std::bidirectional_iterator_tag>::value,
+		               "Only lists of elements with a prev pointer can be walked backwards" );
+		curr = curr ? curr->getPrev() : last;
+		return *this;
+	}
+
+
+	/// @brief move to the previous element, return the previous position
+	iter_t operator--( int ) noexcept {
+		iter_t result( *this );
+		--( *this );
+		return result;
+	}
+
+
+private:
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	elem_t* curr  = nullptr; //!< The current element, `nullptr` is the end
+	elem_t* first = nullptr; //!< The first element of the range
+	elem_t* last  = nullptr; //!< The last element of the range
+}; // class TListIterator
+
+
+/// @return true if @a lhs and @a rhs are positioned on the same element
+template<typename elem_t, typename lhs_t, typename rhs_t>
+bool operator==( TListIterator<elem_t, lhs_t> const& lhs, TListIterator<elem_t, rhs_t> const& rhs ) noexcept {
+	return lhs.elem() == rhs.elem();
+}
+
+
+/// @return true if @a lhs and @a rhs are positioned on different elements
+template<typename elem_t, typename lhs_t, typename rhs_t>
+bool operator!=( TListIterator<elem_t, lhs_t> const& lhs, TListIterator<elem_t, rhs_t> const& rhs ) noexcept {
+	return lhs.elem() != rhs.elem();
+}
+
+
+/** @class TListSnapshot
+  *
+  * @brief Read only range over a list, guarded for its whole lifetime
+  *
+  * A snapshot is what `snapshot()` of the list based containers returns.
+  * While it exists, it holds a shared lock on the list and a
+  * `pwx::CEpochGuard`:
+  *
+  * - The first and last element are fixed when the snapshot is taken.
+  *   Their removal, and everything else that locks the whole list,
+  *   waits until the snapshot ends.
+  * - Elements in between might still be inserted or removed by other
+  *   threads. Removed elements are not freed before the snapshot ends,
+  *   so iterators never run into released memory.
+  *
+  * Iterating the snapshot does not lock anything per step. Several
+  * threads can walk the same snapshot at once, which makes it usable
+  * with the parallel execution policies of `<algorithm>`, and any
+  * number of snapshots of the same list can exist at the same time.
+  *
+  * **Important**: The thread that took the snapshot must not remove
+  * the first or last element of the list, or clear it, before the
+  * snapshot is destroyed. It would wait for itself.
+  *
+  * A snapshot can neither be copied nor moved. Use it directly, like
+  * `for ( auto const& data : list.snapshot() )`, or bind it with
+  * `auto const& snap = list.snapshot();`.
+**/
+template<typename list_t>
+class PWX_API TListSnapshot {
+public:
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TListSnapshot<list_t>           snap_t;         //!< Type of this snapshot
+	typedef typename list_t::elem_type      elem_t;         //!< Element type of the list
+	typedef typename list_t::const_iterator const_iterator; //!< Read only iterator
+	typedef const_iterator                  iterator;       //!< A snapshot is always read only
+	typedef typename list_t::value_type     value_type;     //!< The data type
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+	/** @brief take a snapshot of @a list
+	  * @param[in] list the list to iterate.
+	**/
+	explicit TListSnapshot( list_t const& list ) noexcept
+		: lockGuard( &list ), first( list.head() ), last( first ? list.tail() : nullptr )
+	{ }
+
+	TListSnapshot( snap_t const& ) PWX_DELETE;
+	TListSnapshot( snap_t && ) PWX_DELETE;
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+	/// @return an iterator on the first element
+	const_iterator begin() const noexcept {
+		return const_iterator( first, first, last );
+	}
+
+
+	/// @return an iterator on the first element
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+
+	/// @return the end iterator
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+
+	/// @return true if the list was empty when the snapshot was taken
+	bool empty() const noexcept {
+		return nullptr == first;
+	}
+
+
+	/// @return the end iterator
+	const_iterator end() const noexcept {
+		return const_iterator( nullptr, first, last );
+	}
+
+
+	/* ===============================================
+	 * === Public operators                        ===
+	 * ===============================================
+	*/
+
+	snap_t& operator=( snap_t const& ) PWX_DELETE;
+	snap_t& operator=( snap_t && ) PWX_DELETE;
+
+
+private:
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	// The order matters: first and last are read with both guards in place.
+	CEpochGuard      epochGuard; //!< Keeps removed elements from being freed
+	CSharedLockGuard lockGuard;  //!< Keeps the list from changing head and tail
+	elem_t*          first;      //!< The first element when the snapshot was taken
+	elem_t*          last;       //!< The last element when the snapshot was taken
+}; // class TListSnapshot
+
+
+} // namespace pwx
+
+#endif // PWX_LIBPWX_CONTAINER_TLISTITERATOR_H_INCLUDED
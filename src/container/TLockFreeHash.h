@@ -0,0 +1,716 @@
+#ifndef PWX_LIBPWX_PWX_CONTAINER_TLOCKFREEHASH_H_INCLUDED
+#define PWX_LIBPWX_PWX_CONTAINER_TLOCKFREEHASH_H_INCLUDED
+#pragma once
+
+/** @file TLockFreeHash.h
+  *
+  * @brief Declaration of a lock-free open addressing hash container
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <atomic>
+#include <thread>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CEpochGuard.h"
+#include "basic/CException.h"
+#include "basic/types.h"
+#include "container/CHashBuilder.h"
+
+
+namespace pwx {
+
+
+/** @class TLockFreeHash PLockFreeHash <PLockFreeHash>
+  *
+  * @brief Lock-free open addressing hash container for variable types
+  *
+  * This is an open addressing hash table that does not use any locks. It
+  * is meant for workloads with many threads concurrently reading and
+  * writing, where TOpenHash and TChainHash would serialize on their table
+  * lock.
+  *
+  * The interface follows the other hash containers as far as possible:
+  * Keys are hashed with a THashBuilder using the hash policy @a policy_t,
+  * which defaults to CHashPolicyRNG, optionally with a user defined hash
+  * function, and data is given as pointers the container takes over.
+  *
+  * The table has a power of two size and uses linear probing. Each bucket
+  * holds an atomic pointer to an entry that is set once using a CAS
+  * operation and never changes afterwards. The data pointer of the entry
+  * is atomic as well, so deleting a key just swaps its data out. Lookups
+  * never wait for anything.
+  *
+  * When the table becomes too full, a new table is attached to the current
+  * one and all buckets are migrated in small chunks. Every thread that
+  * wants to insert during a migration helps with it, while readers simply
+  * follow moved buckets into the new table. Deleted entries are dropped
+  * during the migration.
+  *
+  * Removed data, dropped entries and old tables are retired with
+  * `pwx::epoch_retire()`. A data pointer returned by get() therefore stays
+  * valid, even if its key is concurrently deleted, for as long as the
+  * caller holds a `pwx::CEpochGuard` it created before calling get().
+  *
+  * **Important**: As `nullptr` marks deleted keys, `nullptr` can not be
+  * stored as data.
+**/
+template< typename key_t, typename data_t, typename policy_t = CHashPolicyRNG >
+class PWX_API TLockFreeHash {
+public:
+
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TLockFreeHash< key_t, data_t, policy_t > hash_t; //!< Type of this hash
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+
+	/** @brief full constructor with key length
+	  *
+	  * The full constructor initializes an empty hash with user defined
+	  * delete method and hashing method with key length. The initial
+	  * size is the @a initSize raised to the next power of two.
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
+	**/
+	TLockFreeHash( uint32_t initSize,
+	               void ( * destroy_ )( data_t* data ),
+	               uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
+	               uint32_t keyLen_,
+	               double maxLoad_ )
+		  : destroy( destroy_ )
+		  , hash_limited( hash_ )
+		  , hashBuilder( keyLen_ )
+		  , maxLoadFactor( ( maxLoad_ > 0.1 ) && ( maxLoad_ < 0.95 ) ? maxLoad_ : 0.6 ) {
+		PWX_TRY_PWX_FURTHER( root.store( privCreateTable( initSize ), std::memory_order_release ) )
+	}
+
+
+	/** @brief full constructor without key length
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
+	**/
+	TLockFreeHash( uint32_t initSize,
+	               void ( * destroy_ )( data_t* data ),
+	               uint32_t ( * hash_ )( const key_t* key ),
+	               double maxLoad_ )
+		  : destroy( destroy_ )
+		  , hash_user( hash_ )
+		  , maxLoadFactor( ( maxLoad_ > 0.1 ) && ( maxLoad_ < 0.95 ) ? maxLoad_ : 0.6 ) {
+		PWX_TRY_PWX_FURTHER( root.store( privCreateTable( initSize ), std::memory_order_release ) )
+	}
+
+
+	/** @brief size and key length constructor
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TLockFreeHash( uint32_t initSize, uint32_t keyLen_ )
+		  : TLockFreeHash( initSize, nullptr, nullptr, keyLen_, 0.6 )
+	{ }
+
+
+	/** @brief limiting user method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored and takes an optional keyLen
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TLockFreeHash( void ( * destroy_ )( data_t* data ),
+	               uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
+	               uint32_t keyLen_ )
+		  : TLockFreeHash( 128, destroy_, hash_, keyLen_, 0.6 )
+	{ }
+
+
+	/** @brief user method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	**/
+	TLockFreeHash( void ( * destroy_ )( data_t* data ),
+	               uint32_t ( * hash_ )( const key_t* key ) )
+		  : TLockFreeHash( 128, destroy_, hash_, 0.6 )
+	{ }
+
+
+	/** @brief destroy method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	**/
+	explicit TLockFreeHash( void ( * destroy_ )( data_t* data ) )
+		  : TLockFreeHash( 128, destroy_, nullptr, 0, 0.6 )
+	{ }
+
+
+	/** @brief key length constructor
+	  *
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	explicit TLockFreeHash( uint32_t keyLen_ )
+		  : TLockFreeHash( 128, nullptr, nullptr, keyLen_, 0.6 )
+	{ }
+
+
+	/** @brief empty constructor
+	  *
+	  * The empty constructor sets the data destroy method and the hash
+	  * method to the null pointer and the initial size to 128.
+	**/
+	TLockFreeHash()
+		  : TLockFreeHash( 128, nullptr, nullptr, 0, 0.6 )
+	{ }
+
+
+	TLockFreeHash( hash_t const& ) PWX_DELETE;
+	TLockFreeHash( hash_t const&& ) PWX_DELETE;
+	hash_t& operator=( hash_t const& ) PWX_DELETE;
+	hash_t& operator=( hash_t const&& ) PWX_DELETE;
+
+
+	/** @brief default destructor
+	  *
+	  * The destructor must not be called while other threads still
+	  * use the container. It destroys all remaining data, entries and
+	  * tables. Everything that is already retired is freed independently.
+	**/
+	virtual ~TLockFreeHash() noexcept {
+		table_t* curr = root.load( std::memory_order_acquire );
+		while ( curr ) {
+			table_t* next = curr->next.load( std::memory_order_acquire );
+
+			// Only the last table has all entries, the others are already moved.
+			for ( uint32_t i = 0 ; !next && ( i < curr->size ) ; ++i ) {
+				entry_t* entry = curr->slots[i].load( std::memory_order_acquire );
+				if ( entry && ( entry != moved ) ) {
+					data_t* data = entry->data.load( std::memory_order_acquire );
+					if ( data && ( data != sealed ) )
+						privDestroyData( data );
+					delete entry;
+				}
+			}
+
+			privDeleteTable( curr );
+			curr = next;
+		}
+	}
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+
+	/** @brief add a key-data-pair to the hash
+	  *
+	  * This method adds a new element to the hash if @a key is not
+	  * present, yet. If the key already exists, nothing happens and
+	  * the ownership of @a data stays with the caller.
+	  *
+	  * If @a data is `nullptr`, a `pwx::CException` with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * @param[in] key the key of the new element
+	  * @param[in] data pointer to the data of the new element
+	  * @return the resulting number of stored elements
+	**/
+	uint32_t add( const key_t &key, data_t* data ) {
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "nullptr data",
+			           "TLockFreeHash can not store nullptr as data" )
+
+		CEpochGuard guard;
+		uint32_t    hash     = privGetHash( key );
+		entry_t*    newEntry = nullptr;
+
+		while ( true ) {
+			table_t* curr = root.load( std::memory_order_acquire );
+
+			// If a migration is running, new keys must go into the new table
+			// only after all old buckets are moved. So help finishing it.
+			if ( curr->next.load( std::memory_order_acquire ) ) {
+				privHelpMigrate( curr, true );
+				continue;
+			}
+
+			uint32_t idx     = hash & curr->mask;
+			uint32_t probes  = 0;
+			bool     restart = false;
+
+			while ( !restart && ( probes < curr->size ) ) {
+				entry_t* entry = curr->slots[idx].load( std::memory_order_acquire );
+
+				if ( moved == entry ) {
+					restart = true;
+				} else if ( nullptr == entry ) {
+					// Grow before the table gets too crowded
+					if ( ( curr->used.load( std::memory_order_relaxed ) + 1 ) > curr->maxUsed ) {
+						PWX_TRY_PWX_FURTHER( privStartMigration( curr ) )
+						restart = true;
+						continue;
+					}
+
+					if ( nullptr == newEntry ) {
+						try {
+							newEntry = new entry_t( key, hash, data );
+						}
+						PWX_THROW_STD_FURTHER( "EntryCreationFailed", "The new hash entry could not be created" )
+					}
+
+					if ( curr->slots[idx].compare_exchange_strong( entry, newEntry,
+					                                                std::memory_order_acq_rel ) ) {
+						curr->used.fetch_add( 1, std::memory_order_relaxed );
+						return eCount.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+					}
+					// Otherwise somebody else was faster, re-check the same bucket.
+				} else if ( ( entry->hash == hash ) && ( entry->key == key ) ) {
+					data_t* oldData = entry->data.load( std::memory_order_acquire );
+
+					while ( nullptr == oldData ) {
+						// The key was deleted, so it can be revived.
+						if ( entry->data.compare_exchange_weak( oldData, data,
+						                                        std::memory_order_acq_rel ) ) {
+							delete newEntry;
+							return eCount.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+						}
+					}
+
+					if ( sealed == oldData ) {
+						// The dead entry is dropped by a migration. Try again.
+						restart = true;
+						continue;
+					}
+
+					// The key exists, so nothing is to be done.
+					delete newEntry;
+					return eCount.load( std::memory_order_acquire );
+				} else {
+					idx = ( idx + 1 ) & curr->mask;
+					++probes;
+				}
+			} // End of probing
+
+			// If the whole table was probed without success, it is full.
+			if ( !restart )
+				PWX_TRY_PWX_FURTHER( privStartMigration( curr ) )
+		} // End of endless loop
+
+		return eCount.load( std::memory_order_acquire ); // never reached
+	}
+
+
+	/** @brief delete all elements
+	  *
+	  * This removes the data of all stored keys. It is safe to call
+	  * this method while other threads use the container, but keys
+	  * added concurrently might survive.
+	**/
+	void clear() noexcept {
+		CEpochGuard guard;
+		table_t*    curr = root.load( std::memory_order_acquire );
+
+		while ( curr ) {
+			for ( uint32_t i = 0 ; i < curr->size ; ++i ) {
+				entry_t* entry = curr->slots[i].load( std::memory_order_acquire );
+				if ( entry && ( entry != moved ) )
+					privRemoveData( entry );
+			}
+			curr = curr->next.load( std::memory_order_acquire );
+		}
+	}
+
+
+	/** @brief delete the element with the key @a key
+	  *
+	  * If the hash table does not contain an element with the key
+	  * @a key, nothing happens.
+	  *
+	  * The data is not destroyed at once, but retired until no
+	  * other thread can still use it.
+	  *
+	  * @param key reference to the key to search for
+	  * @return The number of elements after the operation.
+	**/
+	uint32_t delKey( const key_t &key ) noexcept {
+		CEpochGuard guard;
+		entry_t*    entry = privFind( key );
+		if ( entry )
+			privRemoveData( entry );
+		return eCount.load( std::memory_order_acquire );
+	}
+
+
+	/// @brief return true if the hash is empty
+	bool empty() const noexcept {
+		return 0 == eCount.load( std::memory_order_acquire );
+	}
+
+
+	/// @brief return true if an element with @a key exists
+	bool exists( const key_t &key ) const noexcept {
+		return nullptr != get( key );
+	}
+
+
+	/** @brief returns a pointer to the data stored with the key @a key
+	  *
+	  * The data might be removed by another thread right after this
+	  * method returns. Hold a `pwx::CEpochGuard` around the call and
+	  * the use of the data to keep it from being freed meanwhile.
+	  *
+	  * @param[in] key the key to search for
+	  * @return a pointer to the data or nullptr if the key could not be found.
+	**/
+	data_t* get( const key_t &key ) const noexcept {
+		CEpochGuard guard;
+
+		// Readers take a share of a running migration, but never wait for it.
+		table_t* curr = root.load( std::memory_order_acquire );
+		if ( curr->next.load( std::memory_order_acquire ) )
+			const_cast<hash_t*>( this )->privHelpMigrate( curr, false );
+
+		entry_t* entry = privFind( key );
+		if ( entry ) {
+			data_t* data = entry->data.load( std::memory_order_acquire );
+			return sealed == data ? nullptr : data;
+		}
+		return nullptr;
+	}
+
+
+	/** @brief returns a reference to the stored data with key @a key
+	  *
+	  * If the key can not be found, a pwx::CException with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * @param[in] key the key to search for
+	  * @return a read/write reference to the stored data.
+	**/
+	data_t &getData( const key_t &key ) const {
+		data_t* data = get( key );
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "key not found",
+			           "TLockFreeHash has no data for the given key" )
+		return *data;
+	}
+
+
+	/// @brief return the number of stored elements
+	uint32_t size() const noexcept {
+		return eCount.load( std::memory_order_acquire );
+	}
+
+
+	/// @brief return the number of buckets of the current table
+	uint32_t sizeMax() const noexcept {
+		CEpochGuard guard;
+		return root.load( std::memory_order_acquire )->size;
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal A key with its atomic data pointer. Entries move between tables.
+	struct entry_t {
+		entry_t( const key_t &key_, uint32_t hash_, data_t* data_ )
+			: key( key_ ), hash( hash_ ), data( data_ )
+		{ }
+
+		const key_t           key;
+		const uint32_t        hash;
+		std::atomic<data_t*>  data;
+	};
+
+	/// @internal One bucket array. Linked to its successor while migrating.
+	struct table_t {
+		uint32_t               size     = 0;       //!< Number of buckets, always a power of two
+		uint32_t               mask     = 0;       //!< size - 1
+		uint32_t               maxUsed  = 0;       //!< Number of used buckets that triggers a migration
+		std::atomic<entry_t*>* slots    = nullptr; //!< The buckets
+		std::atomic<table_t*>  next     { nullptr }; //!< Table to migrate to
+		aui32_t                used     { 0 };     //!< Number of buckets ever set
+		aui32_t                copyIdx  { 0 };     //!< Next bucket to claim for migration
+		aui32_t                copyDone { 0 };     //!< Number of migrated buckets
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+
+	/// @internal Create a table with at least @a minSize buckets
+	table_t* privCreateTable( uint32_t minSize ) PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t tabSize = 16;
+		while ( ( tabSize < minSize ) && ( tabSize < 0x80000000 ) )
+			tabSize <<= 1;
+
+		table_t* table = nullptr;
+		try {
+			table          = new table_t;
+			table->size    = tabSize;
+			table->mask    = tabSize - 1;
+			table->maxUsed = static_cast<uint32_t>( static_cast<double>( tabSize ) * maxLoadFactor );
+			table->slots   = new std::atomic<entry_t*>[tabSize];
+			for ( uint32_t i = 0 ; i < tabSize ; ++i )
+				table->slots[i].store( nullptr, std::memory_order_relaxed );
+		} catch ( std::exception &e ) {
+			delete table;
+			PWX_THROW( "TableCreationFailed", e.what(), "The hash table could not be created" )
+		}
+
+		return table;
+	}
+
+
+	/// @internal Delete a table, not its entries
+	static void privDeleteTable( table_t* table ) noexcept PWX_LOCAL {
+		if ( table ) {
+			delete [] table->slots;
+			delete table;
+		}
+	}
+
+
+	/// @internal Destroy data with the user defined method or delete
+	void privDestroyData( data_t* data ) noexcept PWX_LOCAL {
+		if ( destroy )
+			destroy( data );
+		else
+			delete data;
+	}
+
+
+	/// @internal Find the entry of @a key in the newest table it lives in
+	entry_t* privFind( const key_t &key ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t hash = privGetHash( key );
+		table_t* curr = root.load( std::memory_order_acquire );
+
+		while ( curr ) {
+			uint32_t idx    = hash & curr->mask;
+			uint32_t probes = 0;
+
+			while ( probes < curr->size ) {
+				entry_t* entry = curr->slots[idx].load( std::memory_order_acquire );
+
+				if ( nullptr == entry )
+					return nullptr;
+				if ( moved == entry )
+					break;
+				if ( ( entry->hash == hash ) && ( entry->key == key ) )
+					return entry;
+
+				idx = ( idx + 1 ) & curr->mask;
+				++probes;
+			}
+
+			curr = curr->next.load( std::memory_order_acquire );
+		}
+
+		return nullptr;
+	}
+
+
+	/** @internal Get the hash of @a key
+	  *
+	  * The final mix makes sure that the lower bits used for the
+	  * bucket index depend on all bits of the built hash.
+	  **/
+	uint32_t privGetHash( const key_t &key ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t hash = hashBuilder( &key, hash_user, hash_limited );
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6b;
+		hash ^= hash >> 13;
+		hash *= 0xc2b2ae35;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+
+	/** @internal Help migrating @a table into its successor
+	  *
+	  * Buckets are claimed in chunks. Without @a finish only one chunk is
+	  * migrated, otherwise this method returns when the migration is done.
+	  * Whoever sees the last bucket done replaces the root table.
+	**/
+	void privHelpMigrate( table_t* table, bool finish ) noexcept PWX_LOCAL {
+		table_t* target = table->next.load( std::memory_order_acquire );
+
+		do {
+			uint32_t start = table->copyIdx.fetch_add( migrateChunk, std::memory_order_acq_rel );
+			if ( start >= table->size )
+				break;
+
+			uint32_t end = start + migrateChunk > table->size ? table->size : start + migrateChunk;
+			for ( uint32_t i = start ; i < end ; ++i )
+				privMigrateSlot( table, target, i );
+			table->copyDone.fetch_add( end - start, std::memory_order_acq_rel );
+		} while ( finish );
+
+		while ( finish && ( table->copyDone.load( std::memory_order_acquire ) < table->size ) )
+			std::this_thread::yield();
+
+		if ( table->copyDone.load( std::memory_order_acquire ) >= table->size ) {
+			table_t* expected = table;
+			if ( root.compare_exchange_strong( expected, target, std::memory_order_acq_rel ) )
+				epoch_retire( table, privDeleteTable );
+		}
+	}
+
+
+	/// @internal Move entry @a entry into @a table. No other thread can insert the same key.
+	void privInsertEntry( table_t* table, entry_t* entry ) noexcept PWX_LOCAL {
+		uint32_t idx = entry->hash & table->mask;
+
+		while ( true ) {
+			entry_t* expected = nullptr;
+			if ( table->slots[idx].compare_exchange_strong( expected, entry, std::memory_order_acq_rel ) ) {
+				table->used.fetch_add( 1, std::memory_order_relaxed );
+				return;
+			}
+			idx = ( idx + 1 ) & table->mask;
+		}
+	}
+
+
+	/// @internal Migrate bucket @a idx of @a table into @a target
+	void privMigrateSlot( table_t* table, table_t* target, uint32_t idx ) noexcept PWX_LOCAL {
+		std::atomic<entry_t*> &slot  = table->slots[idx];
+		entry_t*               entry = slot.load( std::memory_order_acquire );
+
+		while ( moved != entry ) {
+			if ( nullptr == entry ) {
+				// Close the empty bucket, so no writer can use it any more.
+				if ( slot.compare_exchange_weak( entry, moved, std::memory_order_acq_rel ) )
+					return;
+				continue;
+			}
+
+			data_t* data = entry->data.load( std::memory_order_acquire );
+
+			// Deleted keys are sealed and dropped, unless revived meanwhile.
+			if ( ( nullptr == data )
+			  && !entry->data.compare_exchange_strong( data, sealed, std::memory_order_acq_rel ) )
+				continue;
+
+			if ( ( nullptr == data ) || ( sealed == data ) ) {
+				slot.store( moved, std::memory_order_release );
+				epoch_retire( entry );
+				return;
+			}
+
+			privInsertEntry( target, entry );
+			slot.store( moved, std::memory_order_release );
+			return;
+		}
+	}
+
+
+	/// @internal Swap out the data of @a entry and retire it, if present
+	void privRemoveData( entry_t* entry ) noexcept PWX_LOCAL {
+		data_t* data = entry->data.load( std::memory_order_acquire );
+
+		while ( data && ( sealed != data ) ) {
+			if ( entry->data.compare_exchange_weak( data, nullptr, std::memory_order_acq_rel ) ) {
+				eCount.fetch_sub( 1, std::memory_order_acq_rel );
+				epoch_retire( data, destroy );
+				return;
+			}
+		}
+	}
+
+
+	/// @internal Start a migration of @a table unless one is already running
+	void privStartMigration( table_t* table ) PWX_LOCAL {
+		if ( nullptr == table->next.load( std::memory_order_acquire ) ) {
+			// Only grow if enough keys are alive, otherwise this just drops deleted entries.
+			uint32_t alive   = eCount.load( std::memory_order_acquire );
+			uint32_t newSize = ( alive * 2 ) >= table->maxUsed ? table->size * 2 : table->size;
+			table_t* target  = nullptr;
+			PWX_TRY_PWX_FURTHER( target = privCreateTable( newSize ) )
+
+			table_t* expected = nullptr;
+			if ( !table->next.compare_exchange_strong( expected, target, std::memory_order_acq_rel ) )
+				privDeleteTable( target ); // Never visible to anybody else
+		}
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	static const uint32_t migrateChunk = 64; //!< Number of buckets claimed at once when migrating
+
+	void ( * destroy )( data_t* data ) = nullptr;
+	uint32_t ( * hash_user )( const key_t* key ) = nullptr;
+	uint32_t ( * hash_limited )( const key_t* key, uint32_t keyLen ) = nullptr;
+
+	aui32_t                  eCount   { 0 };       //!< Number of stored elements
+	THashBuilder<policy_t>   hashBuilder;          //!< instance that will handle the key generation
+	double                   maxLoadFactor;        //!< Load factor that triggers a migration
+	char                     movedChar  = 0;       //!< Storage to point the moved marker to
+	entry_t* const           moved      = reinterpret_cast<entry_t*>( &movedChar ); //!< Marks migrated buckets
+	std::atomic<table_t*>    root       { nullptr }; //!< The current table
+	char                     sealedChar = 0;       //!< Storage to point the sealed marker to
+	data_t* const            sealed     = reinterpret_cast<data_t*>( &sealedChar ); //!< Marks dropped entries
+}; // class TLockFreeHash
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_CONTAINER_TLOCKFREEHASH_H_INCLUDED
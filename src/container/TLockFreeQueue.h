@@ -0,0 +1,335 @@
+#ifndef PWX_LIBPWX_PWX_CONTAINER_TLOCKFREEQUEUE_H_INCLUDED
+#define PWX_LIBPWX_PWX_CONTAINER_TLOCKFREEQUEUE_H_INCLUDED
+#pragma once
+
+/** @file TLockFreeQueue.h
+  *
+  * @brief Declaration of a lock-free unbounded multi producer/multi consumer queue
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <atomic>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CEpochGuard.h"
+#include "basic/CException.h"
+#include "basic/types.h"
+
+
+namespace pwx {
+
+
+/** @class TLockFreeQueue PLockFreeQueue <PLockFreeQueue>
+  *
+  * @brief Lock-free unbounded FiFo queue for any number of producers and consumers
+  *
+  * This queue is meant for handing work from producer threads to consumer
+  * threads, where `pwx::TQueue` serializes all threads on its list lock.
+  * It is the linked queue of Michael and Scott: A singly linked list of
+  * nodes that always starts with a dummy node. Producers link new nodes
+  * behind the tail with a CAS, consumers swing the head forward with a CAS
+  * and the node behind the old head becomes the new dummy. Threads that
+  * find the tail lagging behind help advancing it.
+  *
+  * Unlike `pwx::TBoundedQueue` the queue never gets full, but every push
+  * allocates a node. Unlinked nodes are retired with `pwx::epoch_retire()`
+  * and freed once no operation that might still see them is running.
+  *
+  * Like in `pwx::TQueue`, the data pointers are taken over on push. Data
+  * that is popped belongs to the caller again. Data still stored when the
+  * queue is cleared or destroyed is destroyed with the destroy method
+  * given to the constructor, or deleted if there is none.
+  *
+  * **Important**: As `nullptr` means "empty" to `try_pop()`, `nullptr`
+  * can not be stored as data.
+**/
+template< typename data_t >
+class PWX_API TLockFreeQueue {
+public:
+
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TLockFreeQueue< data_t > queue_t; //!< Type of this queue
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+
+	/** @brief default constructor
+	  *
+	  * If the initial dummy node can not be allocated, a `pwx::CException`
+	  * with the name "QueueCreationFailed" is thrown.
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	**/
+	explicit TLockFreeQueue( void ( * destroy_ )( data_t* data ) )
+		  : destroy( destroy_ ) {
+		sNode* dummy = nullptr;
+		PWX_TRY( dummy = new sNode( nullptr ) )
+		PWX_THROW_STD_FURTHER( "QueueCreationFailed", "The dummy node of the queue could not be allocated" )
+		head.store( dummy, std::memory_order_relaxed );
+		tail.store( dummy, std::memory_order_relaxed );
+	}
+
+
+	/** @brief empty constructor
+	  *
+	  * The empty constructor sets the data destroy method to the null pointer.
+	**/
+	TLockFreeQueue()
+		  : TLockFreeQueue( nullptr )
+	{ }
+
+
+	TLockFreeQueue( queue_t const& ) PWX_DELETE;
+	TLockFreeQueue( queue_t const&& ) PWX_DELETE;
+	queue_t& operator=( queue_t const& ) PWX_DELETE;
+	queue_t& operator=( queue_t const&& ) PWX_DELETE;
+
+
+	/** @brief default destructor
+	  *
+	  * The destructor must not be called while other threads still
+	  * use the queue. It destroys all remaining data and nodes.
+	  * Nodes that are already retired are freed independently.
+	**/
+	virtual ~TLockFreeQueue() noexcept {
+		// The data of the dummy node has already been popped
+		sNode* curr = head.load( std::memory_order_acquire );
+		sNode* next = curr->next.load( std::memory_order_acquire );
+		delete curr;
+
+		while ( next ) {
+			curr = next;
+			next = curr->next.load( std::memory_order_acquire );
+			privDestroyData( curr->data );
+			delete curr;
+		}
+	}
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+
+	/** @brief pop and destroy all data
+	  *
+	  * This is safe to call while other threads use the queue, but
+	  * data pushed concurrently might or might not be destroyed.
+	**/
+	void clear() noexcept {
+		data_t* data = try_pop();
+		while ( data ) {
+			privDestroyData( data );
+			data = try_pop();
+		}
+	}
+
+
+	/// @return true if the queue holds no data
+	bool empty() const noexcept {
+		return 0 == size();
+	}
+
+
+	/** @brief pop the first data pointer from the queue
+	  *
+	  * The data is removed from the queue so you have to take
+	  * care of its deletion once you are finished with it.
+	  *
+	  * If there is no data in the queue a pwx::CException with the
+	  * name "OutOfRange" is thrown.
+	  *
+	  * @return the first data pointer in the queue.
+	**/
+	data_t* pop() {
+		data_t* data = try_pop();
+		if ( nullptr == data )
+			PWX_THROW( "OutOfRange", "Queue is empty", "pop() called on an empty TLockFreeQueue" )
+		return data;
+	}
+
+
+	/** @brief push a data pointer to the end of the queue
+	  *
+	  * If @a data is `nullptr`, a `pwx::CException` with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * If the new node can not be created, a pwx::CException with
+	  * the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] data data pointer to store.
+	  * @return number of data pointers stored after the operation.
+	**/
+	uint32_t push( data_t* data ) {
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "nullptr data",
+			           "TLockFreeQueue can not store nullptr as data" )
+
+		sNode* node = nullptr;
+		PWX_TRY( node = new sNode( data ) )
+		PWX_THROW_STD_FURTHER( "ElementCreationFailed", "The queue node could not be created" )
+
+		// Count first, so a concurrent pop can never bring the counter below zero
+		eCount.fetch_add( 1, std::memory_order_acq_rel );
+
+		CEpochGuard guard;
+		while ( true ) {
+			sNode* last = tail.load( std::memory_order_acquire );
+			sNode* next = last->next.load( std::memory_order_acquire );
+
+			if ( last != tail.load( std::memory_order_acquire ) )
+				continue;
+
+			if ( nullptr == next ) {
+				if ( last->next.compare_exchange_weak( next, node, std::memory_order_acq_rel ) ) {
+					tail.compare_exchange_strong( last, node, std::memory_order_acq_rel );
+					break;
+				}
+			} else
+				// The tail is lagging behind, help advancing it
+				tail.compare_exchange_weak( last, next, std::memory_order_acq_rel );
+		}
+
+		return size();
+	}
+
+
+	/** @brief return the number of stored data pointers
+	  *
+	  * While other threads push and pop, this is only a snapshot.
+	**/
+	uint32_t size() const noexcept {
+		return eCount.load( std::memory_order_acquire );
+	}
+
+
+	/** @brief pop the first data pointer, if any
+	  *
+	  * The data is removed from the queue so you have to take
+	  * care of its deletion once you are finished with it.
+	  *
+	  * @return the first data pointer in the queue or `nullptr` if it is empty.
+	**/
+	data_t* try_pop() noexcept {
+		CEpochGuard guard;
+
+		while ( true ) {
+			sNode* first = head.load( std::memory_order_acquire );
+			sNode* last  = tail.load( std::memory_order_acquire );
+			sNode* next  = first->next.load( std::memory_order_acquire );
+
+			if ( first != head.load( std::memory_order_acquire ) )
+				continue;
+
+			if ( nullptr == next )
+				return nullptr;
+
+			if ( first == last ) {
+				// The tail is lagging behind, help advancing it
+				tail.compare_exchange_weak( last, next, std::memory_order_acq_rel );
+				continue;
+			}
+
+			// Read before the CAS, next might be retired right after it
+			data_t* data = next->data;
+			if ( head.compare_exchange_weak( first, next, std::memory_order_acq_rel ) ) {
+				eCount.fetch_sub( 1, std::memory_order_acq_rel );
+				epoch_retire( first );
+				return data;
+			}
+		}
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal One node of the list. The head node is the dummy.
+	struct sNode {
+		explicit sNode( data_t* data_ ) noexcept
+			: data( data_ )
+		{ }
+
+		data_t*             data;
+		std::atomic<sNode*> next { nullptr };
+	};
+
+	/// @internal Cache line padded node pointer
+	struct alignas( 64 ) sEnd : public std::atomic<sNode*> {
+		sEnd() noexcept : std::atomic<sNode*>( nullptr ) { }
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	/// @internal Destroy @a data with the destroy method or delete
+	void privDestroyData( data_t* data ) noexcept PWX_LOCAL {
+		if ( destroy )
+			destroy( data );
+		else
+			delete data;
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	void ( * destroy )( data_t* data ) = nullptr;
+
+	aui32_t eCount { 0 }; //!< Number of stored data pointers
+	sEnd    head;         //!< The dummy node, pops start here
+	sEnd    tail;         //!< The last node, pushes start here
+}; // class TLockFreeQueue
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_CONTAINER_TLOCKFREEQUEUE_H_INCLUDED
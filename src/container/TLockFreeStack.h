@@ -0,0 +1,355 @@
+#ifndef PWX_LIBPWX_PWX_CONTAINER_TLOCKFREESTACK_H_INCLUDED
+#define PWX_LIBPWX_PWX_CONTAINER_TLOCKFREESTACK_H_INCLUDED
+#pragma once
+
+/** @file TLockFreeStack.h
+  *
+  * @brief Declaration of a lock-free stack after Treiber
+  *
+  * (c) 2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <atomic>
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CEpochGuard.h"
+#include "basic/CException.h"
+#include "basic/types.h"
+
+
+namespace pwx {
+
+
+/** @class TLockFreeStack PLockFreeStack <PLockFreeStack>
+  *
+  * @brief Lock-free LiFo stack for any number of threads
+  *
+  * This stack is meant for free-lists, undo logs and similar hot paths,
+  * where `pwx::TStack` serializes all threads on its list lock. It is the
+  * stack of Treiber: A singly linked list of nodes of which only the top
+  * is ever touched. push() links a new node in front of the top with a
+  * CAS, pop() swings the top to the next node with a CAS.
+  *
+  * Popped nodes are retired with `pwx::epoch_retire()` and only freed when
+  * no operation that might still see them is running. This is also what
+  * protects the stack against the ABA problem: As long as a thread might
+  * still hold a popped node as its expected top, the node is not freed and
+  * can not come back with the same address.
+  *
+  * Only the top of the stack can be reached without locking. Therefore
+  * `shift()` and `unshift()` of `pwx::TStack`, which work on the bottom,
+  * are not offered. Instead `pop_all()` takes everything at once, which
+  * is what undo logs usually need.
+  *
+  * Like in `pwx::TStack`, the data pointers are taken over on push. Data
+  * that is popped belongs to the caller again. Data still stored when the
+  * stack is cleared or destroyed is destroyed with the destroy method
+  * given to the constructor, or deleted if there is none.
+  *
+  * **Important**: As `nullptr` means "empty" to `try_pop()`, `nullptr`
+  * can not be stored as data.
+**/
+template< typename data_t >
+class PWX_API TLockFreeStack {
+public:
+
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef TLockFreeStack< data_t > stack_t; //!< Type of this stack
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+
+	/** @brief default constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	**/
+	explicit TLockFreeStack( void ( * destroy_ )( data_t* data ) ) noexcept
+		  : destroy( destroy_ )
+	{ }
+
+
+	/** @brief empty constructor
+	  *
+	  * The empty constructor sets the data destroy method to the null pointer.
+	**/
+	TLockFreeStack() noexcept
+		  : TLockFreeStack( nullptr )
+	{ }
+
+
+	TLockFreeStack( stack_t const& ) PWX_DELETE;
+	TLockFreeStack( stack_t const&& ) PWX_DELETE;
+	stack_t& operator=( stack_t const& ) PWX_DELETE;
+	stack_t& operator=( stack_t const&& ) PWX_DELETE;
+
+
+	/** @brief default destructor
+	  *
+	  * The destructor must not be called while other threads still
+	  * use the stack. It destroys all remaining data and nodes.
+	  * Nodes that are already retired are freed independently.
+	**/
+	virtual ~TLockFreeStack() noexcept {
+		sNode* curr = top.exchange( nullptr, std::memory_order_acq_rel );
+		while ( curr ) {
+			sNode* next = curr->next;
+			privDestroyData( curr->data );
+			delete curr;
+			curr = next;
+		}
+	}
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+
+	/** @brief pop and destroy all data
+	  *
+	  * This is safe to call while other threads use the stack, but
+	  * data pushed concurrently might or might not be destroyed.
+	**/
+	void clear() noexcept {
+		data_t* data = try_pop();
+		while ( data ) {
+			privDestroyData( data );
+			data = try_pop();
+		}
+	}
+
+
+	/// @return true if the stack holds no data
+	bool empty() const noexcept {
+		return nullptr == top.load( std::memory_order_acquire );
+	}
+
+
+	/** @brief pop the top data pointer from the stack
+	  *
+	  * The data is removed from the stack so you have to take
+	  * care of its deletion once you are finished with it.
+	  *
+	  * If there is no data on the stack a pwx::CException with the
+	  * name "OutOfRange" is thrown.
+	  *
+	  * @return the top data pointer on the stack.
+	**/
+	data_t* pop() {
+		data_t* data = try_pop();
+		if ( nullptr == data )
+			PWX_THROW( "OutOfRange", "Stack is empty", "pop() called on an empty TLockFreeStack" )
+		return data;
+	}
+
+
+	/** @brief pop all data pointers at once
+	  *
+	  * The whole stack is taken in one atomic step, so no data pushed
+	  * concurrently can end up in the middle of the result. @a func is
+	  * called for each data pointer, from the top to the bottom, and is
+	  * responsible for it afterwards.
+	  *
+	  * If @a func throws, all data pointers that were not handed to it
+	  * yet are destroyed like clear() does, and the exception is passed
+	  * on.
+	  *
+	  * @param[in] func callable that takes a `data_t*`.
+	  * @return the number of data pointers handed to @a func.
+	**/
+	template< typename func_t >
+	uint32_t pop_all( func_t func ) {
+		sNode*   curr  = top.exchange( nullptr, std::memory_order_acq_rel );
+		uint32_t count = 0;
+
+		if ( nullptr == curr )
+			return 0;
+
+		// Nobody can reach the taken nodes any more, but a concurrent
+		// pop() might still hold the old top, so all are retired.
+		for ( sNode* node = curr ; node ; node = node->next )
+			++count;
+		eCount.fetch_sub( count, std::memory_order_acq_rel );
+
+		while ( curr ) {
+			sNode*  next = curr->next;
+			data_t* data = curr->data;
+			epoch_retire( curr );
+			curr = next;
+
+			try {
+				func( data );
+			} catch ( ... ) {
+				// Nobody else can reach the rest, so it is dropped here
+				while ( curr ) {
+					next = curr->next;
+					privDestroyData( curr->data );
+					epoch_retire( curr );
+					curr = next;
+				}
+				throw;
+			}
+		}
+
+		return count;
+	}
+
+
+	/** @brief push a data pointer onto the stack
+	  *
+	  * If @a data is `nullptr`, a `pwx::CException` with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * If the new node can not be created, a pwx::CException with
+	  * the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] data data pointer to store.
+	  * @return number of data pointers stored after the operation.
+	**/
+	uint32_t push( data_t* data ) {
+		if ( nullptr == data )
+			PWX_THROW( "NullDataException", "nullptr data",
+			           "TLockFreeStack can not store nullptr as data" )
+
+		sNode* node = nullptr;
+		PWX_TRY( node = new sNode( data ) )
+		PWX_THROW_STD_FURTHER( "ElementCreationFailed", "The stack node could not be created" )
+
+		// Count first, so a concurrent pop can never bring the counter below zero
+		eCount.fetch_add( 1, std::memory_order_acq_rel );
+
+		// A push never dereferences the top, so it needs no epoch guard
+		node->next = top.load( std::memory_order_relaxed );
+		while ( !top.compare_exchange_weak( node->next, node, std::memory_order_release,
+		                                    std::memory_order_relaxed ) ) { }
+
+		return size();
+	}
+
+
+	/** @brief return the number of stored data pointers
+	  *
+	  * While other threads push and pop, this is only a snapshot.
+	**/
+	uint32_t size() const noexcept {
+		return eCount.load( std::memory_order_acquire );
+	}
+
+
+	/** @brief pop the top data pointer, if any
+	  *
+	  * The data is removed from the stack so you have to take
+	  * care of its deletion once you are finished with it.
+	  *
+	  * @return the top data pointer on the stack or `nullptr` if it is empty.
+	**/
+	data_t* try_pop() noexcept {
+		CEpochGuard guard;
+		sNode*      first = top.load( std::memory_order_acquire );
+
+		// first can not be freed while this guard exists,
+		// so reading first->next is safe even if the CAS fails.
+		while ( first && !top.compare_exchange_weak( first, first->next, std::memory_order_acq_rel,
+		                                             std::memory_order_acquire ) ) { }
+
+		if ( nullptr == first )
+			return nullptr;
+
+		data_t* data = first->data;
+		eCount.fetch_sub( 1, std::memory_order_acq_rel );
+		epoch_retire( first );
+
+		return data;
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal One node of the stack
+	struct sNode {
+		explicit sNode( data_t* data_ ) noexcept
+			: data( data_ )
+		{ }
+
+		data_t* data;
+		sNode*  next = nullptr; //!< Written before the node is published only
+	};
+
+	/// @internal Cache line padded node pointer
+	struct alignas( 64 ) sTop : public std::atomic<sNode*> {
+		sTop() noexcept : std::atomic<sNode*>( nullptr ) { }
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	/// @internal Destroy @a data with the destroy method or delete
+	void privDestroyData( data_t* data ) noexcept PWX_LOCAL {
+		if ( destroy )
+			destroy( data );
+		else
+			delete data;
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	void ( * destroy )( data_t* data ) = nullptr;
+
+	aui32_t eCount { 0 }; //!< Number of stored data pointers
+	sTop    top;          //!< The top node, everything starts here
+}; // class TLockFreeStack
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_CONTAINER_TLOCKFREESTACK_H_INCLUDED
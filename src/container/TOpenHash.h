@@ -46,6 +46,20 @@
 namespace pwx {
 
 
+/** @brief enum determining how an open hash table calculates and probes its indexes
+  *
+  * The double hashing mode works with any table size, but needs floating
+  * point math and a division per probe. The power-of-two modes round the
+  * table size up to the next power of two, map the hash with an integer
+  * multiply-shift and probe with additions and a bit mask only.
+**/
+enum eOpenHashMode {
+	OHM_DoubleHash = 1, //!< Any table size, multiplication method and double hashing (default)
+	OHM_PowerLinear,    //!< Power-of-two table size, multiply-shift and linear probing
+	OHM_PowerQuadratic  //!< Power-of-two table size, multiply-shift and quadratic (triangular) probing
+};
+
+
 /** @class TOpenHash POpenHash <POpenHash>
   *
   * @brief Open hash container for variable types
@@ -74,17 +88,25 @@ namespace pwx {
   * The hash algorithms used within the PrydeWorX library already offer a very high
   * level of distribution. For keys not handled by these, or if you think you have
   * a better hash algorithm, you can set your own hash function with the constructor.
+  *
+  * The constructors taking an initial size can be given an eOpenHashMode. With
+  * OHM_PowerLinear or OHM_PowerQuadratic the table size is always a power of two,
+  * and index calculation and probing are done without floating point math and
+  * divisions. This is faster, but relies more on the quality of the hash function.
+  *
+  * The hash policy @a policy_t decides how keys are turned into hashes,
+  * see THashBuilder. It defaults to CHashPolicyRNG.
 **/
-template< typename key_t, typename data_t, typename elem_t = THashElement< key_t, data_t > >
-class PWX_API TOpenHash : public VTHashBase< key_t, data_t, elem_t > {
+template< typename key_t, typename data_t, typename elem_t = THashElement< key_t, data_t >, typename policy_t = CHashPolicyRNG >
+class PWX_API TOpenHash : public VTHashBase< key_t, data_t, elem_t, policy_t > {
 public:
 	/* ===============================================
 	 * === Public types                            ===
 	 * ===============================================
 	*/
 
-	typedef VTHashBase< key_t, data_t, elem_t > base_t;     //!< Base type of the hash
-	typedef TOpenHash< key_t, data_t, elem_t >  hash_t;     //!< Type of this hash
+	typedef VTHashBase< key_t, data_t, elem_t, policy_t > base_t; //!< Base type of the hash
+	typedef TOpenHash< key_t, data_t, elem_t, policy_t >  hash_t; //!< Type of this hash
 
 
 	/* ===============================================
@@ -113,10 +135,13 @@ public:
 	  * @param[in] keyLen_ Length of the key to limit hash generation.
 	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
 	  * @param[in] dynGrow_ growth rate applied when the maximum load factor is reached.
+	  * @param[in] mode_ index calculation and probing mode. (Default: OHM_DoubleHash)
 	**/
 	TOpenHash( uint32_t initSize, uint32_t keyLen_,
-	           double maxLoad_, double dynGrow_ ) noexcept:
-		  base_t( initSize, keyLen_, maxLoad_, dynGrow_ ) {}
+	           double maxLoad_, double dynGrow_,
+	           eOpenHashMode mode_ = OHM_DoubleHash ) noexcept:
+		  base_t( privGetModeSize( initSize, mode_ ), keyLen_, maxLoad_, dynGrow_ )
+		  , hashMode( mode_ ) {}
 
 
 	/** @brief full constructor with key length
@@ -135,13 +160,16 @@ public:
 	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
 	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
 	  * @param[in] dynGrow_ growth rate applied when the maximum load factor is reached.
+	  * @param[in] mode_ index calculation and probing mode. (Default: OHM_DoubleHash)
 	**/
 	TOpenHash( uint32_t initSize,
 	           void ( * destroy_ )( data_t* data ),
 	           uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
 	           uint32_t keyLen_,
-	           double maxLoad_, double dynGrow_ ) noexcept:
-		  base_t( initSize, destroy_, hash_, keyLen_, maxLoad_, dynGrow_ ) {}
+	           double maxLoad_, double dynGrow_,
+	           eOpenHashMode mode_ = OHM_DoubleHash ) noexcept:
+		  base_t( privGetModeSize( initSize, mode_ ), destroy_, hash_, keyLen_, maxLoad_, dynGrow_ )
+		  , hashMode( mode_ ) {}
 
 
 	/** @brief full constructor without key length
@@ -160,12 +188,49 @@ public:
 	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
 	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
 	  * @param[in] dynGrow_ growth rate applied when the maximum load factor is reached.
+	  * @param[in] mode_ index calculation and probing mode. (Default: OHM_DoubleHash)
 	**/
 	TOpenHash( uint32_t initSize,
 	           void ( * destroy_ )( data_t* data ),
 	           uint32_t ( * hash_ )( const key_t* key ),
-	           double maxLoad_, double dynGrow_ ) :
-		  base_t( initSize, destroy_, hash_, maxLoad_, dynGrow_ ) {}
+	           double maxLoad_, double dynGrow_,
+	           eOpenHashMode mode_ = OHM_DoubleHash ) :
+		  base_t( privGetModeSize( initSize, mode_ ), destroy_, hash_, maxLoad_, dynGrow_ )
+		  , hashMode( mode_ ) {}
+
+
+	/** @brief bulk constructor
+	  *
+	  * Builds the hash from all key/data pairs in [@a first, @a last).
+	  * The table is sized once to hold all pairs with the load factor
+	  * @a maxLoad_, and the pairs are inserted without locking. Large
+	  * ranges are split across threads by bucket range.
+	  *
+	  * The iterators must be forward iterators to `std::pair<key_t, data_t*>`,
+	  * a plain array of pairs works, too. Like with add(), pairs with a key
+	  * that was already inserted are ignored and their data stays with the
+	  * caller.
+	  *
+	  * If the building fails, a pwx::CException is thrown.
+	  *
+	  * @param[in] first iterator to the first pair
+	  * @param[in] last iterator behind the last pair
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	  * @param[in] maxLoad_ maximum load factor that triggers automatic growth.
+	  * @param[in] dynGrow_ growth rate applied when the maximum load factor is reached.
+	  * @param[in] mode_ index calculation and probing mode. (Default: OHM_DoubleHash)
+	**/
+	template< typename iter_t, typename = typename base_t::template bulk_iter_t< iter_t > >
+	TOpenHash( iter_t first, iter_t last,
+	           void ( * destroy_ )( data_t* data ),
+	           uint32_t ( * hash_ )( const key_t* key ),
+	           double maxLoad_, double dynGrow_,
+	           eOpenHashMode mode_ = OHM_DoubleHash ) :
+		  base_t( privGetModeSize( base_t::protBulkSize( first, last, maxLoad_ ), mode_ ), destroy_, hash_, maxLoad_, dynGrow_ )
+		  , hashMode( mode_ ) {
+		PWX_TRY_PWX_FURTHER( this->protBulkLoad( first, last ) )
+	}
 
 
 	/** @brief limiting user method constructor
@@ -237,11 +302,28 @@ public:
 	  * @param[in] src reference of the hash to copy.
 	**/
 	TOpenHash( const hash_t &src ) :
-		  base_t( src ) {
+		  base_t( src )
+		  , hashMode( src.hashMode ) {
 		operator+=( src );
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time.
+	  * @a src keeps its settings and gets a new, empty table.
+	  *
+	  * If that table can not be created, a pwx::CException with
+	  * the name "VTHashBase failure" is thrown.
+	  *
+	  * @param[in] src rvalue reference of the hash to move.
+	**/
+	TOpenHash( hash_t &&src ) :
+		  base_t( std::move( src ), privGetModeSize( 100, src.hashMode ) )
+		  , hashMode( src.hashMode )
+	{ }
+
+
 	virtual ~TOpenHash() noexcept;
 
 
@@ -252,14 +334,41 @@ public:
 
 	using base_t::add;
 	using base_t::clear;
+	using base_t::disable_incremental_grow;
 	using base_t::disable_thread_safety;
 	using base_t::empty;
 	using base_t::exists;
+	using base_t::exists_many;
+	using base_t::enable_incremental_grow;
 	using base_t::enable_thread_safety;
 	using base_t::get;
+	using base_t::get_many;
 	using base_t::getData;
+	using base_t::getHash;
 	using base_t::getHops;
-	using base_t::grow;
+
+
+	/** @brief return the index calculation and probing mode of this hash
+	  * @return the eOpenHashMode set with the constructor
+	**/
+	eOpenHashMode getMode() const noexcept {
+		return hashMode;
+	}
+
+
+	/** @brief grow the size of a hash table
+	  *
+	  * In the power-of-two modes @a targetSize is rounded up to
+	  * the next power of two. See VTHashBase::grow() for details.
+	  *
+	  * @param[in] targetSize the new size of the hash.
+	  * @return the resulting size
+	**/
+	virtual uint32_t grow( uint32_t targetSize ) {
+		return base_t::grow( privGetModeSize( targetSize, hashMode ) );
+	}
+
+
 	using base_t::pop;
 	using base_t::pop_back;
 	using base_t::pop_front;
@@ -277,6 +386,49 @@ public:
 	 * ===============================================
 	*/
 
+	/** @brief assignment operator
+	  *
+	  * Clears this hash and copies all elements from @a rhs into it.
+	  *
+	  * @param[in] rhs reference of the hash to copy.
+	  * @return reference to this.
+	**/
+	hash_t &operator=( const hash_t &rhs ) {
+		PWX_TRY_PWX_FURTHER( base_t::operator=( rhs ) )
+		return *this;
+	}
+
+
+	/** @brief move assignment operator
+	  *
+	  * Clears this hash and takes over all elements of @a rhs. If
+	  * both use the same open hash mode, this takes constant time and
+	  * @a rhs gets the empty table of this hash. Otherwise the table
+	  * layouts differ, and the elements are copied before @a rhs is
+	  * cleared.
+	  *
+	  * If a new element can not be created, a pwx::CException with
+	  * the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] rhs rvalue reference of the hash to move.
+	  * @return reference to this.
+	**/
+	hash_t &operator=( hash_t &&rhs ) {
+		if ( &rhs != this ) {
+			if ( hashMode != rhs.hashMode ) {
+				PWX_TRY_PWX_FURTHER( base_t::operator=( rhs ) )
+				rhs.clear();
+			} else {
+				PWX_DOUBLE_LOCK_GUARD( this, &rhs );
+				clear();
+				this->beThreadSafe( rhs.beThreadSafe() );
+				protMoveFrom( rhs );
+			}
+		}
+		return *this;
+	}
+
+
 	using base_t::operator=;
 	using base_t::operator+=;
 	using base_t::operator-=;
@@ -299,6 +451,7 @@ protected:
 	 */
 
 	using base_t::protGetHash;
+	using base_t::protGetMultIndex;
 
 
 	/** @brief use hashBuilder to generate a secondary hash out of primary hash
@@ -313,6 +466,7 @@ protected:
 	using base_t::protIsEmpty;
 	using base_t::protIsUnused;
 	using base_t::protIsVacated;
+	using base_t::protMoveFrom;
 	using base_t::table_key_equals;
 	using base_t::table_get;
 	using base_t::table_set;
@@ -375,14 +529,9 @@ private:
 	**/
 	virtual uint32_t privGetIndex( const key_t &key, bool allowVacated, uint32_t* hops ) const noexcept {
 		uint32_t priHash = this->protGetHash( &key );
-
-		// Use multiplication method for the base index
 		uint32_t tabSize = this->hashSize.load( memOrdLoad );
-		double   dHash   = static_cast<double>( priHash ) * 0.618;
-		uint32_t idxBase = static_cast<uint32_t>( std::floor( ( dHash - std::floor( dHash ) ) * tabSize ) );
-
-		// Use the current hashing method for the stepping (secondary hash)
-		uint32_t idxStep = this->privGetStepping( priHash );
+		uint32_t idxBase = this->privGetBaseIndex( priHash, tabSize, CHMethod );
+		uint32_t idxStep = this->privGetStepping( priHash, tabSize, CHMethod );
 
 		// Now probe the table until we are done or have found the key
 		bool           isFound     = false;
@@ -408,23 +557,8 @@ private:
 				  ) ) {
 				isFound = true;
 			} else {
-				pos = ( pos + idxStep ) % tabSize;
+				pos = this->protGetNextProbe( pos, idxBase, &idxStep, tabSize, i + 1 );
 				if ( hops ) ++( *hops );
-
-				// check whether the stepping goes round
-				if ( ( ( i + 1 ) < tabSize ) && ( pos == idxBase ) ) {
-					// This means the idx stepping is screwed
-					log_debug_error( "open hash",
-					                 "Unfull probing at hop %s: pos %u == base %u, step %u in size %u",
-					                 hops ? pwx::to_string( *hops ).c_str() : "n/a",
-					                 pos, idxBase, idxStep, tabSize );
-					idxStep += idxStep % 2 ? 2 : 3;
-					// Be sure idxStep does not end up being tabSize or we'll be here again next round.
-					if ( idxStep >= tabSize ) {
-						idxStep = 3;
-					}
-					pos = ( pos + idxStep ) % tabSize;
-				}
 			}
 		} // end of traversing the table
 
@@ -468,18 +602,67 @@ private:
 	}
 
 
+	/** @brief the base index uses the multiplication method
+	  *
+	  * The hash is spread with the golden ratio (Fibonacci hashing) and the
+	  * upper half of the product with @a tabSize is the index (Lemire's
+	  * reduction). On a power-of-two size this equals taking the upper
+	  * log2(tabSize) bits of the spread hash.
+	**/
+	virtual uint32_t privGetBaseIndex( uint32_t primary_hash, uint32_t tabSize, eChainHashMethod ) const noexcept {
+		return protGetMultIndex( primary_hash, tabSize );
+	}
+
+
+	/// @brief return the size the table must have in mode @a mode to hold at least @a minSize buckets
+	static uint32_t privGetModeSize( uint32_t minSize, eOpenHashMode mode ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+		if ( OHM_DoubleHash == mode ) {
+			return minSize;
+		}
+
+		uint32_t result = 2;
+		while ( ( result < minSize ) && ( result < 0x80000000U ) ) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+
+	/** @brief get the next position to probe
+	  *
+	  * Double hashing steps by a fixed secondary hash, linear probing by one.
+	  * Quadratic probing increases the stepping by one on each hop, so the
+	  * offsets are the triangular numbers, which visit every bucket of a
+	  * power-of-two table exactly once.
+	**/
+	virtual uint32_t privGetNextProbe( uint32_t pos, uint32_t* step, uint32_t tabSize ) const noexcept {
+		if ( OHM_DoubleHash == hashMode ) {
+			return ( pos + *step ) % tabSize;
+		}
+
+		uint32_t next = ( pos + *step ) & ( tabSize - 1 );
+		if ( OHM_PowerQuadratic == hashMode ) {
+			++( *step );
+		}
+		return next;
+	}
+
+
 	/// @brief small method to get the second hash stepping calculation out of privGetIndex()
-	virtual uint32_t privGetStepping( uint32_t primary_hash ) const noexcept {
+	virtual uint32_t privGetStepping( uint32_t primary_hash, uint32_t tabSize, eChainHashMethod method ) const noexcept {
+		// The power-of-two modes start with a stepping of one
+		if ( OHM_DoubleHash != hashMode ) {
+			return 1;
+		}
+
 		uint32_t stepping = 0;
 		uint32_t secHash  = this->protGetSecHash( &primary_hash );
-		uint32_t tabSize  = hashSize.load( memOrdLoad );
 		uint32_t secSize  = tabSize - ( tabSize % 2 ? 2 : 1 );
 
-		if ( CHM_Division == CHMethod ) {
+		if ( CHM_Division == method ) {
 			stepping = secHash % secSize;
 		} else {
-			double dHash = static_cast<double>( secHash ) * 0.618;
-			stepping = static_cast<uint32_t>( std::floor( ( dHash - std::floor( dHash ) ) * secSize ) );
+			stepping = protGetMultIndex( secHash, secSize );
 		}
 
 		// Be sure stepping is sane:
@@ -635,6 +818,14 @@ private:
 	virtual elem_t* privRemoveKey( const key_t &key ) noexcept {
 		return privRemoveIdx( privGetIndex( key ) );
 	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	eOpenHashMode const hashMode = OHM_DoubleHash; //!< How indexes are calculated and probed
 }; // class TOpenHash
 
 /** @brief default destructor
@@ -642,8 +833,8 @@ private:
   * This destructor will delete all elements currently stored. There is no
   * need to clean up manually before deleting the hash.
 **/
-template< typename key_t, typename data_t, typename elem_t >
-TOpenHash< key_t, data_t, elem_t >::~TOpenHash() noexcept { /* all done in base_t dtor */ }
+template< typename key_t, typename data_t, typename elem_t, typename policy_t >
+TOpenHash< key_t, data_t, elem_t, policy_t >::~TOpenHash() noexcept { /* all done in base_t dtor */ }
 
 
 /** @brief addition operator
@@ -58,23 +58,27 @@ namespace pwx {
   * to destroy the data when the element is deleted. If no such function was set,
   * the standard delete operator is used instead.
   *
+  * The optional second template parameter is the element type. Use
+  * `pwx::TDoubleElement<data_t, pwx::CAllocPolicyPool>` to have the memory of
+  * popped elements recycled instead of returned to the heap.
+  *
   * It is recommended that you use the much more advanced `std::queue` or `std::deque`
   * unless you need to store a very large number of elements and can not live with
   * the downside of every element having to be copied into the std container.
   *
   * @see `pwx::TDoubleList` for further information.
 **/
-template<typename data_t>
-class PWX_API TQueue : public TDoubleList<data_t> {
+template<typename data_t, typename element_t = TDoubleElement<data_t> >
+class PWX_API TQueue : public TDoubleList<data_t, element_t> {
 public:
 	/* ===============================================
 	 * === Public types                            ===
 	 * ===============================================
 	*/
 
-	typedef TDoubleElement<data_t>      elem_t; //!< Type of the stored elements
+	typedef element_t                   elem_t; //!< Type of the stored elements
 	typedef TDoubleList<data_t, elem_t> base_t; //!< Base type of the queue
-	typedef TQueue<data_t>              list_t; //!< Type of this queue
+	typedef TQueue<data_t, elem_t>      list_t; //!< Type of this queue
 
 
 	/* ===============================================
@@ -88,7 +92,7 @@ public:
 	  *
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
-	TQueue ( void ( *destroy_ ) ( data_t* data ) ) noexcept :
+	TQueue ( void ( *destroy_ ) ( data_t* data ) ) :
 		base_t( destroy_ )
 	{ }
 
@@ -97,7 +101,7 @@ public:
 	  *
 	  * The empty constructor sets the data destroy method to the null pointer.
 	**/
-	TQueue() noexcept :
+	TQueue() :
 		base_t ( nullptr )
 	{ }
 
@@ -108,12 +112,24 @@ public:
 	  *
 	  * @param[in] src reference of the list to copy.
 	**/
-	TQueue ( const list_t& src ) noexcept :
+	TQueue ( const list_t& src ) :
 		base_t ( src ) {
 		// The copy ctor of base_t has already copied all elements.
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time,
+	  * @a src is left empty.
+	  *
+	  * @param[in] src rvalue reference of the queue to move.
+	**/
+	TQueue ( list_t&& src ) noexcept :
+		base_t ( std::move( src ) )
+	{ }
+
+
 	virtual ~TQueue() noexcept;
 
 
@@ -129,16 +145,20 @@ public:
 	using base_t::delNextElem;
 	using base_t::delPrev;
 	using base_t::delPrevElem;
+	using base_t::disable_indexing;
 	using base_t::disable_thread_safety;
 	using base_t::empty;
+	using base_t::enable_indexing;
 	using base_t::enable_thread_safety;
 	using base_t::find;
 	using base_t::get;
 	using base_t::getData;
+	using base_t::insAt;
 	using base_t::insNext;
 	using base_t::insNextElem;
 	using base_t::insPrev;
 	using base_t::insPrevElem;
+	using base_t::is_indexed;
 
 
 	/** @brief pop the first element from the queue
@@ -220,6 +240,33 @@ public:
 	 * ===============================================
 	*/
 
+	/** @brief assignment operator
+	  *
+	  * Clears this queue and copies all elements from @a rhs into it.
+	  *
+	  * @param[in] rhs reference of the queue to copy.
+	  * @return reference to this.
+	**/
+	list_t& operator= ( list_t const& rhs ) {
+		PWX_TRY_PWX_FURTHER ( base_t::operator= ( rhs ) )
+		return *this;
+	}
+
+
+	/** @brief move assignment operator
+	  *
+	  * Clears this queue and takes over all elements
+	  * of @a rhs, which is left empty.
+	  *
+	  * @param[in] rhs rvalue reference of the queue to move.
+	  * @return reference to this.
+	**/
+	list_t& operator= ( list_t&& rhs ) noexcept {
+		base_t::operator= ( std::move( rhs ) );
+		return *this;
+	}
+
+
 	using base_t::operator=;
 	using base_t::operator+=;
 	using base_t::operator-=;
@@ -240,8 +287,8 @@ protected:
   * This destructor will delete all elements currently stored. There is no
   * need to clean up manually before deleting the queue.
 **/
-template<typename data_t>
-TQueue<data_t>::~TQueue() noexcept
+template<typename data_t, typename element_t>
+TQueue<data_t, element_t>::~TQueue() noexcept
 { /* done in base_t dtor */ }
 
 
@@ -138,7 +138,7 @@ public:
 	  *
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
-	TSet ( void ( *destroy_ ) ( data_t* data ) ) noexcept :
+	TSet ( void ( *destroy_ ) ( data_t* data ) ) :
 		base_t( destroy_ ),
 		lookup( list_t::do_not_destroy )
 	{ }
@@ -148,7 +148,7 @@ public:
 	  *
 	  * The empty constructor sets the data destroy method to the null pointer.
 	**/
-	TSet() noexcept :
+	TSet() :
 		base_t ( nullptr ),
 		lookup( list_t::do_not_destroy )
 	{ }
@@ -160,7 +160,7 @@ public:
 	  *
 	  * @param[in] src reference of the list to copy.
 	**/
-	TSet ( const list_t& src ) noexcept :
+	TSet ( const list_t& src ) :
 		base_t ( src ),
 		lookup( list_t::do_not_destroy ) {
 		// The copy ctor of base_t has already copied all elements.
@@ -178,6 +178,22 @@ public:
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time.
+	  * @a src is left empty.
+	  *
+	  * If the new lookup table of @a src can not be created, a
+	  * pwx::CException with the name "VTHashBase failure" is thrown.
+	  *
+	  * @param[in] src rvalue reference of the set to move.
+	**/
+	TSet ( list_t&& src ) :
+		base_t ( std::move( src ) ),
+		lookup( std::move( src.lookup ) )
+	{ }
+
+
 	virtual ~TSet() noexcept;
 
 
@@ -193,14 +209,30 @@ public:
 	using base_t::delNextElem;
 	using base_t::delPrev;
 	using base_t::delPrevElem;
+	using base_t::disable_indexing;
 	using base_t::disable_thread_safety;
 	using base_t::empty;
+	using base_t::enable_indexing;
 	using base_t::enable_thread_safety;
 	using base_t::find;
 	using base_t::get;
 	using base_t::getData;
 
 
+	/** @brief return the hash the lookup table uses for @a data
+	  *
+	  * Members that are equal have the same hash. The parallel set
+	  * functions use it to split the members of two sets into
+	  * matching groups.
+	  *
+	  * @param[in] data reference to the data to hash
+	  * @return the hash of @a data
+	**/
+	uint32_t getHash( const data_t& data ) const {
+		return lookup.getHash( data );
+	}
+
+
 	/** @brief return true if @a elem is an element of this set
 	  *
 	  * @param[in] elem reference to the element to test
@@ -225,6 +257,7 @@ public:
 	using base_t::insNextElem;
 	using base_t::insPrev;
 	using base_t::insPrevElem;
+	using base_t::is_indexed;
 
 
 	/** @brief return true if this set is a subset of @a src
@@ -278,6 +311,22 @@ public:
 	using base_t::remPrevElem;
 
 
+	/** @brief prepare the lookup table for @a count members
+	  *
+	  * The lookup table grows automatically, but every growth step
+	  * has to rehash all members. If the final size is known, this
+	  * grows the table once up front.
+	  *
+	  * If the table can not be grown, a pwx::CException with the name
+	  * "GrowFailure" is thrown.
+	  *
+	  * @param[in] count the number of members to prepare for.
+	**/
+	virtual void reserve( uint32_t count ) {
+		PWX_TRY_PWX_FURTHER( lookup.grow( count ) )
+	}
+
+
 	/** @brief reset a set to a predefined state of a different set
 	  *
 	  * This method can be used to clear a set and copy both the
@@ -400,6 +449,24 @@ public:
 	}
 
 
+	/** @brief move assignment operator
+	  *
+	  * Clears this set and takes over all elements of @a rhs
+	  * in constant time. @a rhs is left empty.
+	  *
+	  * @param[in] rhs rvalue reference of the set to move.
+	  * @return reference to this.
+	**/
+	virtual list_t& operator= ( list_t&& rhs ) noexcept {
+		if ( &rhs != this ) {
+			PWX_DOUBLE_LOCK_GUARD ( this, &rhs );
+			base_t::operator= ( std::move( rhs ) );
+			lookup = std::move( rhs.lookup );
+		}
+		return *this;
+	}
+
+
 	using base_t::operator+=;
 	using base_t::operator-=;
 	using base_t::operator[];
@@ -415,6 +482,9 @@ protected:
 	using base_t::head;
 	using base_t::tail;
 	using base_t::destroy;
+	using base_t::protCreateStore;
+	using base_t::protIndexInsert;
+	using base_t::protIndexRemove;
 
 
 	/// @brief Search until the current element contains the searched data
@@ -463,26 +533,33 @@ protected:
 		 * 4: Otherwise insPre->insertNext() can do the insertion
 		*/
 
+		// A set that was moved from needs a new store first
+		PWX_TRY_PWX_FURTHER( protCreateStore() )
+
+		// An indexed set must update links and index in one go
+		PWX_NAMED_LOCK_GUARD( indexed, isIndexed.load( memOrdLoad ) ? this : NULL_LOCK );
+		PWX_TRY_PWX_FURTHER( protIndexInsert( insPre, insElem ) )
+
 		if ( size() ) {
 			if ( insPre ) {
 				if ( tail() == insPre ) {
 					// Case 3: A new tail is to be set
 					insElem->nr( tail()->nr() + 1 );
-					PWX_TRY_PWX_FURTHER( tail()->insertNext( insElem, &currStore ) )
+					PWX_TRY_PWX_FURTHER( tail()->insertNext( insElem, currStore ) )
 					tail( insElem );
 				} else {
 					// Case 4: A normal insert
 					this->doRenumber.store( true, memOrdStore );
-					PWX_TRY_PWX_FURTHER( insPre->insertNext( insElem, &currStore ) )
+					PWX_TRY_PWX_FURTHER( insPre->insertNext( insElem, currStore ) )
 				}
 			} else {
 				// Case 2: A new head is to be set
-				PWX_TRY_PWX_FURTHER( head()->insertPrev( insElem, &currStore ) )
+				PWX_TRY_PWX_FURTHER( head()->insertPrev( insElem, currStore ) )
 				head( insElem ); // Does the renumbering already
 			}
 		} else {
 			// Case 1: The list is empty
-			PWX_TRY_PWX_FURTHER( insElem->insertBefore( nullptr, &currStore ) )
+			PWX_TRY_PWX_FURTHER( insElem->insertBefore( nullptr, currStore ) )
 			head( insElem );
 			tail( insElem );
 		}
@@ -506,6 +583,7 @@ protected:
 
 	using base_t::currStore;
 	using base_t::eCount;
+	using base_t::isIndexed;
 	using base_t::memOrdLoad;
 	using base_t::memOrdStore;
 
@@ -849,12 +927,16 @@ private:
 
 	/// @brief simple method to remove an element from the list.
 	virtual elem_t* privRemove ( elem_t* elem ) noexcept {
+		// An indexed set must update links and index in one go
+		PWX_NAMED_LOCK_GUARD( indexed, isIndexed.load( memOrdLoad ) ? this : NULL_LOCK );
+
 		// return at once if there is no element to remove
 		if ( !elem || elem->removed() || elem->destroyed() )
 			return nullptr;
 
 		// Take out of lookup, so it isn't found any more:
 		lookup.delKey( **elem );
+		protIndexRemove( elem );
 
 		/* The following scenarios are possible:
 		 * 1: elem is head
@@ -35,10 +35,16 @@
 **/
 
 
+#include <memory>
+#include <utility>
+
 #include "basic/compiler.h"
 #include "basic/debug.h"
 
 #include "basic/CException.h"
+#include "basic/CEpochGuard.h"
+#include "basic/CLockGuard.h"
+#include "container/CAllocPolicy.h"
 #include "container/TVarDeleter.h"
 #include "container/VElement.h"
 #include "math_helpers/MathHelpers.h"
@@ -61,6 +67,13 @@ namespace pwx {
   * The data pointer itself is wrapped into an `std::shared_ptr`. It is therefore
   * completely safe to copy `TSingleElement` instances.
   *
+  * The optional template parameter @a alloc_t is the allocation policy for the
+  * element itself and for the control block of the shared data pointer. The
+  * default `pwx::CAllocPolicyNew` uses the global `operator new`, while
+  * `pwx::CAllocPolicyPool` recycles the memory of deleted elements, which makes
+  * repeated push/pop cycles a lot cheaper. Elements are deleted with `delete`
+  * either way.
+  *
   * The data pointer itself is public. You can use `data.get()` to access it.
   * Further the `operator*()` is overloaded and `**foo` will result in a reference
   * to the data.
@@ -126,7 +139,7 @@ namespace pwx {
   * </TR>
   * </TABLE>
 **/
-template< typename data_t >
+template< typename data_t, typename alloc_t = CAllocPolicyNew >
 struct PWX_API TSingleElement : public VElement {
 
 	/* ===============================================
@@ -134,11 +147,12 @@ struct PWX_API TSingleElement : public VElement {
 	 * ===============================================
 	*/
 
-	typedef VElement                  base_t;     //!< Base type of this element
-	typedef TSingleElement< data_t >  elem_t;     //!< Type of this element
-	typedef std::shared_ptr< data_t > share_t;    //!< data_t wrapped in std::shared_ptr
-	typedef std::atomic< elem_t* >    neighbor_t; //!< elem_t* wrapped in std::atomic
-	typedef base_t::store_t           store_t;    //!< The element store type to register this element with
+	typedef VElement                          base_t;     //!< Base type of this element
+	typedef TSingleElement< data_t, alloc_t > elem_t;     //!< Type of this element
+	typedef alloc_t                           alloc_type; //!< Allocation policy of this element
+	typedef std::shared_ptr< data_t >         share_t;    //!< data_t wrapped in std::shared_ptr
+	typedef std::atomic< elem_t* >            neighbor_t; //!< elem_t* wrapped in std::atomic
+	typedef base_t::store_t                   store_t;    //!< The element store type to register this element with
 
 
 	/* ===============================================
@@ -154,7 +168,7 @@ struct PWX_API TSingleElement : public VElement {
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
 	TSingleElement( data_t* data_, void ( * destroy_ )( data_t* data_ ) ) noexcept
-		  : data( data_, TVarDeleter< data_t >( destroy_ ) ) {}
+		  : data( data_, TVarDeleter< data_t >( destroy_ ), TPolicyAllocator< data_t, alloc_t >() ) {}
 
 
 	/** @brief explicit constructor
@@ -187,6 +201,21 @@ struct PWX_API TSingleElement : public VElement {
 		  : base_t( src ), data( src.data ) {}
 
 
+	/** @brief move ctor
+	  *
+	  * The move ctor creates a stand-alone element without neighbours,
+	  * taking over the data pointer and destroy method of @a src.
+	  * @a src is left without data and should not be in a container.
+	  *
+	  * **Important**: Whether the element does locking or not
+	  * is *not* copied. It will silently be turned on by default!
+	  *
+	  * @param[in] src rvalue reference to the element to move.
+	**/
+	TSingleElement( elem_t &&src ) noexcept
+		  : base_t( src ), data( std::move( src.data ) ) {}
+
+
 	/** @brief destructor
 	  *
 	  * The destructor invokes a lock on the instance to allow
@@ -427,6 +456,9 @@ struct PWX_API TSingleElement : public VElement {
 	virtual void remove() noexcept {
 		if ( beThreadSafe() ) {
 			PWX_LOCK_GUARD( this );
+			// Readers still holding this element continue with the successor
+			// it has now. It is retired after this one, so it stays valid.
+			oldNext.store( next.load( memOrdLoad ), memOrdStore );
 			base_t::remove();
 			setNext( nullptr );
 		} else {
@@ -492,15 +524,7 @@ struct PWX_API TSingleElement : public VElement {
 	  * @param[in] new_next target where the next pointer should point at.
 	**/
 	void setNext( elem_t* new_next ) noexcept {
-		if ( beThreadSafe() ) {
-			elem_t* currNext = next.load( memOrdLoad );
-			next.store( new_next, memOrdStore );
-			if ( currNext ) {
-				oldNext.store( currNext, memOrdStore );
-			}
-		} else {
-			next.store( new_next, memOrdStore );
-		}
+		next.store( new_next, memOrdStore );
 	}
 
 
@@ -530,6 +554,27 @@ struct PWX_API TSingleElement : public VElement {
 	}
 
 
+	/** @brief move assignment operator
+	  *
+	  * The move assignment operator takes over the data and the
+	  * destroy method of @a src, which is left without data and
+	  * should not be in a container. This element will stay where
+	  * it is, and not change its position.
+	  *
+	  * @param[in] src rvalue reference of the element to move
+	  * @return reference to this element
+	**/
+	elem_t &operator=( elem_t &&src ) noexcept {
+		if ( ( this != &src ) && !destroyed() && !src.destroyed() ) {
+			PWX_DOUBLE_LOCK_GUARD( this, &src );
+			if ( !destroyed() && !src.destroyed() ) {
+				data = std::move( src.data );
+			}
+		}
+		return *this;
+	}
+
+
 	/** @brief dereferencing an element returns a reference to the stored data
 	  *
 	  * If the data pointer is `nullptr`, a `pwx::CException` with the name
@@ -590,6 +635,22 @@ struct PWX_API TSingleElement : public VElement {
 	}
 
 
+	/// @brief elements are allocated using the allocation policy
+	static void* operator new( size_t size ) {
+		return alloc_t::allocate( size );
+	}
+
+
+	/** @brief elements are given back to the allocation policy
+	  *
+	  * Like with `pwx::VElement`, this only happens when no reader inside
+	  * a `pwx::CEpochGuard` can still hold the element.
+	**/
+	static void operator delete( void* ptr, size_t size ) noexcept {
+		protFreeElement( ptr, reclaim_element, reinterpret_cast<void*>( size ) );
+	}
+
+
 	/* ===============================================
 	 * === Public members                          ===
 	 * ===============================================
@@ -611,6 +672,17 @@ protected:
 
 private:
 
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	 */
+
+	/// @internal Give the memory of a retired element back, @a size is the element size
+	static void reclaim_element( void* ptr, void* size ) noexcept {
+		alloc_t::deallocate( ptr, reinterpret_cast<size_t>( size ) );
+	}
+
+
 	/* ===============================================
 	 * === Private members                         ===
 	 * ===============================================
@@ -621,8 +693,8 @@ private:
 }; // struct TSingleElement
 
 
-template< typename data_t >
-TSingleElement< data_t >::~TSingleElement() noexcept {
+template< typename data_t, typename alloc_t >
+TSingleElement< data_t, alloc_t >::~TSingleElement() noexcept {
 	PWX_LOCK_GUARD( this );
 	isDestroyed.store( true );
 
@@ -35,10 +35,16 @@
 **/
 
 
+#include <utility>
+
 #include "basic/compiler.h"
 #include "basic/macros.h"
 
+#include "basic/CEpochGuard.h"
+#include "basic/CLockGuard.h"
 #include "container/CThreadElementStore.h"
+#include "container/TListIndex.h"
+#include "container/TListIterator.h"
 #include "container/TSingleElement.h"
 #include "container/VContainer.h"
 
@@ -73,6 +79,22 @@ namespace pwx {
   *
   * If you plan to use this container in a strictly single-threaded way, you can
   * turn off most of the thread safety measures with `disable_thread_safety()`.
+  *
+  * **Notes on positional access**
+  *
+  * Retrieving elements by index walks through the list, starting from the last
+  * used position. After insertions or removals in the middle, all elements have
+  * to be renumbered first. If you mix positional access with such modifications
+  * on large lists, call `enable_indexing()`. The list then maintains a positional
+  * index, which makes `get(index)` and `insAt()` O(log n) without renumbering.
+  * All modifications of an indexed list lock the whole list.
+  *
+  * **Notes on iteration**
+  *
+  * The list provides STL compatible iterators via `begin()` and `end()`, so
+  * it can be used in range based for loops and with `<algorithm>`. These are
+  * not guarded. If other threads might change the list meanwhile, iterate
+  * over a `snapshot()` instead, which guards the whole iteration at once.
 **/
 template<typename data_t, typename elem_t = TSingleElement<data_t> >
 class PWX_API TSingleList : public VContainer {
@@ -86,6 +108,15 @@ public:
 	typedef TSingleList<data_t, elem_t> list_t;     //!< Type of this list
 	typedef typename elem_t::neighbor_t neighbor_t; //!< Type of elements neighbours, used for curr, head and tail.
 	typedef CThreadElementStore         store_t;    //!< Storage for the thread id bound curr pointer
+	typedef TListIndex<elem_t>          index_t;    //!< Positional index used by `enable_indexing()`
+
+	typedef elem_t                              elem_type;      //!< Type of the elements
+	typedef data_t                              value_type;     //!< Type of the stored data
+	typedef TListIterator<elem_t, data_t>       iterator;       //!< Read/write iterator, see `begin()`
+	typedef TListIterator<elem_t, data_t const> const_iterator; //!< Read only iterator, see `cbegin()`
+	typedef TListSnapshot<list_t>               snapshot_t;     //!< Guarded read only range, see `snapshot()`
+
+	friend snapshot_t;
 
 
 	/* ===============================================
@@ -97,10 +128,14 @@ public:
 	  *
 	  * The default constructor initializes an empty list.
 	  *
+	  * If the store for the current elements can not be allocated,
+	  * `std::bad_alloc` is thrown.
+	  *
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
-	TSingleList ( void ( *destroy_ ) ( data_t* ) ) noexcept
-		: destroy ( destroy_ )
+	TSingleList ( void ( *destroy_ ) ( data_t* ) )
+		: destroy ( destroy_ ),
+		  currStore( new store_t )
 	{ }
 
 
@@ -109,7 +144,7 @@ public:
 	  * The empty constructor uses the default constructor to set the data
 	  * destroy method to the null pointer.
 	**/
-	TSingleList() noexcept
+	TSingleList()
 		: list_t ( nullptr )
 	{ }
 
@@ -124,11 +159,32 @@ public:
 	  * @param[in] src reference of the list to copy.
 	**/
 	TSingleList ( list_t const& src ) :
-		base_t ( src ) {
+		base_t ( src ),
+		destroy ( src.destroy ),
+		currStore( new store_t ) {
 		operator+=( src );
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src, which is left empty.
+	  * No element is copied or touched, so this takes constant
+	  * time no matter how many elements @a src holds.
+	  *
+	  * @a src is left without a store for its current elements,
+	  * it gets a new one with its next insert.
+	  *
+	  * @param[in] src rvalue reference of the list to move.
+	**/
+	TSingleList ( list_t&& src ) noexcept :
+		base_t ( src ),
+		destroy ( src.destroy ),
+		currStore( nullptr ) {
+		privMoveFrom( src );
+	}
+
+
 	/** @brief default destructor
 	  *
 	  * This destructor will delete all elements currently stored. There is no
@@ -142,6 +198,40 @@ public:
 	 * ===============================================
 	*/
 
+	/** @brief return an iterator on the first element
+	  *
+	  * The iterators are not guarded. Stepping through the list with
+	  * them is only safe if no other thread removes elements meanwhile.
+	  * Otherwise use `snapshot()`.
+	  *
+	  * @return a read/write iterator on the head, or `end()` if the list is empty.
+	**/
+	iterator begin() noexcept {
+		elem_t* xHead = head();
+		return iterator( xHead, xHead, tail() );
+	}
+
+
+	/// @return a read only iterator on the first element, see `begin()`
+	const_iterator begin() const noexcept {
+		return cbegin();
+	}
+
+
+	/// @return a read only iterator on the first element, see `begin()`
+	const_iterator cbegin() const noexcept {
+		elem_t* xHead = head();
+		return const_iterator( xHead, xHead, tail() );
+	}
+
+
+	/// @return the read only end iterator, see `begin()`
+	const_iterator cend() const noexcept {
+		elem_t* xHead = head();
+		return const_iterator( nullptr, xHead, tail() );
+	}
+
+
 	/** @brief delete all elements
 	  *
 	  * This is a quick way to get rid of all elements
@@ -204,6 +294,22 @@ public:
 	}
 
 
+	/** @brief disable the positional index
+	  *
+	  * The index is freed and elements are found by walking
+	  * through the list again. See `enable_indexing()`.
+	  */
+	void disable_indexing() noexcept {
+		PWX_LOCK_GUARD( this );
+		if ( isIndexed.load( memOrdLoad ) ) {
+			isIndexed.store( false, memOrdStore );
+			listIndex.clear();
+			// Element numbers were not maintained while indexed
+			this->doRenumber.store( true, memOrdStore );
+		}
+	}
+
+
 	/** @brief disable thread safety
 	  *
 	  * This method disables all thread safety measures.
@@ -220,7 +326,8 @@ public:
 	void disable_thread_safety() noexcept {
 		this->lock();
 		this->do_locking( false );
-		this->currStore.disable_thread_safety();
+		if ( this->currStore )
+			this->currStore->disable_thread_safety();
 		elem_t* xCurr = head();
 		do {
 			if ( xCurr ) {
@@ -238,6 +345,52 @@ public:
 	}
 
 
+	/** @brief enable the positional index
+	  *
+	  * An indexed list keeps a balanced tree over its elements,
+	  * ordered by their position. `get(index)`, `getData(index)`,
+	  * `operator[]` and `insAt()` then need O(log n) steps, no
+	  * matter where elements were inserted or removed before.
+	  * Element numbers (`nr()`) are not maintained while the
+	  * list is indexed.
+	  *
+	  * The index needs about 50 bytes per element, and every
+	  * insertion or removal locks the whole list while the
+	  * index is updated.
+	  *
+	  * **Warning**: Switching the index on or off is not
+	  * synchronized with other threads modifying the list at
+	  * the same time. Do it while the list is not in use.
+	  *
+	  * If the index can not be built, a `pwx::CException` with
+	  * the name "IndexCreationFailed" is thrown and the list
+	  * stays unindexed.
+	  */
+	void enable_indexing() {
+		PWX_LOCK_GUARD( this );
+		if ( isIndexed.load( memOrdLoad ) )
+			return;
+
+		uint32_t locCnt = size();
+		elem_t*  xPrev  = nullptr;
+		elem_t*  xCurr  = head();
+
+		try {
+			listIndex.reserve( locCnt );
+			for ( uint32_t nr = 0 ; xCurr && ( nr < locCnt ) ; ++nr ) {
+				listIndex.insert( xPrev, xCurr );
+				xPrev = xCurr;
+				xCurr = xCurr->getNext();
+			}
+		} catch( std::exception& e ) {
+			listIndex.clear();
+			PWX_THROW( "IndexCreationFailed", e.what(), "The positional index could not be built." );
+		}
+
+		isIndexed.store( true, memOrdStore );
+	}
+
+
 	/** @brief enable thread safety
 	  *
 	  * This method enables all thread safety measures.
@@ -250,7 +403,8 @@ public:
 	  */
 	void enable_thread_safety() noexcept override {
 		this->do_locking( true );
-		this->currStore.enable_thread_safety();
+		if ( this->currStore )
+			this->currStore->enable_thread_safety();
 		elem_t* xCurr = head();
 		do {
 			if ( xCurr ) {
@@ -262,6 +416,19 @@ public:
 	}
 
 
+	/// @return the read/write end iterator, see `begin()`
+	iterator end() noexcept {
+		elem_t* xHead = head();
+		return iterator( nullptr, xHead, tail() );
+	}
+
+
+	/// @return the read only end iterator, see `begin()`
+	const_iterator end() const noexcept {
+		return cend();
+	}
+
+
 	/** @brief find the element with the given @a data pointer
 	  *
 	  * This method searches through the list and returns the element
@@ -393,7 +560,7 @@ public:
 	  * @return read-only reference to the elements data.
 	**/
 	virtual data_t const& getData ( int32_t const index ) const {
-		PWX_LOCK_GUARD( this );
+		PWX_SHARED_LOCK_GUARD( this );
 		// Note: The guard is needed or another thread can
 		// delete the retrieved element between the retrieval
 		// and the delivery. A segfault would be the result.
@@ -425,7 +592,53 @@ public:
 	  * @return read/write reference to the elements data.
 	**/
 	virtual data_t& getData ( int32_t index ) {
-		PWX_TRY_PWX_FURTHER( return const_cast<data_t&>( getData( index ) ) )
+		PWX_TRY_PWX_FURTHER( return const_cast<data_t&>( static_cast<list_t const*>( this )->getData( index ) ) )
+	}
+
+
+	/** @brief insert a new data pointer at the given position
+	  *
+	  * This method inserts a new element in the list, that gets
+	  * the position @a index. Negative values count from the end,
+	  * an @a index of -1 appends the new element to the list.
+	  * Values out of range are pressed into the valid range.
+	  *
+	  * The position is searched like with `get()`, so this method
+	  * is O(log n) if the list is indexed, see `enable_indexing()`.
+	  *
+	  * If the new element can not be created, a `pwx::CException`
+	  * with the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] index the position the new element gets.
+	  * @param[in] data the pointer that is to be added.
+	  * @return the number of elements in this list after the insertion
+	**/
+	virtual uint32_t insAt ( int32_t index, data_t* data ) {
+		PWX_LOCK_GUARD( this );
+		PWX_TRY_PWX_FURTHER( return privInsDataBehindElem( privGetPrevByPos( index ), data ) )
+	}
+
+
+	/** @brief insert an element copy at the given position
+	  *
+	  * This method inserts a copy of @a src in the list, that gets
+	  * the position @a index. Negative values count from the end,
+	  * an @a index of -1 appends the new element to the list.
+	  * Values out of range are pressed into the valid range.
+	  *
+	  * The position is searched like with `get()`, so this method
+	  * is O(log n) if the list is indexed, see `enable_indexing()`.
+	  *
+	  * If the new element can not be created, a `pwx::CException`
+	  * with the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] index the position the new element gets.
+	  * @param[in] src reference to the element to copy.
+	  * @return the number of elements in this list after the insertion
+	**/
+	virtual uint32_t insAt ( int32_t index, elem_t const& src ) {
+		PWX_LOCK_GUARD( this );
+		PWX_TRY_PWX_FURTHER( return privInsElemBehindElem( privGetPrevByPos( index ), src ) )
 	}
 
 
@@ -555,6 +768,12 @@ public:
 	}
 
 
+	/// @return true if the list maintains a positional index, see `enable_indexing()`
+	bool is_indexed() const noexcept {
+		return isIndexed.load( memOrdLoad );
+	}
+
+
 	/** @brief short alias for pop_front()
 	  *
 	  * You have to delete the removed element by yourself. If you do not intent
@@ -734,6 +953,25 @@ public:
 	}
 
 
+	/** @brief return a read only range over all elements, guarded until it is destroyed
+	  *
+	  * The snapshot holds a shared lock on the list and keeps removed
+	  * elements from being freed, so it can be iterated while other
+	  * threads work with the list, and by several threads at once.
+	  * See `pwx::TListSnapshot` for the details.
+	  *
+	  * @code
+	  * for ( auto const& data : list.snapshot() )
+	  *     sum += data;
+	  * @endcode
+	  *
+	  * @return the guarded range.
+	**/
+	snapshot_t snapshot() const noexcept {
+		return snapshot_t( *this );
+	}
+
+
 	/* ===============================================
 	 * === Public operators                        ===
 	 * ===============================================
@@ -761,6 +999,30 @@ public:
 	}
 
 
+	/** @brief move assignment operator
+	  *
+	  * Clears this list and takes over all elements of @a rhs,
+	  * which is left empty. Both the destroy method and the
+	  * thread safety setting are taken over as well.
+	  *
+	  * @a rhs gets the store for the current elements of this
+	  * list, or creates a new one with its next insert.
+	  *
+	  * @param[in] rhs rvalue reference of the list to move.
+	  * @return reference to this.
+	**/
+	virtual list_t& operator= ( list_t&& rhs ) noexcept {
+		if ( &rhs != this ) {
+			PWX_DOUBLE_LOCK_GUARD( this, &rhs );
+			clear();
+			destroy = rhs.destroy;
+			beThreadSafe( rhs.beThreadSafe() );
+			privMoveFrom( rhs );
+		}
+		return *this;
+	}
+
+
 	/** @brief addition assignment operator
 	  *
 	  * Add all elements from @a rhs to this list.
@@ -892,14 +1154,23 @@ protected:
 
 	/// @brief return curr according to thread safety setting
 	elem_t* curr() const {
-		elem_t* result = static_cast<elem_t*>( currStore.curr() );
+		elem_t* result = currStore ? static_cast<elem_t*>( currStore->curr() ) : nullptr;
 		return result ? result : head();
 	}
 
 
-	/// @brief set curr to @a new_curr according to thread safety settings
+	/** @brief set curr to @a new_curr according to thread safety settings
+	  *
+	  * Readers find @a new_curr without a lock, so it might have been
+	  * removed, and its invalidation already done, before it is stored.
+	  * Such an element must not stay behind as curr, it will be freed.
+	**/
 	void curr( elem_t* new_curr ) const {
-		currStore.curr( new_curr );
+		if ( nullptr == currStore )
+			return;
+		currStore->curr( new_curr );
+		if ( new_curr && new_curr->removed() )
+			currStore->curr( nullptr );
 	}
 
 
@@ -913,17 +1184,24 @@ protected:
 	void head( elem_t* new_head ) {
 		PWX_DOUBLE_LOCK_GUARD( new_head, new_head ? new_head->getNext() : nullptr );
 
-		new_head->nr( 0 );
 		head_.store( new_head, memOrdStore );
 
+		// Nothing to number if the list is empty or indexed
+		if ( ( nullptr == new_head ) || isIndexed.load( memOrdLoad ) )
+			return;
+
+		new_head->nr( 0 );
+
 		// Instead of waiting, we can directly move through the list an renumber here.
-		elem_t* xCurr = head();
-		elem_t* xNext = xCurr ? xCurr->getNext() : nullptr;
+		// Note: In a ring the tail leads back to the (maybe former) head.
+		elem_t* xCurr = new_head;
+		elem_t* xNext = xCurr->getNext();
+		elem_t* xTail = tail();
 
-		while ( xCurr && xNext && (xCurr != xNext ) ) {
+		while ( xNext && ( xCurr != xTail ) && ( xNext != new_head ) ) {
 			xNext->nr( xCurr->nr() + 1 );
-			xNext = xCurr;
-			xCurr = xNext->getNext();
+			xCurr = xNext;
+			xNext = xCurr->getNext();
 			PWX_DOUBLE_LOCK_GUARD_RESET( xCurr, xNext );
 		}
 	}
@@ -969,12 +1247,91 @@ protected:
 	}
 
 
+	/** @brief retrieve an element by any index using the positional index
+	  * @param[in] index the index, wrapped into range like with `get()`.
+	  * @param[out] result the element, or `nullptr` if the list is empty.
+	  * @return false if the list is not indexed, @a result is not touched then.
+	**/
+	bool protIndexGet( int32_t index, elem_t const*& result ) const noexcept {
+		if ( !isIndexed.load( memOrdLoad ) )
+			return false;
+
+		PWX_SHARED_LOCK_GUARD( this );
+
+		// Check again, the index might have been disabled while waiting
+		if ( !isIndexed.load( memOrdLoad ) )
+			return false;
+
+		uint32_t locCnt = listIndex.size();
+		result          = nullptr;
+
+		if ( locCnt ) {
+			uint32_t xIdx = static_cast<uint32_t> ( index < 0
+			                                        ? locCnt - ( std::abs ( index ) % locCnt )
+			                                        : index % locCnt );
+			result = listIndex.get( xIdx < locCnt ? xIdx : 0 );
+		}
+
+		return true;
+	}
+
+
+	/** @brief create the store for the current elements, if there is none
+	  *
+	  * A list that was moved from has no store, so moving never has to
+	  * allocate. This must be called by `protInsert()` before the element
+	  * is linked in.
+	  *
+	  * If the store can not be created, a `pwx::CException` with the name
+	  * "ElementCreationFailed" is thrown.
+	**/
+	void protCreateStore() {
+		if ( nullptr == currStore ) {
+			PWX_LOCK_GUARD( this );
+			if ( nullptr == currStore ) {
+				store_t* store = nullptr;
+				PWX_TRY( store = new store_t )
+				PWX_THROW_STD_FURTHER( "ElementCreationFailed", "The store for the current elements could not be created." )
+				if ( !this->beThreadSafe() )
+					store->disable_thread_safety();
+				currStore = store;
+			}
+		}
+	}
+
+
+	/** @brief add @a insElem behind @a insPrev to the positional index, if there is one
+	  *
+	  * This must be called by `protInsert()` before the element is linked in, and
+	  * with the list locked. If the list is empty or @a insPrev is `nullptr`, the
+	  * element is indexed as the new head.
+	  *
+	  * If the index can not be extended, a `pwx::CException` with the name
+	  * "ElementCreationFailed" is thrown.
+	**/
+	void protIndexInsert( elem_t const* insPrev, elem_t* insElem ) {
+		if ( isIndexed.load( memOrdLoad ) ) {
+			PWX_TRY( listIndex.insert( size() ? insPrev : nullptr, insElem ) )
+			PWX_THROW_STD_FURTHER( "ElementCreationFailed", "The new element could not be indexed." )
+		}
+	}
+
+
+	/// @brief remove @a removed from the positional index, if there is one. The list must be locked.
+	void protIndexRemove( elem_t const* removed ) noexcept {
+		if ( removed && isIndexed.load( memOrdLoad ) )
+			listIndex.remove( removed );
+	}
+
+
 	/// @brief Search until the current element contains the searched data
 	virtual elem_t const* protFind ( const data_t* data ) const noexcept {
 		elem_t* result = nullptr;
 
 		/* Some rules about searching for elements:
-		 * 1) root, tail and curr are checked first in a locked state.
+		 * 1) root, tail and curr are checked first. The list is not locked,
+		 *    so each of them might be nullptr if the list is emptied
+		 *    meanwhile.
 		 * 2) The point in time where the search starts is relevant.
 		 *    This means, that if the list is to be traversed, it
 		 *    will not be locked. If the searched element is inserted
@@ -982,6 +1339,9 @@ protected:
 		 *    already traversed, it will not be found.
 		 *    This is in order, because the element was not there when
 		 *    the search started.
+		 *    A CEpochGuard held for the whole search keeps elements
+		 *    that are removed meanwhile from being freed, so the
+		 *    traversal never touches released memory.
 		 * 3) As new elements might be added to the end, the traversal
 		 *    stops after checking the actual tail if the element could
 		 *    not be found earlier.
@@ -994,19 +1354,12 @@ protected:
 		if ( empty() )
 			return nullptr;
 
-		// Rule 1: Lock for the basic tests.
-		const_cast<list_t*>( this )->lock();
-
-		// Exit if the list has been emptied while we waited for the lock
-		if ( empty() ) {
-			const_cast<list_t*>( this )->unlock();
-			return nullptr;
-		}
+		// Rule 2 needs the traversed elements to stay valid.
+		CEpochGuard guard;
 
 		// Quick exit if curr is already what we want:
 		elem_t* xCurr = curr();
 		if ( xCurr && ( xCurr->data.get() == data ) ) {
-			const_cast<list_t*>( this )->unlock();
 			return xCurr;
 		}
 
@@ -1015,26 +1368,21 @@ protected:
 
 			// Exit if head is wanted...
 			elem_t* xHead = head();
-			if ( ( xHead != xCurr ) && ( xHead->data.get() == data ) ) {
+			if ( xHead && ( xHead != xCurr ) && ( xHead->data.get() == data ) ) {
 				curr( xHead );
-				const_cast<list_t*>( this )->unlock();
 				return xHead;
 			}
 
 			// ...or tail
 			elem_t* xTail = tail();
-			if ( ( xTail != xCurr ) && ( xTail->data.get() == data ) ) {
+			if ( xTail && ( xTail != xCurr ) && ( xTail->data.get() == data ) ) {
 				curr( xTail );
-				const_cast<list_t*>( this )->unlock();
 				return xTail;
 			}
 
 			// Otherwise we have to search for it.
 			bool isDone = false;
-			xCurr = xHead->getNext(); // head is already checked.
-
-			// This is rule 2: Unlock for traversal
-			const_cast<list_t*>( this )->unlock();
+			xCurr = xHead ? xHead->getNext() : nullptr; // head is already checked.
 
 			while ( !result && !isDone && xCurr ) {
 				// Rule 3: Re-check tail. It might be
@@ -1050,8 +1398,6 @@ protected:
 			} // End of manual traversing the container
 
 		} // End of handling a search with more than one element
-		else
-			const_cast<list_t*>( this )->unlock();
 
 		return result;
 	}
@@ -1069,18 +1415,11 @@ protected:
 		if ( empty() )
 			return nullptr;
 
-		// Rule 1
-		const_cast<list_t*>( this )->lock();
-
-		if ( empty() ) {
-			const_cast<list_t*>( this )->unlock();
-			return nullptr;
-		}
+		CEpochGuard guard; // Rule 2
 
 		// Quick exit if curr is already what we want:
 		elem_t* xCurr = curr();
-		if ( *xCurr == data ) {
-			const_cast<list_t*>( this )->unlock();
+		if ( xCurr && ( 0 == xCurr->compare( data ) ) ) {
 			return xCurr;
 		}
 
@@ -1089,26 +1428,21 @@ protected:
 
 			// Exit if head is wanted...
 			elem_t* xHead = head();
-			if ( ( xHead != xCurr ) && ( *xHead == data ) ) {
+			if ( xHead && ( xHead != xCurr ) && ( 0 == xHead->compare( data ) ) ) {
 				curr( xHead );
-				const_cast<list_t*>( this )->unlock();
 				return xHead;
 			}
 
 			// ...or tail
 			elem_t* xTail = tail();
-			if ( ( xTail != xCurr ) && ( *xTail == data ) ) {
+			if ( xTail && ( xTail != xCurr ) && ( 0 == xTail->compare( data ) ) ) {
 				curr( xTail );
-				const_cast<list_t*>( this )->unlock();
 				return xTail;
 			}
 
 			// Otherwise we have to search for it.
 			bool isDone = false;
-			xCurr = xHead->getNext(); // head is already checked.
-
-			// Rule 2:
-			const_cast<list_t*>( this )->unlock();
+			xCurr = xHead ? xHead->getNext() : nullptr; // head is already checked.
 
 			while ( !result && !isDone && xCurr ) {
 				// Note: The container is not locked any more,
@@ -1124,8 +1458,6 @@ protected:
 			}
 
 		} // End of handling a search with more than one element
-		else
-			const_cast<list_t*>( this )->unlock();
 
 		return result;
 	}
@@ -1143,21 +1475,16 @@ protected:
 		if ( empty() )
 			return nullptr;
 
-		// Rule 1
-		const_cast<list_t*>( this )->lock();
-
-		if ( empty() ) {
-			const_cast<list_t*>( this )->unlock();
-			return nullptr;
-		}
+		CEpochGuard guard; // Rule 2
 
 		// Quick exit if curr->next is already what we want:
 		elem_t* xCurr = curr();
-		elem_t* xNext = xCurr->getNext(); // Note: xCurr can not be nullptr at this point.
+		if ( nullptr == xCurr )
+			return nullptr; // The list was emptied meanwhile
+		elem_t* xNext = xCurr->getNext();
 		int32_t comp  = xCurr->compare( data );
 		if ( ( comp < 0 )
 		                && ( ( nullptr == xNext ) || ( xNext->compare( data ) > -1 ) ) ) {
-			const_cast<list_t*>( this )->unlock();
 			return xNext ? xNext : nullptr;
 		}
 
@@ -1165,7 +1492,6 @@ protected:
 		elem_t* xHead = head();
 		if ( xHead && ( xHead->compare( data ) > -1 ) ) {
 			curr( xHead );
-			const_cast<list_t*>( this )->unlock();
 			return xHead;
 		}
 
@@ -1173,17 +1499,13 @@ protected:
 		elem_t* xTail = tail();
 		if ( xTail && ( xTail->compare( data ) < 0 ) ) {
 			curr( xTail );
-			const_cast<list_t*>( this )->unlock();
 			return nullptr; // tail is prev of nullptr by definition.
 		}
 
 		// Otherwise we have to search for it.
 		bool isDone = false;
 		if ( comp > -1 )
-			xCurr = xHead->getNext(); // head is already checked.
-
-		// Rule 2:
-		const_cast<list_t*>( this )->unlock();
+			xCurr = xHead ? xHead->getNext() : nullptr; // head is already checked.
 
 		while ( !result && !isDone && xCurr && xNext ) {
 			// Note: The container is not locked any more,
@@ -1228,31 +1550,39 @@ protected:
 		 *    renumbering is needed then.
 		 * 4: Otherwise insPrev->insertNext() can do the insertion
 		*/
+
+		// A list that was moved from needs a new store first
+		PWX_TRY_PWX_FURTHER( protCreateStore() )
+
+		// An indexed list must update links and index in one go
+		PWX_NAMED_LOCK_GUARD( indexed, isIndexed.load( memOrdLoad ) ? this : NULL_LOCK );
+		PWX_TRY_PWX_FURTHER( protIndexInsert( insPrev, insElem ) )
+
 		curr( insElem ); // always use the new element henceforth
 
 		if ( size() && insPrev && ( tail() != insPrev ) ) {
 			// Case 4: A normal insert
 			this->doRenumber.store( true, memOrdStore );
-			PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, &currStore ) );
+			PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, currStore ) );
 		} else {
 			if ( empty() ) {
 				// Case 1: The list is empty
 				head( insElem );
 				tail( insElem );
-				PWX_TRY_PWX_FURTHER( insElem->insertBefore( nullptr, &currStore ) );
+				PWX_TRY_PWX_FURTHER( insElem->insertBefore( nullptr, currStore ) );
 			} else if ( nullptr == insPrev ) {
 				// Case 2: A new head is to be set
-				PWX_TRY_PWX_FURTHER( insElem->insertBefore( head(), &currStore ) );
+				PWX_TRY_PWX_FURTHER( insElem->insertBefore( head(), currStore ) );
 				head( insElem ); // Does direct renumbering
 			} else if ( ( insPrev == tail() ) || insPrev->destroyed() ) {
 				// Case 3: A new tail is to be set
 				insElem->nr( tail()->nr() + 1 );
-				PWX_TRY_PWX_FURTHER( tail()->insertNext( insElem, &currStore ) );
+				PWX_TRY_PWX_FURTHER( tail()->insertNext( insElem, currStore ) );
 				tail( insElem );
 			} else {
 				// Case 4, but only after acquiring the lock
 				this->doRenumber.store( true, memOrdStore );
-				PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, &currStore ) );
+				PWX_TRY_PWX_FURTHER( insPrev->insertNext( insElem, currStore ) );
 			}
 		}
 
@@ -1279,16 +1609,19 @@ protected:
 				PWX_DOUBLE_LOCK_GUARD_RESET( this, NULL_LOCK );
 			}
 
-			elem_t*  xCurr  = head();
+			elem_t*  xHead  = head();
+			elem_t*  xCurr  = xHead;
 			elem_t*  xNext  = xCurr ? xCurr->getNext() : nullptr;
 
 			if ( xCurr )
 				xCurr->nr( 0 );
 
-			while ( xCurr && xNext && ( xCurr != xNext) ) {
+			// Note: In a ring the tail leads back to the head.
+			elem_t*  xTail  = tail();
+			while ( xCurr && xNext && ( xCurr != xTail ) && ( xNext != xHead ) ) {
 				// Lock guard xCurr, so inserting threads won't give us a headache
 				PWX_DOUBLE_LOCK_GUARD_RESET( xCurr, xNext );
-				xNext->nr( xCurr->nr() );
+				xNext->nr( xCurr->nr() + 1 );
 				xCurr = xNext;
 				xNext = xCurr->getNext();
 			}
@@ -1301,7 +1634,8 @@ protected:
 	 * ===============================================
 	*/
 
-	store_t currStore;         //!< Storage for the thread id bound curr pointers
+	store_t* currStore;        //!< Storage for the thread id bound curr pointers, moves with the elements, nullptr after a move
+	abool_t  isIndexed = ATOMIC_VAR_INIT( false ); //!< Set by `enable_indexing()`, all modifications must maintain `listIndex` then
 	using base_t::memOrdLoad;
 	using base_t::memOrdStore;
 
@@ -1345,7 +1679,9 @@ private:
 			}
 			if ( xHead && size() ) {
 				eCount.store( 0, memOrdStore );
-				if ( !currStore.destroyed() )
+				if ( isIndexed.load( memOrdLoad ) )
+					listIndex.clear();
+				if ( currStore && !currStore->destroyed() )
 					curr( nullptr );
 				head( nullptr );
 				tail( nullptr );
@@ -1356,15 +1692,19 @@ private:
 
 		// Now if this call found anything, it can be destroyed:
 		if ( xHead ) {
-			currStore.clear(); // will all be gone soon anyway
+			if ( currStore )
+				currStore->clear(); // will all be gone soon anyway
 			elem_t* xNext = nullptr;
 			xHead->beThreadSafe( false );
 			while ( xHead && ( xNext = xHead->removeNext() ) ) {
 				if ( xNext && !xNext->destroyed() )
 					delete xNext;
 			}
-			if ( xHead && !xHead->destroyed() )
+			if ( xHead && !xHead->destroyed() ) {
+				// Guarded readers might still hold head
+				xHead->beThreadSafe( this->beThreadSafe() );
 				delete xHead;
+			}
 		}
 	}
 
@@ -1396,11 +1736,19 @@ private:
 		if ( empty() )
 			return nullptr;
 
+		// The positional index needs no renumbering and no walking
+		elem_t const* result = nullptr;
+		if ( protIndexGet( index, result ) )
+			return result;
+
 		protRenumber();
 
+		// The walk below is not locked, removed elements must stay valid
+		CEpochGuard guard;
+
 		// It is necessary to lock briefly to ensure a consistent
 		// start of the search with a minimum of checks
-		const_cast<list_t*>( this )->lock();
+		const_cast<list_t*>( this )->lock_shared();
 
 		uint32_t locCnt = size();
 
@@ -1410,7 +1758,7 @@ private:
 			if ( nullptr == xCurr )
 				xCurr = head();
 
-			const_cast<list_t*>( this )->unlock();
+			const_cast<list_t*>( this )->unlock_shared();
 
 			// Mod index into range
 			uint32_t xIdx = static_cast<uint32_t> ( index < 0
@@ -1486,12 +1834,29 @@ private:
 			curr( xCurr );
 			return xCurr;
 		} else
-			const_cast<list_t*>( this )->unlock();
+			const_cast<list_t*>( this )->unlock_shared();
 
 		return nullptr;
 	}
 
 
+	/** @brief return the element that precedes position @a index after an insertion
+	  * Negative values count from the end, so -1 is behind tail. Values out of
+	  * range are clamped. Returns `nullptr` if the new element becomes head.
+	**/
+	elem_t* privGetPrevByPos( int32_t index ) const noexcept {
+		int64_t locCnt = size();
+		int64_t xPos   = index < 0 ? locCnt + 1 + index : index;
+
+		if ( xPos <= 0 )
+			return nullptr;
+		if ( xPos > locCnt )
+			xPos = locCnt;
+
+		return const_cast<elem_t*>( privGetElementByIndex( static_cast<int32_t>( xPos - 1 ) ) );
+	}
+
+
 	/// @brief preparation method to insert data behind data
 	virtual uint32_t privInsDataBehindData( data_t* prev, data_t* data ) {
 		// 1: Prepare the previous element
@@ -1678,6 +2043,33 @@ private:
 	}
 
 
+	/** @brief take over all elements of @a src, this list must be empty
+	  *
+	  * The elements are registered with the curr store of @a src, so
+	  * that store moves along with them, and @a src gets the store of
+	  * this list instead.
+	**/
+	void privMoveFrom( list_t& src ) noexcept {
+		PWX_DOUBLE_LOCK_GUARD( this, &src );
+
+		std::swap( currStore, src.currStore );
+		if ( src.currStore ) {
+			if ( src.beThreadSafe() )
+				src.currStore->enable_thread_safety();
+			else
+				src.currStore->disable_thread_safety();
+		}
+
+		head_.store( src.head_.exchange( nullptr, memOrdStore ), memOrdStore );
+		tail_.store( src.tail_.exchange( nullptr, memOrdStore ), memOrdStore );
+		eCount.store( src.eCount.exchange( 0, memOrdStore ), memOrdStore );
+		this->doRenumber.store( src.doRenumber.load( memOrdLoad ), memOrdStore );
+		isIndexed.store( src.isIndexed.exchange( false, memOrdStore ), memOrdStore );
+		listIndex.swap( src.listIndex );
+		src.listIndex.clear();
+	}
+
+
 	/** @brief remove the element after the specified data
 	  * If @a prev data can not be found, nothing happens and nullptr is returned.
 	  * @return nullptr if the element holding @a prev is the last element or the list is empty.
@@ -1706,6 +2098,9 @@ private:
 	virtual elem_t* privRemoveAfterElement( elem_t* prev ) noexcept {
 		elem_t* removed = nullptr;
 
+		// An indexed list must update links and index in one go
+		PWX_NAMED_LOCK_GUARD( indexed, isIndexed.load( memOrdLoad ) ? this : NULL_LOCK );
+
 		/* The three possibilities are:
 		 * a) prev is nullptr and head must be removed
 		 * b) prev->next is tail thus tail must be removed
@@ -1755,13 +2150,15 @@ private:
 
 		// If something was removed, the count must be decreased:
 		if ( removed ) {
+			protIndexRemove( removed );
 			if ( 1 == eCount.fetch_sub( 1, memOrdStore ) ) {
 				this->lock();
 				// The list is empty. Or is it?
 				if ( 0 == eCount.load( memOrdLoad ) ) {
 					head( nullptr );
 					tail( nullptr );
-					currStore.clear();
+					if ( currStore )
+						currStore->clear();
 				}
 				this->unlock();
 			}
@@ -1777,6 +2174,7 @@ private:
 	*/
 
 	neighbor_t head_ = ATOMIC_VAR_INIT( nullptr ); //!< pointer to the first element
+	index_t    listIndex;                          //!< Positional index, only used if isIndexed is true
 	neighbor_t tail_ = ATOMIC_VAR_INIT( nullptr ); //!< pointer to the last element
 }; // class TSingleList
 
@@ -1798,6 +2196,9 @@ TSingleList<data_t, elem_t>::~TSingleList() noexcept {
 	while ( waiting() ) {
 		PWX_LOCK_GUARD_RESET( this );
 	}
+
+	// Elements unregister from the store when they are removed
+	delete currStore;
 }
 
 
@@ -86,7 +86,7 @@ public:
 	  *
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
-	TSingleRing ( void ( *destroy_ ) ( data_t* data ) ) noexcept :
+	TSingleRing ( void ( *destroy_ ) ( data_t* data ) ) :
 		base_t ( destroy_ )
 	{ }
 
@@ -96,7 +96,7 @@ public:
 	  * The empty constructor uses the base constructor to set the data
 	  * destroy method to the null pointer.
 	**/
-	TSingleRing() noexcept :
+	TSingleRing() :
 		base_t ( nullptr )
 	{ }
 
@@ -107,13 +107,25 @@ public:
 	  *
 	  * @param[in] src reference of the ring to copy.
 	**/
-	TSingleRing ( list_t const& src ) noexcept :
+	TSingleRing ( list_t const& src ) :
 		base_t ( src ) {
 		// TSingleList copies the elements
 		privConnectEnds(); // All we have to do here!
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time,
+	  * @a src is left empty. The ring stays closed.
+	  *
+	  * @param[in] src rvalue reference of the ring to move.
+	**/
+	TSingleRing ( list_t&& src ) noexcept :
+		base_t ( std::move( src ) )
+	{ }
+
+
 	/** @brief default destructor
 	  *
 	  * This destructor will delete all elements currently stored. There is no
@@ -179,12 +191,54 @@ public:
 	}
 
 
+	using base_t::disable_indexing;
 	using base_t::empty;
+	using base_t::enable_indexing;
 	using base_t::find;
 	using base_t::get;
 	using base_t::getData;
 
 
+	/** @brief insert a new data pointer at the given position
+	  *
+	  * This method inserts a new element in the ring, that gets
+	  * the position @a index. Negative values count from the end,
+	  * an @a index of -1 puts the new element behind the tail.
+	  * Values out of range are pressed into the valid range.
+	  *
+	  * If the new element can not be created, a `pwx::CException`
+	  * with the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] index the position the new element gets.
+	  * @param[in] data the pointer that is to be added.
+	  * @return the number of elements in this ring after the insertion
+	**/
+	virtual uint32_t insAt ( int32_t index, data_t* data ) {
+		PWX_TRY_PWX_FURTHER ( base_t::insAt ( index, data ) )
+		return privConnectEnds();
+	}
+
+
+	/** @brief insert an element copy at the given position
+	  *
+	  * This method inserts a copy of @a src in the ring, that gets
+	  * the position @a index. Negative values count from the end,
+	  * an @a index of -1 puts the new element behind the tail.
+	  * Values out of range are pressed into the valid range.
+	  *
+	  * If the new element can not be created, a `pwx::CException`
+	  * with the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] index the position the new element gets.
+	  * @param[in] src reference to the element to copy.
+	  * @return the number of elements in this ring after the insertion
+	**/
+	virtual uint32_t insAt ( int32_t index, elem_t const& src ) {
+		PWX_TRY_PWX_FURTHER ( base_t::insAt ( index, src ) )
+		return privConnectEnds();
+	}
+
+
 	/** @brief insert a new data pointer after the specified data
 	  *
 	  * This method inserts a new element in the ring after the element
@@ -487,6 +541,20 @@ public:
 	}
 
 
+	/** @brief move assignment operator
+	  *
+	  * Clears this ring and takes over all elements
+	  * of @a rhs, which is left empty.
+	  *
+	  * @param[in] rhs rvalue reference of the ring to move.
+	  * @return reference to this.
+	**/
+	virtual list_t& operator= ( list_t&& rhs ) noexcept {
+		base_t::operator= ( std::move( rhs ) );
+		return *this;
+	}
+
+
 	/** @brief addition assignment operator
 	  *
 	  * Add all elements from @a rhs to this ring.
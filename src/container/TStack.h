@@ -65,6 +65,10 @@ namespace pwx {
   * resides. Please keep that in mind. However, push() and pop() will always do
   * the right thing for you.
   *
+  * The optional second template parameter is the element type. Use
+  * `pwx::TSingleElement<data_t, pwx::CAllocPolicyPool>` to have the memory of
+  * popped elements recycled instead of returned to the heap.
+  *
   * It is recommended that you use the much more advanced `std::stack` or
   * `std::deque`unless you need to store a very large number of elements and can not
   * live with the downside of every element having to be copied into the std
@@ -72,17 +76,17 @@ namespace pwx {
   *
   * @see `pwx::TSingleList` for further information.
 **/
-template<typename data_t>
-class PWX_API TStack : public TSingleList<data_t> {
+template<typename data_t, typename element_t = TSingleElement<data_t> >
+class PWX_API TStack : public TSingleList<data_t, element_t> {
 public:
 	/* ===============================================
 	 * === Public types                            ===
 	 * ===============================================
 	*/
 
-	typedef TSingleElement<data_t>      elem_t; //!< Type of the stored elements
+	typedef element_t                   elem_t; //!< Type of the stored elements
 	typedef TSingleList<data_t, elem_t> base_t; //!< Base type of the stack
-	typedef TStack<data_t>              list_t; //!< Type of this stack
+	typedef TStack<data_t, elem_t>      list_t; //!< Type of this stack
 
 
 	/* ===============================================
@@ -96,7 +100,7 @@ public:
 	  *
 	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
 	**/
-	TStack ( void ( *destroy_ ) ( data_t* data ) ) noexcept :
+	TStack ( void ( *destroy_ ) ( data_t* data ) ) :
 		base_t( destroy_ )
 	{ }
 
@@ -105,7 +109,7 @@ public:
 	  *
 	  * The empty constructor sets the data destroy method to the null pointer.
 	**/
-	TStack() noexcept :
+	TStack() :
 		base_t ( nullptr )
 	{ }
 
@@ -116,12 +120,24 @@ public:
 	  *
 	  * @param[in] src reference of the list to copy.
 	**/
-	TStack ( list_t const& src ) noexcept :
+	TStack ( list_t const& src ) :
 		base_t ( src ) {
 		// The copy ctor of base_t has already copied all elements.
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over all elements of @a src in constant time,
+	  * @a src is left empty.
+	  *
+	  * @param[in] src rvalue reference of the stack to move.
+	**/
+	TStack ( list_t&& src ) noexcept :
+		base_t ( std::move( src ) )
+	{ }
+
+
 	virtual ~TStack() noexcept;
 
 
@@ -133,14 +149,18 @@ public:
 	using base_t::clear;
 	using base_t::delNext;
 	using base_t::delNextElem;
+	using base_t::disable_indexing;
 	using base_t::disable_thread_safety;
 	using base_t::empty;
+	using base_t::enable_indexing;
 	using base_t::enable_thread_safety;
 	using base_t::find;
 	using base_t::get;
 	using base_t::getData;
+	using base_t::insAt;
 	using base_t::insNext;
 	using base_t::insNextElem;
+	using base_t::is_indexed;
 
 
 	/** @brief pop the top element from the stack
@@ -318,6 +338,33 @@ public:
 	 * ===============================================
 	*/
 
+	/** @brief assignment operator
+	  *
+	  * Clears this stack and copies all elements from @a rhs into it.
+	  *
+	  * @param[in] rhs reference of the stack to copy.
+	  * @return reference to this.
+	**/
+	list_t& operator= ( list_t const& rhs ) {
+		PWX_TRY_PWX_FURTHER ( base_t::operator= ( rhs ) )
+		return *this;
+	}
+
+
+	/** @brief move assignment operator
+	  *
+	  * Clears this stack and takes over all elements
+	  * of @a rhs, which is left empty.
+	  *
+	  * @param[in] rhs rvalue reference of the stack to move.
+	  * @return reference to this.
+	**/
+	list_t& operator= ( list_t&& rhs ) noexcept {
+		base_t::operator= ( std::move( rhs ) );
+		return *this;
+	}
+
+
 	using base_t::operator=;
 	using base_t::operator+=;
 	using base_t::operator-=;
@@ -338,8 +385,8 @@ protected:
   * This destructor will delete all elements currently stored. There is no
   * need to clean up manually before deleting the stack.
 **/
-template<typename data_t>
-TStack<data_t>::~TStack() noexcept
+template<typename data_t, typename element_t>
+TStack<data_t, element_t>::~TStack() noexcept
 { /* done in base_t dtor */ }
 
 } // namespace pwx
@@ -0,0 +1,694 @@
+#ifndef PWX_LIBPWX_PWX_CONTAINER_TSWISSHASH_H_INCLUDED
+#define PWX_LIBPWX_PWX_CONTAINER_TSWISSHASH_H_INCLUDED
+#pragma once
+
+/** @file TSwissHash.h
+  *
+  * @brief Declaration of an open hash container probing groups of fingerprints
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif // __SSE2__
+
+#include "basic/compiler.h"
+#include "basic/macros.h"
+
+#include "basic/CException.h"
+#include "basic/CLockable.h"
+#include "basic/CLockGuard.h"
+#include "basic/debug.h"
+#include "container/CHashBuilder.h"
+#include "container/THashElement.h"
+
+
+namespace pwx {
+
+
+/** @class TSwissHash PSwissHash <PSwissHash>
+  *
+  * @brief Open hash container probing groups of hash fingerprints
+  *
+  * TOpenHash has to load each element it probes to compare its key and hops,
+  * so every probe is a cache miss. This container keeps a separate byte array
+  * with one control byte per bucket instead. A control byte either marks the
+  * bucket as empty or deleted, or holds a 7 bit fingerprint of the hash of the
+  * key stored there.
+  *
+  * The buckets are organized in groups of 16. A lookup compares the
+  * fingerprint with all 16 control bytes of a group at once, using SSE2 where
+  * available, and only loads the elements whose fingerprint matches. If the
+  * group has an empty bucket, the key can not be in any later group. Otherwise
+  * the next group is probed quadratically.
+  *
+  * Keys are hashed with a THashBuilder using the hash policy @a policy_t,
+  * which defaults to CHashPolicyRNG, optionally with a user defined hash
+  * function, and the payloads are THashElement instances, just like in the
+  * other hash containers. The table size is always a power of two and the
+  * table grows when 7/8 of the buckets are used.
+  *
+  * The container is thread safe by locking. Lookups use a shared lock, so
+  * they do not block each other.
+**/
+template< typename key_t, typename data_t, typename elem_t = THashElement< key_t, data_t >, typename policy_t = CHashPolicyRNG >
+class PWX_API TSwissHash : public CLockable {
+public:
+
+	/* ===============================================
+	 * === Public types                            ===
+	 * ===============================================
+	*/
+
+	typedef CLockable                          base_t; //!< Base type of the hash
+	typedef TSwissHash< key_t, data_t, elem_t, policy_t > hash_t; //!< Type of this hash
+
+
+	/* ===============================================
+	 * === Public Constructors and destructors     ===
+	 * ===============================================
+	*/
+
+
+	/** @brief full constructor with key length
+	  *
+	  * The full constructor initializes an empty hash with user defined
+	  * delete method and hashing method with key length. The initial
+	  * size is the @a initSize raised to the next power of two, but
+	  * at least one group of 16 buckets.
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TSwissHash( uint32_t initSize,
+	            void ( * destroy_ )( data_t* data ),
+	            uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
+	            uint32_t keyLen_ )
+		  : destroy( destroy_ )
+		  , hash_limited( hash_ )
+		  , hashBuilder( keyLen_ ) {
+		PWX_TRY_PWX_FURTHER( privCreateTable( initSize ) )
+	}
+
+
+	/** @brief full constructor without key length
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	**/
+	TSwissHash( uint32_t initSize,
+	            void ( * destroy_ )( data_t* data ),
+	            uint32_t ( * hash_ )( const key_t* key ) )
+		  : destroy( destroy_ )
+		  , hash_user( hash_ ) {
+		PWX_TRY_PWX_FURTHER( privCreateTable( initSize ) )
+	}
+
+
+	/** @brief size and key length constructor
+	  *
+	  * @param[in] initSize The initial size of the table.
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TSwissHash( uint32_t initSize, uint32_t keyLen_ )
+		  : TSwissHash( initSize, nullptr, nullptr, keyLen_ )
+	{ }
+
+
+	/** @brief limiting user method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored and takes an optional keyLen
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	TSwissHash( void ( * destroy_ )( data_t* data ),
+	            uint32_t ( * hash_ )( const key_t* key, uint32_t keyLen ),
+	            uint32_t keyLen_ )
+		  : TSwissHash( 128, destroy_, hash_, keyLen_ )
+	{ }
+
+
+	/** @brief user method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	  * @param[in] hash_ A pointer to a function that can hash the keys that are stored
+	**/
+	TSwissHash( void ( * destroy_ )( data_t* data ),
+	            uint32_t ( * hash_ )( const key_t* key ) )
+		  : TSwissHash( 128, destroy_, hash_ )
+	{ }
+
+
+	/** @brief destroy method constructor
+	  *
+	  * @param[in] destroy_ A pointer to a function that is to be used to destroy the data
+	**/
+	explicit TSwissHash( void ( * destroy_ )( data_t* data ) )
+		  : TSwissHash( 128, destroy_, nullptr, 0 )
+	{ }
+
+
+	/** @brief key length constructor
+	  *
+	  * @param[in] keyLen_ optional limiting key length for C-Strings and std::string keys
+	**/
+	explicit TSwissHash( uint32_t keyLen_ )
+		  : TSwissHash( 128, nullptr, nullptr, keyLen_ )
+	{ }
+
+
+	/** @brief empty constructor
+	  *
+	  * The empty constructor sets the data destroy method and the hash
+	  * method to the null pointer and the initial size to 128.
+	**/
+	TSwissHash()
+		  : TSwissHash( 128, nullptr, nullptr, 0 )
+	{ }
+
+
+	TSwissHash( hash_t const& ) PWX_DELETE;
+	TSwissHash( hash_t const&& ) PWX_DELETE;
+	hash_t& operator=( hash_t const& ) PWX_DELETE;
+	hash_t& operator=( hash_t const&& ) PWX_DELETE;
+
+
+	/** @brief default destructor
+	  *
+	  * This destructor will delete all elements currently stored.
+	**/
+	virtual ~TSwissHash() noexcept {
+		PWX_LOCK_GUARD( this );
+		isDestroyed.store( true, memOrdStore );
+		privClear();
+		delete [] groups;
+		delete [] slots;
+		groups = nullptr;
+		slots  = nullptr;
+	}
+
+
+	/* ===============================================
+	 * === Public methods                          ===
+	 * ===============================================
+	*/
+
+
+	/** @brief add a key-data-pair to the hash
+	  *
+	  * This method adds a new element to the hash if @a key
+	  * is not present, yet.
+	  *
+	  * If the new element can not be created, a pwx::CException
+	  * with the name "ElementCreationFailed" is thrown.
+	  *
+	  * @param[in] key the key of the new element
+	  * @param[in] data pointer to the data of the new element
+	  * @return the resulting number of stored elements
+	**/
+	uint32_t add( const key_t &key, data_t* data ) {
+		uint32_t hash = privGetHash( key );
+
+		PWX_LOCK_GUARD( this );
+
+		if ( nullptr == privFind( key, hash ) ) {
+			// Grow if no empty bucket may be used any more. If half of the
+			// buckets are tombstones, a rehash at the same size is enough.
+			if ( 0 == growthLeft ) {
+				PWX_TRY_PWX_FURTHER( privRehash( eCount.load( memOrdLoad ) * 2 > capacity ? capacity * 2 : capacity ) )
+			}
+
+			elem_t* newElement = nullptr;
+			PWX_TRY( newElement = new elem_t( key, data, destroy ) )
+			catch ( std::exception &e ) PWX_THROW( "ElementCreationFailed", e.what(), "The Creation of a new hash element failed." );
+
+			if ( !this->beThreadSafe() ) {
+				newElement->disable_thread_safety();
+			}
+
+			privInsert( newElement, hash );
+		}
+
+		return eCount.load( memOrdLoad );
+	}
+
+
+	/** @brief delete all elements
+	  *
+	  * This is a quick way to get rid of all elements at once.
+	  * If a destroy() function was set, it is used for the data
+	  * deletion. Otherwise it is assumed that data_t responds
+	  * to the delete operator.
+	**/
+	void clear() noexcept {
+		PWX_LOCK_GUARD( this );
+		privClear();
+	}
+
+
+	/** @brief delete the element with the key @a key
+	  *
+	  * If the hash table does not contain an element with the key
+	  * @a key, nothing happens.
+	  *
+	  * @param key reference to the key to search for
+	  * @return The number of elements after the operation.
+	**/
+	uint32_t delKey( const key_t &key ) noexcept {
+		elem_t* toDelete = remKey( key );
+		if ( toDelete ) {
+			PWX_TRY( delete toDelete )
+			log_debug_caught_std( "delete element" )
+			catch ( ... ) { /* Can't do anything about that! */ }
+		}
+		return size();
+	}
+
+
+	/// @brief return true if the hash is empty
+	bool empty() const noexcept {
+		return 0 == eCount.load( memOrdLoad );
+	}
+
+
+	/// @brief return true if an element with @a key exists
+	bool exists( const key_t &key ) const noexcept {
+		return nullptr != get( key );
+	}
+
+
+	/** @brief returns a pointer to the element with the key @a key
+	  *
+	  * @param[in] key the key to search for
+	  * @return a pointer to the element or nullptr if the key could not be found.
+	**/
+	elem_t* get( const key_t &key ) const noexcept {
+		uint32_t hash = privGetHash( key );
+		PWX_SHARED_LOCK_GUARD( this );
+		return privFind( key, hash );
+	}
+
+
+	/** @brief returns a reference to the stored data with key @a key
+	  *
+	  * If the key can not be found, a pwx::CException with the name
+	  * "NullDataException" is thrown.
+	  *
+	  * @param[in] key the key to search for
+	  * @return a read/write reference to the stored data.
+	**/
+	data_t &getData( const key_t &key ) const {
+		elem_t* elem = get( key );
+		if ( nullptr == elem )
+			PWX_THROW( "NullDataException", "key not found",
+			           "TSwissHash has no element with the given key" )
+		return **elem;
+	}
+
+
+	/** @brief return the number of groups probed when the element was inserted
+	  *
+	  * @param[in] key The key to search for
+	  * @return number of hops needed, or zero if the key is not found.
+	**/
+	uint32_t getHops( const key_t &key ) const noexcept {
+		elem_t* elem = get( key );
+		return elem ? elem->hops : 0;
+	}
+
+
+	/** @brief remove the element with the key @a key and return it
+	  *
+	  * You have to delete the removed element by yourself.
+	  *
+	  * @param[in] key the key of the element to remove
+	  * @return a pointer to the removed element or nullptr if the key was not found
+	**/
+	elem_t* remKey( const key_t &key ) noexcept {
+		uint32_t hash = privGetHash( key );
+		uint32_t idx  = 0;
+
+		PWX_LOCK_GUARD( this );
+
+		elem_t* result = privFind( key, hash, &idx );
+		if ( result ) {
+			privErase( idx );
+			result->remove();
+		}
+
+		return result;
+	}
+
+
+	/** @brief reserve room for at least @a count elements
+	  *
+	  * The table is grown, so that @a count elements fit in without
+	  * another growth. Tables are never shrunk.
+	  *
+	  * @param[in] count number of elements to make room for
+	  * @return the resulting number of buckets
+	**/
+	uint32_t reserve( uint32_t count ) {
+		PWX_LOCK_GUARD( this );
+		uint32_t needed = static_cast<uint32_t>( static_cast<uint64_t>( count ) * 8 / 7 ) + 1;
+		if ( needed > capacity ) {
+			PWX_TRY_PWX_FURTHER( privRehash( needed ) )
+		}
+		return capacity;
+	}
+
+
+	/// @brief return the number of stored elements
+	uint32_t size() const noexcept {
+		return eCount.load( memOrdLoad );
+	}
+
+
+	/// @brief return the number of buckets of the table
+	uint32_t sizeMax() const noexcept {
+		PWX_SHARED_LOCK_GUARD( this );
+		return capacity;
+	}
+
+
+private:
+
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal 16 control bytes, aligned for a single SSE2 load
+	struct alignas( 16 ) sGroup {
+		int8_t ctrl[16];
+	};
+
+
+	/* ===============================================
+	 * === Private methods                         ===
+	 * ===============================================
+	*/
+
+	/// @internal Delete all elements and mark all buckets as empty
+	void privClear() noexcept PWX_LOCAL {
+		for ( uint32_t i = 0 ; slots && ( i < capacity ) ; ++i ) {
+			if ( slots[i] ) {
+				PWX_TRY( delete slots[i] )
+				log_debug_caught_std( "delete element" )
+				catch ( ... ) { /* Can't do anything about that! */ }
+				slots[i] = nullptr;
+			}
+		}
+		if ( groups ) {
+			memset( groups, ctrlEmpty, sizeof( sGroup ) * ( capacity / groupSize ) );
+		}
+		eCount.store( 0, memOrdStore );
+		growthLeft = privGetMaxCount( capacity );
+	}
+
+
+	/// @internal Create an empty table with at least @a minSize buckets
+	void privCreateTable( uint32_t minSize ) PWX_LOCAL {
+		uint32_t tabSize = groupSize;
+		while ( ( tabSize < minSize ) && ( tabSize < 0x80000000 ) )
+			tabSize <<= 1;
+
+		sGroup*  newGroups = nullptr;
+		elem_t** newSlots  = nullptr;
+		try {
+			newGroups = new sGroup[tabSize / groupSize];
+			newSlots  = new elem_t*[tabSize];
+		} catch ( std::exception &e ) {
+			delete [] newGroups;
+			PWX_THROW( "TableCreationFailed", e.what(), "The hash table could not be created" )
+		}
+
+		memset( newGroups, ctrlEmpty, sizeof( sGroup ) * ( tabSize / groupSize ) );
+		memset( newSlots, 0, sizeof( elem_t* ) * tabSize );
+
+		groups     = newGroups;
+		slots      = newSlots;
+		capacity   = tabSize;
+		groupMask  = tabSize / groupSize - 1;
+		growthLeft = privGetMaxCount( tabSize ) - eCount.load( memOrdLoad );
+	}
+
+
+	/** @internal Mark bucket @a idx as free
+	  *
+	  * Lookups stop at groups that have an empty bucket. So if the group
+	  * of @a idx already has an empty bucket, no probe ever went past it
+	  * and the bucket can be made empty again. Otherwise it becomes a
+	  * tombstone, that is only cleaned up by the next rehash.
+	**/
+	void privErase( uint32_t idx ) noexcept PWX_LOCAL {
+		sGroup* group = &groups[idx / groupSize];
+
+		if ( privMatch( group, ctrlEmpty ) ) {
+			group->ctrl[idx % groupSize] = ctrlEmpty;
+			++growthLeft;
+		} else {
+			group->ctrl[idx % groupSize] = ctrlDeleted;
+		}
+
+		slots[idx] = nullptr;
+		eCount.fetch_sub( 1, memOrdStore );
+	}
+
+
+	/** @internal Find the element with @a key and @a hash
+	  *
+	  * @param[in] key the key to search for
+	  * @param[in] hash the hash of @a key from privGetHash()
+	  * @param[out] idx if not nullptr, the bucket index of the found element is stored here
+	  * @return the element or nullptr if it is not found.
+	**/
+	elem_t* privFind( const key_t &key, uint32_t hash, uint32_t* idx = nullptr ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		if ( isDestroyed.load( memOrdLoad ) || ( nullptr == groups ) ) {
+			return nullptr;
+		}
+
+		int8_t   fprint = privGetFingerprint( hash );
+		uint32_t grpIdx = ( hash >> 7 ) & groupMask;
+
+		for ( uint32_t step = 1 ; step <= groupMask + 1 ; ++step ) {
+			const sGroup* group = &groups[grpIdx];
+			uint32_t      hits  = privMatch( group, fprint );
+
+			// Only buckets with a matching fingerprint are loaded
+			while ( hits ) {
+				uint32_t pos   = grpIdx * groupSize + privLowestBit( hits );
+				elem_t*  xCurr = slots[pos];
+				if ( xCurr->key == key ) {
+					if ( idx ) {
+						*idx = pos;
+					}
+					return xCurr;
+				}
+				hits &= hits - 1;
+			}
+
+			// An empty bucket means that the key was never stored further
+			if ( privMatch( group, ctrlEmpty ) ) {
+				return nullptr;
+			}
+
+			grpIdx = ( grpIdx + step ) & groupMask;
+		}
+
+		return nullptr;
+	}
+
+
+	/// @internal The fingerprint are the lowest 7 bits of the hash
+	static int8_t privGetFingerprint( uint32_t hash ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+		return static_cast<int8_t>( hash & 0x7f );
+	}
+
+
+	/** @internal Get the hash of @a key
+	  *
+	  * The final mix makes sure that both the fingerprint and the
+	  * group index depend on all bits of the built hash.
+	**/
+	uint32_t privGetHash( const key_t &key ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t hash = hashBuilder( &key, hash_user, hash_limited );
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6b;
+		hash ^= hash >> 13;
+		hash *= 0xc2b2ae35;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+
+	/// @internal Maximum number of used buckets (elements and tombstones) in a table of @a tabSize buckets
+	static uint32_t privGetMaxCount( uint32_t tabSize ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+		return tabSize - tabSize / 8;
+	}
+
+
+	/** @internal Insert @a elem into the first free bucket of its probe sequence
+	  * The key must not be stored already, and there must be room left.
+	**/
+	void privInsert( elem_t* elem, uint32_t hash ) noexcept PWX_LOCAL {
+		uint32_t grpIdx = ( hash >> 7 ) & groupMask;
+		uint32_t hops   = 0;
+		uint32_t frees  = privMatchFree( &groups[grpIdx] );
+
+		while ( 0 == frees ) {
+			++hops;
+			grpIdx = ( grpIdx + hops ) & groupMask;
+			frees  = privMatchFree( &groups[grpIdx] );
+		}
+
+		uint32_t slot = privLowestBit( frees );
+		int8_t&  ctrl = groups[grpIdx].ctrl[slot];
+
+		if ( ctrlEmpty == ctrl ) {
+			--growthLeft;
+		}
+		ctrl = privGetFingerprint( hash );
+
+		slots[grpIdx * groupSize + slot] = elem;
+		elem->hops = hops;
+		elem->insertAsFirst();
+		eCount.fetch_add( 1, memOrdStore );
+	}
+
+
+	/// @internal Return the index of the lowest set bit in @a mask, which must not be zero
+	static uint32_t privLowestBit( uint32_t mask ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+#if defined(__GNUC__)
+		return static_cast<uint32_t>( __builtin_ctz( mask ) );
+#else
+		uint32_t result = 0;
+		while ( !( mask & 1 ) ) {
+			mask >>= 1;
+			++result;
+		}
+		return result;
+#endif // __GNUC__
+	}
+
+
+	/// @internal Return a bit mask of all buckets in @a group with control byte @a value
+	static uint32_t privMatch( const sGroup* group, int8_t value ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+#if defined(__SSE2__)
+		__m128i ctrl = _mm_load_si128( reinterpret_cast<const __m128i*>( group->ctrl ) );
+		return static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( ctrl, _mm_set1_epi8( value ) ) ) );
+#else
+		uint32_t result = 0;
+		for ( uint32_t i = 0 ; i < groupSize ; ++i ) {
+			if ( group->ctrl[i] == value ) {
+				result |= 1U << i;
+			}
+		}
+		return result;
+#endif // __SSE2__
+	}
+
+
+	/// @internal Return a bit mask of all empty or deleted buckets in @a group
+	static uint32_t privMatchFree( const sGroup* group ) noexcept PWX_LOCAL PWX_WARNUNUSED {
+#if defined(__SSE2__)
+		// Both empty and deleted have the sign bit set, fingerprints don't.
+		__m128i ctrl = _mm_load_si128( reinterpret_cast<const __m128i*>( group->ctrl ) );
+		return static_cast<uint32_t>( _mm_movemask_epi8( ctrl ) );
+#else
+		uint32_t result = 0;
+		for ( uint32_t i = 0 ; i < groupSize ; ++i ) {
+			if ( group->ctrl[i] < 0 ) {
+				result |= 1U << i;
+			}
+		}
+		return result;
+#endif // __SSE2__
+	}
+
+
+	/** @internal Move all elements into a new table with at least @a minSize buckets
+	  * The elements themselves are moved, not copied. Tombstones are dropped.
+	**/
+	void privRehash( uint32_t minSize ) PWX_LOCAL {
+		sGroup*  oldGroups = groups;
+		elem_t** oldSlots  = slots;
+		uint32_t oldSize   = capacity;
+
+		PWX_TRY_PWX_FURTHER( privCreateTable( minSize ) )
+
+		uint32_t count = eCount.exchange( 0, memOrdStore );
+		growthLeft = privGetMaxCount( capacity );
+
+		for ( uint32_t i = 0 ; count && ( i < oldSize ) ; ++i ) {
+			elem_t* elem = oldSlots[i];
+			if ( elem ) {
+				privInsert( elem, privGetHash( elem->key ) );
+				--count;
+			}
+		}
+
+		delete [] oldGroups;
+		delete [] oldSlots;
+	}
+
+
+	/* ===============================================
+	 * === Private members                         ===
+	 * ===============================================
+	*/
+
+	static const uint32_t groupSize   = 16;  //!< Number of buckets probed at once
+	static const int8_t   ctrlEmpty   = -128; //!< Control byte of a never used bucket
+	static const int8_t   ctrlDeleted = -2;  //!< Control byte of a bucket whose element was removed
+
+	void     ( * destroy )( data_t* data ) = nullptr;                      //!< Optional destroy function for the data
+	uint32_t ( * hash_user )( const key_t* key ) = nullptr;                //!< Optional user hash function
+	uint32_t ( * hash_limited )( const key_t* key, uint32_t keyLen ) = nullptr; //!< Optional user hash function with key length
+
+	THashBuilder<policy_t> hashBuilder { 0 }; //!< Builds the hashes of the keys
+	uint32_t     capacity    = 0;         //!< Number of buckets, always a power of two
+	aui32_t      eCount      { 0 };       //!< Number of stored elements, read without a lock by size() and empty()
+	sGroup*      groups      = nullptr;   //!< Control bytes, one group per 16 buckets
+	uint32_t     groupMask   = 0;         //!< Number of groups - 1
+	uint32_t     growthLeft  = 0;         //!< Number of empty buckets that can still be used before growing
+	elem_t**     slots       = nullptr;   //!< The elements
+}; // class TSwissHash
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_CONTAINER_TSWISSHASH_H_INCLUDED
@@ -36,6 +36,8 @@
 #include "basic/macros.h"
 #include "basic/debug.h"
 
+#include "basic/CEpochGuard.h"
+
 #include "container/VElement.h"
 #include "container/CThreadElementStore.h"
 
@@ -44,6 +46,10 @@
 namespace pwx {
 
 
+/// @internal Set by the destructor if the element to be freed next was not thread safe
+static thread_local bool deletedIsLocal; // Zero initialized and trivially destructible
+
+
 VElement::VElement() noexcept
 { }
 
@@ -54,6 +60,9 @@ VElement::VElement( const VElement& src ) noexcept
 
 VElement::~VElement() noexcept {
 	this->remove();
+	// operator delete follows directly, and nobody else can have
+	// followed an element that was never meant to be shared.
+	deletedIsLocal = !this->beThreadSafe();
 }
 
 
@@ -92,8 +101,11 @@ uint32_t VElement::nr( uint32_t const nr_ ) const noexcept {
 
 void VElement::remove() noexcept {
 	isRemoved.store( true, memOrdStore );
-	if ( currStore )
+	if ( currStore ) {
 		currStore->invalidate( this );
+		// The store goes away with its container, which might happen first
+		currStore = nullptr;
+	}
 }
 
 
@@ -108,4 +120,29 @@ VElement& VElement::operator=( const VElement& src ) noexcept {
 }
 
 
+/// @internal Give the memory of a retired element back
+static void reclaim_element( void* ptr, void* ) noexcept {
+	::operator delete( ptr );
+}
+
+
+void* VElement::operator new( size_t size ) {
+	return ::operator new( size );
+}
+
+
+void VElement::operator delete( void* ptr, size_t ) noexcept {
+	protFreeElement( ptr, reclaim_element, nullptr );
+}
+
+
+void VElement::protFreeElement( void* ptr, epoch_reclaim_t reclaim, void* ctx ) noexcept {
+	if ( deletedIsLocal ) {
+		deletedIsLocal = false;
+		reclaim( ptr, ctx );
+	} else
+		epoch_free( ptr, reclaim, ctx );
+}
+
+
 } // namespace pwx
@@ -37,6 +37,7 @@
 
 #include "basic/compiler.h"
 
+#include "basic/CEpochGuard.h"
 #include "basic/CLockable.h"
 #include "basic/types.h"
 
@@ -56,6 +57,12 @@ class CThreadElementStore;
   * This class is strictly virtual. ALl element templates have
   * to inherit public from this base class.
   *
+  * The memory of deleted thread safe elements is not freed while another
+  * thread is inside a `pwx::CEpochGuard`, but retired with
+  * `pwx::epoch_retire()`. A reader inside a guard can therefore still
+  * follow an element that another thread removes and deletes. The
+  * destructor runs immediately, so such a reader has to check `destroyed()`.
+  *
   * Notes:
   * + eNr does not need a lock, it is atomic.
   * + eNr needs no const_cast, it is mutable.
@@ -177,8 +184,34 @@ public:
 	VElement& operator=( const VElement& src ) noexcept;
 
 
+	/// @brief elements are allocated using the global `operator new`
+	static void* operator new( size_t size );
+
+
+	/// @brief the memory of deleted elements is freed once no reader can hold it any more
+	static void operator delete( void* ptr, size_t size ) noexcept;
+
+
 protected:
 
+	/* ===============================================
+	 * === Protected methods                       ===
+	 * ===============================================
+	 */
+
+	/** @brief free the memory of the element that was just destroyed
+	  *
+	  * Only to be called by `operator delete`. The memory is freed at
+	  * once if the element was not thread safe or if no thread is
+	  * inside a `pwx::CEpochGuard`. Otherwise it is retired.
+	  *
+	  * @param[in] ptr the memory of the element.
+	  * @param[in] reclaim the function that frees @a ptr.
+	  * @param[in] ctx any value @a reclaim needs besides @a ptr.
+	**/
+	static void protFreeElement( void* ptr, epoch_reclaim_t reclaim, void* ctx ) noexcept;
+
+
 	/* ===============================================
 	 * === Protected members                       ===
 	 * ===============================================
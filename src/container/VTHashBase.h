@@ -40,13 +40,20 @@
 **/
 
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <exception>
+#include <iterator>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 #include "basic/compiler.h"
 #include "basic/macros.h"
+#include "basic/thread_pool.h"
 
 #include "container/CHashBuilder.h"
 #include "container/THashElement.h"
@@ -103,15 +110,40 @@ namespace pwx {
     PWX_LOCK_GUARD_CLEAR()
 
 
-/// @brief Support macro to wait for possible growing actions to finish
+/// @brief Support macro to wait for possible growing actions, including incremental ones, to finish
 #define HASH_WAIT_FOR_CLEAR_AND_GROW \
     PWX_LOCK_GUARD(this); \
     while ( growing.load(memOrdLoad) || clearing.load(memOrdLoad) ) { \
         PWX_LOCK_GUARD_RESET(this); \
     } \
+    privFinishMigration(); \
     PWX_LOCK_GUARD_CLEAR()
 
 
+/** @brief Like HASH_WAIT_FOR_CLEAR_AND_GROW, but for noexcept methods
+  * If the migration can not be finished, the remaining buckets simply stay
+  * in the old table, where lookups find them anyway.
+**/
+#define HASH_NOTHROW_WAIT_FOR_CLEAR_AND_GROW \
+    PWX_LOCK_GUARD(this); \
+    while ( growing.load(memOrdLoad) || clearing.load(memOrdLoad) ) { \
+        PWX_LOCK_GUARD_RESET(this); \
+    } \
+    PWX_TRY( privFinishMigration() ) \
+    log_debug_caught_std( "finishing a migration" ) \
+    catch ( ... ) { /* Whatever is left stays in the old table */ } \
+    PWX_LOCK_GUARD_CLEAR()
+
+
+/// @brief Support macro for readers to wait for possible growing actions to finish
+#define HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW \
+    PWX_SHARED_LOCK_GUARD(this); \
+    while ( growing.load(memOrdLoad) || clearing.load(memOrdLoad) ) { \
+        PWX_SHARED_LOCK_GUARD_RESET(this); \
+    } \
+    PWX_SHARED_LOCK_GUARD_CLEAR()
+
+
 /// @brief Support macro to have the clear method wait until all actions ceased
 #define HASH_START_CLEAR \
     PWX_LOCK_GUARD(this); \
@@ -154,8 +186,18 @@ enum eChainHashMethod {
   * call pure virtual private methods, that are then defined
   * in TChainHash and TOpenHash to provide the proper
   * collision resolving.
+  *
+  * Growing a large table by moving all elements at once can
+  * block the container for a long time. With
+  * enable_incremental_grow() the old table is kept after
+  * growing, and every add(), get(), exists() and delKey() call
+  * moves a small number of buckets into the new table.
+  * Lookups consult both tables until the migration is done.
+  *
+  * The hash policy @a policy_t decides how keys are turned into hashes,
+  * see THashBuilder. It defaults to CHashPolicyRNG.
 **/
-template< typename key_t, typename data_t, typename elem_t = THashElement< key_t, data_t > >
+template< typename key_t, typename data_t, typename elem_t = THashElement< key_t, data_t >, typename policy_t = CHashPolicyRNG >
 class VTHashBase : public VContainer {
 public:
 	/* ===============================================
@@ -164,7 +206,14 @@ public:
 	*/
 
 	typedef VContainer                          base_t; //!< Base type of the hash
-	typedef VTHashBase< key_t, data_t, elem_t > hash_t; //!< Type of this hash
+	typedef VTHashBase< key_t, data_t, elem_t, policy_t > hash_t; //!< Type of this hash
+
+	/// @brief Only valid for iterators to pairs of key and data pointer, used to enable the bulk constructors
+	template< typename iter_t >
+	using bulk_iter_t = typename std::enable_if <
+	                    std::is_convertible< decltype( std::declval< iter_t >()->first ), key_t >::value
+	                    && std::is_convertible< decltype( std::declval< iter_t >()->second ), data_t* >::value,
+	                    iter_t >::type;
 
 
 	/* ===============================================
@@ -397,7 +446,8 @@ public:
 		}
 
 		// Could have changed after a grow:
-		hashSize = src.hashSize;
+		hashSize.store( src.hashSize.load( memOrdLoad ), memOrdStore );
+		migrateStep = src.migrateStep;
 
 		// Generate the hash table
 		try {
@@ -419,6 +469,26 @@ public:
 	}
 
 
+	/** @brief move constructor
+	  *
+	  * Takes over the table of @a src with all its elements in constant
+	  * time. @a src keeps its settings and gets a new, empty table.
+	  *
+	  * If the new table can not be created, `std::exception` is caught and
+	  * thrown further as a `pwx::CException` with the name "VTHashBase failure".
+	  * @a src is unchanged then.
+	  *
+	  * @param[in] src rvalue reference of the hash to move.
+	  * @param[in] emptySize size of the new table of @a src. Hashes that
+	  *            restrict their table sizes must pass one that fits @a src.
+	**/
+	VTHashBase( hash_t &&src, uint32_t emptySize = 100 )
+		  : hash_t( emptySize, src.hashBuilder.getKeyLen(), src.maxLoadFactor, src.dynGrowFactor ) {
+		beThreadSafe( src.beThreadSafe() );
+		protMoveFrom( src );
+	}
+
+
 	virtual ~VTHashBase() noexcept;
 
 
@@ -446,6 +516,7 @@ public:
 			if ( !this->privGet( src.key ) ) {
 				double newSize = 0.;
 				PWX_TRY_PWX_FURTHER( newSize = privAdd( src ) )
+				PWX_TRY_PWX_FURTHER( privMigrate( migrateStep ) )
 				HASH_STOP_INSERT;
 
 				// Grow if needed
@@ -482,6 +553,7 @@ public:
 			if ( !this->privGet( key ) ) {
 				double newSize = 0.;
 				PWX_TRY_PWX_FURTHER( newSize = privAdd( key, data ) )
+				PWX_TRY_PWX_FURTHER( privMigrate( migrateStep ) )
 				HASH_STOP_INSERT;
 
 				// Grow if needed
@@ -520,6 +592,12 @@ public:
 
 		HASH_START_CLEAR;
 
+		// Elements not migrated, yet, are deleted together with the old table
+		if ( migrating.load( memOrdLoad ) ) {
+			PWX_DOUBLE_LOCK_GUARD( this, &hashTableLock );
+			privClearOld();
+		}
+
 		while ( ( eCount.load( std::memory_order_relaxed ) > 0 ) && hashTable ) {
 			// We have to use a temporary "grand lock" for cases where multiple threads
 			// call this method. Otherwise, no matter what we do, the destruction of elements
@@ -583,6 +661,7 @@ public:
 		HASH_START_REMOVE;
 
 		uint32_t remaining = 0;
+		PWX_TRY_PWX_FURTHER( privMigrateKey( elem.key ) )
 		elem_t* toDelete = privRemoveKey( elem.key );
 
 		PWX_TRY_PWX_FURTHER( remaining = protDelete( toDelete ) );
@@ -611,6 +690,7 @@ public:
 		HASH_START_REMOVE;
 
 		uint32_t remaining = 0;
+		PWX_TRY_PWX_FURTHER( privMigrateKey( key ) )
 		elem_t* toDelete = privRemoveKey( key );
 
 		PWX_TRY_PWX_FURTHER( remaining = protDelete( toDelete ) );
@@ -621,6 +701,21 @@ public:
 	}
 
 
+	/** @brief disable incremental growing
+	  *
+	  * A migration that is currently running is finished,
+	  * and all future grow() calls move all elements at once.
+	**/
+	virtual void disable_incremental_grow() {
+		PWX_LOCK_GUARD( this );
+		while ( growing.load( memOrdLoad ) || clearing.load( memOrdLoad ) ) {
+			PWX_LOCK_GUARD_RESET( this );
+		}
+		migrateStep = 0;
+		PWX_TRY_PWX_FURTHER( privFinishMigration() )
+	}
+
+
 	/** @brief disable thread safety
 	  *
 	  * This method disables all thread safety measures.
@@ -635,7 +730,7 @@ public:
 	  * lot of elements stored is therefore rather costly!
 	  */
 	virtual void disable_thread_safety() noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_NOTHROW_WAIT_FOR_CLEAR_AND_GROW;
 
 		// Turn off first
 		this->beThreadSafe( false );
@@ -644,29 +739,38 @@ public:
 		// the lock can finish their business first
 		PWX_LOCK_GUARD_RESET( this );
 
-		uint32_t pos     = 0;
-		uint32_t tabSize = this->sizeMax();
-		elem_t* xCurr = nullptr;
-		while ( pos < tabSize ) {
-			xCurr = table_get( pos );
-			if ( xCurr ) {
-				while ( xCurr ) {
-					xCurr->disable_thread_safety();
-					xCurr = xCurr->getNext();
-				}
-			}
-			++pos;
-		}
+		privElemThreadSafety( false );
 	}
 
 
 	/// @brief return true if this container is empty
 	virtual bool empty() const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
 		return !eCount.load( memOrdLoad );
 	}
 
 
+	/** @brief enable incremental growing
+	  *
+	  * When the table is grown, the old table is kept and its
+	  * buckets are moved into the new table a few at a time.
+	  * Every add() and delKey() call moves @a bucketsPerStep
+	  * buckets, and so does every get() and exists() call that
+	  * finds the container unlocked. Lookups search both tables
+	  * until the migration is done.
+	  *
+	  * All operations that work on the whole table, like the
+	  * assignment operators or the index operator, finish a
+	  * running migration first.
+	  *
+	  * @param[in] bucketsPerStep number of old buckets to migrate per operation. (Default: 16)
+	**/
+	virtual void enable_incremental_grow( uint32_t bucketsPerStep = 16 ) noexcept {
+		PWX_LOCK_GUARD( this );
+		migrateStep = bucketsPerStep ? bucketsPerStep : 1;
+	}
+
+
 	/** @brief enable thread safety
 	  *
 	  * This method enables all thread safety measures.
@@ -680,27 +784,17 @@ public:
 	virtual void enable_thread_safety() noexcept {
 		this->beThreadSafe( true );
 
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_NOTHROW_WAIT_FOR_CLEAR_AND_GROW;
 
-		uint32_t pos     = 0;
-		uint32_t tabSize = this->sizeMax();
-		elem_t* xCurr = nullptr;
-		while ( pos < tabSize ) {
-			xCurr = table_get( pos );
-			if ( xCurr ) {
-				while ( xCurr ) {
-					xCurr->enable_thread_safety();
-					xCurr = xCurr->getNext();
-				}
-			}
-			++pos;
-		}
+		PWX_LOCK_GUARD_RESET( this );
+		privElemThreadSafety( true );
 	}
 
 
 	/// @brief return true if an element with @a key exists
 	virtual bool exists( const key_t &key ) const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privHelpMigrate();
 		return this->privGet( key ) ? true : false;
 	}
 
@@ -711,7 +805,8 @@ public:
 	  * @return a const pointer to the element or nullptr if the key could not be found.
 	**/
 	virtual elem_t* get( const key_t &key ) const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privHelpMigrate();
 		return this->privGet( key );
 	}
 
@@ -722,11 +817,48 @@ public:
 	  * @return a pointer to the element or nullptr if the key could not be found.
 	**/
 	virtual elem_t* get( const key_t &key ) noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privHelpMigrate();
 		return const_cast<elem_t*>( this->privGet( key ) );
 	}
 
 
+	/** @brief look up @a n keys at once
+	  *
+	  * This is a batched get(). The keys are hashed and their buckets
+	  * prefetched before any of them is searched, so the cache misses
+	  * of many keys overlap instead of stalling one after another.
+	  * This pays off when looking up hundreds of keys in a table that
+	  * does not fit into the cache.
+	  *
+	  * @param[in] keys array of @a n keys to search for
+	  * @param[in] n number of keys in @a keys
+	  * @param[out] out array of @a n pointers receiving the elements, nullptr for keys not found
+	  * @return the number of keys found
+	**/
+	uint32_t get_many( const key_t* keys, uint32_t n, elem_t** out ) const noexcept {
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privHelpMigrate();
+		return privGetMany( keys, n, out, nullptr );
+	}
+
+
+	/** @brief check @a n keys for existence at once
+	  *
+	  * This is a batched exists(), see get_many().
+	  *
+	  * @param[in] keys array of @a n keys to search for
+	  * @param[in] n number of keys in @a keys
+	  * @param[out] out array of @a n flags, set to true for each key found
+	  * @return the number of keys found
+	**/
+	uint32_t exists_many( const key_t* keys, uint32_t n, bool* out ) const noexcept {
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privHelpMigrate();
+		return privGetMany( keys, n, nullptr, out );
+	}
+
+
 	/** @brief returns a read-only reference to the stored data with key @a key
 	  *
 	  * If the data pointer is nullptr, a pwx::CException with the name
@@ -753,6 +885,21 @@ public:
 	}
 
 
+	/** @brief return the primary hash this table uses for @a key
+	  *
+	  * This is the hash from the user hashing function given to the
+	  * constructor, or the built-in one for the key type. It is
+	  * independent of the table size, so it stays the same when the
+	  * table grows.
+	  *
+	  * @param[in] key the key to hash
+	  * @return the hash of @a key
+	**/
+	uint32_t getHash( const key_t &key ) const {
+		return protGetHash( &key );
+	}
+
+
 	/** @brief return the number of "hops" needed when the element was inserted
 	  *
 	  * This method returns the number of hops (or collisions) that
@@ -764,7 +911,7 @@ public:
 	  * @return number of hops needed.
 	**/
 	virtual uint32_t getHops( const key_t &key ) const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
 		elem_t* elem = privGet( key );
 		if ( elem ) {
 			return elem->hops;
@@ -777,6 +924,10 @@ public:
 	  * This method increases the hash table by creating a new
 	  * table and moving all elements into the new one.
 	  *
+	  * If incremental growing is enabled, the old table is kept
+	  * and the elements are moved bucket by bucket by the
+	  * following operations. See enable_incremental_grow().
+	  *
 	  * This method does not shrink a table. It does nothing if
 	  * @a targetSize is not larger than the current size.
 	  * Therefore the resulting size is returned for you to check.
@@ -792,62 +943,44 @@ public:
 
 			HASH_START_GROW;
 
+			// --- A previous migration must be done before the table is replaced again ---
+			PWX_TRY_PWX_FURTHER( privFinishMigration() )
+
 			// --- store old size ---
-			uint32_t oldSize = hashSize.load( memOrdLoad );
+			uint32_t curSize = hashSize.load( memOrdLoad );
 
-			if ( targetSize > oldSize ) {
-				log_debug( "Hash Grow", "Growing hash table from %u top %u", oldSize, targetSize );
+			if ( targetSize > curSize ) {
+				log_debug( "Hash Grow", "Growing hash table from %u top %u", curSize, targetSize );
 
 				// --- Create a new larger table ---
 				PWX_NAMED_LOCK_GUARD( table_lock, &hashTableLock );
-				elem_t** oldTab = hashTable;
+				elem_t** newTab = nullptr;
 				try {
-					hashTable = new elem_t* [targetSize];
-
-					// --- reset eCount, it will be restored by the move ---
-					eCount.store( 0, memOrdStore );
+					newTab = new elem_t* [targetSize];
 
 					// --- "nullify" the new table ---
 					for ( uint32_t i = 0 ; i < targetSize ; ++i ) {
-						table_set( i, nullptr );
+						newTab[i] = nullptr;
 					}
 				}
 				PWX_THROW_STD_FURTHER( "GrowFailure", "Larger HashTable could not be created" );
 
-				// --- Determine new hashing method ---
-				privSetHashMethod( targetSize );
+				// --- The current table becomes the migration source ---
+				oldTable   = hashTable;
+				oldSize    = curSize;
+				oldMethod  = CHMethod;
+				migratePos = 0;
+				migrating.store( true, memOrdStore );
 
-				// --- Set new size ---
+				// --- Determine new hashing method and set new size ---
+				hashTable = newTab;
+				privSetHashMethod( targetSize );
 				hashSize.store( targetSize, memOrdStore );
 
-				// --- Copy all elements ---
-				elem_t* toMove = nullptr;
-				elem_t* xNext  = nullptr;
-				uint32_t pos = 0;
-
-				while ( pos < oldSize ) {
-					// Note: hashTableLock is still locked, so we can directly edit the tables
-					while ( oldTab[pos] && ( oldTab[pos] != vacated ) ) {
-						toMove = oldTab[pos];
-						xNext  = toMove->getNext();
-
-						// Add the old element to the new table and delete the old one:
-						PWX_TRY_PWX_FURTHER( privAdd( toMove->key, toMove->data.get() ) );
-
-						// Now maintain the old table:
-						oldTab[pos] = xNext != toMove ? xNext : nullptr;
-
-						// And delete the old element
-						if ( toMove && !toMove->destroyed() ) {
-							PWX_TRY_STD_FURTHER( delete toMove, "delete_error", "deleting an element failed" );
-						}
-					}
-					++pos;
+				// --- Move all elements at once unless incremental growing is wanted ---
+				if ( 0 == migrateStep ) {
+					PWX_TRY_PWX_FURTHER( privFinishMigration() )
 				}
-
-				// --- Delete old table ---
-				PWX_TRY_STD_FURTHER( delete[] oldTab, "Delete failed",
-				                     "Deleting the old table after growing into a new table failed." )
 			} // End of inner size check
 
 			// --- Growing is finished: ---
@@ -890,6 +1023,9 @@ public:
 		if ( eCount.load( memOrdLoad ) > 0 ) {
 
 			HASH_START_REMOVE;
+			PWX_TRY( privFinishMigration() )
+			log_debug_caught_std( "finishing a migration" )
+			catch ( ... ) { /* Remaining old elements are simply not found */ }
 
 			uint32_t maxPos = sizeMax();
 			uint32_t pos    = maxPos;
@@ -929,6 +1065,9 @@ public:
 		if ( eCount.load( memOrdLoad ) > 0 ) {
 
 			HASH_START_REMOVE;
+			PWX_TRY( privFinishMigration() )
+			log_debug_caught_std( "finishing a migration" )
+			catch ( ... ) { /* Remaining old elements are simply not found */ }
 
 			uint32_t maxPos = sizeMax();
 			uint32_t pos    = 0;
@@ -1001,6 +1140,9 @@ public:
 	**/
 	virtual elem_t* remElem( elem_t &elem ) noexcept {
 		HASH_START_REMOVE;
+		PWX_TRY( privMigrateKey( elem.key ) )
+		log_debug_caught_std( "migrating a bucket" )
+		catch ( ... ) { /* The key is then searched in the new table only */ }
 		elem_t* result = privRemoveKey( elem.key );
 		HASH_STOP_REMOVE;
 		return result;
@@ -1021,6 +1163,9 @@ public:
 	**/
 	virtual elem_t* remKey( const key_t &key ) noexcept {
 		HASH_START_REMOVE;
+		PWX_TRY( privMigrateKey( key ) )
+		log_debug_caught_std( "migrating a bucket" )
+		catch ( ... ) { /* The key is then searched in the new table only */ }
 		elem_t* result = privRemoveKey( key );
 		HASH_STOP_REMOVE;
 		return result;
@@ -1035,14 +1180,14 @@ public:
 
 	/// @brief return the number of stored elements
 	uint32_t size() const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
 		return eCount.load( memOrdLoad );
 	}
 
 
 	/// @brief return the maximum number of places (elements for open, buckets for chained hashes)
 	uint32_t sizeMax() const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
 		return this->hashSize.load( memOrdLoad );
 	}
 
@@ -1110,6 +1255,7 @@ public:
 		if ( &rhs != this ) {
 			HASH_WAIT_FOR_CLEAR_AND_GROW;
 			PWX_DOUBLE_LOCK_GUARD( this, &rhs );
+			PWX_TRY_PWX_FURTHER( const_cast<hash_t*>( &rhs )->privFinishMigration() )
 
 			// --- grow this table if needed ---
 			uint32_t rhsSize = rhs.sizeMax();
@@ -1152,6 +1298,7 @@ public:
 		if ( &rhs != this ) {
 			HASH_WAIT_FOR_CLEAR_AND_GROW;
 			PWX_DOUBLE_LOCK_GUARD( this, &rhs );
+			PWX_TRY_PWX_FURTHER( const_cast<hash_t*>( &rhs )->privFinishMigration() )
 
 			uint32_t rhsSize = rhs.sizeMax();
 			elem_t* lhsCurr = nullptr;
@@ -1198,7 +1345,8 @@ public:
 	  * @return read-only pointer to the element, or nullptr if there is no element with the specific index.
 	**/
 	virtual const elem_t* operator[]( const int64_t index ) const noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privIndexMigrate();
 		return privGetByIndex( index );
 	}
 
@@ -1222,7 +1370,8 @@ public:
 	  * @return read/write pointer to the element, or nullptr if the hash is empty.
 	**/
 	virtual elem_t* operator[]( int64_t index ) noexcept {
-		HASH_WAIT_FOR_CLEAR_AND_GROW;
+		HASH_SHARED_WAIT_FOR_CLEAR_AND_GROW;
+		privIndexMigrate();
 		return const_cast<elem_t* > ( privGetByIndex( index ) );
 	}
 
@@ -1252,6 +1401,45 @@ protected:
 	uint32_t ( * hash_limited )( const key_t* key, uint32_t keyLen ) = nullptr;
 
 
+	/** @brief take over the table and all elements of @a src, replacing those of this hash
+	  *
+	  * This hash must be empty. The table, the element count and the
+	  * state of a running migration are exchanged, so @a src ends up
+	  * with the empty table of this hash. The destroy and hash methods
+	  * and the key length are copied, @a src keeps its own.
+	  *
+	  * Unlike the other protected methods, this one locks both hashes.
+	  * It is only used by the move constructor and the move operators
+	  * of the hashes, which make sure that @a src uses the same table
+	  * layout.
+	**/
+	void protMoveFrom( hash_t &src ) noexcept {
+		PWX_DOUBLE_LOCK_GUARD( this, &src );
+		while ( growing.load( memOrdLoad ) || src.growing.load( memOrdLoad ) ) {
+			PWX_DOUBLE_LOCK_GUARD_RESET( this, &src );
+		}
+		PWX_NAMED_DOUBLE_LOCK_GUARD( tables, &hashTableLock, &src.hashTableLock );
+
+		destroy      = src.destroy;
+		hash_user    = src.hash_user;
+		hash_limited = src.hash_limited;
+		hashBuilder.setKeyLen( src.hashBuilder.getKeyLen() );
+		migrateStep  = src.migrateStep;
+
+		hashSize.store( src.hashSize.exchange( hashSize.load( memOrdLoad ), memOrdStore ), memOrdStore );
+		eCount.store( src.eCount.exchange( eCount.load( memOrdLoad ), memOrdStore ), memOrdStore );
+		migrating.store( src.migrating.exchange( migrating.load( memOrdLoad ), memOrdStore ), memOrdStore );
+		std::swap( CHMethod,   src.CHMethod );
+		std::swap( hashTable,  src.hashTable );
+		std::swap( migratePos, src.migratePos );
+		std::swap( oldMethod,  src.oldMethod );
+		std::swap( oldSize,    src.oldSize );
+		std::swap( oldTable,   src.oldTable );
+		std::swap( vacChar,    src.vacChar );
+		std::swap( vacated,    src.vacated );
+	}
+
+
 	/** @brief Delete the element @a removed
 	  *
 	  * <B>Important</B>: this method will throw "illegal_delete" if
@@ -1282,6 +1470,181 @@ protected:
 	}
 
 
+	/** @brief fill the empty table with all key/data pairs in [@a first, @a last)
+	  *
+	  * This is the work horse of the bulk constructors. The table must
+	  * already have the size returned by protBulkSize().
+	  *
+	  * 1. The table is split into bucket ranges, one per thread. All
+	  *    keys are hashed, and the number of keys going into each range
+	  *    is counted.
+	  * 2. The keys are scattered into one part per range, keeping their
+	  *    order.
+	  * 3. Each thread inserts the keys of its part whose probe sequence
+	  *    stays inside its range directly, without locking the table or
+	  *    any element.
+	  * 4. The few keys whose probing leaves the range are inserted
+	  *    afterwards, one by one, the normal way.
+	  *
+	  * Like with add(), keys that are already stored are ignored and
+	  * their data stays with the caller. Threads are only used if there
+	  * are at least `bulkPerThread` pairs per thread.
+	  *
+	  * If anything goes wrong, a pwx::CException is thrown. All elements
+	  * inserted until then are counted and will be deleted with the hash.
+	  *
+	  * @param[in] first forward iterator to the first `std::pair<key_t, data_t*>`
+	  * @param[in] last iterator behind the last pair
+	**/
+	template< typename iter_t >
+	void protBulkLoad( iter_t first, iter_t last ) {
+		std::vector< sBulkItem > items;
+
+		try {
+			items.reserve( std::distance( first, last ) );
+			for ( ; first != last ; ++first ) {
+				items.push_back( { &( first->first ), first->second, 0, 0 } );
+			}
+		}
+		PWX_THROW_STD_FURTHER( "BulkLoadFailed", "The list of pairs could not be built" )
+
+		uint32_t count      = static_cast<uint32_t>( items.size() );
+		uint32_t tabSize    = hashSize.load( memOrdLoad );
+		uint32_t numThreads = std::max( 1U, std::min( std::thread::hardware_concurrency(), count / bulkPerThread ) );
+
+		std::vector< sBulkItem* >                parts;
+		std::vector< uint32_t >                  rangeLo( numThreads + 1 );
+		std::vector< uint32_t >                  counts( numThreads * numThreads, 0 );
+		std::vector< uint32_t >                  partLo( numThreads + 1, 0 );
+		std::vector< std::vector< sBulkItem* > > deferred( numThreads );
+		std::vector< uint32_t >                  inserted( numThreads, 0 );
+
+		try {
+			parts.resize( count );
+		}
+		PWX_THROW_STD_FURTHER( "BulkLoadFailed", "The list of parts could not be built" )
+
+		for ( uint32_t nr = 0 ; nr <= numThreads ; ++nr ) {
+			rangeLo[nr] = static_cast<uint32_t>( static_cast<uint64_t>( tabSize ) * nr / numThreads );
+		}
+
+		auto sliceLo = [ count, numThreads ]( uint32_t nr ) {
+			return static_cast<uint32_t>( static_cast<uint64_t>( count ) * nr / numThreads );
+		};
+		auto rangeOf = [ &rangeLo, tabSize, numThreads ]( uint32_t pos ) {
+			uint32_t nr = static_cast<uint32_t>( static_cast<uint64_t>( pos ) * numThreads / tabSize );
+			while ( pos < rangeLo[nr] ) {
+				--nr;
+			}
+			while ( pos >= rangeLo[nr + 1] ) {
+				++nr;
+			}
+			return nr;
+		};
+
+		// 1: Hash all keys and count the keys per range, each thread a slice of the items
+		privBulkRun( numThreads, [ this, &items, &counts, &sliceLo, &rangeOf, tabSize, numThreads ]( uint32_t nr ) {
+			uint32_t* sliceCounts = &counts[nr * numThreads];
+			for ( uint32_t i = sliceLo( nr ), end = sliceLo( nr + 1 ) ; i < end ; ++i ) {
+				items[i].hash = this->protGetHash( items[i].key );
+				items[i].pos  = privGetBaseIndex( items[i].hash, tabSize, CHMethod );
+				++sliceCounts[rangeOf( items[i].pos )];
+			}
+		} );
+
+		// Turn the counts into the offsets each slice writes its keys of each range to
+		uint32_t offset = 0;
+		for ( uint32_t range = 0 ; range < numThreads ; ++range ) {
+			partLo[range] = offset;
+			for ( uint32_t slice = 0 ; slice < numThreads ; ++slice ) {
+				uint32_t sliceCount = counts[slice * numThreads + range];
+				counts[slice * numThreads + range] = offset;
+				offset += sliceCount;
+			}
+		}
+		partLo[numThreads] = offset;
+
+		// 2: Scatter the keys into their parts
+		privBulkRun( numThreads, [ &items, &counts, &parts, &sliceLo, &rangeOf, numThreads ]( uint32_t nr ) {
+			uint32_t* sliceOffsets = &counts[nr * numThreads];
+			for ( uint32_t i = sliceLo( nr ), end = sliceLo( nr + 1 ) ; i < end ; ++i ) {
+				parts[sliceOffsets[rangeOf( items[i].pos )]++] = &items[i];
+			}
+		} );
+
+		// 3: Insert by bucket range
+		auto countInserted = [ this, &inserted ]() {
+			for ( uint32_t &ins : inserted ) {
+				eCount.fetch_add( ins, memOrdStore );
+				ins = 0;
+			}
+		};
+
+		try {
+			privBulkRun( numThreads, [ this, &parts, &partLo, &rangeLo, &deferred, &inserted, tabSize ]( uint32_t nr ) {
+				uint32_t           lo = rangeLo[nr];
+				uint32_t           hi = rangeLo[nr + 1];
+				std::exception_ptr failed;
+
+				try {
+					for ( uint32_t i = partLo[nr] ; i < partLo[nr + 1] ; ++i ) {
+						int32_t res = privBulkPlace( *parts[i], parts[i]->pos, lo, hi, tabSize );
+						if ( res > 0 ) {
+							++inserted[nr];
+						} else if ( res < 0 ) {
+							deferred[nr].push_back( parts[i] );
+						}
+					}
+				} catch ( ... ) {
+					failed = std::current_exception();
+				}
+
+				// The elements were built without thread safety, which must be restored now
+				if ( beThreadSafe() ) {
+					for ( uint32_t pos = lo ; pos < hi ; ++pos ) {
+						for ( elem_t* xCurr = hashTable[pos] ; xCurr ; xCurr = xCurr->getNext() ) {
+							xCurr->enable_thread_safety();
+						}
+					}
+				}
+
+				if ( failed ) {
+					std::rethrow_exception( failed );
+				}
+			} );
+		} catch ( ... ) {
+			countInserted();
+			throw;
+		}
+		countInserted();
+
+		// 4: Keys whose probing left their range
+		for ( auto &list : deferred ) {
+			for ( sBulkItem* item : list ) {
+				if ( !privGet( *item->key ) ) {
+					PWX_TRY_PWX_FURTHER( privAdd( *item->key, item->data ) )
+				}
+			}
+		}
+	}
+
+
+	/** @brief return the table size needed to store [@a first, @a last) with @a maxLoad_
+	  *
+	  * The size is never smaller than the default size of 100 buckets.
+	  *
+	  * @param[in] first forward iterator to the first pair
+	  * @param[in] last iterator behind the last pair
+	  * @param[in] maxLoad_ the maximum load factor of the hash
+	  * @return the number of buckets needed
+	**/
+	template< typename iter_t >
+	static uint32_t protBulkSize( iter_t first, iter_t last, double maxLoad_ ) noexcept {
+		uint32_t needed = static_cast<uint32_t>( static_cast<double>( std::distance( first, last ) ) / maxLoad_ ) + 3;
+		return std::max( needed, static_cast<uint32_t>( 100 ) );
+	}
+
+
 	/** @brief use hashBuilder to generate a hash out of a key
 	  * @param key pointer to the key to hash
 	  * @return uint32_t hash of @a key
@@ -1291,6 +1654,55 @@ protected:
 	}
 
 
+	/** @brief map @a xHash onto [0, @a tabSize) using the multiplication method
+	  *
+	  * The hash is multiplied with the golden ratio in 32 bit fixed point,
+	  * and the fractional part of that product is scaled to the table size.
+	  * Unlike a floating point product with a rounded constant, this uses
+	  * every bucket of the table.
+	  *
+	  * @param[in] xHash the hash to map
+	  * @param[in] tabSize the number of buckets
+	  * @return the bucket index
+	**/
+	static uint32_t protGetMultIndex( uint32_t xHash, uint32_t tabSize ) noexcept {
+		uint32_t fraction = xHash * 2654435769U;
+		return static_cast<uint32_t>( ( static_cast<uint64_t>( fraction ) * tabSize ) >> 32 );
+	}
+
+
+	/** @brief return the next position to probe after @a pos
+	  *
+	  * This is privGetNextProbe() with a guard against unfull probing:
+	  * If the probing gets back to the home bucket @a idxBase before
+	  * all buckets were probed, the stepping is screwed and changed,
+	  * so the rest of the table can still be reached.
+	  *
+	  * @param[in] pos the position probed last
+	  * @param[in] idxBase the home bucket of the key
+	  * @param[in,out] step the current stepping
+	  * @param[in] tabSize the number of buckets
+	  * @param[in] probed the number of buckets probed so far
+	  * @return the next position to probe
+	**/
+	uint32_t protGetNextProbe( uint32_t pos, uint32_t idxBase, uint32_t* step, uint32_t tabSize, uint32_t probed ) const noexcept {
+		pos = privGetNextProbe( pos, step, tabSize );
+
+		if ( ( probed < tabSize ) && ( pos == idxBase ) ) {
+			log_debug_error( "hash", "Unfull probing after %u probes: pos %u == base %u, step %u in size %u",
+			                 probed, pos, idxBase, *step, tabSize );
+			*step += *step % 2 ? 2 : 3;
+			// Be sure the stepping does not end up being tabSize or we'll be here again next round.
+			if ( *step >= tabSize ) {
+				*step = 3;
+			}
+			pos = ( pos + *step ) % tabSize;
+		}
+
+		return pos;
+	}
+
+
 	/** @brief return true if the specified position is empty (aka `nullptr`)
 	  *
 	  * WARNING: This method does **NOT** check @a idx! Check it beforehand!
@@ -1319,9 +1731,9 @@ protected:
 		bool doLocking = beThreadSafe();
 
 		if ( doLocking ) {
-			hashTableLock.lock();
+			hashTableLock.lock_shared();
 			if ( this->isDestroyed.load() || ( nullptr == hashTable ) ) {
-				hashTableLock.unlock();
+				hashTableLock.unlock_shared();
 				return false;
 			}
 		}
@@ -1329,7 +1741,7 @@ protected:
 		bool result = ( hashTable[idx] == nullptr ) || ( hashTable[idx] == vacated );
 
 		if ( doLocking ) {
-			hashTableLock.unlock();
+			hashTableLock.unlock_shared();
 		}
 
 		return result;
@@ -1365,9 +1777,9 @@ protected:
 		bool doLocking = beThreadSafe();
 
 		if ( doLocking ) {
-			hashTableLock.lock();
+			hashTableLock.lock_shared();
 			if ( this->isDestroyed.load() || ( nullptr == hashTable ) ) {
-				hashTableLock.unlock();
+				hashTableLock.unlock_shared();
 				return false;
 			}
 		}
@@ -1375,7 +1787,7 @@ protected:
 		bool result = hashTable[idx] ? ( hashTable[idx] != vacated ? *( hashTable[idx] ) == data : false ) : false;
 
 		if ( doLocking ) {
-			hashTableLock.unlock();
+			hashTableLock.unlock_shared();
 		}
 
 		return result;
@@ -1399,9 +1811,9 @@ protected:
 		bool doLocking = beThreadSafe();
 
 		if ( doLocking ) {
-			hashTableLock.lock();
+			hashTableLock.lock_shared();
 			if ( this->isDestroyed.load() || ( nullptr == hashTable ) ) {
-				hashTableLock.unlock();
+				hashTableLock.unlock_shared();
 				return false;
 			}
 		}
@@ -1409,7 +1821,7 @@ protected:
 		bool result = hashTable[idx] ? hashTable[idx] == elem : ( elem ? false : true );
 
 		if ( doLocking ) {
-			hashTableLock.unlock();
+			hashTableLock.unlock_shared();
 		}
 
 		return result;
@@ -1433,9 +1845,9 @@ protected:
 		bool doLocking = beThreadSafe();
 
 		if ( doLocking ) {
-			hashTableLock.lock();
+			hashTableLock.lock_shared();
 			if ( this->isDestroyed.load() || ( nullptr == hashTable ) ) {
-				hashTableLock.unlock();
+				hashTableLock.unlock_shared();
 				return false;
 			}
 		}
@@ -1443,7 +1855,7 @@ protected:
 		bool result = hashTable[idx] ? ( hashTable[idx] != vacated ? hashTable[idx]->key == key : false ) : false;
 
 		if ( doLocking ) {
-			hashTableLock.unlock();
+			hashTableLock.unlock_shared();
 		}
 
 		return result;
@@ -1469,9 +1881,9 @@ protected:
 		bool doLocking = beThreadSafe();
 
 		if ( doLocking ) {
-			hashTableLock.lock();
+			hashTableLock.lock_shared();
 			if ( this->isDestroyed.load() || ( nullptr == hashTable ) ) {
-				hashTableLock.unlock();
+				hashTableLock.unlock_shared();
 				return nullptr;
 			}
 		}
@@ -1479,7 +1891,7 @@ protected:
 		elem_t* result = hashTable[idx];
 
 		if ( doLocking ) {
-			hashTableLock.unlock();
+			hashTableLock.unlock_shared();
 		}
 
 		return result == vacated ? nullptr : result;
@@ -1505,9 +1917,9 @@ protected:
 		bool doLocking = beThreadSafe();
 
 		if ( doLocking ) {
-			hashTableLock.lock();
+			hashTableLock.lock_shared();
 			if ( this->isDestroyed.load() || ( nullptr == hashTable ) ) {
-				hashTableLock.unlock();
+				hashTableLock.unlock_shared();
 				return nullptr;
 			}
 		}
@@ -1515,7 +1927,7 @@ protected:
 		elem_t* result = hashTable[idx];
 
 		if ( doLocking ) {
-			hashTableLock.unlock();
+			hashTableLock.unlock_shared();
 		}
 
 		return result == vacated ? nullptr : result;
@@ -1601,7 +2013,7 @@ protected:
 	aui32_t          clearing  = ATOMIC_VAR_INIT( 0 ); //!< Needed by the control macros
 	eChainHashMethod CHMethod  = CHM_Division;         //!< Which Hashing method is used
 	aui32_t          growing   = ATOMIC_VAR_INIT( 0 ); //!< Needed by the control macros
-	CHashBuilder     hashBuilder;                      //!< instance that will handle the key generation
+	THashBuilder<policy_t> hashBuilder;                //!< instance that will handle the key generation
 	aui32_t          hashSize;                         //!< number of places to maintain
 	aui32_t          inserting = ATOMIC_VAR_INIT( 0 ); //!< Needed by the control macros
 	aui32_t          removing  = ATOMIC_VAR_INIT( 0 ); //!< Needed by the control macros
@@ -1609,6 +2021,22 @@ protected:
 
 private:
 
+	/* ===============================================
+	 * === Private types                           ===
+	 * ===============================================
+	*/
+
+	/// @internal One key/data pair of a bulk load with the hash and home bucket of its key
+	struct sBulkItem {
+		const key_t* key;  //!< Points to the key in the source range
+		data_t*      data; //!< The data to store
+		uint32_t     hash; //!< Hash of the key
+		uint32_t     pos;  //!< Home bucket of the key
+	};
+
+	static const uint32_t bulkPerThread = 16384; //!< Minimum number of pairs per bulk loading thread
+
+
 	/* ===============================================
 	 * === Private methods                         ===
 	 * ===============================================
@@ -1622,6 +2050,330 @@ private:
 	 * freezing while waiting for themselves to end!
 	 */
 
+	/** @brief delete all elements that have not been migrated, yet
+	  * Both the container and the table lock must be held.
+	**/
+	void privClearOld() noexcept PWX_LOCAL {
+		elem_t* toDel   = nullptr;
+		elem_t* delNext = nullptr;
+
+		for ( uint32_t pos = 0 ; oldTable && ( pos < oldSize ) ; ++pos ) {
+			toDel = oldTable[pos];
+			if ( toDel && ( toDel != vacated ) ) {
+				oldTable[pos] = nullptr;
+
+				// remove a possible chain:
+				while ( ( delNext = toDel->removeNext() )
+				        && !delNext->destroyed()
+				        && delNext != toDel ) {
+					--eCount;
+					delete delNext;
+				}
+
+				if ( !toDel->destroyed() ) {
+					--eCount;
+					delete toDel;
+				}
+			}
+		}
+
+		privDropOld();
+	}
+
+
+	/// @brief delete the (now empty) old table and end the migration. The table lock must be held.
+	void privDropOld() noexcept PWX_LOCAL {
+		if ( oldTable ) {
+			PWX_TRY( delete[] oldTable )
+			log_debug_caught_std( "delete oldTable" )
+			catch ( ... ) { /* Can't do anything about that! */ }
+		}
+		oldTable   = nullptr;
+		oldSize    = 0;
+		migratePos = 0;
+		migrating.store( false, memOrdStore );
+	}
+
+
+	/** @brief switch the thread safety of all elements
+	  * Elements in buckets of the old table that are not migrated yet are
+	  * switched as well. The container lock must be held.
+	**/
+	void privElemThreadSafety( bool doLock ) noexcept PWX_LOCAL {
+		auto switchChain = [doLock]( elem_t* xCurr ) {
+			while ( xCurr ) {
+				if ( doLock )
+					xCurr->enable_thread_safety();
+				else
+					xCurr->disable_thread_safety();
+				xCurr = xCurr->getNext();
+			}
+		};
+
+		uint32_t tabSize = this->sizeMax();
+		for ( uint32_t pos = 0 ; pos < tabSize ; ++pos )
+			switchChain( table_get( pos ) );
+
+		if ( migrating.load( memOrdLoad ) && oldTable ) {
+			for ( uint32_t pos = migratePos ; pos < oldSize ; ++pos ) {
+				if ( oldTable[pos] != vacated )
+					switchChain( oldTable[pos] );
+			}
+		}
+	}
+
+
+	/// @brief move all remaining buckets into the new table. The container lock must be held.
+	void privFinishMigration() PWX_LOCAL {
+		if ( migrating.load( memOrdLoad ) ) {
+			PWX_TRY_PWX_FURTHER( privMigrate( oldSize ) )
+		}
+	}
+
+
+	/** @brief let a reader move some buckets if the container is currently not locked
+	  * Readers must never wait for the exclusive lock, so nothing happens if the
+	  * lock can not be acquired at once.
+	**/
+	void privHelpMigrate() const noexcept PWX_LOCAL {
+		if ( migrating.load( memOrdLoad ) && migrateStep ) {
+			hash_t* self = const_cast<hash_t*>( this );
+			if ( self->try_lock() ) {
+				if ( !growing.load( memOrdLoad ) && !clearing.load( memOrdLoad ) ) {
+					PWX_TRY( self->privMigrate( migrateStep ) )
+					log_debug_caught_std( "migrating buckets" )
+					catch ( ... ) { /* The next writer will try again */ }
+				}
+				self->unlock();
+			}
+		}
+	}
+
+
+	/// @brief index access only knows the new table, so the migration has to be finished first
+	void privIndexMigrate() const noexcept PWX_LOCAL {
+		if ( migrating.load( memOrdLoad ) ) {
+			hash_t* self = const_cast<hash_t*>( this );
+			PWX_LOCK_GUARD( self );
+			while ( growing.load( memOrdLoad ) || clearing.load( memOrdLoad ) ) {
+				PWX_LOCK_GUARD_RESET( self );
+			}
+			PWX_TRY( self->privFinishMigration() )
+			log_debug_caught_std( "finishing a migration" )
+			catch ( ... ) { /* Remaining old elements are simply not found */ }
+		}
+	}
+
+
+	/** @brief move up to @a buckets buckets from the old into the new table
+	  * The container lock must be held.
+	  * @param[in] buckets maximum number of old buckets to migrate
+	**/
+	void privMigrate( uint32_t buckets ) PWX_LOCAL {
+		if ( !migrating.load( memOrdLoad ) ) {
+			return;
+		}
+
+		PWX_NAMED_LOCK_GUARD( table_lock, &hashTableLock );
+
+		uint32_t endPos = ( oldSize - migratePos ) > buckets ? migratePos + buckets : oldSize;
+		while ( migratePos < endPos ) {
+			PWX_TRY_PWX_FURTHER( privMigrateBucket( migratePos ) )
+			++migratePos;
+		}
+
+		if ( migratePos >= oldSize ) {
+			privDropOld();
+		}
+	}
+
+
+	/** @brief move all elements of the old bucket @a pos into the new table
+	  *
+	  * The emptied bucket is marked as vacated, so probing for other keys
+	  * in the old table does not stop there.
+	  * The table lock must be held.
+	  *
+	  * @param[in] pos index of the bucket in the old table
+	**/
+	void privMigrateBucket( uint32_t pos ) PWX_LOCAL {
+		elem_t* toMove = nullptr;
+		elem_t* xNext  = nullptr;
+
+		while ( ( toMove = oldTable[pos] ) && ( toMove != vacated ) ) {
+			xNext = toMove->getNext();
+			oldTable[pos] = xNext && ( xNext != toMove ) ? xNext : vacated;
+
+			// The element is moved, not copied, so its data stays where it is.
+			toMove->remove();
+			eCount.fetch_sub( 1, memOrdStore );
+			PWX_TRY_PWX_FURTHER( privInsert( toMove ) )
+		}
+	}
+
+
+	/** @brief move the bucket holding @a key, then do a regular migration step
+	  * This is done before removing a key, so privRemoveKey() finds it in the new table.
+	  * The container lock must be held.
+	  * @param[in] key the key that is to be removed
+	**/
+	void privMigrateKey( const key_t &key ) PWX_LOCAL {
+		if ( migrating.load( memOrdLoad ) ) {
+			PWX_NAMED_LOCK_GUARD( table_lock, &hashTableLock );
+			uint32_t bucket = 0;
+			if ( privProbeOld( key, &bucket ) ) {
+				PWX_TRY_PWX_FURTHER( privMigrateBucket( bucket ) )
+			}
+			PWX_TRY_PWX_FURTHER( privMigrate( migrateStep ) )
+		}
+	}
+
+
+	/** @brief insert @a item starting at its home bucket @a pos
+	  *
+	  * The probe sequence of the key is followed like privProbe() does.
+	  * The new element is placed in the first empty bucket, or behind the
+	  * last element of the chain in a chained hash. No locks are used,
+	  * so all buckets visited must be in [@a lo, @a hi), which only the
+	  * calling thread writes.
+	  *
+	  * @return 1 if the element was inserted, 0 if the key is already
+	  * stored, -1 if the probing left the range.
+	**/
+	int32_t privBulkPlace( sBulkItem &item, uint32_t pos, uint32_t lo, uint32_t hi, uint32_t tabSize ) PWX_LOCAL {
+		uint32_t idxBase = pos;
+		uint32_t idxStep = privGetStepping( item.hash, tabSize, CHMethod );
+		uint32_t hops    = 0;
+
+		for ( uint32_t i = 0 ; i < tabSize ; ++i ) {
+			elem_t* xCurr = hashTable[pos];
+			elem_t* xTail = nullptr;
+
+			for ( ; xCurr ; xCurr = xCurr->getNext() ) {
+				if ( *xCurr == *item.key ) {
+					return 0;
+				}
+				xTail = xCurr;
+				if ( 0 == idxStep ) {
+					++hops; // Chained hashes count the chain length
+				}
+			}
+
+			if ( ( nullptr == xTail ) || ( 0 == idxStep ) ) {
+				elem_t* newElement = nullptr;
+				try {
+					newElement = new elem_t( *item.key, item.data, destroy );
+				}
+				PWX_THROW_STD_FURTHER( "ElementCreationFailed", "The Creation of a new hash element failed." )
+
+				newElement->disable_thread_safety();
+				newElement->hops = hops;
+				if ( xTail ) {
+					xTail->insertNext( newElement );
+				} else {
+					hashTable[pos] = newElement;
+					newElement->insertAsFirst();
+				}
+				return 1;
+			}
+
+			++hops;
+			pos = this->protGetNextProbe( pos, idxBase, &idxStep, tabSize, i + 1 );
+
+			if ( ( pos < lo ) || ( pos >= hi ) ) {
+				return -1;
+			}
+		}
+
+		return -1;
+	}
+
+
+	/** @brief run @a func( nr ) for @a numThreads numbers on the shared thread pool
+	  *
+	  * If any of them fails, its exception is thrown further after all
+	  * have ended. An `std::exception` is turned into a pwx::CException
+	  * with the name "BulkLoadFailed".
+	**/
+	template< typename func_t >
+	void privBulkRun( uint32_t numThreads, func_t func ) {
+		PWX_TRY_PWXSTD_FURTHER( thread_pool_run( numThreads, func ),
+		                        "BulkLoadFailed", "A bulk loading thread failed" )
+	}
+
+
+	/** @brief search @a key in the old table while a migration is running
+	  *
+	  * The old table is probed the same way it was probed before the
+	  * table was grown, just skipping buckets that are already migrated.
+	  * The table lock must be held.
+	  *
+	  * @param[in] key the key to search for
+	  * @param[out] bucket if not nullptr, the index of the old bucket holding the key is stored here
+	  * @return the element or nullptr if the key is not in the old table
+	**/
+	elem_t* privProbeOld( const key_t &key, uint32_t* bucket ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		if ( !migrating.load( memOrdLoad ) || !oldTable || !oldSize ) {
+			return nullptr;
+		}
+
+		return privProbe( oldTable, oldSize, oldMethod, key, this->protGetHash( &key ), bucket );
+	}
+
+
+	/** @brief search @a key with the hash @a priHash in @a table
+	  *
+	  * @a table is probed with the size @a tabSize and the hashing
+	  * method @a method, skipping vacated buckets.
+	  * The table lock must be held.
+	  *
+	  * @param[in] table the table to search
+	  * @param[in] tabSize the number of buckets in @a table
+	  * @param[in] method the hashing method used for @a table
+	  * @param[in] key the key to search for
+	  * @param[in] priHash the hash of @a key
+	  * @param[out] bucket if not nullptr, the index of the bucket holding the key is stored here
+	  * @return the element or nullptr if the key is not in @a table
+	**/
+	elem_t* privProbe( elem_t** table, uint32_t tabSize, eChainHashMethod method, const key_t &key,
+	                   uint32_t priHash, uint32_t* bucket ) const noexcept PWX_LOCAL PWX_WARNUNUSED {
+		uint32_t idxBase = privGetBaseIndex( priHash, tabSize, method );
+		uint32_t idxStep = privGetStepping( priHash, tabSize, method );
+		uint32_t pos     = idxBase;
+		elem_t* xCurr   = nullptr;
+
+		for ( uint32_t i = 0 ; i < tabSize ; ++i ) {
+			xCurr = table[pos];
+
+			// A never used bucket ends the search
+			if ( nullptr == xCurr ) {
+				return nullptr;
+			}
+
+			if ( xCurr != vacated ) {
+				while ( xCurr && ( *xCurr != key ) ) {
+					xCurr = xCurr->getNext();
+				}
+				if ( xCurr ) {
+					if ( bucket ) {
+						*bucket = pos;
+					}
+					return xCurr;
+				}
+			}
+
+			// Chained hashes have only one bucket per key
+			if ( 0 == idxStep ) {
+				return nullptr;
+			}
+
+			pos = this->protGetNextProbe( pos, idxBase, &idxStep, tabSize, i + 1 );
+		}
+
+		return nullptr;
+	}
+
+
 	/** @brief private part of adding an element
 	  * This is done here, instead of in add() for grow()
 	  * to call without stopping itself.
@@ -1681,17 +2433,110 @@ private:
 	  * @return a const pointer to the element or nullptr if the key could not be found.
 	**/
 	virtual elem_t* privGet( const key_t &key ) const noexcept {
-		uint32_t keyIdx = privGetIndex( key );
-		elem_t* xCurr = table_get( keyIdx );
+		// The table lock is held, so a bucket can not be migrated while it is searched
+		bool doLocking = beThreadSafe();
+		if ( doLocking ) {
+			hashTableLock.lock_shared();
+		}
 
-		while ( xCurr && ( *xCurr != key ) ) {
-			xCurr = xCurr->getNext();
+		elem_t* xCurr = privProbeOld( key, nullptr );
+
+		if ( nullptr == xCurr ) {
+			uint32_t keyIdx = privGetIndex( key );
+			xCurr = table_get( keyIdx );
+
+			while ( xCurr && ( *xCurr != key ) ) {
+				xCurr = xCurr->getNext();
+			}
+		}
+
+		if ( doLocking ) {
+			hashTableLock.unlock_shared();
 		}
 
 		return xCurr;
 	}
 
 
+	/** @brief search @a n keys in three passes
+	  *
+	  * The keys are handled in batches. First all keys of a batch are
+	  * hashed and their home buckets prefetched. Then the elements found
+	  * in these buckets are prefetched. Only then the keys are searched,
+	  * by which time most of the memory should have arrived.
+	  *
+	  * @param[in] keys array of @a n keys
+	  * @param[in] n number of keys
+	  * @param[out] elems if not nullptr, receives the element or nullptr for each key
+	  * @param[out] found if not nullptr, receives whether each key was found
+	  * @return the number of keys found
+	**/
+	uint32_t privGetMany( const key_t* keys, uint32_t n, elem_t** elems, bool* found ) const noexcept PWX_LOCAL {
+		static const uint32_t batchSize = 32;
+
+		uint32_t hashes[batchSize];
+		uint32_t buckets[batchSize];
+		uint32_t result = 0;
+
+		// The table lock is held for the whole search, so no bucket can be migrated meanwhile
+		bool doLocking = beThreadSafe();
+		if ( doLocking ) {
+			hashTableLock.lock_shared();
+		}
+
+		uint32_t tabSize = hashSize.load( memOrdLoad );
+		bool     isAlive = !this->isDestroyed.load() && ( nullptr != hashTable ) && tabSize;
+		bool     hasOld  = isAlive && migrating.load( memOrdLoad ) && oldTable && oldSize;
+
+		for ( uint32_t start = 0 ; start < n ; start += batchSize ) {
+			uint32_t cnt = std::min( batchSize, n - start );
+
+			// 1: Hash all keys and prefetch their home buckets
+			for ( uint32_t i = 0 ; isAlive && ( i < cnt ) ; ++i ) {
+				hashes[i]  = this->protGetHash( &keys[start + i] );
+				buckets[i] = privGetBaseIndex( hashes[i], tabSize, CHMethod );
+				PWX_PREFETCH( &hashTable[buckets[i]] );
+			}
+
+			// 2: Prefetch the elements in the home buckets, their keys are compared next
+			for ( uint32_t i = 0 ; isAlive && ( i < cnt ) ; ++i ) {
+				elem_t* xCurr = hashTable[buckets[i]];
+				if ( xCurr && ( xCurr != vacated ) ) {
+					PWX_PREFETCH( xCurr );
+				}
+			}
+
+			// 3: Search the keys, the old table first like privGet() does
+			for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+				elem_t* xCurr = nullptr;
+
+				if ( hasOld ) {
+					xCurr = privProbe( oldTable, oldSize, oldMethod, keys[start + i], hashes[i], nullptr );
+				}
+				if ( isAlive && ( nullptr == xCurr ) ) {
+					xCurr = privProbe( hashTable, tabSize, CHMethod, keys[start + i], hashes[i], nullptr );
+				}
+
+				if ( xCurr ) {
+					++result;
+				}
+				if ( elems ) {
+					elems[start + i] = xCurr;
+				}
+				if ( found ) {
+					found[start + i] = nullptr != xCurr;
+				}
+			}
+		}
+
+		if ( doLocking ) {
+			hashTableLock.unlock_shared();
+		}
+
+		return result;
+	}
+
+
 	/** @brief get an element by index
 	  * @param[in] index the index of the element to find.
 	  * @return read-only pointer to the element, or nullptr if there is no element with the specific index.
@@ -1728,6 +2573,24 @@ private:
 	virtual uint32_t privGetIndex( const key_t &key ) const noexcept PWX_VIRTUAL_PURE;
 
 
+	/* While a migration is running, the old table has to be probed with the
+	 * size and hashing method it had. So the hash templates provide the base
+	 * index and the stepping for any size and method. A stepping of zero
+	 * means that only the base bucket has to be searched.
+	*/
+	virtual uint32_t privGetBaseIndex( uint32_t hash, uint32_t tabSize, eChainHashMethod method ) const noexcept PWX_VIRTUAL_PURE;
+	virtual uint32_t privGetStepping( uint32_t hash, uint32_t tabSize, eChainHashMethod method ) const noexcept PWX_VIRTUAL_PURE;
+
+
+	/** @brief return the next position to probe after @a pos
+	  * The default is a fixed stepping. Hashes with other probing
+	  * sequences may alter @a step on each call.
+	**/
+	virtual uint32_t privGetNextProbe( uint32_t pos, uint32_t* step, uint32_t tabSize ) const noexcept {
+		return ( pos + *step ) % tabSize;
+	}
+
+
 	// How collisions are resolved is a hash type specific matter
 	virtual uint32_t privInsert( elem_t* elem ) PWX_VIRTUAL_PURE;
 
@@ -1803,6 +2666,12 @@ private:
 	CLockable hashTableLock; //!< the table_*() methods use this to secure access to the table
 	char  * vacChar;       //!< alias pointer to get around the empty elem_t ctor restriction
 	elem_t* vacated;       //!< The Open Hash sets empty places to point at this.
+	uint32_t         migrateStep = 0;                          //!< Buckets moved per operation, 0 moves all at once
+	abool_t          migrating   = ATOMIC_VAR_INIT( false );   //!< True while the old table still holds elements
+	uint32_t         migratePos  = 0;                          //!< Next old bucket to migrate
+	eChainHashMethod oldMethod   = CHM_Division;               //!< Hashing method of the old table
+	uint32_t         oldSize     = 0;                          //!< Size of the old table
+	elem_t**         oldTable    = nullptr;                    //!< Table that is currently migrated
 	// Note: vacated is placed here, so clear(), disable_thread_safety() and
 	//       enable_thread_safety() can be unified here as well. Otherwise
 	//       the hashes would need individual functions that only differ
@@ -1815,8 +2684,8 @@ private:
   * This destructor will delete all elements currently stored. There is no
   * need to clean up manually before deleting the hash.
 **/
-template< typename key_t, typename data_t, typename elem_t >
-VTHashBase< key_t, data_t, elem_t >::~VTHashBase() noexcept {
+template< typename key_t, typename data_t, typename elem_t, typename policy_t >
+VTHashBase< key_t, data_t, elem_t, policy_t >::~VTHashBase() noexcept {
 	PWX_DOUBLE_LOCK_GUARD( this, &hashTableLock );
 
 	// Mark as destroyed
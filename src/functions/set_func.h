@@ -38,12 +38,185 @@
 # error "Do not include pwx_set_fwd.h, include pwx/container/TSet.h!"
 #endif // Check for main file
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include "basic/compiler.h"
+#include "basic/thread_pool.h"
 
 #include "container/TSet.h" // Make IDE-Parsers happy
 
 namespace pwx {
 
+// --- internal helpers of the parallel set functions ---
+
+/// @internal Members each worker of the parallel set functions should have at least
+const uint32_t setParPerThread = 4096;
+
+
+/// @internal run @a func( nr ) for every nr in [0, @a numThreads) on the shared thread pool
+template<typename func_t>
+void set_par_run( uint32_t numThreads, func_t func ) {
+	PWX_TRY_PWXSTD_FURTHER( thread_pool_run( numThreads, func ),
+	                        "SetWorkerFailed", "A set worker thread failed" )
+}
+
+
+/** @internal copy the data pointers of all members of @a set into @a snap
+  *
+  * The set is only locked while the pointers are copied. As the data is
+  * shared, it stays valid even if the members are removed afterwards.
+**/
+template<typename data_t>
+void set_par_snapshot( const TSet<data_t>* const set, std::vector< std::shared_ptr<data_t> > &snap ) {
+	auto const &guarded = set->snapshot();
+	PWX_TRY_STD_FURTHER( snap.reserve( set->size() ), "SetSnapshotFailed", "Could not take a snapshot of a set" )
+	for ( auto xCurr = guarded.cbegin(), xEnd = guarded.cend() ; xCurr != xEnd ; ++xCurr ) {
+		PWX_TRY_STD_FURTHER( snap.push_back( xCurr.elem()->data ),
+		                     "SetSnapshotFailed", "Could not take a snapshot of a set" )
+	}
+}
+
+
+/** @internal mark every entry of @a probe that is also in @a base
+  *
+  * Both snapshots are hashed with the hash function of @a hasher and
+  * sorted into one bucket range per worker, like the bulk loader of the
+  * hashes does it. Then each worker builds a table of the @a base entries
+  * of its range and looks up the @a probe entries of that range. Equal
+  * data has equal hashes, so no match is missed, and every entry is only
+  * touched by one worker per step.
+  *
+  * @param[in] hasher the set whose hash function is used.
+  * @param[in] probe the entries to test.
+  * @param[in] base the entries to test against.
+  * @param[out] found receives 1 for every entry of @a probe that is in @a base, 0 otherwise.
+**/
+template<typename data_t>
+void set_par_match( const TSet<data_t>* const hasher,
+                    std::vector< std::shared_ptr<data_t> > const &probe,
+                    std::vector< std::shared_ptr<data_t> > const &base,
+                    std::vector< char > &found ) {
+	uint32_t probeCnt   = static_cast<uint32_t>( probe.size() );
+	uint32_t baseCnt    = static_cast<uint32_t>( base.size() );
+	uint32_t numThreads = std::max( 1U, std::min( std::thread::hardware_concurrency(),
+	                                ( probeCnt + baseCnt ) / setParPerThread ) );
+
+	std::vector< uint32_t > probeHash;
+	std::vector< uint32_t > baseHash;
+	std::vector< uint32_t > probeParts;  // probe indexes, sorted by range
+	std::vector< uint32_t > baseParts;   // base indexes, sorted by range
+	std::vector< uint32_t > probeOffset; // [slice * numThreads + range] position in probeParts
+	std::vector< uint32_t > baseOffset;  // [slice * numThreads + range] position in baseParts
+	std::vector< uint32_t > probeLo;     // [range] first position of the range in probeParts
+	std::vector< uint32_t > baseLo;      // [range] first position of the range in baseParts
+	try {
+		found.assign( probeCnt, 0 );
+		probeHash.resize( probeCnt );
+		baseHash.resize( baseCnt );
+		probeParts.resize( probeCnt );
+		baseParts.resize( baseCnt );
+		probeOffset.assign( numThreads * numThreads, 0 );
+		baseOffset.assign( numThreads * numThreads, 0 );
+		probeLo.assign( numThreads + 1, 0 );
+		baseLo.assign( numThreads + 1, 0 );
+	}
+	PWX_THROW_STD_FURTHER( "SetWorkerFailed", "Could not prepare the parallel set operation" )
+
+	// The upper bits of the product select the range
+	auto rangeOf = [ numThreads ]( uint32_t hash ) {
+		return static_cast<uint32_t>( ( static_cast<uint64_t>( hash ) * numThreads ) >> 32 );
+	};
+	auto sliceLo = [ numThreads ]( uint32_t count, uint32_t nr ) {
+		return static_cast<uint32_t>( static_cast<uint64_t>( count ) * nr / numThreads );
+	};
+
+	// 1: Hash both snapshots and count the entries per range, each thread a slice of each
+	set_par_run( numThreads, [ & ]( uint32_t nr ) {
+		for ( uint32_t i = sliceLo( probeCnt, nr ), end = sliceLo( probeCnt, nr + 1 ) ; i < end ; ++i ) {
+			probeHash[i] = hasher->getHash( *probe[i] );
+			++probeOffset[nr * numThreads + rangeOf( probeHash[i] )];
+		}
+		for ( uint32_t i = sliceLo( baseCnt, nr ), end = sliceLo( baseCnt, nr + 1 ) ; i < end ; ++i ) {
+			baseHash[i] = hasher->getHash( *base[i] );
+			++baseOffset[nr * numThreads + rangeOf( baseHash[i] )];
+		}
+	} );
+
+	// 2: Turn the counts into positions, range by range and slice by slice in each range
+	uint32_t probePos = 0;
+	uint32_t basePos  = 0;
+	for ( uint32_t range = 0 ; range < numThreads ; ++range ) {
+		probeLo[range] = probePos;
+		baseLo[range]  = basePos;
+		for ( uint32_t slice = 0 ; slice < numThreads ; ++slice ) {
+			uint32_t idx = slice * numThreads + range;
+			std::swap( probeOffset[idx], probePos );
+			probePos += probeOffset[idx];
+			std::swap( baseOffset[idx], basePos );
+			basePos += baseOffset[idx];
+		}
+	}
+	probeLo[numThreads] = probePos;
+	baseLo[numThreads]  = basePos;
+
+	// 3: Sort the indexes into their ranges, each thread its slices again
+	set_par_run( numThreads, [ & ]( uint32_t nr ) {
+		uint32_t* offset = &probeOffset[nr * numThreads];
+		for ( uint32_t i = sliceLo( probeCnt, nr ), end = sliceLo( probeCnt, nr + 1 ) ; i < end ; ++i )
+			probeParts[offset[rangeOf( probeHash[i] )]++] = i;
+		offset = &baseOffset[nr * numThreads];
+		for ( uint32_t i = sliceLo( baseCnt, nr ), end = sliceLo( baseCnt, nr + 1 ) ; i < end ; ++i )
+			baseParts[offset[rangeOf( baseHash[i] )]++] = i;
+	} );
+
+	// 4: Match, each thread only the entries of its own range
+	set_par_run( numThreads, [ & ]( uint32_t nr ) {
+		std::unordered_multimap< uint32_t, uint32_t > table;
+		table.reserve( baseLo[nr + 1] - baseLo[nr] );
+		for ( uint32_t pos = baseLo[nr] ; pos < baseLo[nr + 1] ; ++pos )
+			table.emplace( baseHash[baseParts[pos]], baseParts[pos] );
+
+		for ( uint32_t pos = probeLo[nr] ; pos < probeLo[nr + 1] ; ++pos ) {
+			uint32_t i     = probeParts[pos];
+			auto     range = table.equal_range( probeHash[i] );
+			for ( auto xCurr = range.first ; xCurr != range.second ; ++xCurr ) {
+				if ( *base[xCurr->second] == *probe[i] ) {
+					found[i] = 1;
+					break;
+				}
+			}
+		}
+	} );
+}
+
+
+/** @internal add all entries of @a snap to @a set whose @a found flag equals @a wanted
+  *
+  * The entries are added in the order of @a snap and share their data
+  * with the members they were taken from.
+**/
+template<typename data_t>
+void set_par_push( TSet<data_t>* const set, std::vector< std::shared_ptr<data_t> > const &snap,
+                   std::vector< char > const* found, char wanted ) {
+	typedef typename TSet<data_t>::elem_t elem_t;
+
+	// The data of a copied element is shared, so one carrier is enough
+	elem_t carrier( static_cast<data_t*>( nullptr ) );
+	carrier.disable_thread_safety();
+
+	for ( size_t i = 0 ; i < snap.size() ; ++i ) {
+		if ( found && ( ( *found )[i] != wanted ) )
+			continue;
+		carrier.data = snap[i];
+		PWX_TRY_PWX_FURTHER( set->push( carrier ) )
+	}
+}
+
+
 // --- function implementations ---
 
 /** @brief build the difference of two sets
@@ -52,6 +225,9 @@ namespace pwx {
   * so you have to delete it with the delete operator, that consists
   * of the difference of the sets @a lhs and @a rhs.
   *
+  * Every member of @a lhs is looked up in the hash table of @a rhs,
+  * so this takes time linear in the size of @a lhs.
+  *
   * If @a lhs is the empty set or @a lhs equals @a rhs an empty set is
   * returned. If @a rhs is the empty set a copy of @a lhs is returned.
   *
@@ -90,18 +266,11 @@ TSet<data_t>* set_difference( const TSet<data_t>* const lhs, const TSet<data_t>*
 			// This is possibility 1
 			*newSet = *lhs;
 		else {
-			// This is possibility 2
-			auto xHead  = lhs->get( 0 );
-			auto xTail  = lhs->get( -1 );
-			auto xCurr  = xHead;
-			bool isDone = false;
-			while ( xCurr && !isDone ) {
-				if ( !rhs->hasMember( *xCurr ) )
-					newSet->push( *xCurr );
-				if ( xCurr == xTail )
-					isDone = true;
-				else
-					xCurr = xCurr->getNext();
+			// This is possibility 2, lhs and rhs are locked already
+			PWX_TRY_PWX_FURTHER( newSet->reserve( lhs->size() ) )
+			for ( auto xCurr = lhs->cbegin(), xEnd = lhs->cend() ; xCurr != xEnd ; ++xCurr ) {
+				if ( !rhs->hasMember( *xCurr.elem() ) )
+					newSet->push( *xCurr.elem() );
 			} // end of traversing lhs
 		} // End of building possibility 2
 	} // End of having a combination requiring action
@@ -148,6 +317,9 @@ TSet<data_t> set_difference( const TSet<data_t>& lhs, const TSet<data_t>& rhs )
   * so you have to delete it with the delete operator, that consists
   * of the intersection of the sets @a lhs and @a rhs.
   *
+  * Every member of @a lhs is looked up in the hash table of @a rhs,
+  * so this takes time linear in the size of @a lhs.
+  *
   * If either set is the empty set, the intersection is the empty set.
   *
   * If @a lhs equals @a rhs, the intersection is a copy of @a lhs.
@@ -186,18 +358,11 @@ TSet<data_t>* set_intersection( const TSet<data_t>* const lhs, const TSet<data_t
 			// This is possibility 1
 			*newSet = *lhs;
 		else {
-			// This is possibility 2
-			auto xHead  = lhs->get( 0 );
-			auto xTail  = lhs->get( -1 );
-			auto xCurr  = xHead;
-			bool isDone = false;
-			while ( xCurr && !isDone ) {
-				if ( rhs->hasMember( *xCurr ) )
-					newSet->push( *xCurr );
-				if ( xCurr == xTail )
-					isDone = true;
-				else
-					xCurr = xCurr->getNext();
+			// This is possibility 2, lhs and rhs are locked already
+			PWX_TRY_PWX_FURTHER( newSet->reserve( std::min( lhs->size(), rhs->size() ) ) )
+			for ( auto xCurr = lhs->cbegin(), xEnd = lhs->cend() ; xCurr != xEnd ; ++xCurr ) {
+				if ( rhs->hasMember( *xCurr.elem() ) )
+					newSet->push( *xCurr.elem() );
 			} // end of traversing lhs
 		} // End of building possibility 2
 	} // End of having a combination requiring action
@@ -245,6 +410,9 @@ TSet<data_t> set_intersection( const TSet<data_t>& lhs, const TSet<data_t>& rhs
   * so you have to delete it with the delete operator, that consists
   * of the union of the sets @a lhs and @a rhs.
   *
+  * Every member is checked against the hash table of the new set,
+  * so this takes time linear in the sizes of @a lhs and @a rhs.
+  *
   * If either set is the empty set, the union is a copy of the other.
   *
   * If the new set can not be created, a pwx::CException with
@@ -266,6 +434,7 @@ TSet<data_t>* set_union( const TSet<data_t>* const lhs, const TSet<data_t>* cons
 	// Build an empty set:
 	PWX_TRY( newSet = new list_t() )
 	PWX_THROW_STD_FURTHER( "SetCreationFailed", "set_union(); could not create the union set!" );
+	PWX_TRY_PWX_FURTHER( newSet->reserve( lhs->size() + rhs->size() ) )
 
 	// If lhs has elements, we can begin with adding them.
 	if ( lhs->size() ) {
@@ -318,6 +487,321 @@ TSet<data_t> set_union( const TSet<data_t>& lhs, const TSet<data_t>& rhs ) {
 }
 
 
+// --- parallel function implementations ---
+
+/** @brief build the difference of two sets using all CPU cores
+  *
+  * This is the parallel version of set_difference(). Both sets are only
+  * locked while their members are copied into a snapshot. Then the
+  * members are split into ranges of their hashes, and each range is
+  * compared by its own worker thread. Small sets are handled by the
+  * calling thread alone.
+  *
+  * Members that other threads add to or remove from @a lhs or @a rhs
+  * after the snapshots were taken are not taken into account.
+  *
+  * The new set is created using the new operator, so you have to delete
+  * it with the delete operator. The members of @a lhs keep their order.
+  *
+  * If the new set can not be created, a pwx::CException with
+  * the name "SetCreationFailed" is thrown.
+  *
+  * If a snapshot can not be taken, a pwx::CException with
+  * the name "SetSnapshotFailed" is thrown.
+  *
+  * If a worker thread fails, a pwx::CException with
+  * the name "SetWorkerFailed" is thrown.
+  *
+  * If a new element can not be created, a pwx::CException with
+  * the name "ElementCreationFailed" is thrown.
+  *
+  * @param[in] lhs pointer to the left hand side set
+  * @param[in] rhs pointer to the right hand side set
+  * @return A new set being the difference of @a lhs and @a rhs
+**/
+template<typename data_t>
+TSet<data_t>* set_difference_par( const TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) {
+	typedef TSet<data_t>                           list_t;
+	typedef std::vector< std::shared_ptr<data_t> > snap_t;
+
+	list_t* newSet = nullptr;
+
+	PWX_TRY( newSet = new list_t() )
+	PWX_THROW_STD_FURTHER( "SetCreationFailed", "set_difference_par(); could not create the difference set!" );
+	newSet->reset( *lhs );
+
+	if ( lhs->size() && ( lhs != rhs ) ) {
+		try {
+			snap_t              lhsSnap, rhsSnap;
+			std::vector< char > found;
+
+			set_par_snapshot( lhs, lhsSnap );
+			set_par_snapshot( rhs, rhsSnap );
+			set_par_match( lhs, lhsSnap, rhsSnap, found );
+
+			newSet->reserve( static_cast<uint32_t>( std::count( found.begin(), found.end(), 0 ) ) );
+			set_par_push( newSet, lhsSnap, &found, 0 );
+		} catch ( ... ) {
+			delete newSet;
+			throw;
+		}
+	}
+
+	return newSet;
+}
+
+
+/** @brief remove all members of @a rhs from @a lhs using all CPU cores
+  *
+  * This is the in-place version of set_difference_par(). It works the
+  * same way, but removes the members from @a lhs directly instead of
+  * building a new set.
+  *
+  * If @a lhs equals @a rhs, @a lhs is cleared.
+  *
+  * If a snapshot can not be taken, a pwx::CException with
+  * the name "SetSnapshotFailed" is thrown.
+  *
+  * If a worker thread fails, a pwx::CException with
+  * the name "SetWorkerFailed" is thrown.
+  *
+  * @param[in,out] lhs pointer to the set to remove members from
+  * @param[in] rhs pointer to the set with the members to remove
+  * @return the number of members left in @a lhs
+**/
+template<typename data_t>
+uint32_t set_difference_par_inplace( TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) {
+	typedef std::vector< std::shared_ptr<data_t> > snap_t;
+
+	if ( lhs == rhs ) {
+		lhs->clear();
+		return 0;
+	}
+
+	if ( lhs->size() && rhs->size() ) {
+		snap_t              lhsSnap, rhsSnap;
+		std::vector< char > found;
+
+		PWX_TRY_PWX_FURTHER( set_par_snapshot( lhs, lhsSnap ) )
+		PWX_TRY_PWX_FURTHER( set_par_snapshot( rhs, rhsSnap ) )
+		PWX_TRY_PWX_FURTHER( set_par_match( lhs, lhsSnap, rhsSnap, found ) )
+
+		for ( size_t i = 0 ; i < lhsSnap.size() ; ++i ) {
+			if ( found[i] )
+				PWX_TRY_PWX_FURTHER( lhs->delData( lhsSnap[i].get() ) )
+		}
+	}
+
+	return lhs->size();
+}
+
+
+/** @brief build the intersection of two sets using all CPU cores
+  *
+  * This is the parallel version of set_intersection(). It works like
+  * set_difference_par(), see there for details.
+  *
+  * The new set is created using the new operator, so you have to delete
+  * it with the delete operator. The members of @a lhs keep their order.
+  *
+  * If the new set can not be created, a pwx::CException with
+  * the name "SetCreationFailed" is thrown.
+  *
+  * If a snapshot can not be taken, a pwx::CException with
+  * the name "SetSnapshotFailed" is thrown.
+  *
+  * If a worker thread fails, a pwx::CException with
+  * the name "SetWorkerFailed" is thrown.
+  *
+  * If a new element can not be created, a pwx::CException with
+  * the name "ElementCreationFailed" is thrown.
+  *
+  * @param[in] lhs pointer to the left hand side set
+  * @param[in] rhs pointer to the right hand side set
+  * @return A new set being the intersection of @a lhs and @a rhs
+**/
+template<typename data_t>
+TSet<data_t>* set_intersection_par( const TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) {
+	typedef TSet<data_t>                           list_t;
+	typedef std::vector< std::shared_ptr<data_t> > snap_t;
+
+	list_t* newSet = nullptr;
+
+	PWX_TRY( newSet = new list_t() )
+	PWX_THROW_STD_FURTHER( "SetCreationFailed", "set_intersection_par(); could not create the intersection set!" );
+	newSet->reset( *lhs );
+
+	if ( lhs->size() && rhs->size() ) {
+		try {
+			snap_t              lhsSnap, rhsSnap;
+			std::vector< char > found;
+
+			set_par_snapshot( lhs, lhsSnap );
+			if ( lhs == rhs ) {
+				newSet->reserve( static_cast<uint32_t>( lhsSnap.size() ) );
+				set_par_push( newSet, lhsSnap, nullptr, 1 );
+			} else {
+				set_par_snapshot( rhs, rhsSnap );
+				set_par_match( lhs, lhsSnap, rhsSnap, found );
+				newSet->reserve( static_cast<uint32_t>( std::count( found.begin(), found.end(), 1 ) ) );
+				set_par_push( newSet, lhsSnap, &found, 1 );
+			}
+		} catch ( ... ) {
+			delete newSet;
+			throw;
+		}
+	}
+
+	return newSet;
+}
+
+
+/** @brief remove all members from @a lhs that are not in @a rhs using all CPU cores
+  *
+  * This is the in-place version of set_intersection_par(). It works the
+  * same way, but removes the members from @a lhs directly instead of
+  * building a new set.
+  *
+  * If @a rhs is the empty set, @a lhs is cleared.
+  *
+  * If a snapshot can not be taken, a pwx::CException with
+  * the name "SetSnapshotFailed" is thrown.
+  *
+  * If a worker thread fails, a pwx::CException with
+  * the name "SetWorkerFailed" is thrown.
+  *
+  * @param[in,out] lhs pointer to the set to remove members from
+  * @param[in] rhs pointer to the set with the members to keep
+  * @return the number of members left in @a lhs
+**/
+template<typename data_t>
+uint32_t set_intersection_par_inplace( TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) {
+	typedef std::vector< std::shared_ptr<data_t> > snap_t;
+
+	if ( lhs == rhs )
+		return lhs->size();
+
+	if ( rhs->empty() ) {
+		lhs->clear();
+		return 0;
+	}
+
+	if ( lhs->size() ) {
+		snap_t              lhsSnap, rhsSnap;
+		std::vector< char > found;
+
+		PWX_TRY_PWX_FURTHER( set_par_snapshot( lhs, lhsSnap ) )
+		PWX_TRY_PWX_FURTHER( set_par_snapshot( rhs, rhsSnap ) )
+		PWX_TRY_PWX_FURTHER( set_par_match( lhs, lhsSnap, rhsSnap, found ) )
+
+		for ( size_t i = 0 ; i < lhsSnap.size() ; ++i ) {
+			if ( !found[i] )
+				PWX_TRY_PWX_FURTHER( lhs->delData( lhsSnap[i].get() ) )
+		}
+	}
+
+	return lhs->size();
+}
+
+
+/** @brief build the union of two sets using all CPU cores
+  *
+  * This is the parallel version of set_union(). It works like
+  * set_difference_par(), see there for details.
+  *
+  * The new set is created using the new operator, so you have to delete
+  * it with the delete operator. It holds the members of @a lhs first,
+  * followed by the members of @a rhs that are not in @a lhs.
+  *
+  * If the new set can not be created, a pwx::CException with
+  * the name "SetCreationFailed" is thrown.
+  *
+  * If a snapshot can not be taken, a pwx::CException with
+  * the name "SetSnapshotFailed" is thrown.
+  *
+  * If a worker thread fails, a pwx::CException with
+  * the name "SetWorkerFailed" is thrown.
+  *
+  * If a new element can not be created, a pwx::CException with
+  * the name "ElementCreationFailed" is thrown.
+  *
+  * @param[in] lhs pointer to the left hand side set
+  * @param[in] rhs pointer to the right hand side set
+  * @return A new set being the union of @a lhs and @a rhs
+**/
+template<typename data_t>
+TSet<data_t>* set_union_par( const TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) {
+	typedef TSet<data_t>                           list_t;
+	typedef std::vector< std::shared_ptr<data_t> > snap_t;
+
+	list_t* newSet = nullptr;
+
+	PWX_TRY( newSet = new list_t() )
+	PWX_THROW_STD_FURTHER( "SetCreationFailed", "set_union_par(); could not create the union set!" );
+	newSet->reset( lhs->size() ? *lhs : *rhs );
+
+	try {
+		snap_t              lhsSnap, rhsSnap;
+		std::vector< char > found;
+
+		set_par_snapshot( lhs, lhsSnap );
+		if ( lhs != rhs )
+			set_par_snapshot( rhs, rhsSnap );
+		set_par_match( lhs, rhsSnap, lhsSnap, found );
+
+		newSet->reserve( static_cast<uint32_t>( lhsSnap.size() + std::count( found.begin(), found.end(), 0 ) ) );
+		set_par_push( newSet, lhsSnap, nullptr, 1 );
+		set_par_push( newSet, rhsSnap, &found, 0 );
+	} catch ( ... ) {
+		delete newSet;
+		throw;
+	}
+
+	return newSet;
+}
+
+
+/** @brief add all members of @a rhs to @a lhs using all CPU cores
+  *
+  * This is the in-place version of set_union_par(). It works the same
+  * way, but adds the missing members to @a lhs directly instead of
+  * building a new set. They share their data with the members of @a rhs
+  * they were copied from.
+  *
+  * If a snapshot can not be taken, a pwx::CException with
+  * the name "SetSnapshotFailed" is thrown.
+  *
+  * If a worker thread fails, a pwx::CException with
+  * the name "SetWorkerFailed" is thrown.
+  *
+  * If a new element can not be created, a pwx::CException with
+  * the name "ElementCreationFailed" is thrown.
+  *
+  * @param[in,out] lhs pointer to the set to add members to
+  * @param[in] rhs pointer to the set with the members to add
+  * @return the number of members in @a lhs afterwards
+**/
+template<typename data_t>
+uint32_t set_union_par_inplace( TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) {
+	typedef std::vector< std::shared_ptr<data_t> > snap_t;
+
+	if ( ( lhs != rhs ) && rhs->size() ) {
+		snap_t              lhsSnap, rhsSnap;
+		std::vector< char > found;
+
+		PWX_TRY_PWX_FURTHER( set_par_snapshot( lhs, lhsSnap ) )
+		PWX_TRY_PWX_FURTHER( set_par_snapshot( rhs, rhsSnap ) )
+		PWX_TRY_PWX_FURTHER( set_par_match( lhs, rhsSnap, lhsSnap, found ) )
+
+		PWX_TRY_PWX_FURTHER( lhs->reserve( static_cast<uint32_t>( lhsSnap.size()
+		                                   + std::count( found.begin(), found.end(), 0 ) ) ) )
+		PWX_TRY_PWX_FURTHER( set_par_push( lhs, rhsSnap, &found, 0 ) )
+	}
+
+	return lhs->size();
+}
+
+
 // --- operator implementations ---
 
 /** @brief return true if two sets are equal
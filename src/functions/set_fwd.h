@@ -61,6 +61,20 @@ TSet<data_t>* set_union       ( const TSet<data_t>* const lhs, const TSet<data_t
 template<typename data_t>
 TSet<data_t>  set_union       ( const TSet<data_t>& lhs, const TSet<data_t>& rhs ) PWX_API;
 
+// --- Parallel Function Prototypes ---
+template<typename data_t>
+TSet<data_t>* set_difference_par          ( const TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) PWX_API;
+template<typename data_t>
+uint32_t      set_difference_par_inplace  ( TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) PWX_API;
+template<typename data_t>
+TSet<data_t>* set_intersection_par        ( const TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) PWX_API;
+template<typename data_t>
+uint32_t      set_intersection_par_inplace( TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) PWX_API;
+template<typename data_t>
+TSet<data_t>* set_union_par               ( const TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) PWX_API;
+template<typename data_t>
+uint32_t      set_union_par_inplace       ( TSet<data_t>* const lhs, const TSet<data_t>* const rhs ) PWX_API;
+
 // --- operator prototypes ---
 template<typename data_t>
 bool          operator==( const TSet<data_t>& lhs, const TSet<data_t>& rhs ) noexcept PWX_API;
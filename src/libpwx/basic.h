@@ -11,6 +11,8 @@
   *
   * <TABLE border='1'>
   * <TR><TH>Task</TH><TH>Include file</TH></TR>
+  * <TR><TD>Add CEpochGuard, a RAII guard for readers of memory that is
+  *   retired instead of being freed at once</TD><TD>CEpochGuard.h</TD></TR>
   * <TR><TD>Add CException, a basic exception class with tracing functionality</TD>
   *   <TD>CException.h</TD></TR>
   * <TR><TD>Add CLockable, a base class to make objects lockable via atomic_flag
@@ -24,6 +26,8 @@
   * <TR><TD>Preprocessor macros for general usage</TD><TD>macros.h</TD></TR>
   * <TR><TD>Helper templates and macros for various little issues</TD>
   *   <TD>templates.h</TD></TR>
+  * <TR><TD>Shared pool of worker threads for the parallel functions</TD>
+  *   <TD>thread_pool.h</TD></TR>
   * <TR><TD>Includes and typedefs for types used throughout libpwx</TD>
   *   <TD>types.h</TD></TR>
   * </TABLE>
@@ -61,6 +65,7 @@
 #include "basic/macros.h"
 #include "basic/debug.h"
 
+#include "basic/CEpochGuard.h"
 #include "basic/CException.h"
 #include "basic/CLockable.h"
 #include "basic/CLockGuard.h"
@@ -69,6 +74,7 @@
 #include "basic/templates.h"
 #include "basic/types.h"
 #include "basic/string_utils.h"
+#include "basic/thread_pool.h"
 
 
 #endif // PWX_PWX_BASIC_H_INCLUDED
@@ -11,15 +11,21 @@
   *
   * <TABLE border='1'>
   * <TR><TH>Template</TH><TH>Task</TH><TH>Include file</TH></TR>
+  * <TR><TD>TBoundedQueue</TD><TD>A lock-free bounded FiFo container</TD><TD>TBoundedQueue.h</TD></TR>
   * <TR><TD>TChainHash</TD><TD>A Chained hash table</TD><TD>TChainHash.h</TD></TR>
   * <TR><TD>TDoubleList</TD><TD>A doubly linked list</TD><TD>TDoubleList.h</TD></TR>
   * <TR><TD>TDoubleRing</TD><TD>A doubly linked ring</TD><TD>TDoubleRing.h</TD></TR>
+  * <TR><TD>TFlatHash</TD><TD>An open hash table without elements, not thread safe</TD><TD>TFlatHash.h</TD></TR>
+  * <TR><TD>TLockFreeHash</TD><TD>A lock-free open hash table</TD><TD>TLockFreeHash.h</TD></TR>
+  * <TR><TD>TLockFreeQueue</TD><TD>A lock-free FiFo container</TD><TD>TLockFreeQueue.h</TD></TR>
+  * <TR><TD>TLockFreeStack</TD><TD>A lock-free FiLo container</TD><TD>TLockFreeStack.h</TD></TR>
   * <TR><TD>TOpenHash</TD><TD>An open hash table</TD><TD>TOpenHash.h</TD></TR>
   * <TR><TD>TQueue</TD><TD>A FiFo container</TD><TD>TQueue.h</TD></TR>
   * <TR><TD>TSet</TD><TD>A unique content container</TD><TD>TSet.h</TD></TR>
   * <TR><TD>TSingleList</TD><TD>A singly linked list</TD><TD>TSingleList.h</TD></TR>
   * <TR><TD>TSingleRing</TD><TD>A singly linked ring</TD><TD>TSingleRing.h</TD></TR>
   * <TR><TD>TStack</TD><TD>A FiLo container</TD><TD>TStack.h</TD></TR>
+  * <TR><TD>TSwissHash</TD><TD>An open hash table probing fingerprint groups</TD><TD>TSwissHash.h</TD></TR>
   * </TABLE>
   *
   * (c)  2007 - 2021 PrydeWorX
@@ -53,15 +59,21 @@
 
 #include "basic/compiler.h"
 
+#include "container/TBoundedQueue.h"
 #include "container/TChainHash.h"
 #include "container/TDoubleList.h"
 #include "container/TDoubleRing.h"
+#include "container/TFlatHash.h"
+#include "container/TLockFreeHash.h"
+#include "container/TLockFreeQueue.h"
+#include "container/TLockFreeStack.h"
 #include "container/TOpenHash.h"
 #include "container/TQueue.h"
 #include "container/TSet.h"
 #include "container/TSingleList.h"
 #include "container/TSingleRing.h"
 #include "container/TStack.h"
+#include "container/TSwissHash.h"
 
 
 #endif // PWX_CONTAINERS_H_INCLUDED
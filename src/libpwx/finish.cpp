@@ -30,10 +30,12 @@
 **/
 
 
+#include "basic/CEpochGuard.h"
 #include "basic/mem_utils.h"
 #include "basic/compiler.h"
 #include "basic/debug.h"
 #include "basic/macros.h"
+#include "basic/thread_pool.h"
 #include "libpwx/finish.h"
 #include "libpwx/worker_PAH.h"
 #include "libpwx/worker_SCT.h"
@@ -49,6 +51,12 @@ void finish() noexcept {
 	PAH.clearArgs();
 	SCT.clearTables();
 
+	// End the pool threads, so what they retired is handed over
+	thread_pool_stop();
+
+	// Free everything that waits for readers that are gone by now
+	epoch_drain();
+
 	// Let's see what the memory map has caught (if debugging is enabled)
 	if ( !mem_map_report() )
 		log_debug_error( "pwxLib Finish", "%s", "The Memory Map reported errors! Fix those ASAP!" );
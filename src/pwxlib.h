@@ -98,21 +98,28 @@
   *
   * @subsection contContain Containers
   * All containers are based on pointers instead of copying objects. Further they
-  * are internally threadsafe. But they lack many convenient tools and utilities the
-  * standard containers offer, so you are encouraged to use them instead.
+  * are internally threadsafe, except for pwx::TFlatHash. But they lack many
+  * convenient tools and utilities the standard containers offer, so you are
+  * encouraged to use them instead.
   *
   * The containers are, in alphabetical order:
-  * | Container        | Include     | Description                                                       |
-  * | ---------------- | ----------- | ----------------------------------------------------------------- |
-  * | pwx::TChainHash  | PChainHash  | Chained hash container.                                           |
-  * | pwx::TDoubleList | PDoubleList | Doubly linked list.                                               |
-  * | pwx::TDoubleRing | PDoubleRing | Doubly linked list where the head and tail are connected.         |
-  * | pwx::TOpenHash   | POpenHash   | Open hash container with auto grow and Robin Hood Insertion.      |
-  * | pwx::TQueue      | PQueue      | Doubly linked list variant that pop()s head and push()es tail.    |
-  * | pwx::TSet        | PSet        | A set container supporting unions, differences and intersections. |
-  * | pwx::TSingleList | PSingleList | Singly linked list.                                               |
-  * | pwx::TSingleRing | PSingleRing | Singly linked list where head is next of tail.                    |
-  * | pwx::TStack      | PStack      | Singly linked list variant that pop()s tail and push()es tail.    |
+  * | Container           | Include        | Description                                                       |
+  * | ------------------- | -------------- | ----------------------------------------------------------------- |
+  * | pwx::TBoundedQueue  | PBoundedQueue  | Lock-free bounded FiFo queue on a ring of sequenced cells.        |
+  * | pwx::TChainHash     | PChainHash     | Chained hash container.                                           |
+  * | pwx::TDoubleList    | PDoubleList    | Doubly linked list.                                               |
+  * | pwx::TDoubleRing    | PDoubleRing    | Doubly linked list where the head and tail are connected.         |
+  * | pwx::TFlatHash      | PFlatHash      | Open hash container storing keys inline, not thread safe.         |
+  * | pwx::TLockFreeHash  | PLockFreeHash  | Lock-free open hash container with cooperative growth.            |
+  * | pwx::TLockFreeQueue | PLockFreeQueue | Lock-free unbounded FiFo queue after Michael and Scott.           |
+  * | pwx::TLockFreeStack | PLockFreeStack | Lock-free LiFo stack after Treiber.                               |
+  * | pwx::TOpenHash      | POpenHash      | Open hash container with auto grow and Robin Hood Insertion.      |
+  * | pwx::TQueue         | PQueue         | Doubly linked list variant that pop()s head and push()es tail.    |
+  * | pwx::TSet           | PSet           | A set container supporting unions, differences and intersections. |
+  * | pwx::TSingleList    | PSingleList    | Singly linked list.                                               |
+  * | pwx::TSingleRing    | PSingleRing    | Singly linked list where head is next of tail.                    |
+  * | pwx::TStack         | PStack         | Singly linked list variant that pop()s tail and push()es tail.    |
+  * | pwx::TSwissHash     | PSwissHash     | Open hash container probing 16 fingerprints at once.              |
   *
   * @subsection contTools Tools
   * Apart from the workers and the containers, there are some tools that might be
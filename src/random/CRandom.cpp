@@ -30,17 +30,23 @@
 **/
 
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstring>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "basic/compiler.h"
 #include "basic/macros.h"
 #include "basic/debug.h"
 
 #include "basic/mem_utils.h"
+#include "basic/thread_pool.h"
 #include "random/CRandom.h"
+#include "random/CRandomSimplex.h"
 #include "random/CRandomTHash.h"
 #include "random/CRandomTRandom.h"
 #include "random/CRandomWordConstants.h"
@@ -413,7 +419,7 @@ double CRandom::getStepping( double i, double x, double y, double z, double w, i
 
 /** @brief get Simplex Dot for one dimension
 **/
-double CRandom::getSimpDot( int32_t index, double x ) noexcept {
+double CRandom::getSimpDot( int32_t index, double x ) const noexcept {
 	assert ( ( index >= 0 ) && ( index < 4 ) );
 	return ( ( constants::spxGrTab[index][0] * x ) );
 }
@@ -421,7 +427,7 @@ double CRandom::getSimpDot( int32_t index, double x ) noexcept {
 
 /** @brief get Simplex Dot for second dimension
 **/
-double CRandom::getSimpDot( int32_t index, double x, double y ) noexcept {
+double CRandom::getSimpDot( int32_t index, double x, double y ) const noexcept {
 	assert ( ( index >= 0 ) && ( index < 8 ) );
 	return ( ( constants::spxGrTab[index][0] * x )
 	         + ( constants::spxGrTab[index][1] * y )
@@ -431,7 +437,7 @@ double CRandom::getSimpDot( int32_t index, double x, double y ) noexcept {
 
 /** @brief get Simplex Dot for third dimension
 **/
-double CRandom::getSimpDot( int32_t index, double x, double y, double z ) noexcept {
+double CRandom::getSimpDot( int32_t index, double x, double y, double z ) const noexcept {
 	assert ( ( index >= 0 ) && ( index < 12 ) );
 	return ( ( constants::spxGrTab[index][0] * x )
 	         + ( constants::spxGrTab[index][1] * y )
@@ -442,7 +448,7 @@ double CRandom::getSimpDot( int32_t index, double x, double y, double z ) noexce
 
 /** @brief get Simplex Dot for fourth dimension
 **/
-double CRandom::getSimpDot( int32_t index, double x, double y, double z, double w ) noexcept {
+double CRandom::getSimpDot( int32_t index, double x, double y, double z, double w ) const noexcept {
 	assert ( ( index >= 0 ) && ( index < 32 ) );
 	return ( ( constants::spxGrTab[index][0] * x )
 	         + ( constants::spxGrTab[index][1] * y )
@@ -459,32 +465,35 @@ double CRandom::getSimpDot( int32_t index, double x, double y, double z, double
   * @param[in] x X-Coordinate of the simplex point
   * @return Noise value between -1.0 and 1.0
 **/
-double CRandom::getSpx1D( double x ) noexcept {
-	double contrib = 0.0;
+double CRandom::getSpx1D( double x ) const noexcept {
+	double  contrib = 0.0;
+	double  corn[2];    // Contributions of the two edges
+	double  dist[2][1]; // Distances from the two edges
+	int32_t grads[2];   // Gradient table indices of the two edges
+	int32_t norms[1];   // Normalized coordinate
+	int32_t perms[1];   // Permutation table index
 
-	spxNorms[0] = static_cast<int32_t> ( std::floor( x ) ); // Normalized X-Coordinate
-	spxPerms[0] = spxNorms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
+	norms[0] = static_cast<int32_t> ( std::floor( x ) ); // Normalized X-Coordinate
+	perms[0] = norms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
 
 	// Distances from left and right edge
-	spxDist[0][0] = x - spxNorms[0];
-	spxDist[1][0] = 1.0 - spxDist[0][0];
+	dist[0][0] = x - norms[0];
+	dist[1][0] = 1.0 - dist[0][0];
 
 	// Permuted numbers, normalized to a range of 0 to 3
-	spxGrads[0] = spxTab[spxPerms[0]] % 4;
-	spxGrads[1] = spxTab[spxPerms[0] + 1] % 4;
+	grads[0] = spxTab[perms[0]] % 4;
+	grads[1] = spxTab[perms[0] + 1] % 4;
 
 	// Calculate the contribution from the two edges
-	contrib = 0.75 - std::pow( spxDist[0][0], 2 );
-	spxCorn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[0], noiseD( x ) ) : 0.0;
-	contrib = 0.75 - std::pow( spxDist[1][0], 2 );
-	spxCorn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[1], noiseD( x + 1 ) ) : 0.0;
+	contrib = 0.75 - std::pow( dist[0][0], 2 );
+	corn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[0], noiseD( x ) ) : 0.0;
+	contrib = 0.75 - std::pow( dist[1][0], 2 );
+	corn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[1], noiseD( x + 1 ) ) : 0.0;
 
 
 	// Add contributions from each corner to get the final noise value.
 	// The result is a value in the interval [-1,1].
-	double result = 3.16049383304737219191338226664811 * ( spxCorn[0] + spxCorn[1] );
-	// Note: This factor has been found by searching the factor needed
-	//       To get 1.0 with the largest result out of 100M iterations
+	double result = constants::spxScale[0] * ( corn[0] + corn[1] );
 	if ( result > 1.0l ) result  = 1.0l;
 	if ( result < -1.0l ) result = -1.0l;
 	return ( result );
@@ -499,48 +508,52 @@ double CRandom::getSpx1D( double x ) noexcept {
   * @param[in] y Y-Coordinate of the simplex point
   * @return Noise value between -1.0 and 1.0
 **/
-double CRandom::getSpx2D( double x, double y ) noexcept {
-	double contrib = x + ( ( x + y ) * constants::spxSkew[0][0] );
-	spxNorms[0] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
+double CRandom::getSpx2D( double x, double y ) const noexcept {
+	double  corn[3];    // Contributions of the three corners
+	double  dist[3][2]; // Distances from the three corners
+	int32_t grads[3];   // Gradient table indices of the three corners
+	int32_t norms[2];   // Normalized coordinates
+	int32_t offs[1][2]; // Offsets of the middle corner
+	int32_t perms[2];   // Permutation table indices
+	double  contrib = x + ( ( x + y ) * constants::spxSkew[0][0] );
+	norms[0] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
 	contrib = y + ( ( x + y ) * constants::spxSkew[0][0] );
-	spxNorms[1] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized Y-Coordinate
-	spxPerms[0] = spxNorms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
-	spxPerms[1] = spxNorms[1] & 0x000000ff; // Y-Coordinate factor for Permutation Table
+	norms[1] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized Y-Coordinate
+	perms[0] = norms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
+	perms[1] = norms[1] & 0x000000ff; // Y-Coordinate factor for Permutation Table
 
 	// Distances from corners, middle and last corner are filled when offsets are clear
-	spxDist[0][0] = x - ( spxNorms[0] - ( ( spxNorms[0] + spxNorms[1] ) * constants::spxSkew[0][1] ) );
-	spxDist[0][1] = y - ( spxNorms[1] - ( ( spxNorms[0] + spxNorms[1] ) * constants::spxSkew[0][1] ) );
+	dist[0][0] = x - ( norms[0] - ( ( norms[0] + norms[1] ) * constants::spxSkew[0][1] ) );
+	dist[0][1] = y - ( norms[1] - ( ( norms[0] + norms[1] ) * constants::spxSkew[0][1] ) );
 
-	spxOffs[0][0] = ( spxDist[0][0] > spxDist[0][1] ) ? 1 : 0; // Upper triangle (1, 0),
-	spxOffs[0][1] = ( spxDist[0][0] > spxDist[0][1] ) ? 0 : 1; // Lower triangle (0, 1).
+	offs[0][0] = ( dist[0][0] > dist[0][1] ) ? 1 : 0; // Upper triangle (1, 0),
+	offs[0][1] = ( dist[0][0] > dist[0][1] ) ? 0 : 1; // Lower triangle (0, 1).
 
 	// Distance from middle corner
-	spxDist[1][0] = spxDist[0][0] - spxOffs[0][0] + constants::spxSkew[0][1];
-	spxDist[1][1] = spxDist[0][1] - spxOffs[0][1] + constants::spxSkew[0][1];
+	dist[1][0] = dist[0][0] - offs[0][0] + constants::spxSkew[0][1];
+	dist[1][1] = dist[0][1] - offs[0][1] + constants::spxSkew[0][1];
 
 	// Distance from last corner
-	spxDist[2][0] = spxDist[0][0] - 1.0 + ( 2.0 * constants::spxSkew[0][1] );
-	spxDist[2][1] = spxDist[0][1] - 1.0 + ( 2.0 * constants::spxSkew[0][1] );
+	dist[2][0] = dist[0][0] - 1.0 + ( 2.0 * constants::spxSkew[0][1] );
+	dist[2][1] = dist[0][1] - 1.0 + ( 2.0 * constants::spxSkew[0][1] );
 
 	// Permuted numbers, normalized to a range of 0 to 7
-	spxGrads[0] = spxTab[spxPerms[0] + spxTab[spxPerms[1]]] % 8;
-	spxGrads[1] = spxTab[spxPerms[0] + spxOffs[0][0] + spxTab[spxPerms[1] + spxOffs[0][1]]] % 8;
-	spxGrads[2] = spxTab[spxPerms[0] + 1 + spxTab[spxPerms[1] + 1]] % 8;
+	grads[0] = spxTab[perms[0] + spxTab[perms[1]]] % 8;
+	grads[1] = spxTab[perms[0] + offs[0][0] + spxTab[perms[1] + offs[0][1]]] % 8;
+	grads[2] = spxTab[perms[0] + 1 + spxTab[perms[1] + 1]] % 8;
 
 	// Calculate the contribution from the three corners
-	contrib = 0.5 - std::pow( spxDist[0][0], 2 ) - std::pow( spxDist[0][1], 2 );
-	spxCorn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[0], spxDist[0][0], spxDist[0][1] ) : 0.0;
-	contrib = 0.5 - std::pow( spxDist[1][0], 2 ) - std::pow( spxDist[1][1], 2 );
-	spxCorn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[1], spxDist[1][0], spxDist[1][1] ) : 0.0;
-	contrib = 0.5 - std::pow( spxDist[2][0], 2 ) - std::pow( spxDist[2][1], 2 );
-	spxCorn[2] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[2], spxDist[2][0], spxDist[2][1] ) : 0.0;
+	contrib = 0.5 - std::pow( dist[0][0], 2 ) - std::pow( dist[0][1], 2 );
+	corn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[0], dist[0][0], dist[0][1] ) : 0.0;
+	contrib = 0.5 - std::pow( dist[1][0], 2 ) - std::pow( dist[1][1], 2 );
+	corn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[1], dist[1][0], dist[1][1] ) : 0.0;
+	contrib = 0.5 - std::pow( dist[2][0], 2 ) - std::pow( dist[2][1], 2 );
+	corn[2] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[2], dist[2][0], dist[2][1] ) : 0.0;
 	// Note: This is not looped, because the loop would produce more overhead than it is worth to just have 3 less lines.
 
 	// Add contributions from each corner to get the final noise value.
 	// The result is scaled to return values in the interval [-1,1].
-	double result = 70.14805770653948968629265436902642 * ( spxCorn[0] + spxCorn[1] + spxCorn[2] );
-	// Note: This factor has been found by searching the factor needed
-	//       To get 1.0 with the largest result out of 100M iterations
+	double result = constants::spxScale[1] * ( corn[0] + corn[1] + corn[2] );
 	if ( result > 1.0l ) result  = 1.0l;
 	if ( result < -1.0l ) result = -1.0l;
 	return ( result );
@@ -556,114 +569,118 @@ double CRandom::getSpx2D( double x, double y ) noexcept {
   * @param[in] z Z-Coordinate of the simplex point
   * @return Noise value between -1.0 and 1.0
 **/
-double CRandom::getSpx3D( double x, double y, double z ) noexcept {
-	double contrib = x + ( ( x + y + z ) * constants::spxSkew[1][0] );
-	spxNorms[0] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
+double CRandom::getSpx3D( double x, double y, double z ) const noexcept {
+	double  corn[4];    // Contributions of the four corners
+	double  dist[4][3]; // Distances from the four corners
+	int32_t grads[4];   // Gradient table indices of the four corners
+	int32_t norms[3];   // Normalized coordinates
+	int32_t offs[2][3]; // Offsets of the second and third corner
+	int32_t perms[3];   // Permutation table indices
+	double  contrib = x + ( ( x + y + z ) * constants::spxSkew[1][0] );
+	norms[0] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
 	contrib = y + ( ( x + y + z ) * constants::spxSkew[1][0] );
-	spxNorms[1] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized Y-Coordinate
+	norms[1] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized Y-Coordinate
 	contrib = z + ( ( x + y + z ) * constants::spxSkew[1][0] );
-	spxNorms[2] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized Z-Coordinate
-	spxPerms[0] = spxNorms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
-	spxPerms[1] = spxNorms[1] & 0x000000ff; // Y-Coordinate factor for Permutation Table
-	spxPerms[2] = spxNorms[2] & 0x000000ff; // Z-Coordinate factor for Permutation Table
+	norms[2] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized Z-Coordinate
+	perms[0] = norms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
+	perms[1] = norms[1] & 0x000000ff; // Y-Coordinate factor for Permutation Table
+	perms[2] = norms[2] & 0x000000ff; // Z-Coordinate factor for Permutation Table
 
 	// Distances from corners, second, third and last corner are filled when offsets are clear
-	spxDist[0][0] = x - ( spxNorms[0] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] ) * constants::spxSkew[1][1] ) );
-	spxDist[0][1] = y - ( spxNorms[1] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] ) * constants::spxSkew[1][1] ) );
-	spxDist[0][2] = z - ( spxNorms[2] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] ) * constants::spxSkew[1][1] ) );
+	dist[0][0] = x - ( norms[0] - ( ( norms[0] + norms[1] + norms[2] ) * constants::spxSkew[1][1] ) );
+	dist[0][1] = y - ( norms[1] - ( ( norms[0] + norms[1] + norms[2] ) * constants::spxSkew[1][1] ) );
+	dist[0][2] = z - ( norms[2] - ( ( norms[0] + norms[1] + norms[2] ) * constants::spxSkew[1][1] ) );
 
 	// For the 3D case, the simplex shape is a slightly irregular tetrahedron.
 	// Determine which simplex we are in.
-	if ( spxDist[0][0] >= spxDist[0][1] ) {
-		if ( spxDist[0][1] >= spxDist[0][2] ) {
+	if ( dist[0][0] >= dist[0][1] ) {
+		if ( dist[0][1] >= dist[0][2] ) {
 			// X Y Z order
-			spxOffs[0][0] = 1;
-			spxOffs[0][1] = 0;
-			spxOffs[0][2] = 0;
-			spxOffs[1][0] = 1;
-			spxOffs[1][1] = 1;
-			spxOffs[1][2] = 0;
-		} else if ( spxDist[0][0] >= spxDist[0][2] ) {
+			offs[0][0] = 1;
+			offs[0][1] = 0;
+			offs[0][2] = 0;
+			offs[1][0] = 1;
+			offs[1][1] = 1;
+			offs[1][2] = 0;
+		} else if ( dist[0][0] >= dist[0][2] ) {
 			// X Z Y order
-			spxOffs[0][0] = 1;
-			spxOffs[0][1] = 0;
-			spxOffs[0][2] = 0;
-			spxOffs[1][0] = 1;
-			spxOffs[1][1] = 0;
-			spxOffs[1][2] = 1;
+			offs[0][0] = 1;
+			offs[0][1] = 0;
+			offs[0][2] = 0;
+			offs[1][0] = 1;
+			offs[1][1] = 0;
+			offs[1][2] = 1;
 		} else {
 			// Z X Y order
-			spxOffs[0][0] = 0;
-			spxOffs[0][1] = 0;
-			spxOffs[0][2] = 1;
-			spxOffs[1][0] = 1;
-			spxOffs[1][1] = 0;
-			spxOffs[1][2] = 1;
+			offs[0][0] = 0;
+			offs[0][1] = 0;
+			offs[0][2] = 1;
+			offs[1][0] = 1;
+			offs[1][1] = 0;
+			offs[1][2] = 1;
 		}
-	} else { // spxDist[0][0] < spxDist[0][1]
-		if ( spxDist[0][1] < spxDist[0][2] ) {
+	} else { // dist[0][0] < dist[0][1]
+		if ( dist[0][1] < dist[0][2] ) {
 			// Z Y X order
-			spxOffs[0][0] = 0;
-			spxOffs[0][1] = 0;
-			spxOffs[0][2] = 1;
-			spxOffs[1][0] = 0;
-			spxOffs[1][1] = 1;
-			spxOffs[1][2] = 1;
-		} else if ( spxDist[0][0] < spxDist[0][2] ) {
+			offs[0][0] = 0;
+			offs[0][1] = 0;
+			offs[0][2] = 1;
+			offs[1][0] = 0;
+			offs[1][1] = 1;
+			offs[1][2] = 1;
+		} else if ( dist[0][0] < dist[0][2] ) {
 			// Y Z X order
-			spxOffs[0][0] = 0;
-			spxOffs[0][1] = 1;
-			spxOffs[0][2] = 0;
-			spxOffs[1][0] = 0;
-			spxOffs[1][1] = 1;
-			spxOffs[1][2] = 1;
+			offs[0][0] = 0;
+			offs[0][1] = 1;
+			offs[0][2] = 0;
+			offs[1][0] = 0;
+			offs[1][1] = 1;
+			offs[1][2] = 1;
 		} else {
 			// Y X Z order
-			spxOffs[0][0] = 0;
-			spxOffs[0][1] = 1;
-			spxOffs[0][2] = 0;
-			spxOffs[1][0] = 1;
-			spxOffs[1][1] = 1;
-			spxOffs[1][2] = 0;
+			offs[0][0] = 0;
+			offs[0][1] = 1;
+			offs[0][2] = 0;
+			offs[1][0] = 1;
+			offs[1][1] = 1;
+			offs[1][2] = 0;
 		}
 	}
 
 	// Distance from second corner
-	spxDist[1][0] = spxDist[0][0] - spxOffs[0][0] + constants::spxSkew[1][1];
-	spxDist[1][1] = spxDist[0][1] - spxOffs[0][1] + constants::spxSkew[1][1];
-	spxDist[1][2] = spxDist[0][2] - spxOffs[0][2] + constants::spxSkew[1][1];
+	dist[1][0] = dist[0][0] - offs[0][0] + constants::spxSkew[1][1];
+	dist[1][1] = dist[0][1] - offs[0][1] + constants::spxSkew[1][1];
+	dist[1][2] = dist[0][2] - offs[0][2] + constants::spxSkew[1][1];
 
 	// Distance from third corner
-	spxDist[2][0] = spxDist[0][0] - spxOffs[1][0] + ( 2.0 * constants::spxSkew[1][1] );
-	spxDist[2][1] = spxDist[0][1] - spxOffs[1][1] + ( 2.0 * constants::spxSkew[1][1] );
-	spxDist[2][2] = spxDist[0][2] - spxOffs[1][2] + ( 2.0 * constants::spxSkew[1][1] );
+	dist[2][0] = dist[0][0] - offs[1][0] + ( 2.0 * constants::spxSkew[1][1] );
+	dist[2][1] = dist[0][1] - offs[1][1] + ( 2.0 * constants::spxSkew[1][1] );
+	dist[2][2] = dist[0][2] - offs[1][2] + ( 2.0 * constants::spxSkew[1][1] );
 
 	// Distance from last corner
-	spxDist[3][0] = spxDist[0][0] - 1.0 + ( 3.0 * constants::spxSkew[1][1] );
-	spxDist[3][1] = spxDist[0][1] - 1.0 + ( 3.0 * constants::spxSkew[1][1] );
-	spxDist[3][2] = spxDist[0][2] - 1.0 + ( 3.0 * constants::spxSkew[1][1] );
+	dist[3][0] = dist[0][0] - 1.0 + ( 3.0 * constants::spxSkew[1][1] );
+	dist[3][1] = dist[0][1] - 1.0 + ( 3.0 * constants::spxSkew[1][1] );
+	dist[3][2] = dist[0][2] - 1.0 + ( 3.0 * constants::spxSkew[1][1] );
 
 	// Permuted numbers, normalized to a range of 0 to 11
-	spxGrads[0] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2]]]] % 12;
-	spxGrads[1] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxOffs[0][2]] + spxOffs[0][1]] + spxOffs[0][0]] % 12;
-	spxGrads[2] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxOffs[1][2]] + spxOffs[1][1]] + spxOffs[1][0]] % 12;
-	spxGrads[3] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + 1] + 1] + 1] % 12;
+	grads[0] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2]]]] % 12;
+	grads[1] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + offs[0][2]] + offs[0][1]] + offs[0][0]] % 12;
+	grads[2] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + offs[1][2]] + offs[1][1]] + offs[1][0]] % 12;
+	grads[3] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + 1] + 1] + 1] % 12;
 
 	// Calculate the contribution from the four corners
-	contrib = 0.6 - std::pow( spxDist[0][0], 2 ) - std::pow( spxDist[0][1], 2 ) - std::pow( spxDist[0][2], 2 );
-	spxCorn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[0], spxDist[0][0], spxDist[0][1], spxDist[0][2] ) : 0.0;
-	contrib = 0.6 - std::pow( spxDist[1][0], 2 ) - std::pow( spxDist[1][1], 2 ) - std::pow( spxDist[1][2], 2 );
-	spxCorn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[1], spxDist[1][0], spxDist[1][1], spxDist[1][2] ) : 0.0;
-	contrib = 0.6 - std::pow( spxDist[2][0], 2 ) - std::pow( spxDist[2][1], 2 ) - std::pow( spxDist[2][2], 2 );
-	spxCorn[2] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[2], spxDist[2][0], spxDist[2][1], spxDist[2][2] ) : 0.0;
-	contrib = 0.6 - std::pow( spxDist[3][0], 2 ) - std::pow( spxDist[3][1], 2 ) - std::pow( spxDist[3][2], 2 );
-	spxCorn[3] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( spxGrads[3], spxDist[3][0], spxDist[3][1], spxDist[3][2] ) : 0.0;
+	contrib = 0.6 - std::pow( dist[0][0], 2 ) - std::pow( dist[0][1], 2 ) - std::pow( dist[0][2], 2 );
+	corn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[0], dist[0][0], dist[0][1], dist[0][2] ) : 0.0;
+	contrib = 0.6 - std::pow( dist[1][0], 2 ) - std::pow( dist[1][1], 2 ) - std::pow( dist[1][2], 2 );
+	corn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[1], dist[1][0], dist[1][1], dist[1][2] ) : 0.0;
+	contrib = 0.6 - std::pow( dist[2][0], 2 ) - std::pow( dist[2][1], 2 ) - std::pow( dist[2][2], 2 );
+	corn[2] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[2], dist[2][0], dist[2][1], dist[2][2] ) : 0.0;
+	contrib = 0.6 - std::pow( dist[3][0], 2 ) - std::pow( dist[3][1], 2 ) - std::pow( dist[3][2], 2 );
+	corn[3] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot( grads[3], dist[3][0], dist[3][1], dist[3][2] ) : 0.0;
 
 	// Add contributions from each corner to get the final noise value.
 	// The result is scaled to return values in the interval [-1,1].
-	double result = 36.11293688087369702088835765607655 * ( spxCorn[0] + spxCorn[1] + spxCorn[2] + spxCorn[3] );
-	// Note: This factor has been found by searching the factor needed
-	//       To get 1.0 with the largest result out of 100M iterations
+	double result = constants::spxScale[2] * ( corn[0] + corn[1] + corn[2] + corn[3] );
 	if ( result > 1.0l ) result  = 1.0l;
 	if ( result < -1.0l ) result = -1.0l;
 	return ( result );
@@ -680,27 +697,33 @@ double CRandom::getSpx3D( double x, double y, double z ) noexcept {
   * @param[in] w W-Coordinate of the simplex point
   * @return Noise value between -1.0 and 1.0
 **/
-double CRandom::getSpx4D( double x, double y, double z, double w ) noexcept {
+double CRandom::getSpx4D( double x, double y, double z, double w ) const noexcept {
+	double  corn[4];    // Contributions of the first four corners, the fifth is never used
+	double  dist[5][4]; // Distances from the five corners
+	int32_t grads[5];   // Gradient table indices of the five corners
+	int32_t norms[4];   // Normalized coordinates
+	int32_t offs[3][4]; // Offsets of the second, third and fourth corner
+	int32_t perms[4];   // Permutation table indices
 	int32_t traverse;
 	double  contrib = x + ( ( x + y + z + w ) * constants::spxSkew[2][0] );
-	spxNorms[0] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
+	norms[0] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
 	contrib = y + ( ( x + y + z + w ) * constants::spxSkew[2][0] );
-	spxNorms[1] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
+	norms[1] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
 	contrib = z + ( ( x + y + z + w ) * constants::spxSkew[2][0] );
-	spxNorms[2] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
+	norms[2] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
 	contrib = w + ( ( x + y + z + w ) * constants::spxSkew[2][0] );
-	spxNorms[3] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
+	norms[3] = static_cast<int32_t> ( std::floor( contrib ) ); // Normalized X-Coordinate
 
-	spxPerms[0] = spxNorms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
-	spxPerms[1] = spxNorms[1] & 0x000000ff; // Y-Coordinate factor for Permutation Table
-	spxPerms[2] = spxNorms[2] & 0x000000ff; // Z-Coordinate factor for Permutation Table
-	spxPerms[3] = spxNorms[3] & 0x000000ff; // W-Coordinate factor for Permutation Table
+	perms[0] = norms[0] & 0x000000ff; // X-Coordinate factor for Permutation Table
+	perms[1] = norms[1] & 0x000000ff; // Y-Coordinate factor for Permutation Table
+	perms[2] = norms[2] & 0x000000ff; // Z-Coordinate factor for Permutation Table
+	perms[3] = norms[3] & 0x000000ff; // W-Coordinate factor for Permutation Table
 
 	// Distances from corners, second, third and last corner are filled when offsets are clear
-	spxDist[0][0] = x - ( spxNorms[0] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] + spxNorms[3] ) * constants::spxSkew[2][1] ) );
-	spxDist[0][1] = y - ( spxNorms[1] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] + spxNorms[3] ) * constants::spxSkew[2][1] ) );
-	spxDist[0][2] = z - ( spxNorms[2] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] + spxNorms[3] ) * constants::spxSkew[2][1] ) );
-	spxDist[0][3] = w - ( spxNorms[3] - ( ( spxNorms[0] + spxNorms[1] + spxNorms[2] + spxNorms[3] ) * constants::spxSkew[2][1] ) );
+	dist[0][0] = x - ( norms[0] - ( ( norms[0] + norms[1] + norms[2] + norms[3] ) * constants::spxSkew[2][1] ) );
+	dist[0][1] = y - ( norms[1] - ( ( norms[0] + norms[1] + norms[2] + norms[3] ) * constants::spxSkew[2][1] ) );
+	dist[0][2] = z - ( norms[2] - ( ( norms[0] + norms[1] + norms[2] + norms[3] ) * constants::spxSkew[2][1] ) );
+	dist[0][3] = w - ( norms[3] - ( ( norms[0] + norms[1] + norms[2] + norms[3] ) * constants::spxSkew[2][1] ) );
 
 	// For the 4D case, the simplex is a 4D shape.
 	// The method below is a good way of finding the ordering of x,y,z,w and
@@ -708,98 +731,293 @@ double CRandom::getSpx4D( double x, double y, double z, double w ) noexcept {
 	// First, six pair-wise comparisons are performed between each possible pair
 	// of the four coordinates, and the results are used to add up binary bits
 	// for an integer index.
-	traverse = ( ( spxDist[0][0] > spxDist[0][1] ) ? 32 : 0 )
-	           + ( ( spxDist[0][0] > spxDist[0][2] ) ? 16 : 0 )
-	           + ( ( spxDist[0][1] > spxDist[0][2] ) ? 8 : 0 )
-	           + ( ( spxDist[0][0] > spxDist[0][3] ) ? 4 : 0 )
-	           + ( ( spxDist[0][1] > spxDist[0][3] ) ? 2 : 0 )
-	           + ( ( spxDist[0][2] > spxDist[0][3] ) ? 1 : 0 );
+	traverse = ( ( dist[0][0] > dist[0][1] ) ? 32 : 0 )
+	           + ( ( dist[0][0] > dist[0][2] ) ? 16 : 0 )
+	           + ( ( dist[0][1] > dist[0][2] ) ? 8 : 0 )
+	           + ( ( dist[0][0] > dist[0][3] ) ? 4 : 0 )
+	           + ( ( dist[0][1] > dist[0][3] ) ? 2 : 0 )
+	           + ( ( dist[0][2] > dist[0][3] ) ? 1 : 0 );
 
 	// Now we can use constants::spxTrTab to set the coordinates in turn from the largest magnitude.
 	// The number 3 is at the position of the largest coordinate.
-	spxOffs[0][0] = constants::spxTrTab[traverse][0] >= 3 ? 1 : 0;
-	spxOffs[0][1] = constants::spxTrTab[traverse][1] >= 3 ? 1 : 0;
-	spxOffs[0][2] = constants::spxTrTab[traverse][2] >= 3 ? 1 : 0;
-	spxOffs[0][3] = constants::spxTrTab[traverse][3] >= 3 ? 1 : 0;
+	offs[0][0] = constants::spxTrTab[traverse][0] >= 3 ? 1 : 0;
+	offs[0][1] = constants::spxTrTab[traverse][1] >= 3 ? 1 : 0;
+	offs[0][2] = constants::spxTrTab[traverse][2] >= 3 ? 1 : 0;
+	offs[0][3] = constants::spxTrTab[traverse][3] >= 3 ? 1 : 0;
 	// The number 2 is at the second largest coordinate.
-	spxOffs[1][0] = constants::spxTrTab[traverse][0] >= 2 ? 1 : 0;
-	spxOffs[1][1] = constants::spxTrTab[traverse][1] >= 2 ? 1 : 0;
-	spxOffs[1][2] = constants::spxTrTab[traverse][2] >= 2 ? 1 : 0;
-	spxOffs[1][3] = constants::spxTrTab[traverse][3] >= 2 ? 1 : 0;
+	offs[1][0] = constants::spxTrTab[traverse][0] >= 2 ? 1 : 0;
+	offs[1][1] = constants::spxTrTab[traverse][1] >= 2 ? 1 : 0;
+	offs[1][2] = constants::spxTrTab[traverse][2] >= 2 ? 1 : 0;
+	offs[1][3] = constants::spxTrTab[traverse][3] >= 2 ? 1 : 0;
 	// The number 1 is at the second smallest coordinate.
-	spxOffs[2][0] = constants::spxTrTab[traverse][0] >= 1 ? 1 : 0;
-	spxOffs[2][1] = constants::spxTrTab[traverse][1] >= 1 ? 1 : 0;
-	spxOffs[2][2] = constants::spxTrTab[traverse][2] >= 1 ? 1 : 0;
-	spxOffs[2][3] = constants::spxTrTab[traverse][3] >= 1 ? 1 : 0;
+	offs[2][0] = constants::spxTrTab[traverse][0] >= 1 ? 1 : 0;
+	offs[2][1] = constants::spxTrTab[traverse][1] >= 1 ? 1 : 0;
+	offs[2][2] = constants::spxTrTab[traverse][2] >= 1 ? 1 : 0;
+	offs[2][3] = constants::spxTrTab[traverse][3] >= 1 ? 1 : 0;
 	// The fifth corner has all coordinate offsets = 1, so no need to look that up.
 
 	// Distance from second corner
-	spxDist[1][0] = spxDist[0][0] - spxOffs[0][0] + constants::spxSkew[2][1];
-	spxDist[1][1] = spxDist[0][1] - spxOffs[0][1] + constants::spxSkew[2][1];
-	spxDist[1][2] = spxDist[0][2] - spxOffs[0][2] + constants::spxSkew[2][1];
-	spxDist[1][3] = spxDist[0][3] - spxOffs[0][3] + constants::spxSkew[2][1];
+	dist[1][0] = dist[0][0] - offs[0][0] + constants::spxSkew[2][1];
+	dist[1][1] = dist[0][1] - offs[0][1] + constants::spxSkew[2][1];
+	dist[1][2] = dist[0][2] - offs[0][2] + constants::spxSkew[2][1];
+	dist[1][3] = dist[0][3] - offs[0][3] + constants::spxSkew[2][1];
 
 	// Distance from third corner
-	spxDist[2][0] = spxDist[0][0] - spxOffs[1][0] + ( 2.0 * constants::spxSkew[2][1] );
-	spxDist[2][1] = spxDist[0][1] - spxOffs[1][1] + ( 2.0 * constants::spxSkew[2][1] );
-	spxDist[2][2] = spxDist[0][2] - spxOffs[1][2] + ( 2.0 * constants::spxSkew[2][1] );
-	spxDist[2][3] = spxDist[0][3] - spxOffs[1][3] + ( 2.0 * constants::spxSkew[2][1] );
+	dist[2][0] = dist[0][0] - offs[1][0] + ( 2.0 * constants::spxSkew[2][1] );
+	dist[2][1] = dist[0][1] - offs[1][1] + ( 2.0 * constants::spxSkew[2][1] );
+	dist[2][2] = dist[0][2] - offs[1][2] + ( 2.0 * constants::spxSkew[2][1] );
+	dist[2][3] = dist[0][3] - offs[1][3] + ( 2.0 * constants::spxSkew[2][1] );
 
 	// Distance from fourth corner
-	spxDist[3][0] = spxDist[0][0] - spxOffs[2][0] + ( 3.0 * constants::spxSkew[2][1] );
-	spxDist[3][1] = spxDist[0][1] - spxOffs[2][1] + ( 3.0 * constants::spxSkew[2][1] );
-	spxDist[3][2] = spxDist[0][2] - spxOffs[2][2] + ( 3.0 * constants::spxSkew[2][1] );
-	spxDist[3][3] = spxDist[0][3] - spxOffs[2][3] + ( 3.0 * constants::spxSkew[2][1] );
+	dist[3][0] = dist[0][0] - offs[2][0] + ( 3.0 * constants::spxSkew[2][1] );
+	dist[3][1] = dist[0][1] - offs[2][1] + ( 3.0 * constants::spxSkew[2][1] );
+	dist[3][2] = dist[0][2] - offs[2][2] + ( 3.0 * constants::spxSkew[2][1] );
+	dist[3][3] = dist[0][3] - offs[2][3] + ( 3.0 * constants::spxSkew[2][1] );
 
 	// Distance from last corner
-	spxDist[4][0] = spxDist[0][0] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
-	spxDist[4][1] = spxDist[0][1] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
-	spxDist[4][2] = spxDist[0][2] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
-	spxDist[4][3] = spxDist[0][3] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
+	dist[4][0] = dist[0][0] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
+	dist[4][1] = dist[0][1] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
+	dist[4][2] = dist[0][2] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
+	dist[4][3] = dist[0][3] - 1.0 + ( 4.0 * constants::spxSkew[2][1] );
 
 	// Permuted numbers, normalized to a range of 0 to 32
-	spxGrads[0] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxTab[spxPerms[3]]]]] % 32;
-	spxGrads[1] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxTab[spxPerms[3] + spxOffs[0][3]] + spxOffs[0][2]] +
-	                                          spxOffs[0][1]] + spxOffs[0][0]] % 32;
-	spxGrads[2] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxTab[spxPerms[3] + spxOffs[1][3]] + spxOffs[1][2]] +
-	                                          spxOffs[1][1]] + spxOffs[1][0]] % 32;
-	spxGrads[3] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxTab[spxPerms[3] + spxOffs[2][3]] + spxOffs[2][2]] +
-	                                          spxOffs[2][1]] + spxOffs[2][0]] % 32;
-	spxGrads[4] = spxTab[spxPerms[0] + spxTab[spxPerms[1] + spxTab[spxPerms[2] + spxTab[spxPerms[3] + 1] + 1] + 1] + 1] % 32;
+	grads[0] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + spxTab[perms[3]]]]] % 32;
+	grads[1] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + spxTab[perms[3] + offs[0][3]] + offs[0][2]] +
+	                                          offs[0][1]] + offs[0][0]] % 32;
+	grads[2] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + spxTab[perms[3] + offs[1][3]] + offs[1][2]] +
+	                                          offs[1][1]] + offs[1][0]] % 32;
+	grads[3] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + spxTab[perms[3] + offs[2][3]] + offs[2][2]] +
+	                                          offs[2][1]] + offs[2][0]] % 32;
+	grads[4] = spxTab[perms[0] + spxTab[perms[1] + spxTab[perms[2] + spxTab[perms[3] + 1] + 1] + 1] + 1] % 32;
 
 	// Calculate the contribution from the four corners
-	contrib = 0.6 - ::std::pow( spxDist[0][0], 2 ) - std::pow( spxDist[0][1], 2 ) - std::pow( spxDist[0][2], 2 ) - std::pow( spxDist[0][3], 2 );
-	spxCorn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
-		  spxGrads[0], spxDist[0][0], spxDist[0][1], spxDist[0][2],
-		  spxDist[0][3]
+	contrib = 0.6 - ::std::pow( dist[0][0], 2 ) - std::pow( dist[0][1], 2 ) - std::pow( dist[0][2], 2 ) - std::pow( dist[0][3], 2 );
+	corn[0] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
+		  grads[0], dist[0][0], dist[0][1], dist[0][2],
+		  dist[0][3]
 	) : 0.0;
-	contrib = 0.6 - std::pow( spxDist[1][0], 2 ) - std::pow( spxDist[1][1], 2 ) - std::pow( spxDist[1][2], 2 ) - std::pow( spxDist[1][3], 2 );
-	spxCorn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
-		  spxGrads[1], spxDist[1][0], spxDist[1][1], spxDist[1][2],
-		  spxDist[1][3]
+	contrib = 0.6 - std::pow( dist[1][0], 2 ) - std::pow( dist[1][1], 2 ) - std::pow( dist[1][2], 2 ) - std::pow( dist[1][3], 2 );
+	corn[1] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
+		  grads[1], dist[1][0], dist[1][1], dist[1][2],
+		  dist[1][3]
 	) : 0.0;
-	contrib = 0.6 - std::pow( spxDist[2][0], 2 ) - std::pow( spxDist[2][1], 2 ) - std::pow( spxDist[2][2], 2 ) - std::pow( spxDist[2][3], 2 );
-	spxCorn[2] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
-		  spxGrads[2], spxDist[2][0], spxDist[2][1], spxDist[2][2],
-		  spxDist[2][3]
+	contrib = 0.6 - std::pow( dist[2][0], 2 ) - std::pow( dist[2][1], 2 ) - std::pow( dist[2][2], 2 ) - std::pow( dist[2][3], 2 );
+	corn[2] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
+		  grads[2], dist[2][0], dist[2][1], dist[2][2],
+		  dist[2][3]
 	) : 0.0;
-	contrib = 0.6 - std::pow( spxDist[3][0], 2 ) - std::pow( spxDist[3][1], 2 ) - std::pow( spxDist[3][2], 2 ) - std::pow( spxDist[3][3], 2 );
-	spxCorn[3] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
-		  spxGrads[3], spxDist[3][0], spxDist[3][1], spxDist[3][2],
-		  spxDist[3][3]
+	contrib = 0.6 - std::pow( dist[3][0], 2 ) - std::pow( dist[3][1], 2 ) - std::pow( dist[3][2], 2 ) - std::pow( dist[3][3], 2 );
+	corn[3] = ( contrib > 0.0 ) ? std::pow( contrib, 4 ) * getSimpDot(
+		  grads[3], dist[3][0], dist[3][1], dist[3][2],
+		  dist[3][3]
 	) : 0.0;
 
 	// Add contributions from each corner to get the final noise value.
 	// The result is scaled to return values in the interval [-1,1].
-	double result = 31.91239940056049206873467483092099 * ( spxCorn[0] + spxCorn[1] + spxCorn[2] + spxCorn[3] );
-	// Note: This factor has been found by searching the factor needed
-	//       To get 1.0 with the largest result out of 100M iterations
+	double result = constants::spxScale[3] * ( corn[0] + corn[1] + corn[2] + corn[3] );
 	if ( result > 1.0l ) result  = 1.0l;
 	if ( result < -1.0l ) result = -1.0l;
 	return ( result );
 }
 
 
+/** @brief simplex noise for a row of points
+  *
+  * Calculates `getSpx2D( xs[i], y )`, or `getSpx3D( xs[i], y, z )` if
+  * @a is3D is set, for @a count points. If @a useAvx is set, the AVX2
+  * kernels are used, which calculate several points at once.
+  *
+  * @param[out] dest the @a count results.
+  * @param[in] xs the @a count X-Coordinates.
+  * @param[in] y Y-Coordinate of all points.
+  * @param[in] z Z-Coordinate of all points, ignored unless @a is3D is set.
+  * @param[in] count number of points.
+  * @param[in] is3D calculate 3D instead of 2D simplex noise.
+  * @param[in] useAvx use the AVX2 kernels.
+**/
+void CRandom::getSpxRow( double* dest, double const* xs, double y, double z, uint32_t count,
+                         bool is3D, bool useAvx ) const noexcept {
+	if ( useAvx ) {
+		if ( is3D )
+			private_spx3D_avx2( dest, xs, y, z, count, spxTab );
+		else
+			private_spx2D_avx2( dest, xs, y, count, spxTab );
+	} else if ( is3D ) {
+		for ( uint32_t i = 0 ; i < count ; ++i )
+			dest[i] = getSpx3D( xs[i], y, z );
+	} else {
+		for ( uint32_t i = 0 ; i < count ; ++i )
+			dest[i] = getSpx2D( xs[i], y );
+	}
+}
+
+
+/** @brief fill an array with random values from reproducible streams
+  *
+  * This is the worker behind the random_fill_par() methods. The array is
+  * split into @a threads slices of (nearly) equal size. Slice number n
+  * is filled by a copy of the selected engine that is seeded with
+  * @a streamSeed and then jumped ahead n times, so every slice has its
+  * own stream that does not overlap with the others.
+  *
+  * Which thread fills which slice does not matter. Slices are handed out
+  * through an atomic counter to tasks on the shared thread pool, fewer
+  * of them if the slices are too small. The result is the same in all
+  * cases.
+  * If @a threads is 0, one slice per core is used.
+**/
+template<typename T>
+void CRandom::genRandomFill( T* dest, size_t count, T min, T max, uint64_t streamSeed, uint32_t threads ) noexcept {
+	if ( ( nullptr == dest ) || ( 0 == count ) )
+		return;
+
+	if ( 0 == threads )
+		threads = std::max( std::thread::hardware_concurrency(), 1U );
+
+	eRandomEngine const   currEngine = engine.load( std::memory_order_relaxed );
+	sRandomEngines        base;
+	std::atomic<uint32_t> nextSlice( 0 );
+
+	base.seed( streamSeed );
+
+	auto worker = [&]() {
+		for ( uint32_t slice = nextSlice.fetch_add( 1 ) ; slice < threads ; slice = nextSlice.fetch_add( 1 ) ) {
+			size_t const   first  = ( count / threads ) * slice + std::min<size_t>( slice, count % threads );
+			size_t const   length = ( count / threads ) + ( slice < ( count % threads ) ? 1 : 0 );
+			sRandomEngines stream = base;
+
+			for ( uint32_t nr = 0 ; nr < slice ; ++nr )
+				stream.jump( currEngine );
+
+			private_random_fill( stream, currEngine, dest + first, length, min, max );
+		}
+	};
+
+	// Only use more tasks if each of them has enough to do
+	uint32_t workers = threads;
+	if ( ( count / rndFillMinSlice ) < workers )
+		workers = static_cast<uint32_t>( std::max<size_t>( count / rndFillMinSlice, 1 ) );
+
+	thread_pool_run( workers, [ &worker ]( uint32_t ) { worker(); } );
+}
+
+
+/** @brief fill a grid with simplex noise
+  *
+  * This is the worker behind the simplexField*() and simplexMap*()
+  * methods. Each point gets exactly the value simplex2D() or simplex3D()
+  * calculates, apart from rounding differences of the AVX2 kernels in
+  * the last digits.
+  *
+  * The grid is split into tiles of `spxBatch` points times `spxTileRows`
+  * rows. @a threads tasks on the shared thread pool take the tiles one
+  * by one, and the calling thread takes part.
+**/
+template<typename T>
+void CRandom::genSpxMap( T* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+                         double xStep, double yStep, double zStep, double zoom, double smooth, double reduction,
+                         int32_t waves, bool is3D, uint32_t threads ) const noexcept {
+	if ( ( nullptr == dest ) || ( 0 == width ) || ( 0 == height ) || ( 0 == depth ) )
+		return;
+
+	if ( zoom < 0.001 ) zoom         = 0.001;
+	if ( smooth < 1.0 ) smooth       = 1.0;
+	if ( reduction < 1.0 ) reduction = 1.0;
+	if ( waves < 1 ) waves           = 1;
+
+	bool     useAvx    = getSimd();
+	uint32_t tileCols  = ( width  + spxBatch    - 1 ) / spxBatch;
+	uint32_t tileRows  = ( height + spxTileRows - 1 ) / spxTileRows;
+	uint64_t tileCount = static_cast<uint64_t>( tileCols ) * tileRows * depth;
+	std::atomic<uint64_t> nextTile( 0 );
+
+	auto worker = [&]() {
+		for ( uint64_t tile = nextTile.fetch_add( 1 ) ; tile < tileCount ; tile = nextTile.fetch_add( 1 ) ) {
+			uint32_t zIdx  = static_cast<uint32_t>( tile / ( static_cast<uint64_t>( tileCols ) * tileRows ) );
+			uint32_t rest  = static_cast<uint32_t>( tile % ( static_cast<uint64_t>( tileCols ) * tileRows ) );
+			uint32_t yIdx  = ( rest / tileCols ) * spxTileRows;
+			uint32_t xIdx  = ( rest % tileCols ) * spxBatch;
+			size_t   first = ( ( ( static_cast<size_t>( zIdx ) * height ) + yIdx ) * width ) + xIdx;
+
+			genSpxTile( dest + first, width, xIdx, yIdx, std::min( spxBatch, width - xIdx ),
+			            std::min( spxTileRows, height - yIdx ), x, y, is3D ? z + ( zIdx * zStep ) : 0.0,
+			            xStep, yStep, zoom, smooth, reduction, waves, is3D, useAvx );
+		}
+	};
+
+	if ( 0 == threads )
+		threads = std::max( std::thread::hardware_concurrency(), 1U );
+	if ( threads > tileCount )
+		threads = static_cast<uint32_t>( tileCount );
+
+	thread_pool_run( threads, [ &worker ]( uint32_t ) { worker(); } );
+}
+
+
+/** @brief fill one tile of a grid with simplex noise
+  *
+  * @a dest points to the first point of the tile, and @a stride is the
+  * number of values from one row of the grid to the next. @a xIdx and
+  * @a yIdx are the column and row of the first point in the grid, so
+  * every point is calculated from the origin of the grid, no matter
+  * which tile it is in. Rows are calculated in batches of up to
+  * `spxBatch` points, so the zoom and smoothing of each wave are only
+  * determined once per batch.
+**/
+template<typename T>
+void CRandom::genSpxTile( T* dest, size_t stride, uint32_t xIdx, uint32_t yIdx, uint32_t width, uint32_t height,
+                          double x, double y, double z, double xStep, double yStep, double zoom, double smooth,
+                          double reduction, int32_t waves, bool is3D, bool useAvx ) const noexcept {
+	double coords[spxBatch]; // X-Coordinates, modified by the seed
+	double scaled[spxBatch]; // X-Coordinates divided by the zoom of the current wave
+	double noise[spxBatch];  // Simplex noise of the current wave
+	double result[spxBatch]; // Sum of all waves
+	double currZ = is3D ? z + seed : 0.0;
+
+	for ( uint32_t row = 0 ; row < height ; ++row ) {
+		double currY = ( y + ( ( yIdx + row ) * yStep ) ) + seed;
+		T*     out   = dest + ( row * stride );
+
+		for ( uint32_t done = 0 ; done < width ; ) {
+			uint32_t count = std::min( spxBatch, width - done );
+
+			for ( uint32_t i = 0 ; i < count ; ++i ) {
+				coords[i] = ( x + ( static_cast<double>( xIdx + done + i ) * xStep ) ) + seed;
+				scaled[i] = coords[i] / zoom;
+			}
+			getSpxRow( noise, scaled, currY / zoom, currZ / zoom, count, is3D, useAvx );
+			for ( uint32_t i = 0 ; i < count ; ++i )
+				result[i] = noise[i] / smooth;
+
+			if ( waves > 1 ) {
+				double currWave   = 1.0;
+				double currSmooth = smooth;
+				double factor     = 1.0;
+				double currZoom;
+
+				while ( currWave < waves ) {
+					currWave += 1.0;
+					currSmooth *= reduction;
+					currZoom = zoom / std::pow( currWave, 2 );
+					for ( uint32_t i = 0 ; i < count ; ++i )
+						scaled[i] = coords[i] / currZoom;
+					getSpxRow( noise, scaled, currY / currZoom, currZ / currZoom, count, is3D, useAvx );
+					for ( uint32_t i = 0 ; i < count ; ++i )
+						result[i] += noise[i] / currSmooth;
+					factor += 1.0 / currSmooth;
+				}
+				for ( uint32_t i = 0 ; i < count ; ++i )
+					result[i] /= factor;
+			}
+
+			for ( uint32_t i = 0 ; i < count ; ++i )
+				out[done + i] = static_cast<T>( result[i] );
+			done += count;
+		} // End of row
+	} // End of tile
+}
+
+
 double CRandom::noiseD( double x ) const noexcept {
 	return noise( doubToInt( x ) );
 }
@@ -839,35 +1057,16 @@ int32_t CRandom::doubToInt( double val ) const noexcept {
 /** @brief default ctor
 *
 * Initializes the random number generator and assigns a first random value
-* to lastRndValue. The seed and Simplex data are initialized as well.
+* to lastRndValue. The seed is initialized as well.
 **/
 CRandom::CRandom() noexcept
-	  : nst( NST_NAMES_EN ) {
+	  : engine( RE_XOSHIRO256SS )
+	  , spxSimd( true )
+	  , nst( NST_NAMES_EN ) {
 
 	// Initialize Seed
-	static const auto randomValueRange = static_cast<long double>( std::random_device::max() ) -
-	                                     static_cast<long double>( std::random_device::min() );
-	seed = ( ( private_get_random32() - ( randomValueRange / 2 ) ) / 100 );
-
-	// Initialize Simplex values:
-	for ( int32_t i = 0 ; i < 5 ; i++ ) {
-		spxCorn[i]  = 0.0;
-		spxGrads[i] = 0;
-		for ( int32_t j = 0 ; j < 4 ; j++ ) {
-			spxDist[i][j] = 0.0;
-		}
-
-		if ( i < 4 ) {
-			spxNorms[i] = 0;
-			spxPerms[i] = 0;
-		}
-
-		if ( i < 3 ) {
-			for ( int32_t j = 0 ; j < 4 ; j++ ) {
-				spxOffs[i][j] = 0;
-			}
-		}
-	}
+	static const auto randomValueRange = static_cast<long double>( std::numeric_limits<uint32_t>::max() );
+	seed = ( ( private_get_random32( RE_XOSHIRO256SS ) - ( randomValueRange / 2 ) ) / 100 );
 }
 
 
@@ -879,6 +1078,15 @@ CRandom::CRandom() noexcept
 CRandom::~CRandom() noexcept = default;
 
 
+/** @brief return the engine used by random()
+  *
+  * @return the current random engine
+**/
+eRandomEngine CRandom::getEngine() const noexcept {
+	return engine.load( std::memory_order_relaxed );
+}
+
+
 /** @brief return current seed
   *
   * This method simply returns the current Seed used to manipulate values
@@ -891,6 +1099,15 @@ int32_t CRandom::getSeed() const noexcept {
 }
 
 
+/** @brief return whether the simplex grids are calculated with AVX2
+  *
+  * @return true if the processor supports AVX2 and setSimd() did not turn it off
+**/
+bool CRandom::getSimd() const noexcept {
+	return spxSimd.load( std::memory_order_relaxed ) && private_spx_avx2_usable();
+}
+
+
 /** @brief hash an unsigned 16 bit integer to an unsigned 32 bit integer
   *
   * @param[in] key The key to hash
@@ -1100,7 +1317,7 @@ eNameSourceType CRandom::prevNST( void ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 int16_t CRandom::random( int16_t max ) noexcept {
-	return private_random< int16_t >( 0, max );
+	return private_random< int16_t >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1113,7 +1330,7 @@ int16_t CRandom::random( int16_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 int16_t CRandom::random( int16_t min, int16_t max ) noexcept {
-	return private_random< int16_t >( min, max );
+	return private_random< int16_t >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1125,7 +1342,7 @@ int16_t CRandom::random( int16_t min, int16_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 uint16_t CRandom::random( uint16_t max ) noexcept {
-	return private_random< uint16_t >( 0, max );
+	return private_random< uint16_t >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1138,7 +1355,7 @@ uint16_t CRandom::random( uint16_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 uint16_t CRandom::random( uint16_t min, uint16_t max ) noexcept {
-	return private_random< uint16_t >( min, max );
+	return private_random< uint16_t >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1150,7 +1367,7 @@ uint16_t CRandom::random( uint16_t min, uint16_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 int32_t CRandom::random( int32_t max ) noexcept {
-	return private_random< int32_t >( 0, max );
+	return private_random< int32_t >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1165,7 +1382,7 @@ int32_t CRandom::random( int32_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 int32_t CRandom::random( int32_t min, int32_t max ) noexcept {
-	return private_random< int32_t >( min, max );
+	return private_random< int32_t >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1179,7 +1396,7 @@ int32_t CRandom::random( int32_t min, int32_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 uint32_t CRandom::random( uint32_t max ) noexcept {
-	return private_random< uint32_t >( 0, max );
+	return private_random< uint32_t >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1192,7 +1409,7 @@ uint32_t CRandom::random( uint32_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 uint32_t CRandom::random( uint32_t min, uint32_t max ) noexcept {
-	return private_random< uint32_t >( min, max );
+	return private_random< uint32_t >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1204,7 +1421,7 @@ uint32_t CRandom::random( uint32_t min, uint32_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 int64_t CRandom::random( int64_t max ) noexcept {
-	return private_random< int64_t >( 0, max );
+	return private_random< int64_t >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1217,7 +1434,7 @@ int64_t CRandom::random( int64_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 int64_t CRandom::random( int64_t min, int64_t max ) noexcept {
-	return private_random< int64_t >( min, max );
+	return private_random< int64_t >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1229,7 +1446,7 @@ int64_t CRandom::random( int64_t min, int64_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 uint64_t CRandom::random( uint64_t max ) noexcept {
-	return private_random< uint64_t >( 0, max );
+	return private_random< uint64_t >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1242,7 +1459,7 @@ uint64_t CRandom::random( uint64_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 uint64_t CRandom::random( uint64_t min, uint64_t max ) noexcept {
-	return private_random< uint64_t >( min, max );
+	return private_random< uint64_t >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1254,7 +1471,7 @@ uint64_t CRandom::random( uint64_t min, uint64_t max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 float CRandom::random( float max ) noexcept {
-	return private_random< float >( 0, max );
+	return private_random< float >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1267,7 +1484,7 @@ float CRandom::random( float max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 float CRandom::random( float min, float max ) noexcept {
-	return private_random< float >( min, max );
+	return private_random< float >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1279,7 +1496,7 @@ float CRandom::random( float min, float max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 double CRandom::random( double max ) noexcept {
-	return private_random< double >( 0, max );
+	return private_random< double >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1292,7 +1509,7 @@ double CRandom::random( double max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 double CRandom::random( double min, double max ) noexcept {
-	return private_random< double >( min, max );
+	return private_random< double >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1304,7 +1521,7 @@ double CRandom::random( double min, double max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 long double CRandom::random( long double max ) noexcept {
-	return private_random< long double >( 0, max );
+	return private_random< long double >( engine.load( std::memory_order_relaxed ), 0, max );
 }
 
 
@@ -1317,7 +1534,7 @@ long double CRandom::random( long double max ) noexcept {
   * @return A random value between 0 and @a max.
 **/
 long double CRandom::random( long double min, long double max ) noexcept {
-	return private_random< long double >( min, max );
+	return private_random< long double >( engine.load( std::memory_order_relaxed ), min, max );
 }
 
 
@@ -1338,7 +1555,412 @@ long double CRandom::random( long double min, long double max ) noexcept {
   * @return number of characters actually written including the final zero-byte.
 **/
 size_t CRandom::random( char* dest, size_t minLen, size_t maxLen ) noexcept {
-	return private_random_str( dest, minLen, maxLen );
+	return private_random_str( engine.load( std::memory_order_relaxed ), dest, minLen, maxLen );
+}
+
+
+/** @brief Fill @a dest with @a count random values of int16_t between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( int16_t* dest, size_t count, int16_t min, int16_t max ) noexcept {
+	if ( dest )
+		private_random_fill< int16_t >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of uint16_t between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( uint16_t* dest, size_t count, uint16_t min, uint16_t max ) noexcept {
+	if ( dest )
+		private_random_fill< uint16_t >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                 dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of int32_t between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( int32_t* dest, size_t count, int32_t min, int32_t max ) noexcept {
+	if ( dest )
+		private_random_fill< int32_t >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of uint32_t between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( uint32_t* dest, size_t count, uint32_t min, uint32_t max ) noexcept {
+	if ( dest )
+		private_random_fill< uint32_t >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                 dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of int64_t between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( int64_t* dest, size_t count, int64_t min, int64_t max ) noexcept {
+	if ( dest )
+		private_random_fill< int64_t >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of uint64_t between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( uint64_t* dest, size_t count, uint64_t min, uint64_t max ) noexcept {
+	if ( dest )
+		private_random_fill< uint64_t >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                 dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of float between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( float* dest, size_t count, float min, float max ) noexcept {
+	if ( dest )
+		private_random_fill< float >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                              dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of double between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( double* dest, size_t count, double min, double max ) noexcept {
+	if ( dest )
+		private_random_fill< double >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                               dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of long double between @a min and @a max.
+  *
+  * The values are the same random() would return, but drawn in blocks
+  * from the engine of the calling thread, and the range is prepared
+  * only once.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+**/
+void CRandom::random_fill( long double* dest, size_t count, long double min, long double max ) noexcept {
+	if ( dest )
+		private_random_fill< long double >( private_thread_engines(), engine.load( std::memory_order_relaxed ),
+		                                    dest, count, min, max );
+}
+
+
+/** @brief Fill @a dest with @a count random values of int16_t between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( int16_t* dest, size_t count, int16_t min, int16_t max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< int16_t >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of uint16_t between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( uint16_t* dest, size_t count, uint16_t min, uint16_t max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< uint16_t >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of int32_t between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( int32_t* dest, size_t count, int32_t min, int32_t max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< int32_t >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of uint32_t between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( uint32_t* dest, size_t count, uint32_t min, uint32_t max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< uint32_t >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of int64_t between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( int64_t* dest, size_t count, int64_t min, int64_t max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< int64_t >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of uint64_t between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( uint64_t* dest, size_t count, uint64_t min, uint64_t max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< uint64_t >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of float between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( float* dest, size_t count, float min, float max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< float >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of double between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( double* dest, size_t count, double min, double max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< double >( dest, count, min, max, streamSeed, threads );
+}
+
+
+/** @brief Fill @a dest with @a count random values of long double between @a min and @a max, using several threads.
+  *
+  * The array is split into @a threads slices, each filled from its own
+  * jump-ahead stream of the selected engine, seeded with @a streamSeed.
+  * The result is reproducible for the same seed, engine and number of
+  * threads, no matter how many threads could actually be started.
+  * With @a threads being 0, the number of streams is the number of
+  * cores, so the result differs between machines. Pass a fixed number
+  * if it must be reproducible everywhere.
+  *
+  * if @a max is lower than @a min, the results will be @a max <= result <= @a min.
+  *
+  * @param[out] dest the array to fill, it must hold at least @a count values.
+  * @param[in] count number of values to generate.
+  * @param[in] min Minimum result.
+  * @param[in] max Maximum result.
+  * @param[in] streamSeed the seed all streams are derived from.
+  * @param[in] threads the number of streams and threads to use, 0 (default) means one per core, see above.
+**/
+void CRandom::random_fill_par( long double* dest, size_t count, long double min, long double max, uint64_t streamSeed,
+                               uint32_t threads ) noexcept {
+	genRandomFill< long double >( dest, count, min, max, streamSeed, threads );
 }
 
 
@@ -1624,6 +2246,20 @@ char* CRandom::rndName( double x, double y, double z, double w, int32_t chars, i
 }
 
 
+/** @brief set the engine used by random() to @a newEngine
+  *
+  * Every thread has its own instance of each engine, so the selection
+  * takes effect for all threads at their next call of random(). An
+  * invalid @a newEngine is ignored.
+  *
+  * @param[in] newEngine the new random engine
+**/
+void CRandom::setEngine( eRandomEngine newEngine ) noexcept {
+	if ( newEngine < RE_NUM_ENGINES )
+		engine.store( newEngine, std::memory_order_relaxed );
+}
+
+
 /** @brief set name source type to @a type
   *
   * @param[in] type the new name source type
@@ -1636,6 +2272,9 @@ void CRandom::setNST( eNameSourceType type ) noexcept {
   *
   * Set the seed to @a newSeed which will cause the simplex table to be
   * reinitialized.
+  *
+  * This is the only method writing to the simplex table. It must not
+  * run while other threads calculate simplex noise.
 **/
 void CRandom::setSeed( int32_t newSeed ) noexcept {
 	newSeed &= constants::fourthMaxInt;
@@ -1649,6 +2288,20 @@ void CRandom::setSeed( int32_t newSeed ) noexcept {
 }
 
 
+/** @brief turn the AVX2 kernels of the simplex grids on or off
+  *
+  * simplexField2D(), simplexField3D(), simplexMap2D() and simplexMap3D()
+  * use AVX2 by default if the processor supports it. The results of both
+  * paths only differ by rounding, so turning it off is only needed to
+  * compare them, or to get the exact values of simplex2D() and simplex3D().
+  *
+  * @param[in] enable false to always use the scalar path
+**/
+void CRandom::setSimd( bool enable ) noexcept {
+	spxSimd.store( enable, std::memory_order_relaxed );
+}
+
+
 /** @brief calculate a one dimensional simplex noise value
   *
   * This method returns a simplex noise value of one dimension.
@@ -1663,7 +2316,7 @@ void CRandom::setSeed( int32_t newSeed ) noexcept {
   * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
   * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
 **/
-double CRandom::simplex1D( double x, double zoom, double smooth ) noexcept {
+double CRandom::simplex1D( double x, double zoom, double smooth ) const noexcept {
 	if ( zoom < 0.001 ) zoom   = 0.001;
 	if ( smooth < 1.0 ) smooth = 1.0;
 
@@ -1695,7 +2348,7 @@ double CRandom::simplex1D( double x, double zoom, double smooth ) noexcept {
   * @param[in] reduction Multiplier for the smoothing factor in each round.
   * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
 **/
-double CRandom::simplex1D( double x, double zoom, double smooth, double reduction, int32_t waves ) noexcept {
+double CRandom::simplex1D( double x, double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
 	if ( zoom < 0.001 ) zoom         = 0.001;
 	if ( smooth < 1.0 ) smooth       = 1.0;
 	if ( reduction < 1.0 ) reduction = 1.0;
@@ -1742,7 +2395,7 @@ double CRandom::simplex1D( double x, double zoom, double smooth, double reductio
   * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
   * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
 **/
-double CRandom::simplex2D( double x, double y, double zoom, double smooth ) noexcept {
+double CRandom::simplex2D( double x, double y, double zoom, double smooth ) const noexcept {
 	if ( zoom < 0.001 ) zoom   = 0.001;
 	if ( smooth < 1.0 ) smooth = 1.0;
 
@@ -1776,7 +2429,7 @@ double CRandom::simplex2D( double x, double y, double zoom, double smooth ) noex
   * @param[in] reduction Multiplier for the smoothing factor in each round.
   * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
 **/
-double CRandom::simplex2D( double x, double y, double zoom, double smooth, double reduction, int32_t waves ) noexcept {
+double CRandom::simplex2D( double x, double y, double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
 	if ( zoom < 0.001 ) zoom         = 0.001;
 	if ( smooth < 1.0 ) smooth       = 1.0;
 	if ( reduction < 1.0 ) reduction = 1.0;
@@ -1826,7 +2479,7 @@ double CRandom::simplex2D( double x, double y, double zoom, double smooth, doubl
   * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
   * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
 **/
-double CRandom::simplex3D( double x, double y, double z, double zoom, double smooth ) noexcept {
+double CRandom::simplex3D( double x, double y, double z, double zoom, double smooth ) const noexcept {
 	if ( zoom < 0.001 ) zoom   = 0.001;
 	if ( smooth < 1.0 ) smooth = 1.0;
 
@@ -1862,7 +2515,7 @@ double CRandom::simplex3D( double x, double y, double z, double zoom, double smo
   * @param[in] reduction Multiplier for the smoothing factor in each round.
   * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
 **/
-double CRandom::simplex3D( double x, double y, double z, double zoom, double smooth, double reduction, int32_t waves ) noexcept {
+double CRandom::simplex3D( double x, double y, double z, double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
 	if ( zoom < 0.001 ) zoom         = 0.001;
 	if ( smooth < 1.0 ) smooth       = 1.0;
 	if ( reduction < 1.0 ) reduction = 1.0;
@@ -1915,7 +2568,7 @@ double CRandom::simplex3D( double x, double y, double z, double zoom, double smo
   * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
   * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
 **/
-double CRandom::simplex4D( double x, double y, double z, double w, double zoom, double smooth ) noexcept {
+double CRandom::simplex4D( double x, double y, double z, double w, double zoom, double smooth ) const noexcept {
 	if ( zoom < 0.001 ) zoom   = 0.001;
 	if ( smooth < 1.0 ) smooth = 1.0;
 
@@ -1955,7 +2608,7 @@ double CRandom::simplex4D( double x, double y, double z, double w, double zoom,
   * @param[in] reduction Multiplier for the smoothing factor in each round.
   * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
 **/
-double CRandom::simplex4D( double x, double y, double z, double w, double zoom, double smooth, double reduction, int32_t waves ) noexcept {
+double CRandom::simplex4D( double x, double y, double z, double w, double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
 	if ( zoom < 0.001 ) zoom         = 0.001;
 	if ( smooth < 1.0 ) smooth       = 1.0;
 	if ( reduction < 1.0 ) reduction = 1.0;
@@ -1992,4 +2645,159 @@ double CRandom::simplex4D( double x, double y, double z, double w, double zoom,
 }
 
 
+/** @brief fill a two dimensional grid with simplex noise
+  *
+  * This method fills @a dest with @a width times @a height values, row by
+  * row. The value at `dest[( yIdx * width ) + xIdx]` is what
+  *
+  * `simplex2D( x + ( xIdx * xStep ), y + ( yIdx * yStep ), zoom, smooth, reduction, waves )`
+  *
+  * returns. The values are calculated several at once, using AVX2 if the
+  * processor supports it. The results of the AVX2 path may differ from
+  * simplex2D() in the last few digits.
+  *
+  * @param[out] dest the buffer to fill, it must hold at least @a width * @a height values.
+  * @param[in] width number of points per row.
+  * @param[in] height number of rows.
+  * @param[in] x X-Coordinate of the first point.
+  * @param[in] y Y-Coordinate of the first point.
+  * @param[in] xStep distance between two points of a row.
+  * @param[in] yStep distance between two rows.
+  * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
+  * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
+  * @param[in] reduction Multiplier for the smoothing factor in each round.
+  * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
+**/
+void CRandom::simplexField2D( double* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+                              double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
+	genSpxMap( dest, width, height, 1, x, y, 0.0, xStep, yStep, 0.0, zoom, smooth, reduction, waves, false, 1 );
+}
+
+
+/// @brief fill a two dimensional grid with simplex noise, see the double version for details
+void CRandom::simplexField2D( float* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+                              double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
+	genSpxMap( dest, width, height, 1, x, y, 0.0, xStep, yStep, 0.0, zoom, smooth, reduction, waves, false, 1 );
+}
+
+
+/** @brief fill a three dimensional grid with simplex noise
+  *
+  * This method fills @a dest with @a width times @a height times @a depth
+  * values, row by row and layer by layer. The value at
+  * `dest[( ( ( zIdx * height ) + yIdx ) * width ) + xIdx]` is what
+  *
+  * `simplex3D( x + ( xIdx * xStep ), y + ( yIdx * yStep ), z + ( zIdx * zStep ), zoom, smooth, reduction, waves )`
+  *
+  * returns. The values are calculated several at once, using AVX2 if the
+  * processor supports it. The results of the AVX2 path may differ from
+  * simplex3D() in the last few digits.
+  *
+  * @param[out] dest the buffer to fill, it must hold at least @a width * @a height * @a depth values.
+  * @param[in] width number of points per row.
+  * @param[in] height number of rows per layer.
+  * @param[in] depth number of layers.
+  * @param[in] x X-Coordinate of the first point.
+  * @param[in] y Y-Coordinate of the first point.
+  * @param[in] z Z-Coordinate of the first point.
+  * @param[in] xStep distance between two points of a row.
+  * @param[in] yStep distance between two rows.
+  * @param[in] zStep distance between two layers.
+  * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
+  * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
+  * @param[in] reduction Multiplier for the smoothing factor in each round.
+  * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
+**/
+void CRandom::simplexField3D( double* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+                              double xStep, double yStep, double zStep,
+                              double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
+	genSpxMap( dest, width, height, depth, x, y, z, xStep, yStep, zStep, zoom, smooth, reduction, waves, true, 1 );
+}
+
+
+/// @brief fill a three dimensional grid with simplex noise, see the double version for details
+void CRandom::simplexField3D( float* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+                              double xStep, double yStep, double zStep,
+                              double zoom, double smooth, double reduction, int32_t waves ) const noexcept {
+	genSpxMap( dest, width, height, depth, x, y, z, xStep, yStep, zStep, zoom, smooth, reduction, waves, true, 1 );
+}
+
+
+/** @brief fill a two dimensional map with simplex noise using several threads
+  *
+  * This method produces exactly the same values as simplexField2D(), but
+  * splits the map into tiles that are calculated by @a threads threads,
+  * including the calling one. The tiles are handed out one by one, so
+  * faster threads simply calculate more of them.
+  *
+  * The threads only read the permutation table. The seed must therefore
+  * not be changed while this method runs.
+  *
+  * @param[out] dest the buffer to fill, it must hold at least @a width * @a height values.
+  * @param[in] width number of points per row.
+  * @param[in] height number of rows.
+  * @param[in] x X-Coordinate of the first point.
+  * @param[in] y Y-Coordinate of the first point.
+  * @param[in] xStep distance between two points of a row.
+  * @param[in] yStep distance between two rows.
+  * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
+  * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
+  * @param[in] reduction Multiplier for the smoothing factor in each round.
+  * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
+  * @param[in] threads number of threads to use. The default of 0 uses one per hardware thread.
+**/
+void CRandom::simplexMap2D( double* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+                            double zoom, double smooth, double reduction, int32_t waves, uint32_t threads ) const noexcept {
+	genSpxMap( dest, width, height, 1, x, y, 0.0, xStep, yStep, 0.0, zoom, smooth, reduction, waves, false, threads );
+}
+
+
+/// @brief fill a two dimensional map with simplex noise using several threads, see the double version for details
+void CRandom::simplexMap2D( float* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+                            double zoom, double smooth, double reduction, int32_t waves, uint32_t threads ) const noexcept {
+	genSpxMap( dest, width, height, 1, x, y, 0.0, xStep, yStep, 0.0, zoom, smooth, reduction, waves, false, threads );
+}
+
+
+/** @brief fill a three dimensional map with simplex noise using several threads
+  *
+  * This method produces exactly the same values as simplexField3D(), but
+  * splits the map into tiles that are calculated by @a threads threads,
+  * including the calling one. The tiles are handed out one by one, so
+  * faster threads simply calculate more of them.
+  *
+  * The threads only read the permutation table. The seed must therefore
+  * not be changed while this method runs.
+  *
+  * @param[out] dest the buffer to fill, it must hold at least @a width * @a height * @a depth values.
+  * @param[in] width number of points per row.
+  * @param[in] height number of rows per layer.
+  * @param[in] depth number of layers.
+  * @param[in] x X-Coordinate of the first point.
+  * @param[in] y Y-Coordinate of the first point.
+  * @param[in] z Z-Coordinate of the first point.
+  * @param[in] xStep distance between two points of a row.
+  * @param[in] yStep distance between two rows.
+  * @param[in] zStep distance between two layers.
+  * @param[in] zoom Zooming factor into the point. Your coordinate will divided by this factor.
+  * @param[in] smooth Divisor for the result. The higher, the nearer the result will be to zero.
+  * @param[in] reduction Multiplier for the smoothing factor in each round.
+  * @param[in] waves Number of waves to overlay. The default of 1 returns the pure Simplex Noise Value.
+  * @param[in] threads number of threads to use. The default of 0 uses one per hardware thread.
+**/
+void CRandom::simplexMap3D( double* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+                            double xStep, double yStep, double zStep, double zoom, double smooth, double reduction,
+                            int32_t waves, uint32_t threads ) const noexcept {
+	genSpxMap( dest, width, height, depth, x, y, z, xStep, yStep, zStep, zoom, smooth, reduction, waves, true, threads );
+}
+
+
+/// @brief fill a three dimensional map with simplex noise using several threads, see the double version for details
+void CRandom::simplexMap3D( float* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+                            double xStep, double yStep, double zStep, double zoom, double smooth, double reduction,
+                            int32_t waves, uint32_t threads ) const noexcept {
+	genSpxMap( dest, width, height, depth, x, y, z, xStep, yStep, zStep, zoom, smooth, reduction, waves, true, threads );
+}
+
+
 } // namespace pwx
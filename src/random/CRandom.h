@@ -35,6 +35,7 @@
 **/
 
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -44,6 +45,7 @@
 
 #include "basic/CLockable.h"
 #include "random/eNameSourceType.h"
+#include "random/eRandomEngine.h"
 
 
 namespace pwx {
@@ -62,6 +64,16 @@ namespace pwx {
   * These return random numbers as int32_t, int64_t, float, double and
   * long double. They can be used without or with up to two arguments
   * to get results between those two or from zero to the one argument.
+  * Each thread draws from its own engine, setEngine() selects whether
+  * that is xoshiro256** (default), PCG64 or SplitMix64.
+  *
+  * - random_fill() / random_fill_par()
+  * Fill a whole array with random values of one of the types random()
+  * supports. The parallel variant splits the array between several
+  * threads, each using its own jump-ahead stream of the selected engine,
+  * so the result only depends on the seed and the number of threads.
+  * The default of one thread per core is not reproducible across
+  * machines, pass a fixed number of threads if that matters.
   *
   * - hash()
   * Hash functions for integer arguments, mostly taken from:
@@ -83,6 +95,18 @@ namespace pwx {
   * The documentation is taken from:
   * http://staffwww.itn.liu.se/~stegu/simplexnoise/simplexnoise.pdf
   *  (Stefan Gustavson)
+  * The simplex functions keep no state besides the permutation table,
+  * which only setSeed() changes. So they can be called from any number
+  * of threads at once, as long as nobody changes the seed meanwhile.
+  *
+  * - simplexField2D() / simplexField3D()
+  * Fill a whole grid with the values simplex2D() and simplex3D()
+  * would return. Several points are calculated at once, using AVX2
+  * if the processor supports it and setSimd() did not turn it off.
+  *
+  * - simplexMap2D() / simplexMap3D()
+  * The same as simplexField2D() and simplexField3D(), but the grid is
+  * split into tiles that are calculated by several threads.
   *
   * - rndName()
   * A method that returns a random name built by combining random
@@ -117,7 +141,9 @@ public:
 	 * === Public methods                          ===
 	 * ===============================================
 	 */
+	eRandomEngine getEngine() const noexcept;
 	int32_t getSeed() const noexcept;
+	bool getSimd() const noexcept;
 	uint32_t hash( int16_t key ) const noexcept;
 	uint32_t hash( uint16_t key ) const noexcept;
 	uint32_t hash( int32_t key ) const noexcept;
@@ -156,6 +182,33 @@ public:
 	long double random( long double max ) noexcept;
 	long double random( long double min, long double max ) noexcept;
 	size_t random( char* dest, size_t minLen, size_t maxLen ) noexcept;
+	void random_fill( int16_t* dest, size_t count, int16_t min, int16_t max ) noexcept;
+	void random_fill( uint16_t* dest, size_t count, uint16_t min, uint16_t max ) noexcept;
+	void random_fill( int32_t* dest, size_t count, int32_t min, int32_t max ) noexcept;
+	void random_fill( uint32_t* dest, size_t count, uint32_t min, uint32_t max ) noexcept;
+	void random_fill( int64_t* dest, size_t count, int64_t min, int64_t max ) noexcept;
+	void random_fill( uint64_t* dest, size_t count, uint64_t min, uint64_t max ) noexcept;
+	void random_fill( float* dest, size_t count, float min, float max ) noexcept;
+	void random_fill( double* dest, size_t count, double min, double max ) noexcept;
+	void random_fill( long double* dest, size_t count, long double min, long double max ) noexcept;
+	void random_fill_par( int16_t* dest, size_t count, int16_t min, int16_t max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( uint16_t* dest, size_t count, uint16_t min, uint16_t max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( int32_t* dest, size_t count, int32_t min, int32_t max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( uint32_t* dest, size_t count, uint32_t min, uint32_t max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( int64_t* dest, size_t count, int64_t min, int64_t max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( uint64_t* dest, size_t count, uint64_t min, uint64_t max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( float* dest, size_t count, float min, float max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( double* dest, size_t count, double min, double max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
+	void random_fill_par( long double* dest, size_t count, long double min, long double max, uint64_t streamSeed,
+	                      uint32_t threads = 0 ) noexcept;
 	char* rndName( double x, bool lN = false, bool mW = false ) noexcept;
 	char* rndName( double x, double y, bool lN = false, bool mW = false ) noexcept;
 	char* rndName( double x, double y, double z, bool lN = false, bool mW = false ) noexcept;
@@ -164,16 +217,40 @@ public:
 	char* rndName( double x, double y, int32_t chars, int32_t sylls, int32_t parts ) noexcept;
 	char* rndName( double x, double y, double z, int32_t chars, int32_t sylls, int32_t parts ) noexcept;
 	char* rndName( double x, double y, double z, double w, int32_t chars, int32_t sylls, int32_t parts ) noexcept;
+	void setEngine( eRandomEngine newEngine ) noexcept;
 	void setNST( eNameSourceType type ) noexcept;
 	void setSeed( int32_t newSeed ) noexcept;
-	double simplex1D( double x, double zoom = 1.0, double smooth = 1.0 ) noexcept;
-	double simplex1D( double x, double zoom, double smooth, double reduction, int32_t waves ) noexcept;
-	double simplex2D( double x, double y, double zoom = 1.0, double smooth = 1.0 ) noexcept;
-	double simplex2D( double x, double y, double zoom, double smooth, double reduction, int32_t waves ) noexcept;
-	double simplex3D( double x, double y, double z, double zoom = 1.0, double smooth = 1.0 ) noexcept;
-	double simplex3D( double x, double y, double z, double zoom, double smooth, double reduction, int32_t waves ) noexcept;
-	double simplex4D( double x, double y, double z, double w, double zoom = 1.0, double smooth = 1.0 ) noexcept;
-	double simplex4D( double x, double y, double z, double w, double zoom, double smooth, double reduction, int32_t waves ) noexcept;
+	void setSimd( bool enable ) noexcept;
+	double simplex1D( double x, double zoom = 1.0, double smooth = 1.0 ) const noexcept;
+	double simplex1D( double x, double zoom, double smooth, double reduction, int32_t waves ) const noexcept;
+	double simplex2D( double x, double y, double zoom = 1.0, double smooth = 1.0 ) const noexcept;
+	double simplex2D( double x, double y, double zoom, double smooth, double reduction, int32_t waves ) const noexcept;
+	double simplex3D( double x, double y, double z, double zoom = 1.0, double smooth = 1.0 ) const noexcept;
+	double simplex3D( double x, double y, double z, double zoom, double smooth, double reduction, int32_t waves ) const noexcept;
+	double simplex4D( double x, double y, double z, double w, double zoom = 1.0, double smooth = 1.0 ) const noexcept;
+	double simplex4D( double x, double y, double z, double w, double zoom, double smooth, double reduction, int32_t waves ) const noexcept;
+	void simplexField2D( double* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+	                     double zoom = 1.0, double smooth = 1.0, double reduction = 1.0, int32_t waves = 1 ) const noexcept;
+	void simplexField2D( float* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+	                     double zoom = 1.0, double smooth = 1.0, double reduction = 1.0, int32_t waves = 1 ) const noexcept;
+	void simplexField3D( double* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+	                     double xStep, double yStep, double zStep,
+	                     double zoom = 1.0, double smooth = 1.0, double reduction = 1.0, int32_t waves = 1 ) const noexcept;
+	void simplexField3D( float* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+	                     double xStep, double yStep, double zStep,
+	                     double zoom = 1.0, double smooth = 1.0, double reduction = 1.0, int32_t waves = 1 ) const noexcept;
+	void simplexMap2D( double* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+	                   double zoom = 1.0, double smooth = 1.0, double reduction = 1.0, int32_t waves = 1,
+	                   uint32_t threads = 0 ) const noexcept;
+	void simplexMap2D( float* dest, uint32_t width, uint32_t height, double x, double y, double xStep, double yStep,
+	                   double zoom = 1.0, double smooth = 1.0, double reduction = 1.0, int32_t waves = 1,
+	                   uint32_t threads = 0 ) const noexcept;
+	void simplexMap3D( double* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+	                   double xStep, double yStep, double zStep, double zoom = 1.0, double smooth = 1.0,
+	                   double reduction = 1.0, int32_t waves = 1, uint32_t threads = 0 ) const noexcept;
+	void simplexMap3D( float* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+	                   double xStep, double yStep, double zStep, double zoom = 1.0, double smooth = 1.0,
+	                   double reduction = 1.0, int32_t waves = 1, uint32_t threads = 0 ) const noexcept;
 
 
 	/* ===============================================
@@ -216,17 +293,29 @@ private:
 	                                       int32_t pl ) noexcept PWX_WARNUNUSED PWX_LOCAL;
 
 	/* === Helper methods for Simplex Noise === */
-	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x ) noexcept PWX_LOCAL;
-	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x, double y ) noexcept PWX_LOCAL;
-	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x, double y, double z ) noexcept PWX_LOCAL;
-	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x, double y, double z, double w ) noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x, double y ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x, double y, double z ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSimpDot( int32_t index, double x, double y, double z, double w ) const noexcept PWX_LOCAL;
 	/* Note: These are four functions, because using 1 with default values would cause alot of overhead with 0
 		   multiplication. Testing 10M Iterations with 2 dimensions was 500ms slower with such an "universal"
 		   getSimpDot() method. */
-	PWX_PRIVATE_INLINE double getSpx1D( double x ) noexcept PWX_LOCAL;
-	PWX_PRIVATE_INLINE double getSpx2D( double x, double y ) noexcept PWX_LOCAL;
-	PWX_PRIVATE_INLINE double getSpx3D( double x, double y, double z ) noexcept PWX_LOCAL;
-	PWX_PRIVATE_INLINE double getSpx4D( double x, double y, double z, double w ) noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSpx1D( double x ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSpx2D( double x, double y ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSpx3D( double x, double y, double z ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE double getSpx4D( double x, double y, double z, double w ) const noexcept PWX_LOCAL;
+	PWX_PRIVATE_INLINE void getSpxRow( double* dest, double const* xs, double y, double z, uint32_t count,
+	                                   bool is3D, bool useAvx ) const noexcept PWX_LOCAL;
+	template<typename T>
+	void genRandomFill( T* dest, size_t count, T min, T max, uint64_t streamSeed, uint32_t threads ) noexcept PWX_LOCAL;
+	template<typename T>
+	void genSpxMap( T* dest, uint32_t width, uint32_t height, uint32_t depth, double x, double y, double z,
+	                double xStep, double yStep, double zStep, double zoom, double smooth, double reduction,
+	                int32_t waves, bool is3D, uint32_t threads ) const noexcept PWX_LOCAL;
+	template<typename T>
+	void genSpxTile( T* dest, size_t stride, uint32_t xIdx, uint32_t yIdx, uint32_t width, uint32_t height,
+	                 double x, double y, double z, double xStep, double yStep, double zoom, double smooth,
+	                 double reduction, int32_t waves, bool is3D, bool useAvx ) const noexcept PWX_LOCAL;
 
 	// These are helpers to make the functions using raw noise more powerful when calculating with doubles
 	PWX_PRIVATE_INLINE double noiseD( double x ) const noexcept PWX_LOCAL;
@@ -245,15 +334,11 @@ private:
 	 * ===============================================
 	*/
 
+	std::atomic<eRandomEngine> engine; //!< Engine used by random(), can be changed with setEngine()
+	std::atomic_bool spxSimd;          //!< Whether the simplex grids may use AVX2, can be changed with setSimd()
 	eNameSourceType nst; //!< Type of the name source
 	int32_t         seed;          //!< General seed, can be changed with setSeed(new_value)
-	double          spxCorn[5]{};    //!< The Corners contributing to a simplex noise. (1D: 2, 4D: 5 corners)
-	double          spxDist[5][4]{}; //!< Simplex distance of a point to the simplex' corners
-	int32_t         spxGrads[5]{};   //!< Gradient table index for the simplex corners
-	int32_t         spxNorms[4]{};   //!< Normalized Coordinates for x, y, z, w
-	int32_t         spxOffs[3][4]{}; //!< Offsets for determining which vertice a dot is in
-	int32_t         spxPerms[4]{};   //!< Permutation table indices for x, y, z, w
-	int32_t         spxTab[512]{};   //!< A permutation table for simplex noise
+	int32_t         spxTab[512]{}; //!< A permutation table for simplex noise, only written by setSeed()
 };
 
 } // namespace pwx
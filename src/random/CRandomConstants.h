@@ -94,6 +94,18 @@ const double spxSkew[3][2] = {
 	{0.30901699437494745126286943559535L, 0.13819660112501050419631098975515L}  // 4D
 };
 
+
+/** Simplex result scaling factors for 1D to 4D.
+  * These have been found by searching the factor needed to get 1.0
+  * with the largest result out of 100M iterations.
+**/
+const double spxScale[4] = {
+	3.16049383304737219191338226664811, // 1D
+	70.14805770653948968629265436902642, // 2D
+	36.11293688087369702088835765607655, // 3D
+	31.91239940056049206873467483092099  // 4D
+};
+
 } // End of namespace constants
 
 } // namespace pwx
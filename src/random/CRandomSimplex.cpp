@@ -0,0 +1,341 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include "random/CRandomConstants.h"
+#include "random/CRandomSimplex.h"
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && defined( __GNUC__ )
+#  define PWX_HAVE_SPX_AVX2 1
+#  include <immintrin.h>
+#  define PWX_SPX_AVX2 __attribute__ ( ( target ( "avx2" ) ) )
+#else
+#  define PWX_HAVE_SPX_AVX2 0
+#endif
+
+
+namespace pwx {
+
+
+#if PWX_HAVE_SPX_AVX2
+
+/* Note: The kernels are deliberately built without FMA. Fused
+ *       multiply-adds round differently than the scalar functions,
+ *       and the results should differ as little as possible.
+ *       The only remaining difference is contrib^4, which the scalar
+ *       functions get from std::pow().
+ */
+
+namespace {
+
+
+/// @internal 1.0 where @a mask is set, 0.0 where it is not
+PWX_SPX_AVX2 inline __m256d spx_ones( __m256d mask ) noexcept {
+	return _mm256_and_pd( mask, _mm256_set1_pd( 1.0 ) );
+}
+
+
+/// @internal 0.0 where @a mask is set, 1.0 where it is not
+PWX_SPX_AVX2 inline __m256d spx_zeros( __m256d mask ) noexcept {
+	return _mm256_andnot_pd( mask, _mm256_set1_pd( 1.0 ) );
+}
+
+
+/// @internal look up @a idx in the permutation table @a tab
+PWX_SPX_AVX2 inline __m128i spx_perm( int32_t const* tab, __m128i idx ) noexcept {
+	return _mm_i32gather_epi32( tab, idx, 4 );
+}
+
+
+/// @internal gather the component @a comp of the gradients @a grads
+PWX_SPX_AVX2 inline __m256d spx_grad( __m128i grads, int32_t comp ) noexcept {
+	__m128i idx = _mm_add_epi32( _mm_slli_epi32( grads, 2 ), _mm_set1_epi32( comp ) );
+	return _mm256_cvtepi32_pd( _mm_i32gather_epi32( &constants::spxGrTab[0][0], idx, 4 ) );
+}
+
+
+/// @internal contribution of a corner: contrib^4 * dot, or zero if contrib is not positive
+PWX_SPX_AVX2 inline __m256d spx_corner( __m256d contrib, __m256d dot ) noexcept {
+	__m256d square = _mm256_mul_pd( contrib, contrib );
+	__m256d result = _mm256_mul_pd( _mm256_mul_pd( square, square ), dot );
+	return _mm256_and_pd( _mm256_cmp_pd( contrib, _mm256_setzero_pd(), _CMP_GT_OQ ), result );
+}
+
+
+/// @internal scale the sum of the corners and clamp it to [-1, 1]
+PWX_SPX_AVX2 inline __m256d spx_result( double scale, __m256d sum ) noexcept {
+	__m256d result = _mm256_mul_pd( _mm256_set1_pd( scale ), sum );
+	return _mm256_min_pd( _mm256_max_pd( result, _mm256_set1_pd( -1.0 ) ), _mm256_set1_pd( 1.0 ) );
+}
+
+
+/// @internal Four points of 2D simplex noise, see CRandom::getSpx2D()
+PWX_SPX_AVX2 __m256d spx2D( __m256d x, __m256d y, int32_t const* tab ) noexcept {
+	const __m256d skew   = _mm256_set1_pd( constants::spxSkew[0][0] );
+	const __m256d unskew = _mm256_set1_pd( constants::spxSkew[0][1] );
+	const __m256d one    = _mm256_set1_pd( 1.0 );
+	const __m256d half   = _mm256_set1_pd( 0.5 );
+	const __m128i byte   = _mm_set1_epi32( 0xff );
+	const __m128i iOne   = _mm_set1_epi32( 1 );
+	const __m128i seven  = _mm_set1_epi32( 7 );
+
+	// Normalized coordinates and permutation table indices
+	__m256d sum   = _mm256_mul_pd( _mm256_add_pd( x, y ), skew );
+	__m128i normX = _mm256_cvttpd_epi32( _mm256_floor_pd( _mm256_add_pd( x, sum ) ) );
+	__m128i normY = _mm256_cvttpd_epi32( _mm256_floor_pd( _mm256_add_pd( y, sum ) ) );
+	__m128i permX = _mm_and_si128( normX, byte );
+	__m128i permY = _mm_and_si128( normY, byte );
+
+	// Distances from the first corner
+	__m256d unsk = _mm256_mul_pd( _mm256_cvtepi32_pd( _mm_add_epi32( normX, normY ) ), unskew );
+	__m256d d0x  = _mm256_sub_pd( x, _mm256_sub_pd( _mm256_cvtepi32_pd( normX ), unsk ) );
+	__m256d d0y  = _mm256_sub_pd( y, _mm256_sub_pd( _mm256_cvtepi32_pd( normY ), unsk ) );
+
+	// Upper triangle (1, 0) or lower triangle (0, 1)
+	__m256d upper = _mm256_cmp_pd( d0x, d0y, _CMP_GT_OQ );
+	__m256d offX  = spx_ones( upper );
+	__m256d offY  = spx_zeros( upper );
+
+	// Distances from the middle and the last corner
+	__m256d twice = _mm256_set1_pd( 2.0 * constants::spxSkew[0][1] );
+	__m256d d1x   = _mm256_add_pd( _mm256_sub_pd( d0x, offX ), unskew );
+	__m256d d1y   = _mm256_add_pd( _mm256_sub_pd( d0y, offY ), unskew );
+	__m256d d2x   = _mm256_add_pd( _mm256_sub_pd( d0x, one ), twice );
+	__m256d d2y   = _mm256_add_pd( _mm256_sub_pd( d0y, one ), twice );
+
+	// Permuted numbers, normalized to a range of 0 to 7
+	__m128i iOffX = _mm256_cvttpd_epi32( offX );
+	__m128i iOffY = _mm256_cvttpd_epi32( offY );
+	__m128i g0    = spx_perm( tab, _mm_add_epi32( permX, spx_perm( tab, permY ) ) );
+	__m128i g1    = spx_perm( tab, _mm_add_epi32( _mm_add_epi32( permX, iOffX ),
+	                                              spx_perm( tab, _mm_add_epi32( permY, iOffY ) ) ) );
+	__m128i g2    = spx_perm( tab, _mm_add_epi32( _mm_add_epi32( permX, iOne ),
+	                                              spx_perm( tab, _mm_add_epi32( permY, iOne ) ) ) );
+	g0 = _mm_and_si128( g0, seven );
+	g1 = _mm_and_si128( g1, seven );
+	g2 = _mm_and_si128( g2, seven );
+
+	// Calculate the contribution from the three corners
+	__m256d c0 = spx_corner( _mm256_sub_pd( _mm256_sub_pd( half, _mm256_mul_pd( d0x, d0x ) ), _mm256_mul_pd( d0y, d0y ) ),
+	                         _mm256_add_pd( _mm256_mul_pd( spx_grad( g0, 0 ), d0x ), _mm256_mul_pd( spx_grad( g0, 1 ), d0y ) ) );
+	__m256d c1 = spx_corner( _mm256_sub_pd( _mm256_sub_pd( half, _mm256_mul_pd( d1x, d1x ) ), _mm256_mul_pd( d1y, d1y ) ),
+	                         _mm256_add_pd( _mm256_mul_pd( spx_grad( g1, 0 ), d1x ), _mm256_mul_pd( spx_grad( g1, 1 ), d1y ) ) );
+	__m256d c2 = spx_corner( _mm256_sub_pd( _mm256_sub_pd( half, _mm256_mul_pd( d2x, d2x ) ), _mm256_mul_pd( d2y, d2y ) ),
+	                         _mm256_add_pd( _mm256_mul_pd( spx_grad( g2, 0 ), d2x ), _mm256_mul_pd( spx_grad( g2, 1 ), d2y ) ) );
+
+	return spx_result( constants::spxScale[1], _mm256_add_pd( _mm256_add_pd( c0, c1 ), c2 ) );
+}
+
+
+/// @internal Distances of four points from one corner of a 3D simplex
+struct sSpxDist3D {
+	__m256d x;
+	__m256d y;
+	__m256d z;
+};
+
+
+/// @internal Offsets of one corner of a 3D simplex, as doubles and as permutation table offsets
+struct sSpxOffs3D {
+	__m256d x, y, z;
+	__m128i iX, iY, iZ;
+};
+
+
+/// @internal distances @a d0 moved by the corner offsets @a offs and @a unsk
+PWX_SPX_AVX2 inline sSpxDist3D spx_dist3D( sSpxDist3D const& d0, sSpxOffs3D const& offs, __m256d unsk ) noexcept {
+	return sSpxDist3D {
+		_mm256_add_pd( _mm256_sub_pd( d0.x, offs.x ), unsk ),
+		_mm256_add_pd( _mm256_sub_pd( d0.y, offs.y ), unsk ),
+		_mm256_add_pd( _mm256_sub_pd( d0.z, offs.z ), unsk )
+	};
+}
+
+
+/// @internal corner offsets out of the 0.0 / 1.0 values @a oX, @a oY and @a oZ
+PWX_SPX_AVX2 inline sSpxOffs3D spx_offs3D( __m256d oX, __m256d oY, __m256d oZ ) noexcept {
+	return sSpxOffs3D {
+		oX, oY, oZ,
+		_mm256_cvttpd_epi32( oX ), _mm256_cvttpd_epi32( oY ), _mm256_cvttpd_epi32( oZ )
+	};
+}
+
+
+/// @internal contribution of one 3D corner at the distances @a d with the permutation indices @a pX, @a pY, @a pZ
+PWX_SPX_AVX2 inline __m256d spx_corner3D( int32_t const* tab, sSpxDist3D const& d,
+                                          __m128i pX, __m128i pY, __m128i pZ ) noexcept {
+	// Permuted number, normalized to a range of 0 to 11.
+	// ( g * 171 ) >> 11 is g / 12 for all g < 256.
+	__m128i g    = spx_perm( tab, _mm_add_epi32( pX, spx_perm( tab, _mm_add_epi32( pY, spx_perm( tab, pZ ) ) ) ) );
+	__m128i quot = _mm_srli_epi32( _mm_mullo_epi32( g, _mm_set1_epi32( 171 ) ), 11 );
+	g = _mm_sub_epi32( g, _mm_mullo_epi32( quot, _mm_set1_epi32( 12 ) ) );
+
+	__m256d contrib = _mm256_sub_pd( _mm256_sub_pd( _mm256_sub_pd( _mm256_set1_pd( 0.6 ), _mm256_mul_pd( d.x, d.x ) ),
+	                                                _mm256_mul_pd( d.y, d.y ) ), _mm256_mul_pd( d.z, d.z ) );
+	__m256d dot     = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( spx_grad( g, 0 ), d.x ),
+	                                                _mm256_mul_pd( spx_grad( g, 1 ), d.y ) ),
+	                                 _mm256_mul_pd( spx_grad( g, 2 ), d.z ) );
+
+	return spx_corner( contrib, dot );
+}
+
+
+/// @internal Four points of 3D simplex noise, see CRandom::getSpx3D()
+PWX_SPX_AVX2 __m256d spx3D( __m256d x, __m256d y, __m256d z, int32_t const* tab ) noexcept {
+	const __m256d skew   = _mm256_set1_pd( constants::spxSkew[1][0] );
+	const __m256d unskew = _mm256_set1_pd( constants::spxSkew[1][1] );
+	const __m256d one    = _mm256_set1_pd( 1.0 );
+	const __m128i byte   = _mm_set1_epi32( 0xff );
+	const __m128i iOne   = _mm_set1_epi32( 1 );
+
+	// Normalized coordinates and permutation table indices
+	__m256d sum   = _mm256_mul_pd( _mm256_add_pd( _mm256_add_pd( x, y ), z ), skew );
+	__m128i normX = _mm256_cvttpd_epi32( _mm256_floor_pd( _mm256_add_pd( x, sum ) ) );
+	__m128i normY = _mm256_cvttpd_epi32( _mm256_floor_pd( _mm256_add_pd( y, sum ) ) );
+	__m128i normZ = _mm256_cvttpd_epi32( _mm256_floor_pd( _mm256_add_pd( z, sum ) ) );
+	__m128i permX = _mm_and_si128( normX, byte );
+	__m128i permY = _mm_and_si128( normY, byte );
+	__m128i permZ = _mm_and_si128( normZ, byte );
+
+	// Distances from the first corner
+	__m256d unsk = _mm256_mul_pd( _mm256_cvtepi32_pd( _mm_add_epi32( _mm_add_epi32( normX, normY ), normZ ) ), unskew );
+	sSpxDist3D d0 {
+		_mm256_sub_pd( x, _mm256_sub_pd( _mm256_cvtepi32_pd( normX ), unsk ) ),
+		_mm256_sub_pd( y, _mm256_sub_pd( _mm256_cvtepi32_pd( normY ), unsk ) ),
+		_mm256_sub_pd( z, _mm256_sub_pd( _mm256_cvtepi32_pd( normZ ), unsk ) )
+	};
+
+	// Determine which simplex we are in. This is the decision tree of
+	// CRandom::getSpx3D() with xy = x >= y, yz = y >= z and xz = x >= z:
+	//   second corner: ( xy && ( yz || xz ), !xy && yz, !( yz || ( xy && xz ) ) )
+	//   third corner:  ( xy || ( yz && xz ), !( xy && !yz ), !( yz && ( xy || xz ) ) )
+	__m256d xy = _mm256_cmp_pd( d0.x, d0.y, _CMP_GE_OQ );
+	__m256d yz = _mm256_cmp_pd( d0.y, d0.z, _CMP_GE_OQ );
+	__m256d xz = _mm256_cmp_pd( d0.x, d0.z, _CMP_GE_OQ );
+
+	sSpxOffs3D offs1 = spx_offs3D( spx_ones( _mm256_and_pd( xy, _mm256_or_pd( yz, xz ) ) ),
+	                               spx_ones( _mm256_andnot_pd( xy, yz ) ),
+	                               spx_zeros( _mm256_or_pd( yz, _mm256_and_pd( xy, xz ) ) ) );
+	sSpxOffs3D offs2 = spx_offs3D( spx_ones( _mm256_or_pd( xy, _mm256_and_pd( yz, xz ) ) ),
+	                               spx_zeros( _mm256_andnot_pd( yz, xy ) ),
+	                               spx_zeros( _mm256_and_pd( yz, _mm256_or_pd( xy, xz ) ) ) );
+
+	// Distances from the second, third and last corner
+	sSpxDist3D d1 = spx_dist3D( d0, offs1, unskew );
+	sSpxDist3D d2 = spx_dist3D( d0, offs2, _mm256_set1_pd( 2.0 * constants::spxSkew[1][1] ) );
+	sSpxDist3D d3 = spx_dist3D( d0, sSpxOffs3D { one, one, one, iOne, iOne, iOne },
+	                            _mm256_set1_pd( 3.0 * constants::spxSkew[1][1] ) );
+
+	// Calculate the contribution from the four corners
+	__m256d c0 = spx_corner3D( tab, d0, permX, permY, permZ );
+	__m256d c1 = spx_corner3D( tab, d1, _mm_add_epi32( permX, offs1.iX ), _mm_add_epi32( permY, offs1.iY ),
+	                           _mm_add_epi32( permZ, offs1.iZ ) );
+	__m256d c2 = spx_corner3D( tab, d2, _mm_add_epi32( permX, offs2.iX ), _mm_add_epi32( permY, offs2.iY ),
+	                           _mm_add_epi32( permZ, offs2.iZ ) );
+	__m256d c3 = spx_corner3D( tab, d3, _mm_add_epi32( permX, iOne ), _mm_add_epi32( permY, iOne ),
+	                           _mm_add_epi32( permZ, iOne ) );
+
+	return spx_result( constants::spxScale[2], _mm256_add_pd( _mm256_add_pd( _mm256_add_pd( c0, c1 ), c2 ), c3 ) );
+}
+
+
+} // anonymous namespace
+
+
+/// @internal Whether the AVX2 simplex kernels can be used on this machine. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+bool private_spx_avx2_usable() noexcept {
+	static const bool usable = __builtin_cpu_supports( "avx2" );
+	return usable;
+}
+
+
+/// @internal Calculate 2D simplex noise for @a count points using AVX2. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+PWX_SPX_AVX2 void private_spx2D_avx2( double* dest, double const* xs, double y, uint32_t count, int32_t const* tab ) noexcept {
+	__m256d  vY   = _mm256_set1_pd( y );
+	uint32_t full = count - ( count % spxLanes );
+	uint32_t i    = 0;
+
+	for ( ; i < full ; i += spxLanes )
+		_mm256_storeu_pd( dest + i, spx2D( _mm256_loadu_pd( xs + i ), vY, tab ) );
+
+	// The rest is calculated padded with the last point
+	if ( i < count ) {
+		double tail[spxLanes];
+		for ( uint32_t j = 0 ; j < spxLanes ; ++j )
+			tail[j] = xs[ ( i + j ) < count ? ( i + j ) : ( count - 1 ) ];
+		_mm256_storeu_pd( tail, spx2D( _mm256_loadu_pd( tail ), vY, tab ) );
+		for ( uint32_t j = 0 ; ( i + j ) < count ; ++j )
+			dest[i + j] = tail[j];
+	}
+}
+
+
+/// @internal Calculate 3D simplex noise for @a count points using AVX2. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+PWX_SPX_AVX2 void private_spx3D_avx2( double* dest, double const* xs, double y, double z, uint32_t count,
+                                      int32_t const* tab ) noexcept {
+	__m256d  vY   = _mm256_set1_pd( y );
+	__m256d  vZ   = _mm256_set1_pd( z );
+	uint32_t full = count - ( count % spxLanes );
+	uint32_t i    = 0;
+
+	for ( ; i < full ; i += spxLanes )
+		_mm256_storeu_pd( dest + i, spx3D( _mm256_loadu_pd( xs + i ), vY, vZ, tab ) );
+
+	// The rest is calculated padded with the last point
+	if ( i < count ) {
+		double tail[spxLanes];
+		for ( uint32_t j = 0 ; j < spxLanes ; ++j )
+			tail[j] = xs[ ( i + j ) < count ? ( i + j ) : ( count - 1 ) ];
+		_mm256_storeu_pd( tail, spx3D( _mm256_loadu_pd( tail ), vY, vZ, tab ) );
+		for ( uint32_t j = 0 ; ( i + j ) < count ; ++j )
+			dest[i + j] = tail[j];
+	}
+}
+
+
+#else // No AVX2 support
+
+
+bool private_spx_avx2_usable() noexcept {
+	return false;
+}
+
+
+void private_spx2D_avx2( double*, double const*, double, uint32_t, int32_t const* ) noexcept { }
+
+
+void private_spx3D_avx2( double*, double const*, double, double, uint32_t, int32_t const* ) noexcept { }
+
+
+#endif // PWX_HAVE_SPX_AVX2
+
+
+} // namespace pwx
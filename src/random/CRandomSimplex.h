@@ -0,0 +1,102 @@
+#pragma once
+#ifndef PWX_LIBPWX_PWX_INTERNAL_CRANDOMSIMPLEX_H_INCLUDED
+#define PWX_LIBPWX_PWX_INTERNAL_CRANDOMSIMPLEX_H_INCLUDED 1
+
+/** @internal
+  * @file CRandomSimplex.h
+  *
+  * @brief declaration of the vectorized simplex noise kernels
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <cstdint>
+
+#include "basic/compiler.h"
+
+
+/// @namespace pwx
+namespace pwx {
+
+
+#ifndef PWX_NODOX
+
+
+/// @internal Number of points the simplex kernels calculate at once
+const uint32_t spxLanes = 4;
+
+
+/// @internal Number of points the simplex field functions handle in one batch, also the width of one tile
+const uint32_t spxBatch = 256;
+
+
+/// @internal Number of rows of one tile of the simplex map functions
+const uint32_t spxTileRows = 64;
+
+
+/// @internal Whether the AVX2 simplex kernels can be used on this machine. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+bool private_spx_avx2_usable() noexcept;
+
+
+/** @internal Calculate 2D simplex noise for @a count points using AVX2. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+  *
+  * The results are the same as `CRandom::getSpx2D( xs[i], y )` would
+  * return, within a few units in the last place.
+  *
+  * @param[out] dest the @a count results.
+  * @param[in] xs the @a count X-Coordinates.
+  * @param[in] y the Y-Coordinate of all points.
+  * @param[in] count the number of points.
+  * @param[in] tab the permutation table of the CRandom instance.
+**/
+void private_spx2D_avx2( double* dest, double const* xs, double y, uint32_t count, int32_t const* tab ) noexcept;
+
+
+/** @internal Calculate 3D simplex noise for @a count points using AVX2. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+  *
+  * The results are the same as `CRandom::getSpx3D( xs[i], y, z )`
+  * would return, within a few units in the last place.
+  *
+  * @param[out] dest the @a count results.
+  * @param[in] xs the @a count X-Coordinates.
+  * @param[in] y the Y-Coordinate of all points.
+  * @param[in] z the Z-Coordinate of all points.
+  * @param[in] count the number of points.
+  * @param[in] tab the permutation table of the CRandom instance.
+**/
+void private_spx3D_avx2( double* dest, double const* xs, double y, double z, uint32_t count, int32_t const* tab ) noexcept;
+
+
+#endif // Do not document with doxygen
+
+
+} // namespace pwx
+
+
+#endif // PWX_LIBPWX_PWX_INTERNAL_CRANDOMSIMPLEX_H_INCLUDED
@@ -34,72 +34,82 @@
 #include "random/CRandomTRandom.h"
 
 
+
+
+#include <atomic>
+#include <chrono>
+#include <random>
+
+#include "basic/macros.h"
+#include "random/CRandomTRandom.h"
+
+
 namespace pwx {
 
 
-class privRand32_t {
-public:
-	rand_t operator()() {
-		try {
-			thread_local static std::random_device privRandDev_;
-			thread_local static std::mt19937 privRandMt32_( privRandDev_() );
-			return privRandMt32_();
-		} catch ( ... ) {}
-		return 0;
-	}
-} privRand32;
-
-
-class privRand64_t {
-public:
-	rand_t operator()() {
-		try {
-			thread_local static std::random_device privRandDev_;
-			thread_local static std::mt19937_64 privRandMt64_( privRandDev_() );
-			return privRandMt64_();
-		} catch ( ... ) {}
-		return 0;
-	}
-} privRand64;
+/// @internal seed for a new thread, falls back to clock and counter if std::random_device fails
+static uint64_t private_thread_seed() noexcept {
+	static std::atomic<uint64_t> counter( 0 );
+
+	try {
+		std::random_device randDev;
+		return ( static_cast<uint64_t>( randDev() ) << 32 ) ^ static_cast<uint64_t>( randDev() );
+	} catch ( ... ) {}
+
+	uint64_t mix = static_cast<uint64_t>( std::chrono::steady_clock::now().time_since_epoch().count() )
+	               ^ ( counter.fetch_add( 1, std::memory_order_relaxed ) << 32 );
+	return private_splitmix64( mix );
+}
+
+
+/** @internal The engines of each thread. Zero initialized and trivially destructible.
+  * The initial-exec model turns every access into a single load instead of a call
+  * to __tls_get_addr(), which costs more than drawing a number. The few bytes are
+  * served from the reserve glibc keeps for that, even if libpwx is loaded via dlopen().
+**/
+thread_local sRandomEngines engines __attribute__ ( ( tls_model( "initial-exec" ) ) );
 
 
 } // namespace pwx
 
 
-/// @internal random number generator, 32 bit. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
-pwx::rand_t pwx::private_get_random32() noexcept {
-	return privRand32();
+/// @internal the engines of the calling thread, seeded on first use. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+pwx::sRandomEngines& pwx::private_thread_engines() noexcept {
+	if ( !engines.seeded )
+		engines.seed( private_thread_seed() );
+	return engines;
 }
 
 
-/// @internal random number generator, 64 bit. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
-pwx::rand_t pwx::private_get_random64() noexcept {
-	return privRand64();
+/// @internal random number generator, 32 bit. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+uint32_t pwx::private_get_random32( eRandomEngine engine ) noexcept {
+	return static_cast<uint32_t>( private_thread_engines().next( engine ) >> 32 );
 }
 
 
 /// @internal random character handler. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
-size_t pwx::private_random_str( char* dest, size_t min_, size_t max_ ) noexcept {
+size_t pwx::private_random_str( eRandomEngine engine, char* dest, size_t min_, size_t max_ ) noexcept {
 	static const uint8_t lowA = 'a';
 	static const uint8_t uppA = 'A';
 
 	size_t pos = 0;
 
 	if ( min_ || max_ ) {
-		size_t xMin        = std::min( min_, max_ );
-		size_t xMax        = std::max( min_, max_ );
-		size_t finishRange = xMax - xMin;
-		size_t finishDone  = finishRange;
+		sRandomEngines& engines     = private_thread_engines();
+		size_t          xMin        = std::min( min_, max_ );
+		size_t          xMax        = std::max( min_, max_ );
+		size_t          finishRange = xMax - xMin;
+		size_t          finishDone  = finishRange;
 
 		while ( ( pos < ( xMax - 1 ) )
 		        && ( ( pos < xMin )
-		             || ( private_random( static_cast<size_t>( 0 ), finishRange ) <= finishDone )
+		             || ( private_random( engine, static_cast<size_t>( 0 ), finishRange ) <= finishDone )
 		        )
 			  ) {
 			// Set up next character
 			dest[pos] = static_cast<char>(
-				  (   0x000000ff & ( ( privRand32() ) % 26 ) ) +
-				  ( ( 0x000000ff & ( ( privRand32() ) %  2 ) ) ? lowA : uppA )
+				  private_random_upto32( engines, engine, 25 ) +
+				  ( private_random_upto32( engines, engine, 1 ) ? lowA : uppA )
 			);
 
 			// Advance pos and reduce finishDone if xMin is already met
@@ -5,7 +5,7 @@
 /** @internal
   * @file CRandomTRandom.h
   *
-  * @brief definition of a little template that does all the random() handling
+  * @brief definition of the random engines and the template that does all the random() handling
   *
   * (c)  2007 - 2021 PrydeWorX
   * @author Sven Eden, PrydeWorX - Adendorf, Germany
@@ -36,10 +36,15 @@
 **/
 
 
-#include <atomic>
-#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 #include "basic/compiler.h"
+#include "random/eRandomEngine.h"
 
 #include "math_helpers/MathHelpers.h"
 
@@ -51,55 +56,414 @@ namespace pwx {
 #ifndef PWX_NODOX
 
 
-typedef std::random_device::result_type rand_t;
+/// @internal Expand @a state into well mixed 64 bit values (SplitMix64)
+static inline uint64_t private_splitmix64( uint64_t& state ) noexcept {
+	uint64_t z = ( state += 0x9e3779b97f4a7c15ULL );
+	z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+	z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+	return z ^ ( z >> 31 );
+}
+
+
+/// @internal xoshiro256** 1.0, 256 bit state, period 2^256 - 1
+struct sXoshiro256ss {
+	uint64_t s[4];
 
-rand_t private_get_random32() noexcept;
-rand_t private_get_random64() noexcept;
-size_t private_random_str( char* dest, size_t min_, size_t max_ ) noexcept;
+	void seed( uint64_t seed_ ) noexcept {
+		for ( uint64_t& x : s )
+			x = private_splitmix64( seed_ );
+	}
 
+	uint64_t next() noexcept {
+		uint64_t const result = rotl( s[1] * 5, 7 ) * 9;
+		uint64_t const t      = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3]  = rotl( s[3], 45 );
+		return result;
+	}
 
-// random number selectors
-template< class T, std::size_t SIZE > struct type_size_less_than : std::integral_constant< bool, ( sizeof( T ) < SIZE ) > {};
-template< class T, std::size_t SIZE > struct type_size_at_least : std::integral_constant< bool, ( sizeof( T ) >= SIZE ) > {};
-template< class T, typename std::enable_if< type_size_less_than< T, 64 >::value >::type* = nullptr >
-rand_t private_get_random() noexcept { return private_get_random32(); }
-template< class T, typename std::enable_if< type_size_at_least< T, 64 >::value >::type* = nullptr >
-rand_t private_get_random() noexcept { return private_get_random64(); }
+	/// @brief advance by 2^128 values, which gives 2^128 non-overlapping streams
+	void jump() noexcept {
+		static uint64_t const poly[4] = {
+			0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+		};
+		uint64_t result[4] = { 0, 0, 0, 0 };
 
+		for ( uint64_t word : poly ) {
+			for ( int bit = 0 ; bit < 64 ; ++bit ) {
+				if ( word & ( 1ULL << bit ) ) {
+					for ( int i = 0 ; i < 4 ; ++i )
+						result[i] ^= s[i];
+				}
+				next();
+			}
+		}
+
+		for ( int i = 0 ; i < 4 ; ++i )
+			s[i] = result[i];
+	}
+
+	static uint64_t rotl( uint64_t x, int k ) noexcept {
+		return ( x << k ) | ( x >> ( 64 - k ) );
+	}
+};
+
+
+/// @internal PCG XSL-RR 128/64, 128 bit LCG state, period 2^128
+struct sPcg64 {
+	unsigned __int128 state;
+	unsigned __int128 inc;
+
+	void seed( uint64_t seed_ ) noexcept {
+		uint64_t          mix  = seed_;
+		unsigned __int128 init = static_cast<unsigned __int128>( private_splitmix64( mix ) ) << 64;
+		unsigned __int128 seq  = static_cast<unsigned __int128>( private_splitmix64( mix ) ) << 64;
+		init |= private_splitmix64( mix );
+		seq  |= private_splitmix64( mix );
+		inc   = ( seq << 1 ) | 1;
+		state = 0;
+		step();
+		state += init;
+		step();
+	}
+
+	/// @brief advance by 2^64 values, which gives 2^64 non-overlapping streams
+	void jump() noexcept {
+		// Combine the steps for all bits of the distance (Brown, "Random Number Generation
+		// with Arbitrary Strides"). Only bit 64 is set, so squaring 64 times does it.
+		unsigned __int128 curMult = mult();
+		unsigned __int128 curPlus = inc;
+
+		for ( int bit = 0 ; bit < 64 ; ++bit ) {
+			curPlus *= curMult + 1;
+			curMult *= curMult;
+		}
+
+		state = ( curMult * state ) + curPlus;
+	}
+
+	static unsigned __int128 mult() noexcept {
+		return ( static_cast<unsigned __int128>( 0x2360ed051fc65da4ULL ) << 64 ) | 0x4385df649fccf645ULL;
+	}
+
+	uint64_t next() noexcept {
+		step();
+		uint64_t const value = static_cast<uint64_t>( state >> 64 ) ^ static_cast<uint64_t>( state );
+		unsigned const rot   = static_cast<unsigned>( state >> 122 );
+		return ( value >> rot ) | ( value << ( ( 64 - rot ) & 63 ) );
+	}
+
+	void step() noexcept {
+		state = state * mult() + inc;
+	}
+};
 
-/// @internal random number handler. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
-template< typename Tval > Tval private_random( Tval min_, Tval max_ ) noexcept {
-	// Type borders:
-	static const auto maxRandomValue   = static_cast<long double>( std::random_device::max() );
-	static const auto minRandomValue   = static_cast<long double>( std::random_device::min() );
-	static const auto randomValueRange = maxRandomValue - minRandomValue;
-	static const Tval realMaxVal       = std::numeric_limits< Tval >::max();
-	static const Tval realMinVal       = std::numeric_limits< Tval >::lowest();
-	static const auto xMaxVal          = static_cast<long double>( realMaxVal );
-	static const auto xMinVal          = static_cast<long double>( realMinVal );
 
+/// @internal SplitMix64, 64 bit state, period 2^64
+struct sSplitMix64 {
+	uint64_t state;
+
+	void seed( uint64_t seed_ ) noexcept {
+		state = seed_;
+	}
+
+	/// @brief advance by 2^48 values, which gives 2^16 non-overlapping streams
+	void jump() noexcept {
+		state += 0x9e3779b97f4a7c15ULL << 48;
+	}
+
+	uint64_t next() noexcept {
+		return private_splitmix64( state );
+	}
+};
+
+
+/** @internal One instance of each engine. Every thread has its own set, see private_thread_engines()
+  * All members are trivial, so the thread local instance needs no guard and no destructor.
+**/
+struct sRandomEngines {
+	sXoshiro256ss xoshiro;
+	sPcg64        pcg;
+	sSplitMix64   splitmix;
+	bool          seeded; //!< Set by seed(), the thread local instance starts zeroed
+
+	void seed( uint64_t seed_ ) noexcept {
+		xoshiro.seed( seed_ );
+		pcg.seed( ~seed_ );
+		splitmix.seed( seed_ ^ 0x5851f42d4c957f2dULL );
+		seeded = true;
+	}
+
+	/** @brief write @a count raw values of @a engine into @a dest
+	  * The engine state is copied to the stack, so it can stay in registers
+	  * instead of being reloaded after every store to @a dest.
+	**/
+	void fill( eRandomEngine engine, uint64_t* dest, size_t count ) noexcept {
+		switch ( engine ) {
+			case RE_PCG64: {
+				sPcg64 local = pcg;
+				for ( size_t i = 0 ; i < count ; ++i )
+					dest[i] = local.next();
+				pcg = local;
+				break;
+			}
+			case RE_SPLITMIX64: {
+				sSplitMix64 local = splitmix;
+				for ( size_t i = 0 ; i < count ; ++i )
+					dest[i] = local.next();
+				splitmix = local;
+				break;
+			}
+			default: {
+				sXoshiro256ss local = xoshiro;
+				for ( size_t i = 0 ; i < count ; ++i )
+					dest[i] = local.next();
+				xoshiro = local;
+				break;
+			}
+		}
+	}
+
+	void jump( eRandomEngine engine ) noexcept {
+		switch ( engine ) {
+			case RE_PCG64:
+				pcg.jump();
+				break;
+			case RE_SPLITMIX64:
+				splitmix.jump();
+				break;
+			default:
+				xoshiro.jump();
+				break;
+		}
+	}
+
+	uint64_t next( eRandomEngine engine ) noexcept {
+		switch ( engine ) {
+			case RE_PCG64:
+				return pcg.next();
+			case RE_SPLITMIX64:
+				return splitmix.next();
+			default:
+				return xoshiro.next();
+		}
+	}
+};
+
+
+sRandomEngines& private_thread_engines() noexcept;
+uint32_t private_get_random32( eRandomEngine engine ) noexcept;
+size_t private_random_str( eRandomEngine engine, char* dest, size_t min_, size_t max_ ) noexcept;
+
+
+/** @internal unbiased random value between 0 and @a range, both inclusive (Lemire)
+  *
+  * The high half of the product of a random value and the number of
+  * possible results is the result. Only if the low half falls into the
+  * small area that would favour some results, a new value is drawn.
+**/
+static inline uint32_t private_random_upto32( sRandomEngines& engines, eRandomEngine engine, uint32_t range ) noexcept {
+	uint32_t x = static_cast<uint32_t>( engines.next( engine ) >> 32 );
 
+	if ( std::numeric_limits<uint32_t>::max() == range )
+		return x;
+
+	uint32_t const bound = range + 1;
+	uint64_t       m     = static_cast<uint64_t>( x ) * bound;
+	uint32_t       low   = static_cast<uint32_t>( m );
+
+	if ( low < bound ) {
+		uint32_t const threshold = ( 0U - bound ) % bound;
+		while ( low < threshold ) {
+			x   = static_cast<uint32_t>( engines.next( engine ) >> 32 );
+			m   = static_cast<uint64_t>( x ) * bound;
+			low = static_cast<uint32_t>( m );
+		}
+	}
+
+	return static_cast<uint32_t>( m >> 32 );
+}
+
+
+/// @internal 64 bit variant of private_random_upto32()
+static inline uint64_t private_random_upto64( sRandomEngines& engines, eRandomEngine engine, uint64_t range ) noexcept {
+	uint64_t x = engines.next( engine );
+
+	if ( std::numeric_limits<uint64_t>::max() == range )
+		return x;
+
+	uint64_t const    bound = range + 1;
+	unsigned __int128 m     = static_cast<unsigned __int128>( x ) * bound;
+	uint64_t          low   = static_cast<uint64_t>( m );
+
+	if ( low < bound ) {
+		uint64_t const threshold = ( 0ULL - bound ) % bound;
+		while ( low < threshold ) {
+			x   = engines.next( engine );
+			m   = static_cast<unsigned __int128>( x ) * bound;
+			low = static_cast<uint64_t>( m );
+		}
+	}
+
+	return static_cast<uint64_t>( m >> 64 );
+}
+
+
+/** @internal turn 64 random bits into a value in [0, 1)
+  *
+  * float and double put the top bits into the mantissa of a number
+  * in [1, 2) and subtract one. long double has no portable layout, it
+  * is scaled from all 64 bits instead.
+**/
+template< typename Tval > Tval private_random_unit( uint64_t bits ) noexcept {
+	if constexpr ( std::is_same<Tval, float>::value ) {
+		uint32_t const xBits = 0x3f800000U | static_cast<uint32_t>( bits >> 41 );
+		float          result;
+		std::memcpy( &result, &xBits, sizeof( result ) );
+		return result - 1.f;
+	} else if constexpr ( std::is_same<Tval, double>::value ) {
+		uint64_t const xBits = 0x3ff0000000000000ULL | ( bits >> 12 );
+		double         result;
+		std::memcpy( &result, &xBits, sizeof( result ) );
+		return result - 1.;
+	} else
+		return static_cast<Tval>( bits ) * static_cast<Tval>( 0x1p-64L );
+}
+
+
+/// @internal random number handler. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+template< typename Tval > Tval private_random( eRandomEngine engine, Tval min_, Tval max_ ) noexcept {
 	// Quick exit when no calculation can be done
-	if ( areAlmostEqual( max_, min_ ) ) {
+	if ( areAlmostEqual( max_, min_ ) )
 		return ( max_ );
+
+	Tval const      xMin    = std::min( min_, max_ );
+	Tval const      xMax    = std::max( min_, max_ );
+	sRandomEngines& engines = private_thread_engines();
+
+	if constexpr ( std::is_integral<Tval>::value ) {
+		// Work with the distance to xMin, which always fits into the unsigned type
+		typedef typename std::make_unsigned<Tval>::type Tuval;
+		Tuval const range = static_cast<Tuval>( static_cast<Tuval>( xMax ) - static_cast<Tuval>( xMin ) );
+		Tuval       dist;
+
+		if constexpr ( sizeof( Tval ) > sizeof( uint32_t ) )
+			dist = static_cast<Tuval>( private_random_upto64( engines, engine, range ) );
+		else
+			dist = static_cast<Tuval>( private_random_upto32( engines, engine, range ) );
+
+		return static_cast<Tval>( static_cast<Tuval>( static_cast<Tuval>( xMin ) + dist ) );
 	} else {
-		// Step 1: Get a new random value
-		rand_t randVal = private_get_random< Tval >();
+		Tval const unit = private_random_unit< Tval >( engines.next( engine ) );
+		Tval const span = xMax - xMin;
 
-		// Step 2: Reorder min_ and max_ and bring everything to long double and in range
-		long double xMin = static_cast<long double>( std::min( min_, max_ ) );
-		long double xMax = static_cast<long double>( std::max( min_, max_ ) );
-		long double xVal = xMin // Start with this offset
-		                   - minRandomValue // Shift so the range fits
-		                   + ( static_cast<long double>( randVal ) * ( ( xMax - xMin ) / randomValueRange ) );
+		// If the span overflows, interpolate between both borders instead
+		Tval xVal = std::isfinite( span )
+		            ? xMin + unit * span
+		            : ( xMin * ( static_cast<Tval>( 1 ) - unit ) ) + ( xMax * unit );
 
-		// Step 3: Check Type borders:
-		if ( xVal > xMaxVal ) xVal = xMaxVal;
-		if ( xVal < xMinVal ) xVal = xMinVal;
+		// Rounding might cross the borders
+		if ( xVal > xMax ) xVal = xMax;
+		if ( xVal < xMin ) xVal = xMin;
 
-		return static_cast<Tval>( xVal );
+		return xVal;
 	}
+}
+
+
+/// @internal Number of values random_fill() draws from the engine at once
+const size_t rndFillBlock = 256;
 
+
+/// @internal random_fill_par() only starts threads if each gets at least this many values
+const size_t rndFillMinSlice = 16384;
+
+
+/** @internal fill @a dest with @a count random values. NEVER EXPOSE OR USE OUTSIDE CRandom.cpp !
+  *
+  * Raw values are drawn in blocks of `rndFillBlock` and then mapped
+  * into the range in one loop per block, which the compiler can
+  * vectorize for floating point types. The ranges are checked and the
+  * rejection threshold of the integer reduction is computed only once.
+  * The results follow the same rules as private_random() does.
+**/
+template< typename Tval >
+void private_random_fill( sRandomEngines& engines, eRandomEngine engine, Tval* dest, size_t count,
+                          Tval min_, Tval max_ ) noexcept {
+	if ( areAlmostEqual( max_, min_ ) ) {
+		std::fill( dest, dest + count, max_ );
+		return;
+	}
+
+	Tval const xMin = std::min( min_, max_ );
+	Tval const xMax = std::max( min_, max_ );
+	uint64_t   bits[rndFillBlock];
+
+	for ( size_t pos = 0 ; pos < count ; pos += rndFillBlock ) {
+		size_t const todo = std::min( rndFillBlock, count - pos );
+		Tval* const  out  = dest + pos;
+
+		engines.fill( engine, bits, todo );
+
+		if constexpr ( std::is_integral<Tval>::value ) {
+			typedef typename std::make_unsigned<Tval>::type Tuval;
+			Tuval const range = static_cast<Tuval>( static_cast<Tuval>( xMax ) - static_cast<Tuval>( xMin ) );
+			Tuval const base  = static_cast<Tuval>( xMin );
+
+			if constexpr ( sizeof( Tval ) > sizeof( uint32_t ) ) {
+				if ( std::numeric_limits<uint64_t>::max() == range ) {
+					for ( size_t i = 0 ; i < todo ; ++i )
+						out[i] = static_cast<Tval>( bits[i] );
+					continue;
+				}
+
+				uint64_t const bound     = range + 1;
+				uint64_t const threshold = ( 0ULL - bound ) % bound;
+				for ( size_t i = 0 ; i < todo ; ++i ) {
+					unsigned __int128 const m = static_cast<unsigned __int128>( bits[i] ) * bound;
+					out[i] = static_cast<Tval>( base + ( static_cast<uint64_t>( m ) < threshold
+					                                     ? private_random_upto64( engines, engine, range )
+					                                     : static_cast<uint64_t>( m >> 64 ) ) );
+				}
+			} else {
+				if ( std::numeric_limits<uint32_t>::max() == static_cast<uint32_t>( range ) ) {
+					for ( size_t i = 0 ; i < todo ; ++i )
+						out[i] = static_cast<Tval>( bits[i] >> 32 );
+					continue;
+				}
+
+				uint32_t const bound     = static_cast<uint32_t>( range ) + 1;
+				uint32_t const threshold = ( 0U - bound ) % bound;
+				for ( size_t i = 0 ; i < todo ; ++i ) {
+					uint64_t const m = ( bits[i] >> 32 ) * bound;
+					out[i] = static_cast<Tval>( static_cast<Tuval>(
+					                base + ( static_cast<uint32_t>( m ) < threshold
+					                         ? private_random_upto32( engines, engine, static_cast<uint32_t>( range ) )
+					                         : static_cast<uint32_t>( m >> 32 ) ) ) );
+				}
+			}
+		} else {
+			Tval const span = xMax - xMin;
+
+			if ( std::isfinite( span ) ) {
+				for ( size_t i = 0 ; i < todo ; ++i ) {
+					Tval const xVal = xMin + ( private_random_unit< Tval >( bits[i] ) * span );
+					out[i] = xVal > xMax ? xMax : xVal;
+				}
+			} else {
+				// The span overflows, interpolate between both borders instead
+				for ( size_t i = 0 ; i < todo ; ++i ) {
+					Tval const unit = private_random_unit< Tval >( bits[i] );
+					Tval const xVal = ( xMin * ( static_cast<Tval>( 1 ) - unit ) ) + ( xMax * unit );
+					out[i] = xVal > xMax ? xMax : xVal < xMin ? xMin : xVal;
+				}
+			}
+		}
+	}
 }
 
 
@@ -110,4 +474,3 @@ template< typename Tval > Tval private_random( Tval min_, Tval max_ ) noexcept {
 
 
 #endif // PWX_LIBPWX_PWX_INTERNAL_CRANDOMTRANDOM_H_INCLUDED
-
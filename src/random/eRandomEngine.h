@@ -0,0 +1,57 @@
+#ifndef PWX_LIBPWX_PWX_TYPES_ERANDOMENGINE_H_INCLUDED
+#define PWX_LIBPWX_PWX_TYPES_ERANDOMENGINE_H_INCLUDED 1
+#pragma once
+
+/** @file eRandomEngine.h
+  *
+  * @brief Selection of the engine behind CRandom::random()
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include "basic/compiler.h"
+
+
+namespace pwx {
+
+
+/** @brief [R]andom [E]ngine enum with RE_<engine>
+  * Note: Every thread has its own instance of each engine, seeded
+  *       from std::random_device when the thread first needs one.
+**/
+enum eRandomEngine {
+	RE_XOSHIRO256SS = 0, // xoshiro256** by Blackman and Vigna, the default
+	RE_PCG64        = 1, // PCG XSL-RR 128/64 by O'Neill
+	RE_SPLITMIX64   = 2, // SplitMix64 by Steele, Lea and Flood
+	RE_NUM_ENGINES  = 3  // End-of-list marker! No valid engine!
+};
+
+} // namespace pwx
+
+#endif // PWX_LIBPWX_PWX_TYPES_ERANDOMENGINE_H_INCLUDED
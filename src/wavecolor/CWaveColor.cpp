@@ -34,6 +34,7 @@
 #include "basic/macros.h"
 #include "basic/debug.h"
 
+#include "basic/CLockGuard.h"
 #include "wavecolor/CWaveColor.h"
 
 
@@ -32,7 +32,9 @@
 
 
 #include <PChainHash>
+#include <PFlatHash>
 #include <POpenHash>
+#include <PSwissHash>
 #include <PStreamHelpers>
 #include <PStringUtils>
 #include <RNG>
@@ -43,8 +45,11 @@ typedef pwx::CAdjRight adjRight;
 typedef std::chrono::high_resolution_clock             hrClock;
 typedef std::chrono::high_resolution_clock::time_point hrTime_t;
 using std::chrono::duration_cast;
+using std::chrono::microseconds;
 using std::chrono::milliseconds;
 
+#include <iomanip>
+
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -54,15 +59,187 @@ using std::endl;
 #include <string>
 using std::string;
 
+#include <vector>
+
 #include <unistd.h>
 using std::ofstream;
 
 
+/// @internal The benchmark stores no real data
+static void no_destroy( char* ) { }
+
+
+/// @internal insert all @a keys into @a hash, look up all @a keys and @a misses and print the times
+template< typename hash_t >
+static int32_t bench_hash( hash_t &hash, const char* name, std::vector< uint32_t > &keys, std::vector< uint32_t > &misses ) {
+	static char storeVal = 0x20;
+	uint32_t    cnt      = static_cast<uint32_t>( keys.size() );
+
+	hrTime_t tStart = hrClock::now();
+	for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+		hash.add( keys[i], &storeVal );
+	}
+	hrTime_t tInsert = hrClock::now();
+
+	uint32_t found = 0;
+	for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+		if ( hash.exists( keys[i] ) ) ++found;
+		if ( hash.exists( misses[i] ) ) ++found;
+	}
+	hrTime_t tLookup = hrClock::now();
+
+	// Every key must be found, and no missing key
+	if ( found != cnt ) {
+		cerr << "\nERROR: " << name << " found " << found << " of " << cnt << " keys" << endl;
+		return EXIT_FAILURE;
+	}
+
+	double hops = 0.;
+	for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+		hops += hash.getHops( keys[i] );
+	}
+
+	cout << name << " | " << std::setw( 8 ) << hash.sizeMax();
+	cout << " | " << std::setw( 10 ) << duration_cast< microseconds >( tInsert - tStart ).count();
+	cout << " | " << std::setw( 10 ) << duration_cast< microseconds >( tLookup - tInsert ).count();
+	cout << " | " << std::fixed << std::setprecision( 3 ) << ( cnt ? hops / cnt : 0. ) << endl;
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal look up all @a lookups in @a hash one by one and with exists_many() in batches of 256
+template< typename hash_t >
+static int32_t bench_batch( hash_t &hash, const char* name, std::vector< uint32_t > &lookups ) {
+	static const uint32_t batchSize = 256;
+	uint32_t              cnt       = static_cast<uint32_t>( lookups.size() );
+	bool                  found[batchSize];
+
+	hrTime_t tStart = hrClock::now();
+	uint32_t single = 0;
+	for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+		if ( hash.exists( lookups[i] ) ) ++single;
+	}
+	hrTime_t tSingle = hrClock::now();
+
+	uint32_t batched = 0;
+	for ( uint32_t i = 0 ; i < cnt ; i += batchSize ) {
+		batched += hash.exists_many( &lookups[i], std::min( batchSize, cnt - i ), found );
+	}
+	hrTime_t tBatched = hrClock::now();
+
+	if ( single != batched ) {
+		cerr << "\nERROR: " << name << " found " << single << " keys one by one, but " << batched << " batched" << endl;
+		return EXIT_FAILURE;
+	}
+
+	auto usSingle  = duration_cast< microseconds >( tSingle - tStart ).count();
+	auto usBatched = duration_cast< microseconds >( tBatched - tSingle ).count();
+	cout << name << " | " << std::setw( 10 ) << usSingle;
+	cout << " | " << std::setw( 10 ) << usBatched;
+	cout << " | " << std::fixed << std::setprecision( 2 ) << ( usBatched ? static_cast<double>( usSingle ) / usBatched : 0. ) << endl;
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal compare insertion and lookup speed of the open hash modes, the swiss hash and the flat hash
+static int32_t bench_open_modes( int32_t cnt_ ) {
+	typedef POpenHash< uint32_t, char >  o_hash_t; //!< Type of the open hash
+	typedef PSwissHash< uint32_t, char > s_hash_t; //!< Type of the swiss hash
+	typedef PFlatHash< uint32_t, char >  f_hash_t; //!< Type of the flat hash
+
+	static const pwx::eOpenHashMode modes[3] = { pwx::OHM_DoubleHash, pwx::OHM_PowerLinear, pwx::OHM_PowerQuadratic };
+	static const char* modeNames[3] = { "double hash   ", "pow2 linear   ", "pow2 quadratic" };
+
+	int32_t  result = EXIT_SUCCESS;
+	uint32_t cnt    = static_cast<uint32_t>( cnt_ );
+
+	// The same keys for all modes. Every second lookup misses.
+	std::vector< uint32_t > keys( cnt );
+	std::vector< uint32_t > misses( cnt );
+	for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+		keys[i]   = RNG.random( static_cast<uint32_t>( 0 ), static_cast<uint32_t>( 0x7fffffff ) );
+		misses[i] = RNG.random( static_cast<uint32_t>( 0x80000000 ), std::numeric_limits< uint32_t >::max() );
+	}
+
+	cout << "Comparing open hash modes with " << cnt << " uint32_t keys, max load 0.8:" << endl;
+	cout << "Mode           | Size     | insert us  | lookup us  | avg hops" << endl;
+	cout << "---------------+----------+------------+------------+---------" << endl;
+
+	for ( int32_t m = 0 ; ( EXIT_SUCCESS == result ) && ( m < 3 ) ; ++m ) {
+		o_hash_t hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr, 0.8, 1.5, modes[m] );
+		result = bench_hash( hash, modeNames[m], keys, misses );
+	}
+
+	// The swiss hash counts probed groups of 16 as hops
+	if ( EXIT_SUCCESS == result ) {
+		s_hash_t hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr );
+		result = bench_hash( hash, "swiss groups  ", keys, misses );
+	}
+
+	if ( EXIT_SUCCESS == result ) {
+		f_hash_t hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr );
+		result = bench_hash( hash, "flat inline   ", keys, misses );
+	}
+
+	// The pow2 modes rely on the hash quality, so compare them with a mixing policy
+	if ( EXIT_SUCCESS == result ) {
+		POpenHash< uint32_t, char, pwx::THashElement< uint32_t, char >, pwx::CHashPolicyWy >
+		hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr, 0.8, 1.5, pwx::OHM_PowerLinear );
+		result = bench_hash( hash, "pow2 lin. wy  ", keys, misses );
+	}
+
+	if ( EXIT_SUCCESS == result ) {
+		PSwissHash< uint32_t, char, pwx::THashElement< uint32_t, char >, pwx::CHashPolicyWy >
+		hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr );
+		result = bench_hash( hash, "swiss wyhash  ", keys, misses );
+	}
+
+	if ( EXIT_SUCCESS == result ) {
+		PFlatHash< uint32_t, char, pwx::CHashPolicyWy > hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr );
+		result = bench_hash( hash, "flat wyhash   ", keys, misses );
+	}
+
+	// Batched lookups, keys and misses interleaved
+	static char             storeVal = 0x20;
+	std::vector< uint32_t > lookups( cnt * 2 );
+	for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+		lookups[i * 2]     = keys[i];
+		lookups[i * 2 + 1] = misses[i];
+	}
+
+	if ( EXIT_SUCCESS == result ) {
+		cout << "\nComparing single and batched lookups of " << cnt * 2 << " keys:" << endl;
+		cout << "Mode           | single us  | batched us | speedup" << endl;
+		cout << "---------------+------------+------------+--------" << endl;
+	}
+
+	for ( int32_t m = 0 ; ( EXIT_SUCCESS == result ) && ( m < 3 ) ; ++m ) {
+		o_hash_t hash( static_cast<uint32_t>( cnt / 0.8 ) + 3, no_destroy, nullptr, 0.8, 1.5, modes[m] );
+		for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+			hash.add( keys[i], &storeVal );
+		}
+		result = bench_batch( hash, modeNames[m], lookups );
+	}
+
+	if ( EXIT_SUCCESS == result ) {
+		PChainHash< uint32_t, char > hash( static_cast<uint32_t>( cnt / 3.0 ) + 3, no_destroy, nullptr, 3.0, 1.25 );
+		for ( uint32_t i = 0 ; i < cnt ; ++i ) {
+			hash.add( keys[i], &storeVal );
+		}
+		result = bench_batch( hash, "chained       ", lookups );
+	}
+
+	return result;
+}
+
+
 /// @internal build a numerical hash list
-template< typename T >
+template< typename T, typename policy_t >
 int32_t build_cluster_num( string &outfile_chain, string &outfile_open, int32_t cnt_, bool useBigHash ) {
-	typedef PChainHash< T, char > c_hash_t; //!< Type of the chained hash
-	typedef POpenHash< T, char >  o_hash_t; //!< Type of the open hash
+	typedef PChainHash< T, char, pwx::THashElement< T, char >, policy_t > c_hash_t; //!< Type of the chained hash
+	typedef POpenHash< T, char, pwx::THashElement< T, char >, policy_t >  o_hash_t; //!< Type of the open hash
 
 	static char hopBuf[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
@@ -166,9 +343,10 @@ int32_t build_cluster_num( string &outfile_chain, string &outfile_open, int32_t
 
 
 /// @internal build a string based cluster list
+template< typename policy_t >
 static int32_t build_cluster_string( string &outfile_chain, string &outfile_open, int32_t cnt_, bool useBigHash ) {
-	typedef PChainHash< string, char > c_hash_t; //!< Type of the chained hash
-	typedef POpenHash< string, char >  o_hash_t; //!< Type of the open hash
+	typedef PChainHash< string, char, pwx::THashElement< string, char >, policy_t > c_hash_t; //!< Type of the chained hash
+	typedef POpenHash< string, char, pwx::THashElement< string, char >, policy_t >  o_hash_t; //!< Type of the open hash
 
 	static char hopBuf[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
@@ -240,19 +418,115 @@ static int32_t build_cluster_string( string &outfile_chain, string &outfile_open
 }
 
 
+/// @internal build the cluster lists of all types selected by @a hash_type using the hash policy @a policy_t
+template< typename policy_t >
+static int32_t build_clusters( string const& destdir, string const& tag, int32_t hash_type, int32_t argMax, bool useBigHash ) {
+	int32_t result = EXIT_SUCCESS;
+	string  destfile_chain, destfile_open;
+
+	// --- int16_t ---
+	//-----------------
+	if ( hash_type & 4 ) {
+		destfile_chain = destdir + "/cluster_int16_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_int16_open" + tag + ".csv";
+		result         = build_cluster_num< int16_t, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- uint16_t ---
+	//------------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
+		destfile_chain = destdir + "/cluster_uint16_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_uint16_open" + tag + ".csv";
+		result         = build_cluster_num< uint16_t, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- int32_t ---
+	//-----------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
+		destfile_chain = destdir + "/cluster_int32_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_int32_open" + tag + ".csv";
+		result         = build_cluster_num< int32_t, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- uint32_t ---
+	//------------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
+		destfile_chain = destdir + "/cluster_uint32_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_uint32_open" + tag + ".csv";
+		result         = build_cluster_num< uint32_t, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- int64_t ---
+	//-----------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
+		destfile_chain = destdir + "/cluster_int64_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_int64_open" + tag + ".csv";
+		result         = build_cluster_num< int64_t, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- uint64_t ---
+	//------------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
+		destfile_chain = destdir + "/cluster_uint64_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_uint64_open" + tag + ".csv";
+		result         = build_cluster_num< uint64_t, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- float ---
+	//---------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 2 ) ) {
+		destfile_chain = destdir + "/cluster_float_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_float_open" + tag + ".csv";
+		result         = build_cluster_num< float, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- double ---
+	//----------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 2 ) ) {
+		destfile_chain = destdir + "/cluster_double_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_double_open" + tag + ".csv";
+		result         = build_cluster_num< double, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- long double ---
+	//---------------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 2 ) ) {
+		destfile_chain = destdir + "/cluster_long_double_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_long_double_open" + tag + ".csv";
+		result         = build_cluster_num< long double, policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	// --- string ---
+	//---------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 1 ) ) {
+		destfile_chain = destdir + "/cluster_string_chain" + tag + ".csv";
+		destfile_open  = destdir + "/cluster_string_open" + tag + ".csv";
+		result         = build_cluster_string< policy_t >( destfile_chain, destfile_open, argMax, useBigHash );
+	}
+
+	return result;
+}
+
+
 int32_t main( int32_t argc, char** argv ) {
 	int32_t result = EXIT_SUCCESS;
 
 	pwx::init( true, nullptr, 0 );
 
-	if ( ( argc < 3 ) || ( argc > 5 ) ) {
+	if ( ( argc < 3 ) || ( argc > 6 ) ) {
 		cerr << "Usage:\n  " << basename( argv[0] )
-		     << " <destination directory> <number of hashes> [type] [bighash]\n"
+		     << " <destination directory> <number of hashes> [type] [policy] [bighash]\n"
 		     << " type is one of:\n"
 		     << "   all   : build cluster lists for all key types (default)\n"
 		     << "   string: build the cluster list for string keys\n"
 		     << "   float : build cluster lists for float, double and long double keys\n"
 		     << "   int   : build cluster lists for [u]int16_t to [u]int64_t keys\n"
+		     << "   bench : compare the open hash index modes and the swiss hash, no files are written\n"
+		     << "\n policy is one of:\n"
+		     << "   rng     : hash keys with CHashPolicyRNG (default)\n"
+		     << "   wy      : hash keys with CHashPolicyWy, the files get a \"_wy\" suffix\n"
+		     << "   xx      : hash keys with CHashPolicyXX, the files get a \"_xx\" suffix\n"
+		     << "   policies: build the cluster lists with all three policies\n"
 		     << "\n bighash:\n"
 		     << "If this keyword is seen the hash tables are initialized with ten\n"
 		     << "times the number of hashes to build. This is useful to detect\n"
@@ -284,118 +558,61 @@ int32_t main( int32_t argc, char** argv ) {
 		return EXIT_FAILURE;
 	}
 
-	// Set the type and check optional third argument
+	// Check the optional arguments, which can be given in any order
 	int32_t hash_type  = 7; // this is all
+	int32_t policies   = 1; // Only the RNG policy by default
 	bool    useBigHash = false; // Never by default
-	if ( argc >= 4 ) {
-		string hType = argv[3];
-		if ( hType != "string" ) {
+	for ( int32_t a = 3 ; a < argc ; ++a ) {
+		string arg = argv[a];
+		if ( arg == "string" ) {
 			hash_type = 1;
-		} else if ( hType != "float" ) {
+		} else if ( arg == "float" ) {
 			hash_type = 2;
-		} else if ( hType != "int" ) {
+		} else if ( arg == "int" ) {
 			hash_type = 4;
-		} else if ( hType != "bighash" ) {
+		} else if ( arg == "bench" ) {
+			hash_type = 8;
+		} else if ( arg == "all" ) {
+			hash_type = 7;
+		} else if ( arg == "rng" ) {
+			policies = 1;
+		} else if ( arg == "wy" ) {
+			policies = 2;
+		} else if ( arg == "xx" ) {
+			policies = 4;
+		} else if ( arg == "policies" ) {
+			policies = 7;
+		} else if ( STRCEQ( argv[a], "bighash" ) ) {
 			useBigHash = true;
-		} else if ( hType != "all" ) {
-			cerr << "Hash type \"" << hType << "\" is unknown." << endl;
+		} else {
+			cerr << "Option \"" << arg << "\" is unknown." << endl;
 			return EXIT_FAILURE;
 		}
 	}
 
-	// Check whether a fourth argument enables bighash
-	if ( argc >= 5 ) {
-		if ( STRCEQ( argv[4], "bighash" ) ) {
-			useBigHash = true;
-		} else {
-			cerr << "Option \"" << argv[4] << "\" is unknown." << endl;
-			return EXIT_FAILURE;
+	if ( 8 == hash_type ) {
+		try {
+			result = bench_open_modes( argMax );
+		} catch ( pwx::CException &e ) {
+			cerr << "\n-----\npwx exception \"" << e.name() << "\" caught!" << endl;
+			cerr << "What : \"" << e.what() << "\"" << endl;
+			result = EXIT_FAILURE;
 		}
+		pwx::finish();
+		return result;
 	}
 
 	cout << "Building cluster lists in \"" << destdir << "\"." << endl;
 
 	try {
-		string destfile_chain, destfile_open;
-
-		// --- int16_t ---
-		//-----------------
-		if ( hash_type & 4 ) {
-			destfile_chain = destdir + "/cluster_int16_chain.csv";
-			destfile_open  = destdir + "/cluster_int16_open.csv";
-			result         = build_cluster_num< int16_t >( destfile_chain, destfile_open, argMax, useBigHash );
+		if ( policies & 1 ) {
+			result = build_clusters< pwx::CHashPolicyRNG >( destdir, "", hash_type, argMax, useBigHash );
 		}
-
-		// --- uint16_t ---
-		//------------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
-			destfile_chain = destdir + "/cluster_uint16_chain.csv";
-			destfile_open  = destdir + "/cluster_uint16_open.csv";
-			result         = build_cluster_num< uint16_t >( destfile_chain, destfile_open, argMax, useBigHash );
+		if ( ( EXIT_SUCCESS == result ) && ( policies & 2 ) ) {
+			result = build_clusters< pwx::CHashPolicyWy >( destdir, "_wy", hash_type, argMax, useBigHash );
 		}
-
-		// --- int32_t ---
-		//-----------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
-			destfile_chain = destdir + "/cluster_int32_chain.csv";
-			destfile_open  = destdir + "/cluster_int32_open.csv";
-			result         = build_cluster_num< int32_t >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- uint32_t ---
-		//------------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
-			destfile_chain = destdir + "/cluster_uint32_chain.csv";
-			destfile_open  = destdir + "/cluster_uint32_open.csv";
-			result         = build_cluster_num< uint32_t >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- int64_t ---
-		//-----------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
-			destfile_chain = destdir + "/cluster_int64_chain.csv";
-			destfile_open  = destdir + "/cluster_int64_open.csv";
-			result         = build_cluster_num< int64_t >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- uint64_t ---
-		//------------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 4 ) ) {
-			destfile_chain = destdir + "/cluster_uint64_chain.csv";
-			destfile_open  = destdir + "/cluster_uint64_open.csv";
-			result         = build_cluster_num< uint64_t >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- float ---
-		//---------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 2 ) ) {
-			destfile_chain = destdir + "/cluster_float_chain.csv";
-			destfile_open  = destdir + "/cluster_float_open.csv";
-			result         = build_cluster_num< float >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- double ---
-		//----------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 2 ) ) {
-			destfile_chain = destdir + "/cluster_double_chain.csv";
-			destfile_open  = destdir + "/cluster_double_open.csv";
-			result         = build_cluster_num< double >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- long double ---
-		//---------------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 2 ) ) {
-			destfile_chain = destdir + "/cluster_long_double_chain.csv";
-			destfile_open  = destdir + "/cluster_long_double_open.csv";
-			result         = build_cluster_num< long double >( destfile_chain, destfile_open, argMax, useBigHash );
-		}
-
-		// --- string ---
-		//---------------
-		if ( ( EXIT_SUCCESS == result ) && ( hash_type & 1 ) ) {
-			destfile_chain = destdir + "/cluster_string_chain.csv";
-			destfile_open  = destdir + "/cluster_string_open.csv";
-			result         = build_cluster_string( destfile_chain, destfile_open, argMax, useBigHash );
+		if ( ( EXIT_SUCCESS == result ) && ( policies & 4 ) ) {
+			result = build_clusters< pwx::CHashPolicyXX >( destdir, "_xx", hash_type, argMax, useBigHash );
 		}
 
 		// End of giant try
@@ -42,6 +42,10 @@ typedef std::chrono::high_resolution_clock             hrClock;
 typedef std::chrono::high_resolution_clock::time_point hrTime_t;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+#include <algorithm>
+#include <iomanip>
 
 #include <iostream>
 using std::cout;
@@ -52,6 +56,8 @@ using std::endl;
 #include <string>
 using std::string;
 
+#include <vector>
+
 #include <unistd.h>
 using std::ofstream;
 
@@ -211,6 +217,123 @@ static int32_t build_hash_list_char( string &outfile, int32_t cnt_ ) {
 }
 
 
+/// @internal Hash all C-String @a keys with @a builder into @a hashes, return the used nanoseconds
+template< typename builder_t >
+static int64_t hash_strings( builder_t &builder, std::vector< string > &keys, std::vector< uint32_t > &hashes ) {
+	size_t   cnt    = keys.size();
+	hrTime_t tStart = hrClock::now();
+	for ( size_t i = 0 ; i < cnt ; ++i ) {
+		hashes[i] = builder( keys[i].c_str() );
+	}
+	return duration_cast< nanoseconds >( hrClock::now() - tStart ).count();
+}
+
+
+/// @internal Hash all numerical @a keys with @a builder into @a hashes, return the used nanoseconds
+template< typename builder_t, typename T >
+static int64_t hash_nums( builder_t &builder, std::vector< T > &keys, std::vector< uint32_t > &hashes ) {
+	size_t   cnt    = keys.size();
+	hrTime_t tStart = hrClock::now();
+	for ( size_t i = 0 ; i < cnt ; ++i ) {
+		hashes[i] = builder( &keys[i] );
+	}
+	return duration_cast< nanoseconds >( hrClock::now() - tStart ).count();
+}
+
+
+/** @internal print throughput and distribution quality of @a hashes
+  *
+  * The collisions are the number of hashes that are equal to another one.
+  * The chi-square value is taken over the lowest bits, with about 16 keys
+  * per bucket, and divided by the degrees of freedom. It should be close
+  * to 1.0, much larger values mean the hash clusters.
+**/
+static void print_quality( const char* policy, const char* keyName, size_t bytes, int64_t nsecs,
+                           std::vector< uint32_t > hashes ) {
+	size_t   cnt     = hashes.size();
+	uint32_t buckets = 1;
+	while ( buckets < ( cnt / 16 ) ) buckets <<= 1;
+
+	std::vector< uint32_t > counts( buckets, 0 );
+	for ( size_t i = 0 ; i < cnt ; ++i ) {
+		++counts[hashes[i] & ( buckets - 1 )];
+	}
+
+	double expected = static_cast<double>( cnt ) / buckets;
+	double chiSq    = 0.;
+	for ( uint32_t i = 0 ; i < buckets ; ++i ) {
+		double diff = counts[i] - expected;
+		chiSq += diff * diff / expected;
+	}
+
+	std::sort( hashes.begin(), hashes.end() );
+	size_t collisions = 0;
+	for ( size_t i = 1 ; i < cnt ; ++i ) {
+		if ( hashes[i] == hashes[i - 1] ) ++collisions;
+	}
+
+	cout << policy << " | " << keyName;
+	cout << " | " << std::setw( 7 ) << std::fixed << std::setprecision( 3 );
+	cout << ( nsecs > 0 ? static_cast<double>( bytes ) / static_cast<double>( nsecs ) : 0. );
+	cout << " | " << std::setw( 10 ) << collisions;
+	cout << " | " << std::setw( 7 ) << ( buckets > 1 ? chiSq / ( buckets - 1 ) : 0. ) << endl;
+}
+
+
+/// @internal hash all key sets with the policy of @a builder_t
+template< typename builder_t >
+static void bench_policy( const char* policy, std::vector< string > &shortKeys, std::vector< string > &longKeys,
+                          std::vector< uint32_t > &intKeys, std::vector< uint64_t > &longIntKeys ) {
+	builder_t               builder;
+	size_t                  cnt = shortKeys.size();
+	std::vector< uint32_t > hashes( cnt );
+	int64_t                 nsecs;
+
+	nsecs = hash_strings( builder, shortKeys, hashes );
+	print_quality( policy, "16 byte strings ", cnt * 16, nsecs, hashes );
+
+	nsecs = hash_strings( builder, longKeys, hashes );
+	print_quality( policy, "128 byte strings", cnt * 128, nsecs, hashes );
+
+	nsecs = hash_nums( builder, intKeys, hashes );
+	print_quality( policy, "uint32_t 0..n   ", cnt * sizeof( uint32_t ), nsecs, hashes );
+
+	nsecs = hash_nums( builder, longIntKeys, hashes );
+	print_quality( policy, "uint64_t n << 32", cnt * sizeof( uint64_t ), nsecs, hashes );
+}
+
+
+/// @internal compare throughput and distribution of the CHashBuilder policies
+static int32_t bench_policies( int32_t cnt_ ) {
+	size_t cnt = static_cast<size_t>( cnt_ );
+
+	std::vector< string >   shortKeys( cnt );
+	std::vector< string >   longKeys( cnt );
+	std::vector< uint32_t > intKeys( cnt );
+	std::vector< uint64_t > longIntKeys( cnt );
+
+	char randVal[129];
+	for ( size_t i = 0 ; i < cnt ; ++i ) {
+		RNG.random( randVal, 17, 17 );
+		shortKeys[i] = randVal;
+		RNG.random( randVal, 129, 129 );
+		longKeys[i]    = randVal;
+		intKeys[i]     = static_cast<uint32_t>( i );
+		longIntKeys[i] = static_cast<uint64_t>( i ) << 32;
+	}
+
+	cout << "Comparing hash policies with " << cnt << " keys each:" << endl;
+	cout << "Policy | Keys             | GB/s    | collisions | chi2/df" << endl;
+	cout << "-------+------------------+---------+------------+--------" << endl;
+
+	bench_policy< pwx::THashBuilder< pwx::CHashPolicyRNG > >( "RNG   ", shortKeys, longKeys, intKeys, longIntKeys );
+	bench_policy< pwx::THashBuilder< pwx::CHashPolicyWy > >(  "wyhash", shortKeys, longKeys, intKeys, longIntKeys );
+	bench_policy< pwx::THashBuilder< pwx::CHashPolicyXX > >(  "xxh3  ", shortKeys, longKeys, intKeys, longIntKeys );
+
+	return EXIT_SUCCESS;
+}
+
+
 int32_t main( int32_t argc, char** argv ) {
 	int32_t result = EXIT_SUCCESS;
 
@@ -222,7 +345,8 @@ int32_t main( int32_t argc, char** argv ) {
 		cerr << "   all   : build hash lists for all types (default)\n";
 		cerr << "   char  : build the hash list for char* strings\n";
 		cerr << "   float : build hash lists for float, double and long double\n";
-		cerr << "   int   : build hash lists for [u]int16_t to [u]int64_t" << endl;
+		cerr << "   int   : build hash lists for [u]int16_t to [u]int64_t\n";
+		cerr << "   bench : compare throughput and distribution of the hash policies" << endl;
 		return EXIT_FAILURE;
 	}
 
@@ -254,12 +378,14 @@ int32_t main( int32_t argc, char** argv ) {
 	int32_t hash_type = 7; // this is all
 	if ( argc == 4 ) {
 		string hType = argv[3];
-		if ( hType != "char" ) {
+		if ( hType == "char" ) {
 			hash_type = 1;
-		} else if ( hType != "float" ) {
+		} else if ( hType == "float" ) {
 			hash_type = 2;
-		} else if ( hType != "int" ) {
+		} else if ( hType == "int" ) {
 			hash_type = 4;
+		} else if ( hType == "bench" ) {
+			hash_type = 8;
 		} else if ( hType != "all" ) {
 			cerr << "Hash type \"" << hType << "\" is unknown." << endl;
 			return EXIT_FAILURE;
@@ -339,6 +465,12 @@ int32_t main( int32_t argc, char** argv ) {
 		result   = build_hash_list_char( destfile, argMax );
 	}
 
+	// --- policies ---
+	//------------------
+	if ( ( EXIT_SUCCESS == result ) && ( hash_type & 8 ) ) {
+		result = bench_policies( argMax );
+	}
+
 	pwx::finish();
 
 	return result;
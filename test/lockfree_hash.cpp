@@ -0,0 +1,234 @@
+/** @file lockfree_hash.cpp
+  *
+  * @brief Throughput comparison of TLockFreeHash and TOpenHash
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PLockFreeHash>
+#include <POpenHash>
+#include <PStreamHelpers>
+
+#include <atomic>
+#include <chrono>
+typedef std::chrono::high_resolution_clock             hrClock;
+typedef std::chrono::high_resolution_clock::time_point hrTime_t;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+#include <iomanip>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <thread>
+#include <vector>
+
+#include <libgen.h>
+
+
+typedef PLockFreeHash< uint32_t, uint32_t > lf_hash_t; //!< Type of the lock-free hash
+typedef POpenHash< uint32_t, uint32_t >     o_hash_t;  //!< Type of the open hash
+
+
+/// @internal The stored data points into this vector, so allocations do not distort the results
+static std::vector< uint32_t > values;
+
+
+/// @internal The data is owned by `values`, nothing to destroy
+static void no_destroy( uint32_t* ) { }
+
+
+/// @internal Shuffle the key space, so neighbouring keys do not end up in neighbouring buckets
+static uint32_t make_key( uint32_t nr ) {
+	return nr * 2654435761U + 1;
+}
+
+
+/// @internal Simple per thread xorshift generator, so the RNG does not dominate the results
+static uint32_t next_rand( uint32_t &state ) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+
+/// @internal Let @a numThreads threads run @a func( threadNr ), return the used microseconds
+template< typename func_t >
+static int64_t run_threads( uint32_t numThreads, func_t func ) {
+	std::vector< std::thread > threads;
+	std::atomic_bool           go( false );
+
+	for ( uint32_t nr = 0 ; nr < numThreads ; ++nr ) {
+		threads.emplace_back( [ &go, &func, nr ]() {
+			while ( !go.load() )
+				std::this_thread::yield();
+			func( nr );
+		} );
+	}
+
+	hrTime_t tStart = hrClock::now();
+	go.store( true );
+	for ( auto &thr : threads )
+		thr.join();
+	hrTime_t tEnd = hrClock::now();
+
+	return duration_cast< microseconds >( tEnd - tStart ).count();
+}
+
+
+/// @internal Fill @a hash with @a numKeys keys using @a numThreads threads
+template< typename hash_t >
+static int64_t bench_insert( hash_t &hash, uint32_t numKeys, uint32_t numThreads ) {
+	return run_threads( numThreads, [ &hash, numKeys, numThreads ]( uint32_t nr ) {
+		for ( uint32_t i = nr ; i < numKeys ; i += numThreads )
+			hash.add( make_key( i ), &values[i] );
+	} );
+}
+
+
+/// @internal Look up @a numKeys random keys, one in eight missing, using @a numThreads threads
+template< typename hash_t >
+static int64_t bench_lookup( hash_t &hash, uint32_t numKeys, uint32_t numThreads, std::atomic_uint &found ) {
+	return run_threads( numThreads, [ &hash, &found, numKeys, numThreads ]( uint32_t nr ) {
+		uint32_t state = 0x9e3779b9 ^ ( nr + 1 );
+		uint32_t hits  = 0;
+		for ( uint32_t i = nr ; i < numKeys ; i += numThreads ) {
+			uint32_t key = make_key( next_rand( state ) % ( numKeys + numKeys / 8 ) );
+			if ( hash.exists( key ) )
+				++hits;
+		}
+		found.fetch_add( hits );
+	} );
+}
+
+
+/// @internal Mixed workload on the lock-free hash: 80% get, 10% add, 10% delKey
+static int64_t bench_mixed( lf_hash_t &hash, uint32_t numKeys, uint32_t numThreads ) {
+	return run_threads( numThreads, [ &hash, numKeys, numThreads ]( uint32_t nr ) {
+		uint32_t state = 0x85ebca6b ^ ( nr + 1 );
+		for ( uint32_t i = nr ; i < numKeys ; i += numThreads ) {
+			uint32_t rnd = next_rand( state );
+			uint32_t nr_ = rnd % ( numKeys * 2 );
+			uint32_t key = make_key( nr_ );
+			uint32_t op  = ( rnd >> 24 ) % 10;
+
+			if ( op == 0 )
+				hash.add( key, &values[nr_] );
+			else if ( op == 1 )
+				hash.delKey( key );
+			else
+				( void )hash.get( key );
+		}
+	} );
+}
+
+
+/// @internal Return million operations per second
+static double mops( uint32_t ops, int64_t usecs ) {
+	return usecs > 0 ? static_cast<double>( ops ) / static_cast<double>( usecs ) : 0.;
+}
+
+
+int32_t main( int32_t argc, char** argv ) {
+	int32_t result = EXIT_SUCCESS;
+
+	if ( ( argc < 2 ) || ( argc > 3 ) ) {
+		cerr << "Usage:\n  " << basename( argv[0] ) << " <number of keys> [max threads]\n";
+		cerr << " The thread count starts with 1 and is doubled until max threads (default: 64)" << endl;
+		return EXIT_FAILURE;
+	}
+
+	int32_t numKeys = pwx::to_int32( argv[1] );
+	if ( numKeys <= 0 ) {
+		cerr << "Number \"" << argv[1] << "\" is no legal number (" << numKeys << ")" << endl;
+		return EXIT_FAILURE;
+	}
+
+	int32_t maxThreads = argc == 3 ? pwx::to_int32( argv[2] ) : 64;
+	if ( ( maxThreads < 1 ) || ( maxThreads > 1024 ) ) {
+		cerr << "Thread count \"" << argv[2] << "\" must be between 1 and 1024" << endl;
+		return EXIT_FAILURE;
+	}
+
+	pwx::init( true, nullptr, 0 );
+
+	uint32_t keys = static_cast<uint32_t>( numKeys );
+	values.resize( keys * 2 );
+	for ( uint32_t i = 0 ; i < keys * 2 ; ++i )
+		values[i] = i;
+
+	cout << "Throughput in million operations per second, " << keys << " keys." << endl;
+	cout << "The lock-free hash starts with 128 buckets, the open hash is presized.\n" << endl;
+	cout << "Threads | LF insert | Open insert | LF lookup | Open lookup | LF mixed" << endl;
+	cout << "--------+-----------+-------------+-----------+-------------+---------" << endl;
+	cout << std::fixed << std::setprecision( 3 );
+
+	for ( uint32_t numThreads = 1 ; ( EXIT_SUCCESS == result )
+	                                && ( numThreads <= static_cast<uint32_t>( maxThreads ) ) ; numThreads *= 2 ) {
+		lf_hash_t        lf_hash( 128, no_destroy, nullptr, 0, 0.6 );
+		o_hash_t         o_hash( static_cast<uint32_t>( keys / 0.8 ) + 3, no_destroy, nullptr, 0.8, 1.5 );
+		std::atomic_uint lf_found( 0 );
+		std::atomic_uint o_found( 0 );
+
+		int64_t lf_ins = bench_insert( lf_hash, keys, numThreads );
+		int64_t o_ins  = bench_insert( o_hash, keys, numThreads );
+		int64_t lf_lkp = bench_lookup( lf_hash, keys, numThreads, lf_found );
+		int64_t o_lkp  = bench_lookup( o_hash, keys, numThreads, o_found );
+
+		// Both containers must agree before the contents get mangled
+		if ( ( lf_hash.size() != keys ) || ( o_hash.size() != keys ) || ( lf_found != o_found ) ) {
+			cerr << "\nERROR: sizes " << lf_hash.size() << " / " << o_hash.size() << " (expected " << keys;
+			cerr << "), hits " << lf_found.load() << " / " << o_found.load() << endl;
+			result = EXIT_FAILURE;
+		}
+		for ( uint32_t i = 0 ; ( EXIT_SUCCESS == result ) && ( i < keys ) ; ++i ) {
+			uint32_t* data = lf_hash.get( make_key( i ) );
+			if ( !data || ( *data != i ) ) {
+				cerr << "\nERROR: key number " << i << " is missing or has wrong data" << endl;
+				result = EXIT_FAILURE;
+			}
+		}
+
+		int64_t lf_mix = bench_mixed( lf_hash, keys, numThreads );
+
+		cout << std::setw( 7 ) << numThreads;
+		cout << " | " << std::setw( 9 ) << mops( keys, lf_ins );
+		cout << " | " << std::setw( 11 ) << mops( keys, o_ins );
+		cout << " | " << std::setw( 9 ) << mops( keys, lf_lkp );
+		cout << " | " << std::setw( 11 ) << mops( keys, o_lkp );
+		cout << " | " << std::setw( 8 ) << mops( keys, lf_mix ) << endl;
+	}
+
+	pwx::finish();
+
+	return result;
+}
@@ -0,0 +1,253 @@
+/** @file noise_map.cpp
+  *
+  * @brief Throughput of the simplex noise map generator of CRandom
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * Permission is hereby granted, free of charge, to any person obtaining a copy
+  * of this software and associated documentation files (the "Software"), to deal
+  * in the Software without restriction, including without limitation the rights
+  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  * copies of the Software, and to permit persons to whom the Software is
+  * furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in all
+  * copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  * SOFTWARE.
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PRandom>
+#include <PStreamHelpers>
+#include <RNG>
+using pwx::RNG;
+
+#include <chrono>
+typedef std::chrono::high_resolution_clock             hrClock;
+typedef std::chrono::high_resolution_clock::time_point hrTime_t;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+#include <iomanip>
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include <libgen.h>
+
+
+// The map parameters, a typical terrain setup
+static const double   mapZoom      = 256.;  //!< Zoom of the first wave
+static const double   mapSmooth    = 1.;    //!< Smoothing of the first wave
+static const double   mapReduction = 1.5;   //!< Smoothing multiplier per wave
+static const int32_t  mapWaves     = 4;     //!< Number of waves
+static const uint32_t mapDepth     = 4;     //!< Number of layers of the 3D map
+
+
+/// @internal Return the microseconds @a func() needs
+template< typename func_t >
+static int64_t measure( func_t func ) {
+	hrTime_t tStart = hrClock::now();
+	func();
+	hrTime_t tEnd = hrClock::now();
+
+	return duration_cast< microseconds >( tEnd - tStart ).count();
+}
+
+
+/// @internal Largest difference allowed between the AVX2 kernels and simplex2D()/simplex3D()
+static const double   maxAvxDiff   = 8. * DBL_EPSILON;
+
+
+/** @internal Compare a grid of @a width x @a height x @a depth points with simplex2D() or simplex3D()
+  *
+  * The grid starts at the origin with a step of 1 in every direction. Both
+  * simplexField*D() and simplexMap*D() are checked, with the AVX2 kernels
+  * turned off, where every point must be exact, and turned on, where the
+  * points may differ by rounding.
+  *
+  * @return EXIT_SUCCESS if all points are close enough, EXIT_FAILURE otherwise
+**/
+static int32_t check_grid( uint32_t width, uint32_t height, uint32_t depth, bool is3D ) {
+	int32_t              result  = EXIT_SUCCESS;
+	size_t               samples = static_cast<size_t>( width ) * height * depth;
+	std::vector<double>  exact( samples );
+	std::vector<double>  grid( samples );
+	char const*          name    = is3D ? "3D" : "2D";
+
+	for ( uint32_t z = 0 ; z < depth ; ++z ) {
+		for ( uint32_t y = 0 ; y < height ; ++y ) {
+			for ( uint32_t x = 0 ; x < width ; ++x )
+				exact[( ( ( z * height ) + y ) * width ) + x] = is3D
+				        ? RNG.simplex3D( x, y, z, mapZoom, mapSmooth, mapReduction, mapWaves )
+				        : RNG.simplex2D( x, y, mapZoom, mapSmooth, mapReduction, mapWaves );
+		}
+	}
+
+	bool const hasAvx = RNG.getSimd();
+
+	for ( int32_t pass = 0 ; pass < 4 ; ++pass ) {
+		bool const useAvx = pass > 1;
+		bool const useMap = pass % 2;
+
+		if ( useAvx && !hasAvx ) {
+			cout << name << " " << ( useMap ? "map,   " : "field, " ) << "AVX2    : not supported by this processor" << endl;
+			continue;
+		}
+
+		RNG.setSimd( useAvx );
+		std::fill( grid.begin(), grid.end(), 2. );
+		if ( is3D ) {
+			if ( useMap )
+				RNG.simplexMap3D( grid.data(), width, height, depth, 0., 0., 0., 1., 1., 1.,
+				                  mapZoom, mapSmooth, mapReduction, mapWaves, 0 );
+			else
+				RNG.simplexField3D( grid.data(), width, height, depth, 0., 0., 0., 1., 1., 1.,
+				                    mapZoom, mapSmooth, mapReduction, mapWaves );
+		} else if ( useMap )
+			RNG.simplexMap2D( grid.data(), width, height, 0., 0., 1., 1.,
+			                  mapZoom, mapSmooth, mapReduction, mapWaves, 0 );
+		else
+			RNG.simplexField2D( grid.data(), width, height, 0., 0., 1., 1.,
+			                    mapZoom, mapSmooth, mapReduction, mapWaves );
+
+		double maxDiff = 0.;
+		for ( size_t i = 0 ; i < samples ; ++i )
+			maxDiff = std::max( maxDiff, std::abs( grid[i] - exact[i] ) );
+
+		cout << name << " " << ( useMap ? "map,   " : "field, " ) << ( useAvx ? "AVX2  " : "scalar" );
+		cout << "  : largest difference " << std::scientific << std::setprecision( 2 ) << maxDiff << endl;
+
+		if ( useAvx ? !( maxDiff <= maxAvxDiff ) : ( maxDiff != 0. ) ) {
+			cerr << "ERROR: The " << name << ( useMap ? " map" : " field" ) << " differs from ";
+			cerr << ( is3D ? "simplex3D()" : "simplex2D()" ) << endl;
+			result = EXIT_FAILURE;
+		}
+	}
+
+	RNG.setSimd( true );
+
+	return result;
+}
+
+
+/// @internal Return million samples per second
+static double msamples( size_t samples, int64_t usecs ) {
+	return usecs > 0 ? static_cast<double>( samples ) / static_cast<double>( usecs ) : 0.;
+}
+
+
+int32_t main( int32_t argc, char** argv ) {
+	int32_t result = EXIT_SUCCESS;
+
+	if ( ( argc < 2 ) || ( argc > 3 ) ) {
+		cerr << "Usage:\n  " << basename( argv[0] ) << " <map size> [max threads]\n";
+		cerr << " The 2D map has <map size> x <map size> points, the 3D map " << mapDepth << " layers of those.\n";
+		cerr << " The thread count starts with 1 and is doubled until max threads (default: 64)" << endl;
+		return EXIT_FAILURE;
+	}
+
+	int32_t mapSize = pwx::to_int32( argv[1] );
+	if ( ( mapSize <= 0 ) || ( mapSize > 32768 ) ) {
+		cerr << "Map size \"" << argv[1] << "\" must be between 1 and 32768" << endl;
+		return EXIT_FAILURE;
+	}
+
+	int32_t maxThreads = argc == 3 ? pwx::to_int32( argv[2] ) : 64;
+	if ( ( maxThreads < 1 ) || ( maxThreads > 1024 ) ) {
+		cerr << "Thread count \"" << argv[2] << "\" must be between 1 and 1024" << endl;
+		return EXIT_FAILURE;
+	}
+
+	pwx::init( true, nullptr, 0 );
+
+	uint32_t size    = static_cast<uint32_t>( mapSize );
+	size_t   samples = static_cast<size_t>( size ) * size;
+	std::vector< float > baseline( samples );
+	std::vector< float > first2D( samples );
+	std::vector< float > first3D( samples * mapDepth );
+	std::vector< float > map( samples * mapDepth );
+
+	// Every point must have the value simplex2D() or simplex3D() gives
+	uint32_t checkSize = std::min( size, 128U );
+	if ( EXIT_SUCCESS != check_grid( checkSize, checkSize, 1, false ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != check_grid( checkSize, checkSize, mapDepth, true ) )
+		result = EXIT_FAILURE;
+	cout << endl;
+
+	cout << "Throughput in million samples per second, " << size << " x " << size << " points, ";
+	cout << mapWaves << " waves." << endl;
+
+	// The baseline is one simplex2D() call per point, measured on a part of the map
+	uint32_t baseRows  = std::min( size, 256U );
+	int64_t  baseUsecs = measure( [&]() {
+		for ( uint32_t y = 0 ; y < baseRows ; ++y ) {
+			for ( uint32_t x = 0 ; x < size ; ++x )
+				baseline[( y * size ) + x] = static_cast<float>(
+					RNG.simplex2D( x, y, mapZoom, mapSmooth, mapReduction, mapWaves ) );
+		}
+	} );
+	cout << std::fixed << std::setprecision( 3 );
+	cout << "Single simplex2D() calls: " << msamples( static_cast<size_t>( baseRows ) * size, baseUsecs ) << "\n" << endl;
+
+	cout << "Threads | 2D map    | 3D map" << endl;
+	cout << "--------+-----------+----------" << endl;
+
+	for ( uint32_t numThreads = 1 ; ( EXIT_SUCCESS == result )
+	                                && ( numThreads <= static_cast<uint32_t>( maxThreads ) ) ; numThreads *= 2 ) {
+		int64_t usecs2D = measure( [&]() {
+			RNG.simplexMap2D( map.data(), size, size, 0., 0., 1., 1.,
+			                  mapZoom, mapSmooth, mapReduction, mapWaves, numThreads );
+		} );
+
+		// All thread counts must produce the same maps
+		auto const end2D = map.begin() + static_cast<std::ptrdiff_t>( samples );
+		if ( 1 == numThreads )
+			std::copy( map.begin(), end2D, first2D.begin() );
+		else if ( !std::equal( map.begin(), end2D, first2D.begin() ) ) {
+			cerr << "\nERROR: The 2D map of " << numThreads << " threads differs from the single threaded one" << endl;
+			result = EXIT_FAILURE;
+		}
+
+		int64_t usecs3D = measure( [&]() {
+			RNG.simplexMap3D( map.data(), size, size, mapDepth, 0., 0., 0., 1., 1., 1.,
+			                  mapZoom, mapSmooth, mapReduction, mapWaves, numThreads );
+		} );
+
+		if ( 1 == numThreads )
+			first3D = map;
+		else if ( map != first3D ) {
+			cerr << "\nERROR: The 3D map of " << numThreads << " threads differs from the single threaded one" << endl;
+			result = EXIT_FAILURE;
+		}
+
+		cout << std::setw( 7 ) << numThreads;
+		cout << " | " << std::setw( 9 ) << msamples( samples, usecs2D );
+		cout << " | " << std::setw( 8 ) << msamples( samples * mapDepth, usecs3D ) << endl;
+	}
+
+	pwx::finish();
+
+	return result;
+}
@@ -0,0 +1,286 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PDoubleList>
+#include <PEpochGuard>
+#include <PLog>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+/// @internal Object counting how many of its kind are alive
+struct sCounted {
+	static std::atomic_int alive;
+	sCounted()  noexcept { ++alive; }
+	~sCounted() noexcept { --alive; }
+};
+std::atomic_int sCounted::alive { 0 };
+
+
+/** @internal Allocation policy counting the element memory that is not given back yet
+  *
+  * The policy is used for the shared data of the elements, too, which
+  * is given back with the element destructor. Only blocks of
+  * @a elemSize are counted.
+**/
+struct sCountingAlloc {
+	static std::atomic_int live;
+	static size_t          elemSize;
+	static void* allocate( size_t size ) {
+		if ( elemSize == size )
+			++live;
+		return ::operator new( size );
+	}
+	static void deallocate( void* ptr, size_t size ) noexcept {
+		if ( elemSize == size )
+			--live;
+		::operator delete( ptr );
+	}
+};
+std::atomic_int sCountingAlloc::live { 0 };
+size_t          sCountingAlloc::elemSize = 0;
+
+
+typedef pwx::TDoubleElement<int32_t, sCountingAlloc> celem_t;
+typedef PDoubleList<int32_t, celem_t>                clist_t;
+
+
+/// @internal A thread entering one guard, or two nested ones, and holding it until told to leave
+struct sReader {
+	std::atomic_bool inside { false };
+	std::atomic_bool leave  { false };
+	std::thread      thread;
+
+	explicit sReader( uint32_t depth ) :
+		thread( [this, depth]() { this->run( depth ); } ) {
+		while ( !inside.load() )
+			std::this_thread::yield();
+	}
+
+	~sReader() {
+		leave.store( true );
+		thread.join();
+	}
+
+	void run( uint32_t depth ) {
+		pwx::CEpochGuard guard;
+		if ( depth > 1 ) {
+			// The inner guard ends at once, the outer one must still count
+			pwx::CEpochGuard inner;
+		}
+		inside.store( true );
+		while ( !leave.load() )
+			std::this_thread::yield();
+	}
+};
+
+
+/// @internal Give the epoch a few chances to advance and reclaim what is safe
+static void reclaim_some() {
+	for ( int32_t i = 0; i < 8; ++i )
+		pwx::epoch_reclaim();
+}
+
+
+/// @internal Nothing retired may be freed while a guard of another thread is active
+static int test_retire( uint32_t depth, char const* what ) {
+	const int32_t count = 200;
+
+	{
+		sReader reader( depth );
+
+		for ( int32_t i = 0; i < count; ++i )
+			pwx::epoch_retire( new sCounted() );
+		reclaim_some();
+
+		if ( count != sCounted::alive.load() ) {
+			log_error( nullptr, "%s: %d of %d retired objects freed while a guard was active",
+			           what, count - sCounted::alive.load(), count );
+			return EXIT_FAILURE;
+		}
+	} // The reader leaves its guard here
+
+	reclaim_some();
+	pwx::epoch_drain();
+
+	if ( sCounted::alive.load() ) {
+		log_error( nullptr, "%s: %d retired objects are still alive after epoch_drain()",
+		           what, sCounted::alive.load() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal epoch_free() must only defer while some thread is inside a guard
+static int test_free() {
+	pwx::epoch_free( new sCounted(), pwx::epoch_reclaim_delete<sCounted>, nullptr );
+	if ( sCounted::alive.load() ) {
+		log_error( nullptr, "%s", "epoch_free() deferred without any active guard" );
+		return EXIT_FAILURE;
+	}
+
+	{
+		sReader reader( 1 );
+		pwx::epoch_free( new sCounted(), pwx::epoch_reclaim_delete<sCounted>, nullptr );
+		if ( 1 != sCounted::alive.load() ) {
+			log_error( nullptr, "%s", "epoch_free() freed while another thread was inside a guard" );
+			return EXIT_FAILURE;
+		}
+	}
+
+	pwx::epoch_drain();
+	if ( sCounted::alive.load() ) {
+		log_error( nullptr, "%s", "epoch_free(): object still alive after epoch_drain()" );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Deleted elements are freed at once unless their memory must be kept for guarded readers
+static int test_element_free() {
+	clist_t list;
+
+	for ( int32_t i = 0; i < 10; ++i )
+		list.push_back( new int32_t( i ) );
+	if ( 10 != sCountingAlloc::live.load() ) {
+		log_error( nullptr, "elements: %d element allocations, should be 10", sCountingAlloc::live.load() );
+		return EXIT_FAILURE;
+	}
+
+	// Without any guard, removing frees at once
+	list.delElem( list.get( 0 ) );
+	if ( 9 != sCountingAlloc::live.load() ) {
+		log_error( nullptr, "%s", "elements: delElem() without guards did not free the element" );
+		return EXIT_FAILURE;
+	}
+
+	{
+		sReader reader( 1 );
+
+		// A thread safe list must keep the memory for the reader...
+		list.delElem( list.get( 0 ) );
+		if ( 9 != sCountingAlloc::live.load() ) {
+			log_error( nullptr, "%s", "elements: element freed while a guard was active" );
+			return EXIT_FAILURE;
+		}
+
+		// ...a list that is not thread safe does not.
+		list.disable_thread_safety();
+		list.delElem( list.get( 0 ) );
+		if ( 8 != sCountingAlloc::live.load() ) {
+			log_error( nullptr, "%s", "elements: element of an unsafe list was not freed at once" );
+			return EXIT_FAILURE;
+		}
+		list.enable_thread_safety();
+	}
+
+	list.clear();
+	pwx::epoch_drain();
+	if ( sCountingAlloc::live.load() ) {
+		log_error( nullptr, "elements: %d elements still allocated after clear() and epoch_drain()",
+		           sCountingAlloc::live.load() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Readers search a list while it is shrunk, the odd values must always be found
+static int test_concurrent_find() {
+	const int32_t count   = 2000;
+	const int32_t readers = 3;
+	clist_t          list;
+	std::atomic_bool done { false };
+	std::atomic_int  errors { 0 };
+
+	for ( int32_t i = 0; i < count; ++i )
+		list.push_back( new int32_t( i ) );
+
+	std::vector<std::thread> threads;
+	for ( int32_t r = 0; r < readers; ++r ) {
+		threads.emplace_back( [&list, &done, &errors, r, count]() {
+			for ( int32_t i = r; !done.load() || ( i < count * 2 ) ; i += 7 ) {
+				int32_t value = i % count;
+				auto*   elem  = list.find( value );
+				if ( ( value % 2 ) && ( !elem || ( value != **elem ) ) )
+					++errors;
+			}
+		} );
+	}
+
+	// Remove all even values, from both ends towards the middle
+	for ( int32_t i = 0; i < count / 2; i += 2 ) {
+		int32_t low  = i;
+		int32_t high = count - 2 - i;
+		list.delElem( list.find( low ) );
+		list.delElem( list.find( high ) );
+	}
+	done.store( true );
+
+	for ( auto &thread : threads )
+		thread.join();
+
+	if ( errors.load() ) {
+		log_error( nullptr, "concurrent find: %d searches for values never removed failed", errors.load() );
+		return EXIT_FAILURE;
+	}
+	if ( static_cast<uint32_t>( count / 2 ) != list.size() ) {
+		log_error( nullptr, "concurrent find: %u elements left, should be %d", list.size(), count / 2 );
+		return EXIT_FAILURE;
+	}
+
+	list.clear();
+	pwx::epoch_drain();
+	if ( sCountingAlloc::live.load() ) {
+		log_error( nullptr, "concurrent find: %d elements still allocated", sCountingAlloc::live.load() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+	sCountingAlloc::elemSize = sizeof( celem_t );
+
+	if ( EXIT_SUCCESS != test_retire( 1, "guard" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_retire( 2, "nested guard" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_free() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_element_free() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_concurrent_find() )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
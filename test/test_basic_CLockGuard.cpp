@@ -100,6 +100,44 @@ static int test_lock_guard( PLockable* a, PLockable* b, PLockable* c ) {
 }
 
 
+static int test_shared_lock_guard( PLockable* a, PLockable* b, PLockable* c ) {
+	int result = EXIT_SUCCESS;
+
+	PWX_NAMED_SHARED_LOCK_GUARD( Single_Shared, a );
+	PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD( Double_Shared, b, c );
+
+	if ( ( 1 != a->shared_lock_count() ) || ( 1 != b->shared_lock_count() ) || ( 1 != c->shared_lock_count() ) ) {
+		log_error( nullptr, "%s has FAILED on 'a', 'b', 'c'", "Shared Guards" );
+		result = EXIT_FAILURE;
+	}
+	if ( a->is_locked() || b->is_locked() || c->is_locked() ) {
+		log_error( nullptr, "%s locked exclusively", "Shared Guards" );
+		result = EXIT_FAILURE;
+	}
+
+	// A second reader in the same thread must not block
+	PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD( Triple_Shared, a, b, c );
+
+	if ( ( 2 != a->shared_lock_count() ) || ( 1 != a->readers() ) ) {
+		log_error( nullptr, "%s resulted in 'a' having %u/2 shared locks and %u/1 readers",
+		           "Triple_Shared", a->shared_lock_count(), a->readers() );
+		result = EXIT_FAILURE;
+	}
+
+	PWX_NAMED_TRIPLE_SHARED_LOCK_GUARD_CLEAR( Triple_Shared );
+	PWX_NAMED_DOUBLE_SHARED_LOCK_GUARD_CLEAR( Double_Shared );
+	PWX_NAMED_SHARED_LOCK_GUARD_CLEAR( Single_Shared );
+
+	if ( a->shared_lock_count() || b->shared_lock_count() || c->shared_lock_count()
+	     || a->readers() || b->readers() || c->readers() ) {
+		log_error( nullptr, "%s has FAILED on 'a', 'b', 'c'", "Shared Guards Clear" );
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
 int main() {
 	int result = EXIT_SUCCESS;
 
@@ -118,6 +156,10 @@ int main() {
 		result = EXIT_FAILURE;
 	}
 
+	if ( EXIT_SUCCESS != test_shared_lock_guard( &lock_a, &lock_b, &lock_c ) ) {
+		result = EXIT_FAILURE;
+	}
+
 	pwx::finish();
 
 	if ( EXIT_SUCCESS == result )
@@ -12,6 +12,9 @@
 **/
 
 
+#include <thread>
+#include <vector>
+
 #include <PLockable>
 #include <PLog>
 
@@ -223,6 +226,206 @@ static int test_clear_locks( PLockable &a, PLockable &b, PLockable* c ) {
 }
 
 
+static int test_adaptive( PLockable &a ) {
+	int result = EXIT_SUCCESS;
+
+	a.set_lock_mode( pwx::LM_ADAPTIVE );
+	if ( pwx::LM_ADAPTIVE != a.lock_mode() ) {
+		log_error( nullptr, "%s FAILED", "set_lock_mode( LM_ADAPTIVE )" );
+		return EXIT_FAILURE;
+	}
+
+	// Let some threads hammer on the lock to force spinning and parking
+	const uint32_t thrCount = 8;
+	const uint32_t maxRuns  = 20000;
+	uint32_t       counter  = 0;
+	std::vector<std::thread> threads;
+
+	for ( uint32_t t = 0; t < thrCount; ++t ) {
+		threads.emplace_back( [&a, &counter]() {
+			for ( uint32_t i = 0; i < maxRuns; ++i ) {
+				a.lock();
+				++counter;
+				a.unlock();
+			}
+		} );
+	}
+	for ( auto &thr : threads ) {
+		thr.join();
+	}
+
+	if ( ( thrCount * maxRuns ) != counter ) {
+		log_error( nullptr, "LM_ADAPTIVE counted %u/%u", counter, thrCount * maxRuns );
+		result = EXIT_FAILURE;
+	}
+
+	// Recursion and try_lock() must work like in the default mode
+	a.lock();
+	if ( !a.try_lock() || ( 2 != a.lock_count() ) ) {
+		log_error( nullptr, "LM_ADAPTIVE resulted in 'a' having %d/2 locks", a.lock_count() );
+		result = EXIT_FAILURE;
+	}
+	a.unlock();
+	a.unlock();
+	if ( a.is_locked() ) {
+		log_error( nullptr, "'a' still locked after using %s!", "LM_ADAPTIVE unlock()" );
+		result = EXIT_FAILURE;
+	}
+
+	a.set_lock_mode( pwx::LM_DEFAULT );
+	if ( pwx::LM_DEFAULT != a.lock_mode() ) {
+		log_error( nullptr, "%s FAILED", "set_lock_mode( LM_DEFAULT )" );
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
+static int test_shared( PLockable &a ) {
+	int result = EXIT_SUCCESS;
+
+	// Recursive shared locks count once as a reader
+	a.lock_shared();
+	if ( !a.try_lock_shared() || ( 2 != a.shared_lock_count() ) || ( 1 != a.readers() ) ) {
+		log_error( nullptr, "lock_shared() resulted in 'a' having %u/2 shared locks and %u/1 readers",
+		           a.shared_lock_count(), a.readers() );
+		result = EXIT_FAILURE;
+	}
+	if ( a.is_locked() ) {
+		log_error( nullptr, "'a' is exclusively locked after %s!", "lock_shared()" );
+		result = EXIT_FAILURE;
+	}
+
+	// Another thread must be able to read, but not to write
+	bool otherRead  = false;
+	bool otherWrite = true;
+	std::thread( [&a, &otherRead, &otherWrite]() {
+		otherRead = a.try_lock_shared();
+		if ( otherRead ) {
+			a.unlock_shared();
+		}
+		otherWrite = a.try_lock();
+		if ( otherWrite ) {
+			a.unlock();
+		}
+	} ).join();
+	if ( !otherRead || otherWrite ) {
+		log_error( nullptr, "Concurrent try_lock_shared() %s, try_lock() %s",
+		           otherRead ? "succeeded" : "FAILED", otherWrite ? "succeeded (WRONG)" : "failed" );
+		result = EXIT_FAILURE;
+	}
+
+	// Upgrading must work and leave this thread a reader afterwards
+	a.lock();
+	if ( !a.is_locked() || ( 0 != a.readers() ) ) {
+		log_error( nullptr, "Upgrade resulted in 'a' being %s with %u/0 readers",
+		           a.is_locked() ? "locked" : "unlocked", a.readers() );
+		result = EXIT_FAILURE;
+	}
+	a.unlock();
+	if ( a.is_locked() || ( 1 != a.readers() ) ) {
+		log_error( nullptr, "Downgrade resulted in 'a' being %s with %u/1 readers",
+		           a.is_locked() ? "locked" : "unlocked", a.readers() );
+		result = EXIT_FAILURE;
+	}
+
+	a.unlock_shared();
+	a.unlock_shared();
+	if ( ( 0 != a.shared_lock_count() ) || ( 0 != a.readers() ) ) {
+		log_error( nullptr, "unlock_shared() left 'a' with %u/0 shared locks and %u/0 readers",
+		           a.shared_lock_count(), a.readers() );
+		result = EXIT_FAILURE;
+	}
+
+	// Now let readers and writers hammer on the lock
+	const uint32_t thrCount = 8;
+	const uint32_t maxRuns  = 5000;
+	uint32_t       value_a  = 0;
+	uint32_t       value_b  = 0;
+	pwx::abool_t   torn     = ATOMIC_VAR_INIT( false );
+	std::vector<std::thread> threads;
+
+	for ( uint32_t t = 0; t < thrCount; ++t ) {
+		threads.emplace_back( [&a, &value_a, &value_b, &torn, t]() {
+			for ( uint32_t i = 0; i < maxRuns; ++i ) {
+				if ( t % 2 ) {
+					a.lock();
+					++value_a;
+					std::this_thread::yield();
+					++value_b;
+					a.unlock();
+				} else {
+					a.lock_shared();
+					a.lock_shared();
+					if ( value_a != value_b ) {
+						torn.store( true );
+					}
+					a.unlock_shared();
+					a.unlock_shared();
+				}
+			}
+		} );
+	}
+	for ( auto &thr : threads ) {
+		thr.join();
+	}
+
+	if ( torn.load() || ( ( thrCount / 2 * maxRuns ) != value_a ) ) {
+		log_error( nullptr, "Shared locking %s, writers counted %u/%u",
+		           torn.load() ? "saw torn values" : "is consistent", value_a, thrCount / 2 * maxRuns );
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
+static int test_shared_many() {
+	int result = EXIT_SUCCESS;
+
+	// More objects than the per-thread slots, so some holds spill over
+	const uint32_t objCount = 40;
+	std::vector<PLockable> objects( objCount );
+
+	for ( uint32_t i = 0; i < objCount; ++i ) {
+		objects[i].lock_shared();
+		if ( !objects[i].try_lock_shared() ) {
+			log_error( nullptr, "try_lock_shared() on object %u FAILED", i );
+			result = EXIT_FAILURE;
+		}
+	}
+
+	for ( uint32_t i = 0; i < objCount; ++i ) {
+		if ( ( 2 != objects[i].shared_lock_count() ) || ( 1 != objects[i].readers() ) ) {
+			log_error( nullptr, "Object %u has %u/2 shared locks and %u/1 readers",
+			           i, objects[i].shared_lock_count(), objects[i].readers() );
+			result = EXIT_FAILURE;
+		}
+	}
+
+	// Release the first slots first, so spilled holds move back
+	for ( uint32_t i = 0; i < objCount; ++i ) {
+		objects[i].unlock_shared();
+		objects[i].unlock_shared();
+		if ( ( 0 != objects[i].shared_lock_count() ) || ( 0 != objects[i].readers() ) ) {
+			log_error( nullptr, "Object %u kept %u/0 shared locks and %u/0 readers",
+			           i, objects[i].shared_lock_count(), objects[i].readers() );
+			result = EXIT_FAILURE;
+		}
+		for ( uint32_t j = i + 1; j < objCount; ++j ) {
+			if ( 2 != objects[j].shared_lock_count() ) {
+				log_error( nullptr, "Releasing object %u left object %u with %u/2 shared locks",
+				           i, j, objects[j].shared_lock_count() );
+				result = EXIT_FAILURE;
+			}
+		}
+	}
+
+	return result;
+}
+
+
 int main() {
 	int result = EXIT_SUCCESS;
 
@@ -262,6 +465,21 @@ int main() {
 		result = EXIT_FAILURE;
 	}
 
+	// Switch to adaptive locking and back
+	if ( EXIT_SUCCESS != test_adaptive( lock_a ) ) {
+		result = EXIT_FAILURE;
+	}
+
+	// Readers and writers
+	if ( EXIT_SUCCESS != test_shared( lock_a ) ) {
+		result = EXIT_FAILURE;
+	}
+
+	// Shared locks on many objects at once
+	if ( EXIT_SUCCESS != test_shared_many() ) {
+		result = EXIT_FAILURE;
+	}
+
 
 	pwx::finish();
 
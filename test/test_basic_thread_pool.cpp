@@ -0,0 +1,160 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PBasic>
+#include <PLog>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+/// @internal Every task must run exactly once, whatever the number of tasks is
+static int test_run_all( uint32_t count ) {
+	std::vector< std::atomic<uint32_t> > runs( count );
+	for ( auto &run : runs )
+		run.store( 0 );
+
+	pwx::thread_pool_run( count, [ &runs ]( uint32_t nr ) {
+		runs[nr].fetch_add( 1 );
+	} );
+
+	for ( uint32_t nr = 0; nr < count; ++nr ) {
+		if ( 1 != runs[nr].load() ) {
+			log_error( nullptr, "%u tasks: task %u ran %u times", count, nr, runs[nr].load() );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Repeated runs must reuse the pool threads instead of starting new ones
+static int test_reuse() {
+	std::mutex                  idLock;
+	std::set< std::thread::id > ids;
+
+	// Start with an empty pool, so only the threads of these runs are there
+	pwx::thread_pool_stop();
+
+	for ( int32_t round = 0; round < 50; ++round ) {
+		pwx::thread_pool_run( 8, [ &idLock, &ids ]( uint32_t ) {
+			std::this_thread::yield();
+			std::lock_guard<std::mutex> guard( idLock );
+			ids.insert( std::this_thread::get_id() );
+		} );
+	}
+
+	// Seven pool threads and the caller
+	if ( ids.size() > 8 ) {
+		log_error( nullptr, "reuse: 50 runs of 8 tasks used %u threads", static_cast<uint32_t>( ids.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal A task may run more tasks on the pool
+static int test_nested() {
+	std::atomic<uint32_t> inner { 0 };
+
+	pwx::thread_pool_run( 6, [ &inner ]( uint32_t ) {
+		pwx::thread_pool_run( 6, [ &inner ]( uint32_t ) {
+			inner.fetch_add( 1 );
+		} );
+	} );
+
+	if ( 36 != inner.load() ) {
+		log_error( nullptr, "nested: %u inner tasks ran, should be 36", inner.load() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal An exception of a task is thrown further after all other tasks have ended
+static int test_exception() {
+	std::atomic<uint32_t> done { 0 };
+	bool                  caught = false;
+
+	try {
+		pwx::thread_pool_run( 16, [ &done ]( uint32_t nr ) {
+			if ( 5 == nr )
+				throw std::runtime_error( "task 5 failed" );
+			done.fetch_add( 1 );
+		} );
+	} catch ( std::runtime_error & ) {
+		caught = true;
+	}
+
+	if ( !caught || ( 15 != done.load() ) ) {
+		log_error( nullptr, "exception: %s, %u other tasks done", caught ? "caught" : "not caught", done.load() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal After stopping, the pool starts new threads on its next use
+static int test_stop() {
+	pwx::thread_pool_stop();
+	if ( EXIT_SUCCESS != test_run_all( 4 ) )
+		return EXIT_FAILURE;
+	pwx::thread_pool_stop();
+	pwx::thread_pool_stop();
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_run_all( 0 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_run_all( 1 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_run_all( 7 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_run_all( 10000 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_run_all( pwx::threadPoolMax * 3 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_reuse() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_nested() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_exception() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_stop() )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
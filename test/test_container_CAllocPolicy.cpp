@@ -0,0 +1,214 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PQueue>
+#include <PLog>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+typedef pwx::CAllocPolicyPool pool_t;
+
+
+/// @internal A block taken from the pool with the pattern written into it
+struct sBlock {
+	unsigned char* ptr;
+	size_t         size;
+	unsigned char  tag;
+};
+typedef std::vector<sBlock> blocks_t;
+
+
+/// @internal allocate @a count blocks of all size classes and fill each with its own pattern
+static void alloc_blocks( blocks_t &blocks, uint32_t count, unsigned char tagBase ) {
+	for ( uint32_t i = 0; i < count; ++i ) {
+		size_t        size = 1 + ( i * 13 ) % pool_t::maxNodeSize;
+		unsigned char tag  = static_cast<unsigned char>( tagBase + i );
+		auto*         ptr  = static_cast<unsigned char*>( pool_t::allocate( size ) );
+		memset( ptr, tag, size );
+		blocks.push_back( { ptr, size, tag } );
+	}
+}
+
+
+/// @internal Check that no block was handed out twice and no pattern was overwritten
+static int check_blocks( blocks_t &blocks, char const* what ) {
+	for ( auto const &block : blocks ) {
+		for ( size_t i = 0; i < block.size; ++i ) {
+			if ( block.tag != block.ptr[i] ) {
+				log_error( nullptr, "%s: block %p byte %u is 0x%02x, should be 0x%02x", what,
+				           static_cast<void*>( block.ptr ), static_cast<uint32_t>( i ), block.ptr[i], block.tag );
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	std::vector<unsigned char*> ptrs;
+	for ( auto const &block : blocks )
+		ptrs.push_back( block.ptr );
+	std::sort( ptrs.begin(), ptrs.end() );
+	if ( std::adjacent_find( ptrs.begin(), ptrs.end() ) != ptrs.end() ) {
+		log_error( nullptr, "%s: a block was handed out twice", what );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal give all @a blocks back to the pool
+static void free_blocks( blocks_t &blocks ) {
+	for ( auto const &block : blocks )
+		pool_t::deallocate( block.ptr, block.size );
+	blocks.clear();
+}
+
+
+/// @internal Blocks allocated by one thread are freed by another one, which keeps using them
+static int test_cross_thread() {
+	blocks_t foreign;
+	blocks_t own;
+
+	// Far more than the per-thread lists hold, so they overflow into the depot
+	std::thread producer( [&foreign]() { alloc_blocks( foreign, 5000, 0x10 ); } );
+	producer.join();
+
+	alloc_blocks( own, 1000, 0x80 );
+	if ( EXIT_SUCCESS != check_blocks( foreign, "cross thread, foreign" ) )
+		return EXIT_FAILURE;
+
+	free_blocks( foreign );
+
+	// The freed nodes now come from this thread's lists
+	alloc_blocks( own, 5000, 0x40 );
+	if ( EXIT_SUCCESS != check_blocks( own, "cross thread, reuse" ) )
+		return EXIT_FAILURE;
+
+	free_blocks( own );
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Threads end while holding cached nodes and while blocks they allocated are still in use
+static int test_thread_exit() {
+	int      result = EXIT_SUCCESS;
+	blocks_t kept;
+	blocks_t survivors[4];
+
+	// Each thread frees half of its blocks, so its lists are filled when it ends
+	std::vector<std::thread> threads;
+	for ( uint32_t nr = 0; nr < 4; ++nr ) {
+		threads.emplace_back( [nr, &survivors]() {
+			blocks_t mine;
+			alloc_blocks( mine, 1000, static_cast<unsigned char>( nr * 0x20 ) );
+			for ( uint32_t i = 0; i < mine.size(); ++i ) {
+				if ( i % 2 )
+					pool_t::deallocate( mine[i].ptr, mine[i].size );
+				else
+					survivors[nr].push_back( mine[i] );
+			}
+		} );
+	}
+	for ( auto &thr : threads )
+		thr.join();
+
+	// The ended threads handed their lists to the depot. New threads must
+	// get those nodes without clashing with the blocks still in use.
+	for ( uint32_t nr = 0; nr < 4; ++nr )
+		kept.insert( kept.end(), survivors[nr].begin(), survivors[nr].end() );
+
+	threads.clear();
+	blocks_t fresh[4];
+	for ( uint32_t nr = 0; nr < 4; ++nr )
+		threads.emplace_back( [nr, &fresh]() { alloc_blocks( fresh[nr], 1000, static_cast<unsigned char>( 0x90 + nr ) ); } );
+	for ( auto &thr : threads )
+		thr.join();
+
+	for ( uint32_t nr = 0; nr < 4; ++nr )
+		kept.insert( kept.end(), fresh[nr].begin(), fresh[nr].end() );
+	if ( EXIT_SUCCESS != check_blocks( kept, "thread exit" ) )
+		result = EXIT_FAILURE;
+
+	// Blocks of ended threads are freed by this one
+	free_blocks( kept );
+
+	return result;
+}
+
+
+/// @internal Pooled queue elements pushed by threads that end before the elements are popped
+static int test_pooled_elements() {
+	typedef pwx::TDoubleElement<int32_t, pool_t> elem_t;
+	typedef PQueue<int32_t, elem_t>              queue_t;
+
+	queue_t queue;
+
+	std::vector<std::thread> threads;
+	for ( int32_t nr = 0; nr < 4; ++nr ) {
+		threads.emplace_back( [nr, &queue]() {
+			for ( int32_t i = 0; i < 500; ++i )
+				queue.push( new int32_t( nr * 1000 + i ) );
+		} );
+	}
+	for ( auto &thr : threads )
+		thr.join();
+
+	if ( 2000 != queue.size() ) {
+		log_error( nullptr, "pooled elements: queue holds %u/2000 elements", queue.size() );
+		return EXIT_FAILURE;
+	}
+
+	std::vector<int32_t> seen;
+	while ( queue.size() ) {
+		elem_t* elem = queue.pop();
+		seen.push_back( **elem );
+		delete elem;
+	}
+
+	std::sort( seen.begin(), seen.end() );
+	for ( int32_t i = 0; i < 2000; ++i ) {
+		if ( seen[i] != ( i / 500 ) * 1000 + i % 500 ) {
+			log_error( nullptr, "pooled elements: value %d is %d", i, seen[i] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_cross_thread() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_thread_exit() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_pooled_elements() )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
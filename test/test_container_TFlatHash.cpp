@@ -0,0 +1,315 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PFlatHash>
+#include <PLog>
+
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+
+typedef PFlatHash<int32_t, int32_t>  hash_t;
+typedef std::map<int32_t, int32_t>   model_t;
+
+
+/// @internal Every key gets the same hash, so all keys share one probe sequence
+static uint32_t same_hash( const int32_t* ) {
+	return 7;
+}
+
+
+/// @internal Sixteen consecutive keys share one hash, so the table is full of clusters
+static uint32_t clustered_hash( const int32_t* key ) {
+	return static_cast<uint32_t>( *key ) / 16;
+}
+
+
+/// @internal Check that @a hash holds exactly the keys and data of @a model, looking at all keys below @a keyRange
+static int check_model( hash_t const &hash, model_t const &model, int32_t keyRange, char const* what ) {
+	if ( model.size() != hash.size() ) {
+		log_error( nullptr, "%s: size() is %u, should be %u", what, hash.size(), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	for ( int32_t key = 0; key < keyRange; ++key ) {
+		auto     found = model.find( key );
+		int32_t* data  = hash.get( key );
+
+		if ( found == model.end() ) {
+			if ( data || hash.exists( key ) ) {
+				log_error( nullptr, "%s: removed key %d is still found", what, key );
+				return EXIT_FAILURE;
+			}
+		} else if ( !data || !hash.exists( key ) || ( found->second != *data ) ) {
+			log_error( nullptr, "%s: key %d %s", what, key, data ? "has wrong data" : "is missing" );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Add @a key with @a value to both @a hash and @a model, an existing key must keep its data
+static int add_key( hash_t &hash, model_t &model, int32_t key, int32_t value, char const* what ) {
+	int32_t* data = new int32_t( value );
+	hash.add( key, data );
+
+	if ( model.count( key ) ) {
+		// Not stored, the data stays with the caller
+		if ( data == hash.get( key ) ) {
+			log_error( nullptr, "%s: add() replaced the data of key %d", what, key );
+			return EXIT_FAILURE;
+		}
+		delete data;
+	} else
+		model[key] = value;
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Remove @a key from both @a hash and @a model, alternating between remKey() and delKey()
+static int rem_key( hash_t &hash, model_t &model, int32_t key, bool useDel, char const* what ) {
+	auto found = model.find( key );
+
+	if ( useDel ) {
+		uint32_t left = hash.delKey( key );
+		if ( found != model.end() )
+			model.erase( found );
+		if ( model.size() != left ) {
+			log_error( nullptr, "%s: delKey(%d) left %u keys, should be %u", what, key,
+			           left, static_cast<uint32_t>( model.size() ) );
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	int32_t* data = hash.remKey( key );
+	if ( found == model.end() ) {
+		if ( data ) {
+			log_error( nullptr, "%s: remKey(%d) returned data for a missing key", what, key );
+			delete data;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	if ( !data || ( found->second != *data ) ) {
+		log_error( nullptr, "%s: remKey(%d) returned %s", what, key, data ? "the wrong data" : "nothing" );
+		delete data;
+		return EXIT_FAILURE;
+	}
+	delete data;
+	model.erase( found );
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Interleave adding, removing and searching keys, so the backward shift of removals is used a lot
+static int test_random_ops( hash_t &hash, int32_t keyRange, uint32_t ops, char const* what ) {
+	model_t      model;
+	std::mt19937 rng( 4711 );
+
+	for ( uint32_t op = 1; op <= ops; ++op ) {
+		int32_t key = static_cast<int32_t>( rng() % static_cast<uint32_t>( keyRange ) );
+
+		switch ( rng() % 4 ) {
+			case 0:
+			case 1:
+				if ( EXIT_SUCCESS != add_key( hash, model, key, static_cast<int32_t>( op ), what ) )
+					return EXIT_FAILURE;
+				break;
+			default:
+				if ( EXIT_SUCCESS != rem_key( hash, model, key, 0 == ( op % 2 ), what ) )
+					return EXIT_FAILURE;
+				break;
+		}
+
+		if ( ( 0 == ( op % 499 ) ) && ( EXIT_SUCCESS != check_model( hash, model, keyRange, what ) ) )
+			return EXIT_FAILURE;
+	}
+
+	return check_model( hash, model, keyRange, what );
+}
+
+
+/** @internal Remove keys from the middle of one long probe sequence
+  *
+  * All keys have the same home bucket, so the n keys of the sequence must
+  * be exactly 0 to n-1 hops away from it. Removing a key shifts all of its
+  * successors back by one. If a gap was left, or a key was shifted too far,
+  * the hops would no longer be a gapless sequence, or keys would be lost.
+**/
+static int test_backward_shift() {
+	hash_t               hash( 64, nullptr, same_hash );
+	model_t              model;
+	std::mt19937         rng( 815 );
+	std::vector<int32_t> keys;
+
+	for ( int32_t key = 0; key < 40; ++key ) {
+		if ( EXIT_SUCCESS != add_key( hash, model, key, key * 3, "backward shift" ) )
+			return EXIT_FAILURE;
+		keys.push_back( key );
+	}
+
+	while ( !keys.empty() ) {
+		std::vector<bool> seen( keys.size(), false );
+		for ( int32_t key : keys ) {
+			uint32_t hops = hash.getHops( key );
+			if ( ( hops >= keys.size() ) || seen[hops] ) {
+				log_error( nullptr, "backward shift: key %d is %u hops away with %u keys stored",
+				           key, hops, static_cast<uint32_t>( keys.size() ) );
+				return EXIT_FAILURE;
+			}
+			seen[hops] = true;
+		}
+		if ( EXIT_SUCCESS != check_model( hash, model, 40, "backward shift" ) )
+			return EXIT_FAILURE;
+
+		auto victim = keys.begin() + static_cast<ptrdiff_t>( rng() % keys.size() );
+		if ( EXIT_SUCCESS != rem_key( hash, model, *victim, keys.size() % 2, "backward shift" ) )
+			return EXIT_FAILURE;
+		keys.erase( victim );
+	}
+
+	return hash.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/// @internal Grow a small table to many keys, remove every other key and add them again
+static int test_growth() {
+	const int32_t count = 50000;
+	hash_t        hash( 16, 0U );
+	model_t       model;
+	uint32_t      tabSize = hash.sizeMax();
+
+	for ( int32_t key = 0; key < count; ++key ) {
+		if ( EXIT_SUCCESS != add_key( hash, model, key, key * 3, "growth" ) )
+			return EXIT_FAILURE;
+
+		// Each growth doubles the table, and grows before more than 80% of it are used
+		if ( tabSize != hash.sizeMax() ) {
+			if ( ( tabSize * 2 ) != hash.sizeMax() ) {
+				log_error( nullptr, "growth: the table grew from %u to %u buckets", tabSize, hash.sizeMax() );
+				return EXIT_FAILURE;
+			}
+			tabSize = hash.sizeMax();
+		}
+		if ( hash.size() > ( tabSize - tabSize / 5 ) ) {
+			log_error( nullptr, "growth: %u keys in %u buckets", hash.size(), tabSize );
+			return EXIT_FAILURE;
+		}
+	}
+	if ( EXIT_SUCCESS != check_model( hash, model, count, "growth" ) )
+		return EXIT_FAILURE;
+
+	for ( int32_t key = 0; key < count; key += 2 ) {
+		if ( EXIT_SUCCESS != rem_key( hash, model, key, key % 4, "growth" ) )
+			return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_model( hash, model, count, "growth, halved" ) )
+		return EXIT_FAILURE;
+
+	for ( int32_t key = 0; key < count; key += 2 ) {
+		if ( EXIT_SUCCESS != add_key( hash, model, key, -key, "growth" ) )
+			return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_model( hash, model, count, "growth, refilled" ) )
+		return EXIT_FAILURE;
+
+	// Without removals gaining room, the refill fits into the same table
+	if ( tabSize != hash.sizeMax() ) {
+		log_error( nullptr, "growth: the refill grew the table from %u to %u buckets", tabSize, hash.sizeMax() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal reserve(), clear() and getData() of missing keys
+static int test_reserve_clear() {
+	hash_t  hash;
+	model_t model;
+
+	uint32_t tabSize = hash.reserve( 1000 );
+	if ( tabSize < 1000 * 5 / 4 ) {
+		log_error( nullptr, "reserve: 1000 keys got %u buckets", tabSize );
+		return EXIT_FAILURE;
+	}
+	for ( int32_t key = 0; key < 1000; ++key )
+		add_key( hash, model, key, key, "reserve" );
+	if ( tabSize != hash.sizeMax() ) {
+		log_error( nullptr, "reserve: the table grew from %u to %u buckets", tabSize, hash.sizeMax() );
+		return EXIT_FAILURE;
+	}
+
+	hash.clear();
+	model.clear();
+	if ( !hash.empty() || ( EXIT_SUCCESS != check_model( hash, model, 1000, "clear" ) ) )
+		return EXIT_FAILURE;
+
+	bool thrown = false;
+	try {
+		hash.getData( 5 );
+	} catch ( pwx::CException &e ) {
+		thrown = ( 0 == strcmp( "NullDataException", e.name() ) );
+	}
+	if ( !thrown ) {
+		log_error( nullptr, "%s", "getData() of a missing key did not throw NullDataException" );
+		return EXIT_FAILURE;
+	}
+
+	for ( int32_t key = 500; key < 600; ++key )
+		add_key( hash, model, key, key * 2, "clear" );
+
+	return check_model( hash, model, 1000, "refill after clear" );
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	hash_t smallHash( 16, 0U );
+	hash_t largeHash( 16, 0U );
+	hash_t clusterHash( 16, nullptr, clustered_hash );
+
+	if ( EXIT_SUCCESS != test_random_ops( smallHash, 64, 20000, "small range" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_random_ops( largeHash, 2000, 60000, "large range" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_random_ops( clusterHash, 2000, 60000, "clusters" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_backward_shift() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_growth() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_reserve_clear() )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
@@ -0,0 +1,201 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PChainHash>
+#include <POpenHash>
+#include <PLog>
+
+#include <utility>
+#include <vector>
+
+
+typedef PChainHash<int32_t, int32_t> chash_t;
+typedef POpenHash<int32_t, int32_t>  ohash_t;
+
+
+/// @internal Check that the keys 0 to @a count - 1 are all there with data key * 3, and the thread safety is @a ts.
+template<typename hash_t>
+static int check_keys( hash_t &hash, int32_t count, bool ts, char const* what ) {
+	int result = EXIT_SUCCESS;
+
+	if ( static_cast<uint32_t>( count ) != hash.size() ) {
+		log_error( nullptr, "%s: size() is %u/%d", what, hash.size(), count );
+		result = EXIT_FAILURE;
+	}
+
+	for ( int32_t key = 0; key < count; ++key ) {
+		auto* elem = hash.get( key );
+		if ( !elem || ( ( key * 3 ) != **elem ) ) {
+			log_error( nullptr, "%s: key %d %s", what, key, elem ? "has wrong data" : "is missing" );
+			return EXIT_FAILURE;
+		}
+		if ( ts != elem->beThreadSafe() ) {
+			log_error( nullptr, "%s: element %d is %sthread safe", what, key, ts ? "not " : "" );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return result;
+}
+
+
+/// @internal Fill @a hash with the keys 0 to @a count - 1 and data key * 3
+template<typename hash_t>
+static void fill_keys( hash_t &hash, int32_t count ) {
+	for ( int32_t key = 0; key < count; ++key )
+		hash.add( key, new int32_t( key * 3 ) );
+}
+
+
+/// @internal Switch the thread safety while an incremental migration is running
+template<typename hash_t>
+static int test_incremental_toggle( hash_t &hash, char const* what ) {
+	int result = EXIT_SUCCESS;
+
+	// One bucket per step, so the migration is far from done when the toggles come
+	hash.enable_incremental_grow( 1 );
+	fill_keys( hash, 200 );
+
+	hash.disable_thread_safety();
+	if ( EXIT_SUCCESS != check_keys( hash, 200, false, what ) )
+		result = EXIT_FAILURE;
+
+	hash.enable_thread_safety();
+	if ( EXIT_SUCCESS != check_keys( hash, 200, true, what ) )
+		result = EXIT_FAILURE;
+
+	return result;
+}
+
+
+/// @internal Build a hash from pairs with duplicate keys and check that the first pair of each key was used
+template<typename hash_t, typename... Args>
+static int test_bulk_ctor( char const* what, Args... args ) {
+	typedef std::pair<int32_t, int32_t*> pair_t;
+
+	int                   result = EXIT_SUCCESS;
+	int32_t const         count  = 70000; // Enough for several threads
+	std::vector< pair_t > pairs;
+
+	// Every key is used twice, the second time with different data
+	// that is ignored by the hash and stays with the caller.
+	for ( int32_t key = 0; key < count; ++key )
+		pairs.emplace_back( ( key * 7919 ) % count, new int32_t( ( ( key * 7919 ) % count ) * 3 ) );
+	for ( int32_t key = 0; key < count; ++key )
+		pairs.emplace_back( key, new int32_t( -1 ) );
+
+	try {
+		hash_t hash( pairs.begin(), pairs.end(), nullptr, nullptr, args... );
+		if ( EXIT_SUCCESS != check_keys( hash, count, true, what ) )
+			result = EXIT_FAILURE;
+
+		// The hash must still work normally after bulk loading
+		hash.add( count, new int32_t( count * 3 ) );
+		if ( EXIT_SUCCESS != check_keys( hash, count + 1, true, what ) )
+			result = EXIT_FAILURE;
+	} catch ( pwx::CException &e ) {
+		log_error( nullptr, "%s: %s - %s", what, e.name(), e.what() );
+		result = EXIT_FAILURE;
+	}
+
+	for ( int32_t i = count; i < 2 * count; ++i )
+		delete pairs[i].second;
+
+	return result;
+}
+
+
+/// @internal Move a hash by construction and assignment, the moved-from hash must stay usable
+template<typename hash_t, typename... Args>
+static int test_move( char const* what, Args... args ) {
+	int result = EXIT_SUCCESS;
+
+	try {
+		hash_t src( 7, nullptr, nullptr, args... );
+		fill_keys( src, 500 );
+
+		hash_t dst( std::move( src ) );
+		if ( EXIT_SUCCESS != check_keys( dst, 500, true, what ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != check_keys( src, 0, true, what ) )
+			result = EXIT_FAILURE;
+
+		// The table left to src must fit its settings
+		fill_keys( src, 300 );
+		if ( EXIT_SUCCESS != check_keys( src, 300, true, what ) )
+			result = EXIT_FAILURE;
+
+		dst = std::move( src );
+		if ( EXIT_SUCCESS != check_keys( dst, 300, true, what ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != check_keys( src, 0, true, what ) )
+			result = EXIT_FAILURE;
+
+		fill_keys( src, 100 );
+		if ( EXIT_SUCCESS != check_keys( src, 100, true, what ) )
+			result = EXIT_FAILURE;
+	} catch ( pwx::CException &e ) {
+		log_error( nullptr, "%s: %s - %s", what, e.name(), e.what() );
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	// Incremental growing combined with the thread safety toggles
+	{
+		chash_t chash( 7, nullptr, nullptr, 3.0, 2.0 );
+		if ( EXIT_SUCCESS != test_incremental_toggle( chash, "TChainHash incremental toggle" ) )
+			result = EXIT_FAILURE;
+
+		ohash_t ohash( 7, nullptr, nullptr, 0.8, 2.0 );
+		if ( EXIT_SUCCESS != test_incremental_toggle( ohash, "TOpenHash incremental toggle" ) )
+			result = EXIT_FAILURE;
+	}
+
+	// Bulk constructors
+	if ( EXIT_SUCCESS != test_bulk_ctor<chash_t>( "TChainHash bulk", 3.0, 1.25 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_bulk_ctor<ohash_t>( "TOpenHash bulk double hash", 0.8, 1.5, pwx::OHM_DoubleHash ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_bulk_ctor<ohash_t>( "TOpenHash bulk pow2 linear", 0.8, 1.5, pwx::OHM_PowerLinear ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_bulk_ctor<ohash_t>( "TOpenHash bulk pow2 quadratic", 0.8, 1.5, pwx::OHM_PowerQuadratic ) )
+		result = EXIT_FAILURE;
+
+	// Moving, and reusing what was moved from
+	if ( EXIT_SUCCESS != test_move<chash_t>( "TChainHash move", 3.0, 2.0 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<ohash_t>( "TOpenHash move double hash", 0.8, 2.0, pwx::OHM_DoubleHash ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<ohash_t>( "TOpenHash move pow2 linear", 0.8, 2.0, pwx::OHM_PowerLinear ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<ohash_t>( "TOpenHash move pow2 quadratic", 0.8, 2.0, pwx::OHM_PowerQuadratic ) )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
@@ -0,0 +1,185 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PDoubleList>
+#include <PSingleList>
+#include <PLog>
+
+#include <utility>
+#include <vector>
+
+
+typedef PSingleList<int32_t>  slist_t;
+typedef PDoubleList<int32_t>  dlist_t;
+typedef std::vector<int32_t> model_t;
+
+
+/// @internal Check that @a list holds exactly what @a model holds, in the same order
+template<typename list_t>
+static int check_list( list_t &list, model_t const &model, char const* what, char const* step ) {
+	if ( model.size() != list.size() ) {
+		log_error( nullptr, "%s %s: size() is %u/%u", what, step,
+		           list.size(), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	// Positional access, which uses the index if there is one
+	for ( uint32_t i = 0; i < model.size(); ++i ) {
+		auto* elem = list.get( static_cast<int32_t>( i ) );
+		if ( !elem || ( model[i] != **elem ) ) {
+			log_error( nullptr, "%s %s: get(%u) is %d, should be %d", what, step,
+			           i, elem ? **elem : -1, model[i] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Negative indexes count from the end
+	if ( !model.empty() && ( model.back() != **list.get( -1 ) ) ) {
+		log_error( nullptr, "%s %s: get(-1) is %d, should be %d", what, step, **list.get( -1 ), model.back() );
+		return EXIT_FAILURE;
+	}
+
+	// Walking the list must give the same order
+	uint32_t i = 0;
+	for ( auto* elem = list.get( 0 ); elem && ( i < model.size() ); elem = elem->getNext(), ++i ) {
+		if ( model[i] != **elem ) {
+			log_error( nullptr, "%s %s: element %u is %d, should be %d", what, step, i, **elem, model[i] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal remove the element at @a index of a singly linked list
+static void rem_at( slist_t &list, int32_t index ) {
+	list.delNextElem( index ? list.get( index - 1 ) : nullptr );
+}
+
+
+/// @internal remove the element at @a index of a doubly linked list
+static void rem_at( dlist_t &list, int32_t index ) {
+	list.delElem( list.get( index ) );
+}
+
+
+/// @internal Insert, remove and move with an indexed list, and switch the index off again
+template<typename list_t>
+static int test_index( char const* what ) {
+	list_t  list;
+	model_t model;
+
+	for ( int32_t i = 0; i < 100; ++i ) {
+		list.push_back( new int32_t( i ) );
+		model.push_back( i );
+	}
+
+	list.enable_indexing();
+	if ( !list.is_indexed() ) {
+		log_error( nullptr, "%s: enable_indexing() had no effect", what );
+		return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_list( list, model, what, "enable_indexing" ) )
+		return EXIT_FAILURE;
+
+	// insAt() at the front, the back, the middle and out of range
+	int32_t next = 100;
+	for ( int32_t i = 0; i < 200; ++i, ++next ) {
+		int32_t pos = ( i * 37 ) % ( static_cast<int32_t>( model.size() ) + 1 );
+		list.insAt( pos, new int32_t( next ) );
+		model.insert( model.begin() + pos, next );
+	}
+	list.insAt( 0, new int32_t( next ) );
+	model.insert( model.begin(), next++ );
+	list.insAt( -1, new int32_t( next ) );
+	model.push_back( next++ );
+	list.insAt( 100000, new int32_t( next ) );
+	model.push_back( next++ );
+	if ( EXIT_SUCCESS != check_list( list, model, what, "insAt" ) )
+		return EXIT_FAILURE;
+
+	// Removing from the front, the back and in between
+	for ( int32_t i = 0; i < 150; ++i ) {
+		int32_t pos = ( i * 53 ) % static_cast<int32_t>( model.size() );
+		rem_at( list, pos );
+		model.erase( model.begin() + pos );
+	}
+	rem_at( list, 0 );
+	model.erase( model.begin() );
+	rem_at( list, static_cast<int32_t>( model.size() ) - 1 );
+	model.pop_back();
+	if ( EXIT_SUCCESS != check_list( list, model, what, "remove" ) )
+		return EXIT_FAILURE;
+
+	// Moving takes the index along and leaves an empty, unindexed list behind
+	list_t moved( std::move( list ) );
+	if ( !moved.is_indexed() || list.is_indexed() ) {
+		log_error( nullptr, "%s: move constructor: moved is %sindexed, source is %sindexed", what,
+		           moved.is_indexed() ? "" : "not ", list.is_indexed() ? "" : "not " );
+		return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_list( moved, model, what, "move constructor" ) )
+		return EXIT_FAILURE;
+	if ( EXIT_SUCCESS != check_list( list, model_t(), what, "moved-from" ) )
+		return EXIT_FAILURE;
+
+	list = std::move( moved );
+	if ( !list.is_indexed() || EXIT_SUCCESS != check_list( list, model, what, "move assignment" ) )
+		return EXIT_FAILURE;
+
+	list.insAt( 5, new int32_t( next ) );
+	model.insert( model.begin() + 5, next++ );
+	if ( EXIT_SUCCESS != check_list( list, model, what, "insAt after move" ) )
+		return EXIT_FAILURE;
+
+	// Without the index everything must still be the same
+	list.disable_indexing();
+	if ( list.is_indexed() ) {
+		log_error( nullptr, "%s: disable_indexing() had no effect", what );
+		return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_list( list, model, what, "disable_indexing" ) )
+		return EXIT_FAILURE;
+
+	list.insAt( 7, new int32_t( next ) );
+	model.insert( model.begin() + 7, next++ );
+	rem_at( list, 3 );
+	model.erase( model.begin() + 3 );
+	if ( EXIT_SUCCESS != check_list( list, model, what, "unindexed insAt and remove" ) )
+		return EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_index<slist_t>( "TSingleList" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_index<dlist_t>( "TDoubleList" ) )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
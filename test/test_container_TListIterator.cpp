@@ -0,0 +1,268 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PDoubleList>
+#include <PDoubleRing>
+#include <PSingleList>
+#include <PSingleRing>
+#include <PLog>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+typedef PDoubleList<int32_t> dlist_t;
+typedef std::vector<int32_t> model_t;
+
+
+/// @internal Check that iterating @a list from begin() to end() yields exactly @a model
+template<typename list_t>
+static int check_forward( list_t const &list, model_t const &model, char const* what ) {
+	model_t seen;
+	for ( auto it = list.begin(); it != list.end(); ++it ) {
+		seen.push_back( *it );
+		if ( seen.size() > model.size() )
+			break; // A ring that does not stop
+	}
+
+	if ( seen != model ) {
+		log_error( nullptr, "%s: iterated %u values, should be %u", what,
+		           static_cast<uint32_t>( seen.size() ), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Iterate, search, sum up and write through the iterators of a list or ring
+template<typename list_t>
+static int test_iterate( char const* what ) {
+	list_t  list;
+	model_t model;
+
+	if ( list.begin() != list.end() ) {
+		log_error( nullptr, "%s: begin() of an empty list is not end()", what );
+		return EXIT_FAILURE;
+	}
+
+	for ( int32_t i = 0; i < 50; ++i ) {
+		list.push_back( new int32_t( i ) );
+		model.push_back( i );
+	}
+	if ( EXIT_SUCCESS != check_forward( list, model, what ) )
+		return EXIT_FAILURE;
+
+	// Algorithms work on the data
+	int32_t sum = std::accumulate( list.cbegin(), list.cend(), 0 );
+	if ( std::accumulate( model.begin(), model.end(), 0 ) != sum ) {
+		log_error( nullptr, "%s: std::accumulate() gives %d", what, sum );
+		return EXIT_FAILURE;
+	}
+	auto found = std::find( list.begin(), list.end(), 42 );
+	if ( ( found == list.end() ) || ( 42 != *found ) || ( 42 != **found.elem() ) ) {
+		log_error( nullptr, "%s: std::find() did not find 42", what );
+		return EXIT_FAILURE;
+	}
+
+	// Read/write iterators change the data, and convert into read only ones
+	for ( auto &data : list )
+		data *= 2;
+	for ( auto &data : model )
+		data *= 2;
+	typename list_t::const_iterator cit = list.begin();
+	if ( ( 0 != *cit ) || ( 2 != *( ++cit ) ) ) {
+		log_error( nullptr, "%s: writing through the iterator failed", what );
+		return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_forward( list, model, what ) )
+		return EXIT_FAILURE;
+
+	// Post increment returns the old position
+	auto it  = list.begin();
+	auto old = it++;
+	if ( ( old != list.begin() ) || ( model[1] != *it ) ) {
+		log_error( nullptr, "%s: post increment is wrong", what );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Walking a list or ring of doubly linked elements backwards
+template<typename list_t>
+static int test_backwards( char const* what ) {
+	list_t  list;
+	model_t model;
+
+	for ( int32_t i = 0; i < 50; ++i ) {
+		list.push_back( new int32_t( i ) );
+		model.push_back( i );
+	}
+
+	model_t seen;
+	std::reverse( model.begin(), model.end() );
+	std::copy( std::make_reverse_iterator( list.end() ), std::make_reverse_iterator( list.begin() ),
+	           std::back_inserter( seen ) );
+	if ( seen != model ) {
+		log_error( nullptr, "%s: walking backwards iterated %u values, should be %u", what,
+		           static_cast<uint32_t>( seen.size() ), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal A snapshot must see the same values as the list while nobody changes it
+static int test_snapshot() {
+	dlist_t list;
+
+	if ( !list.snapshot().empty() ) {
+		log_error( nullptr, "%s", "snapshot of an empty list is not empty" );
+		return EXIT_FAILURE;
+	}
+
+	model_t model;
+	for ( int32_t i = 0; i < 20; ++i ) {
+		list.push_back( new int32_t( i ) );
+		model.push_back( i );
+	}
+
+	model_t seen;
+	for ( auto const &data : list.snapshot() )
+		seen.push_back( data );
+	if ( seen != model ) {
+		log_error( nullptr, "snapshot: iterated %u values, should be %u",
+		           static_cast<uint32_t>( seen.size() ), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	// Two snapshots at once
+	auto const &snapA = list.snapshot();
+	auto const &snapB = list.snapshot();
+	if ( !std::equal( snapA.begin(), snapA.end(), snapB.begin(), snapB.end() ) ) {
+		log_error( nullptr, "%s", "snapshot: two snapshots of the same list differ" );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/** @internal Walk a snapshot while another thread removes and inserts elements in between
+  *
+  * The even values are never removed, and the first and last element are
+  * fixed by the snapshot. The writer removes the odd values and inserts
+  * values of `count` and up behind each multiple of four.
+**/
+static int test_snapshot_concurrent() {
+	const int32_t count = 2000;
+	dlist_t          list;
+	std::atomic_bool started { false };
+	std::vector<dlist_t::elem_type*> removed;
+
+	for ( int32_t i = 0; i < count; ++i )
+		list.push_back( new int32_t( i ) );
+
+	int         result = EXIT_SUCCESS;
+	std::thread writer;
+	{
+		auto const &snap = list.snapshot();
+
+		writer = std::thread( [&list, &started, &removed, count]() {
+			started.store( true );
+			for ( int32_t i = 1; i < count - 1; ++i ) {
+				int32_t value = i;
+				auto*   elem  = list.find( value );
+				if ( i % 2 )
+					removed.push_back( list.remElem( elem ) );
+				else if ( 0 == ( i % 4 ) )
+					list.insNextElem( elem, new int32_t( count + i ) );
+			}
+		} );
+		while ( !started.load() )
+			std::this_thread::yield();
+
+		for ( int32_t round = 0; ( EXIT_SUCCESS == result ) && ( round < 20 ); ++round ) {
+			int32_t expected = 0; // The next even value that must show up
+			int32_t lastOld  = -1;
+			for ( auto it = snap.begin(); it != snap.end(); ++it ) {
+				int32_t value = *it;
+				if ( value >= count )
+					continue; // Inserted by the writer
+				if ( value <= lastOld ) {
+					log_error( nullptr, "snapshot concurrent: %d follows %d", value, lastOld );
+					result = EXIT_FAILURE;
+				}
+				if ( value == expected )
+					expected += 2;
+				lastOld = value;
+			}
+			if ( ( count != expected ) || ( count - 1 != lastOld ) ) {
+				log_error( nullptr, "snapshot concurrent: round %d ended with %d, next even value %d",
+				           round, lastOld, expected );
+				result = EXIT_FAILURE;
+			}
+		}
+	} // The writer might wait for the snapshot to end
+
+	writer.join();
+	for ( auto* elem : removed )
+		delete elem;
+
+	if ( static_cast<uint32_t>( count / 2 + count / 4 ) != list.size() ) {
+		log_error( nullptr, "snapshot concurrent: %u elements left", list.size() );
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_iterate<PSingleList<int32_t> >( "single list" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_iterate<PDoubleList<int32_t> >( "double list" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_iterate<PSingleRing<int32_t> >( "single ring" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_iterate<PDoubleRing<int32_t> >( "double ring" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_backwards<PDoubleList<int32_t> >( "double list" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_backwards<PDoubleRing<int32_t> >( "double ring" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_snapshot() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_snapshot_concurrent() )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
@@ -0,0 +1,179 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PDoubleList>
+#include <PDoubleRing>
+#include <PQueue>
+#include <PSet>
+#include <PSingleList>
+#include <PSingleRing>
+#include <PStack>
+#include <PLog>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+typedef std::vector<int32_t> model_t;
+
+
+// Moving must never allocate, so it can not throw. Only TSet has to build a new lookup hash.
+static_assert( std::is_nothrow_move_constructible<PSingleList<int32_t> >::value, "TSingleList move ctor may throw" );
+static_assert( std::is_nothrow_move_constructible<PDoubleList<int32_t> >::value, "TDoubleList move ctor may throw" );
+static_assert( std::is_nothrow_move_constructible<PSingleRing<int32_t> >::value, "TSingleRing move ctor may throw" );
+static_assert( std::is_nothrow_move_constructible<PDoubleRing<int32_t> >::value, "TDoubleRing move ctor may throw" );
+static_assert( std::is_nothrow_move_constructible<PStack<int32_t> >::value,      "TStack move ctor may throw" );
+static_assert( std::is_nothrow_move_constructible<PQueue<int32_t> >::value,      "TQueue move ctor may throw" );
+static_assert( std::is_nothrow_move_assignable<PSingleList<int32_t> >::value,    "TSingleList move assignment may throw" );
+static_assert( std::is_nothrow_move_assignable<PDoubleList<int32_t> >::value,    "TDoubleList move assignment may throw" );
+static_assert( std::is_nothrow_move_assignable<PSingleRing<int32_t> >::value,    "TSingleRing move assignment may throw" );
+static_assert( std::is_nothrow_move_assignable<PDoubleRing<int32_t> >::value,    "TDoubleRing move assignment may throw" );
+static_assert( std::is_nothrow_move_assignable<PStack<int32_t> >::value,         "TStack move assignment may throw" );
+static_assert( std::is_nothrow_move_assignable<PQueue<int32_t> >::value,         "TQueue move assignment may throw" );
+static_assert( std::is_nothrow_move_assignable<PSet<int32_t> >::value,           "TSet move assignment may throw" );
+
+
+/// @internal Return the values of @a list in iteration order
+template<typename list_t>
+static model_t values_of( list_t &list ) {
+	model_t result;
+	for ( auto const &value : list ) {
+		result.push_back( value );
+		if ( result.size() > list.size() )
+			break; // A ring that does not stop
+	}
+	return result;
+}
+
+
+/// @internal Check that @a list holds exactly the values of @a model, in the same order
+template<typename list_t>
+static int check_values( list_t &list, model_t const &model, char const* what, char const* step ) {
+	if ( model.size() != list.size() ) {
+		log_error( nullptr, "%s %s: size() is %u/%u", what, step,
+		           list.size(), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+	if ( values_of( list ) != model ) {
+		log_error( nullptr, "%s %s: the values differ", what, step );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Add @a first to @a first + @a count - 1 to @a list
+template<typename list_t>
+static void fill_values( list_t &list, int32_t first, int32_t count ) {
+	for ( int32_t i = first; i < first + count; ++i )
+		list.push_back( new int32_t( i ) );
+}
+
+
+/// @internal Move a list by construction and assignment, the moved-from list must stay usable
+template<typename list_t>
+static int test_move( char const* what ) {
+	model_t const empty;
+	list_t        src;
+	fill_values( src, 0, 100 );
+	model_t model = values_of( src );
+
+	list_t dst( std::move( src ) );
+	if ( EXIT_SUCCESS != check_values( dst, model, what, "move ctor" ) )
+		return EXIT_FAILURE;
+	if ( EXIT_SUCCESS != check_values( src, empty, what, "moved-from" ) )
+		return EXIT_FAILURE;
+
+	// Both must keep working on their own
+	list_t refSrc, refDst;
+	fill_values( src, 200, 50 );
+	fill_values( refSrc, 200, 50 );
+	if ( EXIT_SUCCESS != check_values( src, values_of( refSrc ), what, "refilled" ) )
+		return EXIT_FAILURE;
+	fill_values( dst, 100, 10 );
+	fill_values( refDst, 0, 110 );
+	if ( EXIT_SUCCESS != check_values( dst, values_of( refDst ), what, "extended" ) )
+		return EXIT_FAILURE;
+
+	dst = std::move( src );
+	if ( EXIT_SUCCESS != check_values( dst, values_of( refSrc ), what, "move assignment" ) )
+		return EXIT_FAILURE;
+	if ( EXIT_SUCCESS != check_values( src, empty, what, "assigned-from" ) )
+		return EXIT_FAILURE;
+
+	fill_values( src, 300, 5 );
+	if ( 5 != src.size() ) {
+		log_error( nullptr, "%s: the assigned-from list holds %u values after reuse", what, src.size() );
+		return EXIT_FAILURE;
+	}
+
+	// A list that was moved from twice has nothing to hand over the second time
+	list_t first( std::move( src ) );
+	list_t second( std::move( src ) );
+	if ( ( 5 != first.size() ) || !second.empty() || !src.empty() || src.get( 0 ) ) {
+		log_error( nullptr, "%s: moving twice left %u/%u/%u values", what,
+		           first.size(), second.size(), src.size() );
+		return EXIT_FAILURE;
+	}
+	list_t refTwice, refSecond;
+	fill_values( src, 400, 3 );
+	fill_values( refTwice, 400, 3 );
+	fill_values( second, 500, 4 );
+	fill_values( refSecond, 500, 4 );
+	if ( EXIT_SUCCESS != check_values( src, values_of( refTwice ), what, "moved twice, refilled" ) )
+		return EXIT_FAILURE;
+	if ( EXIT_SUCCESS != check_values( second, values_of( refSecond ), what, "moved from moved, refilled" ) )
+		return EXIT_FAILURE;
+
+	// Positional access must work with the moved elements
+	if ( !dst.get( 10 ) || ( **refSrc.get( 10 ) != **dst.get( 10 ) ) ) {
+		log_error( nullptr, "%s: get(10) after the move assignment is wrong", what );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_move<PSingleList<int32_t> >( "TSingleList" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<PDoubleList<int32_t> >( "TDoubleList" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<PSingleRing<int32_t> >( "TSingleRing" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<PDoubleRing<int32_t> >( "TDoubleRing" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<PStack<int32_t> >( "TStack" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<PQueue<int32_t> >( "TQueue" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_move<PSet<int32_t> >( "TSet" ) )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
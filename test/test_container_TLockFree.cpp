@@ -0,0 +1,345 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PBoundedQueue>
+#include <PLockFreeQueue>
+#include <PLockFreeStack>
+#include <PLog>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+typedef PLockFreeStack<uint64_t> stack_t;
+typedef PLockFreeQueue<uint64_t> lf_queue_t;
+typedef PBoundedQueue<uint64_t>  bd_queue_t;
+
+
+static std::atomic<uint32_t> destroyed { 0 }; //!< Number of data destroyed by count_destroy()
+
+
+/// @internal destroy method that counts its calls
+static void count_destroy( uint64_t* data ) {
+	destroyed.fetch_add( 1 );
+	delete data;
+}
+
+
+/// @internal Return true if @a func throws a pwx::CException named @a name
+template< typename func_t >
+static bool throws( char const* name, func_t func ) {
+	try {
+		func();
+	} catch ( pwx::CException &e ) {
+		return 0 == strcmp( name, e.name() );
+	}
+	return false;
+}
+
+
+/// @internal push(), try_pop() and pop() must work from the top, and the errors must be thrown
+static int test_stack_basic() {
+	stack_t stack;
+
+	for ( uint64_t nr = 1; nr <= 100; ++nr ) {
+		if ( nr != stack.push( new uint64_t( nr ) ) ) {
+			log_error( nullptr, "stack: push %lu left %u data", nr, stack.size() );
+			return EXIT_FAILURE;
+		}
+	}
+
+	for ( uint64_t nr = 100; nr > 0; --nr ) {
+		uint64_t* data = 0 == ( nr % 2 ) ? stack.try_pop() : stack.pop();
+		if ( !data || ( nr != *data ) ) {
+			log_error( nullptr, "stack: popped %lu, should be %lu", data ? *data : 0UL, nr );
+			delete data;
+			return EXIT_FAILURE;
+		}
+		delete data;
+	}
+
+	if ( !stack.empty() || stack.size() || stack.try_pop() ) {
+		log_error( nullptr, "stack: not empty with %u data", stack.size() );
+		return EXIT_FAILURE;
+	}
+	if ( !throws( "OutOfRange", [ &stack ]() { stack.pop(); } ) ) {
+		log_error( nullptr, "%s", "stack: pop() of an empty stack did not throw OutOfRange" );
+		return EXIT_FAILURE;
+	}
+	if ( !throws( "NullDataException", [ &stack ]() { stack.push( nullptr ); } ) || !stack.empty() ) {
+		log_error( nullptr, "%s", "stack: push( nullptr ) did not throw NullDataException" );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal pop_all() must hand over everything from the top to the bottom
+static int test_stack_pop_all() {
+	stack_t               stack( count_destroy );
+	std::vector<uint64_t> popped;
+
+	if ( 0 != stack.pop_all( [ &popped ]( uint64_t* data ) { popped.push_back( *data ); delete data; } ) ) {
+		log_error( nullptr, "%s", "pop_all: an empty stack handed out data" );
+		return EXIT_FAILURE;
+	}
+
+	for ( uint64_t nr = 1; nr <= 10; ++nr )
+		stack.push( new uint64_t( nr ) );
+
+	uint32_t count = stack.pop_all( [ &popped ]( uint64_t* data ) {
+		popped.push_back( *data );
+		delete data;
+	} );
+
+	if ( ( 10 != count ) || ( 10 != popped.size() ) || !stack.empty() || stack.size() ) {
+		log_error( nullptr, "pop_all: handed out %u of 10 data, %u left", count, stack.size() );
+		return EXIT_FAILURE;
+	}
+	for ( uint64_t idx = 0; idx < 10; ++idx ) {
+		if ( ( 10 - idx ) != popped[idx] ) {
+			log_error( nullptr, "pop_all: data %lu is %lu, should be %lu", idx, popped[idx], 10 - idx );
+			return EXIT_FAILURE;
+		}
+	}
+
+	// The stack is still usable afterwards
+	stack.push( new uint64_t( 42 ) );
+	uint64_t* data = stack.try_pop();
+	if ( !data || ( 42 != *data ) || !stack.empty() ) {
+		log_error( nullptr, "%s", "pop_all: the stack is broken afterwards" );
+		delete data;
+		return EXIT_FAILURE;
+	}
+	delete data;
+
+	return destroyed.load() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+/// @internal If the pop_all() callback throws, the data not handed out yet must be destroyed
+static int test_stack_pop_all_throw() {
+	stack_t  stack( count_destroy );
+	uint32_t handed = 0;
+	bool     caught = false;
+
+	destroyed.store( 0 );
+	for ( uint64_t nr = 1; nr <= 10; ++nr )
+		stack.push( new uint64_t( nr ) );
+
+	try {
+		stack.pop_all( [ &handed ]( uint64_t* data ) {
+			// The callback owns all data it gets, even the one it throws on
+			++handed;
+			bool fail = ( 7 == *data );
+			delete data;
+			if ( fail )
+				throw std::runtime_error( "callback failed" );
+		} );
+	} catch ( std::runtime_error & ) {
+		caught = true;
+	}
+
+	if ( !caught || ( 4 != handed ) || ( 6 != destroyed.load() ) || !stack.empty() || stack.size() ) {
+		log_error( nullptr, "pop_all throw: %s, %u handed out, %u destroyed, %u left",
+		           caught ? "caught" : "not caught", handed, destroyed.load(), stack.size() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal push(), try_pop() and pop() must work in order, and the errors must be thrown
+template< typename queue_t >
+static int test_queue_basic( queue_t &queue, uint64_t count, char const* what ) {
+	// Several rounds, so a ring is used in more than one lap
+	for ( uint64_t round = 0; round < 5; ++round ) {
+		for ( uint64_t nr = 1; nr <= count; ++nr ) {
+			if ( nr != queue.push( new uint64_t( nr ) ) ) {
+				log_error( nullptr, "%s: push %lu left %u data", what, nr, queue.size() );
+				return EXIT_FAILURE;
+			}
+		}
+
+		for ( uint64_t nr = 1; nr <= count; ++nr ) {
+			uint64_t* data = 0 == ( nr % 2 ) ? queue.try_pop() : queue.pop();
+			if ( !data || ( nr != *data ) ) {
+				log_error( nullptr, "%s: popped %lu, should be %lu", what, data ? *data : 0UL, nr );
+				delete data;
+				return EXIT_FAILURE;
+			}
+			delete data;
+		}
+	}
+
+	if ( !queue.empty() || queue.size() || queue.try_pop() ) {
+		log_error( nullptr, "%s: not empty with %u data", what, queue.size() );
+		return EXIT_FAILURE;
+	}
+	if ( !throws( "OutOfRange", [ &queue ]() { queue.pop(); } ) ) {
+		log_error( nullptr, "%s: pop() of an empty queue did not throw OutOfRange", what );
+		return EXIT_FAILURE;
+	}
+	if ( !throws( "NullDataException", [ &queue ]() { queue.push( nullptr ); } ) || !queue.empty() ) {
+		log_error( nullptr, "%s: push( nullptr ) did not throw NullDataException", what );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal try_push() must refuse data when the ring is full, and the ring must hold its capacity
+static int test_bounded_full() {
+	bd_queue_t queue( 5, count_destroy );
+
+	if ( 8 != queue.capacity_max() ) {
+		log_error( nullptr, "bounded: capacity 5 became %u, should be 8", queue.capacity_max() );
+		return EXIT_FAILURE;
+	}
+
+	for ( uint64_t nr = 1; nr <= 8; ++nr ) {
+		if ( !queue.try_push( new uint64_t( nr ) ) ) {
+			log_error( nullptr, "bounded: try_push %lu failed", nr );
+			return EXIT_FAILURE;
+		}
+	}
+
+	uint64_t* data = new uint64_t( 9 );
+	if ( queue.try_push( data ) || ( 8 != queue.size() ) ) {
+		log_error( nullptr, "bounded: a full queue took data, size is %u", queue.size() );
+		return EXIT_FAILURE;
+	}
+	delete data;
+
+	if ( !throws( "NullDataException", [ &queue ]() { queue.try_push( nullptr ); } ) ) {
+		log_error( nullptr, "%s", "bounded: try_push( nullptr ) did not throw NullDataException" );
+		return EXIT_FAILURE;
+	}
+
+	// Freeing one cell makes room for exactly one more
+	data = queue.pop();
+	delete data;
+	data = new uint64_t( 9 );
+	if ( !queue.try_push( data ) ) {
+		log_error( nullptr, "%s", "bounded: a freed cell could not be used" );
+		delete data;
+		return EXIT_FAILURE;
+	}
+
+	destroyed.store( 0 );
+	queue.clear();
+	if ( ( 8 != destroyed.load() ) || !queue.empty() ) {
+		log_error( nullptr, "bounded: clear() destroyed %u of 8 data", destroyed.load() );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/** @internal Let producers and consumers work on @a cont at the same time
+  *
+  * Every producer pushes the numbers 1 to @a count, consumers pop until
+  * all are handed over. Nothing may be lost or popped twice, so the sum
+  * of all popped numbers must be exactly the sum of all pushed numbers.
+**/
+template< typename cont_t >
+static int test_mpmc( cont_t &cont, uint32_t producers, uint32_t consumers, uint64_t count, char const* what ) {
+	std::atomic<uint64_t>    popped { 0 };
+	std::atomic<uint64_t>    sum    { 0 };
+	std::vector<std::thread> threads;
+	uint64_t                 total  = count * producers;
+
+	for ( uint32_t nr = 0; nr < consumers; ++nr ) {
+		threads.emplace_back( [ &cont, &popped, &sum, total ]() {
+			uint64_t mySum = 0;
+			while ( popped.load() < total ) {
+				uint64_t* data = cont.try_pop();
+				if ( data ) {
+					mySum += *data;
+					delete data;
+					popped.fetch_add( 1 );
+				} else
+					std::this_thread::yield();
+			}
+			sum.fetch_add( mySum );
+		} );
+	}
+
+	for ( uint32_t nr = 0; nr < producers; ++nr ) {
+		threads.emplace_back( [ &cont, count ]() {
+			for ( uint64_t value = 1; value <= count; ++value )
+				cont.push( new uint64_t( value ) );
+		} );
+	}
+
+	for ( auto &thread : threads )
+		thread.join();
+
+	uint64_t expected = producers * ( count * ( count + 1 ) / 2 );
+	if ( ( expected != sum.load() ) || ( total != popped.load() ) || !cont.empty() ) {
+		log_error( nullptr, "%s: popped %lu of %lu data, sum %lu, should be %lu", what,
+		           popped.load(), total, sum.load(), expected );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_stack_basic() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_stack_pop_all() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_stack_pop_all_throw() )
+		result = EXIT_FAILURE;
+
+	lf_queue_t lfQueue;
+	bd_queue_t bdQueue( 64 );
+	if ( EXIT_SUCCESS != test_queue_basic( lfQueue, 100, "lock-free queue" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_queue_basic( bdQueue, 64, "bounded queue" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_bounded_full() )
+		result = EXIT_FAILURE;
+
+	stack_t    stack;
+	bd_queue_t smallQueue( 16 );
+	if ( EXIT_SUCCESS != test_mpmc( stack, 4, 4, 20000, "stack threads" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_mpmc( lfQueue, 4, 4, 20000, "lock-free queue threads" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_mpmc( smallQueue, 4, 4, 20000, "bounded queue threads" ) )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
@@ -0,0 +1,149 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PSet>
+#include <PLog>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+
+typedef PSet<int32_t>        set_t;
+typedef std::vector<int32_t> model_t;
+
+
+/// @internal Return the members of @a set in sorted order
+static model_t sorted_of( set_t const &set ) {
+	model_t result( set.begin(), set.end() );
+	std::sort( result.begin(), result.end() );
+	return result;
+}
+
+
+/// @internal Add every value from @a first to @a last - 1 that is a multiple of @a step
+static void fill_set( set_t &set, int32_t first, int32_t last, int32_t step ) {
+	for ( int32_t i = first; i < last; ++i ) {
+		if ( 0 == ( i % step ) )
+			set.push( new int32_t( i ) );
+	}
+}
+
+
+/// @internal Check that @a par holds the same members as @a serial, and delete both
+static int check_same( set_t* serial, set_t* par, char const* what ) {
+	int result = EXIT_SUCCESS;
+
+	if ( !serial || !par ) {
+		log_error( nullptr, "%s: no result set", what );
+		result = EXIT_FAILURE;
+	} else if ( sorted_of( *serial ) != sorted_of( *par ) ) {
+		log_error( nullptr, "%s: %u members, the serial version has %u", what, par->size(), serial->size() );
+		result = EXIT_FAILURE;
+	}
+
+	delete serial;
+	delete par;
+	return result;
+}
+
+
+/// @internal Check that the in place version turns a copy of @a lhs into @a serial and returns its size
+template<typename func_t>
+static int check_inplace( set_t const &lhs, set_t const &rhs, set_t* serial, func_t func, char const* what ) {
+	set_t*   copy  = new set_t( lhs );
+	uint32_t count = func( copy, &rhs );
+
+	if ( count != copy->size() ) {
+		log_error( nullptr, "%s: returned %u, but %u members are left", what, count, copy->size() );
+		delete serial;
+		delete copy;
+		return EXIT_FAILURE;
+	}
+
+	return check_same( serial, copy, what );
+}
+
+
+/// @internal Compare the parallel set functions with the serial ones for @a lhs and @a rhs
+static int test_compare( set_t const &lhs, set_t const &rhs, char const* what ) {
+	int result = EXIT_SUCCESS;
+
+	try {
+		if ( EXIT_SUCCESS != check_same( pwx::set_difference( &lhs, &rhs ),
+		                                 pwx::set_difference_par( &lhs, &rhs ), what ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != check_same( pwx::set_intersection( &lhs, &rhs ),
+		                                 pwx::set_intersection_par( &lhs, &rhs ), what ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != check_same( pwx::set_union( &lhs, &rhs ),
+		                                 pwx::set_union_par( &lhs, &rhs ), what ) )
+			result = EXIT_FAILURE;
+
+		if ( EXIT_SUCCESS != check_inplace( lhs, rhs, pwx::set_difference( &lhs, &rhs ),
+		                                    pwx::set_difference_par_inplace<int32_t>, what ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != check_inplace( lhs, rhs, pwx::set_intersection( &lhs, &rhs ),
+		                                    pwx::set_intersection_par_inplace<int32_t>, what ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != check_inplace( lhs, rhs, pwx::set_union( &lhs, &rhs ),
+		                                    pwx::set_union_par_inplace<int32_t>, what ) )
+			result = EXIT_FAILURE;
+	} catch ( pwx::CException &e ) {
+		log_error( nullptr, "%s: %s - %s", what, e.name(), e.what() );
+		result = EXIT_FAILURE;
+	}
+
+	return result;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	{
+		// Small sets are handled by the calling thread
+		set_t lhs, rhs, empty;
+		fill_set( lhs, 0, 300, 2 );
+		fill_set( rhs, 100, 400, 3 );
+		if ( EXIT_SUCCESS != test_compare( lhs, rhs, "small" ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != test_compare( lhs, empty, "empty rhs" ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != test_compare( empty, rhs, "empty lhs" ) )
+			result = EXIT_FAILURE;
+		if ( EXIT_SUCCESS != test_compare( lhs, lhs, "same set" ) )
+			result = EXIT_FAILURE;
+	}
+
+	{
+		// Large enough for several workers
+		set_t lhs, rhs;
+		fill_set( lhs, 0, 12000, 2 );
+		fill_set( rhs, 4000, 16000, 3 );
+		if ( EXIT_SUCCESS != test_compare( lhs, rhs, "large" ) )
+			result = EXIT_FAILURE;
+	}
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
@@ -0,0 +1,285 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PSwissHash>
+#include <PLog>
+
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <random>
+
+
+typedef PSwissHash<int32_t, int32_t>  hash_t;
+typedef std::map<int32_t, int32_t>    model_t;
+
+
+/// @internal Check that @a hash holds exactly the keys and data of @a model, looking at all keys below @a keyRange
+static int check_model( hash_t const &hash, model_t const &model, int32_t keyRange, char const* what ) {
+	if ( model.size() != hash.size() ) {
+		log_error( nullptr, "%s: size() is %u, should be %u", what, hash.size(), static_cast<uint32_t>( model.size() ) );
+		return EXIT_FAILURE;
+	}
+
+	for ( int32_t key = 0; key < keyRange; ++key ) {
+		auto  found = model.find( key );
+		auto* elem  = hash.get( key );
+
+		if ( found == model.end() ) {
+			if ( elem || hash.exists( key ) ) {
+				log_error( nullptr, "%s: removed key %d is still found", what, key );
+				return EXIT_FAILURE;
+			}
+		} else if ( !elem || !hash.exists( key ) || ( found->second != **elem ) ) {
+			log_error( nullptr, "%s: key %d %s", what, key, elem ? "has wrong data" : "is missing" );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Add @a key with @a value to both @a hash and @a model, an existing key must keep its data
+static int add_key( hash_t &hash, model_t &model, int32_t key, int32_t value, char const* what ) {
+	int32_t* data = new int32_t( value );
+	hash.add( key, data );
+
+	if ( model.count( key ) ) {
+		// Not stored, the data stays with the caller
+		if ( hash.get( key ) && ( data == &( **hash.get( key ) ) ) ) {
+			log_error( nullptr, "%s: add() replaced the data of key %d", what, key );
+			return EXIT_FAILURE;
+		}
+		delete data;
+	} else
+		model[key] = value;
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Remove @a key from both @a hash and @a model, alternating between remKey() and delKey()
+static int rem_key( hash_t &hash, model_t &model, int32_t key, bool useDel, char const* what ) {
+	auto found = model.find( key );
+
+	if ( useDel ) {
+		uint32_t left = hash.delKey( key );
+		if ( found != model.end() )
+			model.erase( found );
+		if ( model.size() != left ) {
+			log_error( nullptr, "%s: delKey(%d) left %u keys, should be %u", what, key,
+			           left, static_cast<uint32_t>( model.size() ) );
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	auto* elem = hash.remKey( key );
+	if ( found == model.end() ) {
+		if ( elem ) {
+			log_error( nullptr, "%s: remKey(%d) returned an element for a missing key", what, key );
+			delete elem;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+
+	if ( !elem || ( found->second != **elem ) ) {
+		log_error( nullptr, "%s: remKey(%d) returned %s", what, key, elem ? "the wrong data" : "nothing" );
+		delete elem;
+		return EXIT_FAILURE;
+	}
+	delete elem;
+	model.erase( found );
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal Interleave adding, removing and searching keys of a small range, so buckets are reused a lot
+static int test_random_ops( uint32_t initSize, int32_t keyRange, uint32_t ops, char const* what ) {
+	hash_t       hash( initSize, 0U );
+	model_t      model;
+	std::mt19937 rng( 4711 );
+
+	for ( uint32_t op = 1; op <= ops; ++op ) {
+		int32_t key = static_cast<int32_t>( rng() % static_cast<uint32_t>( keyRange ) );
+
+		switch ( rng() % 4 ) {
+			case 0:
+			case 1:
+				if ( EXIT_SUCCESS != add_key( hash, model, key, static_cast<int32_t>( op ), what ) )
+					return EXIT_FAILURE;
+				break;
+			default:
+				if ( EXIT_SUCCESS != rem_key( hash, model, key, 0 == ( op % 2 ), what ) )
+					return EXIT_FAILURE;
+				break;
+		}
+
+		if ( ( 0 == ( op % 499 ) ) && ( EXIT_SUCCESS != check_model( hash, model, keyRange, what ) ) )
+			return EXIT_FAILURE;
+	}
+
+	return check_model( hash, model, keyRange, what );
+}
+
+
+/** @internal Keep a nearly full table busy with removals and new keys
+  *
+  * Removing from a group without an empty bucket leaves a tombstone, and
+  * new keys take tombstones first. Once no empty bucket may be used any
+  * more, the table is rehashed, which drops the tombstones. As the number
+  * of keys stays the same, the table must only grow once, from 64 to 128
+  * buckets, and then keep its size.
+**/
+static int test_tombstones() {
+	hash_t       hash( 64, 0U );
+	model_t      model;
+	std::mt19937 rng( 815 );
+	int32_t      nextKey = 0;
+
+	while ( nextKey < 56 ) {
+		if ( EXIT_SUCCESS != add_key( hash, model, nextKey, nextKey * 3, "tombstones" ) )
+			return EXIT_FAILURE;
+		++nextKey;
+	}
+	if ( 64 != hash.sizeMax() ) {
+		log_error( nullptr, "tombstones: 56 keys need %u buckets, should be 64", hash.sizeMax() );
+		return EXIT_FAILURE;
+	}
+
+	for ( int32_t round = 1; round <= 20000; ++round ) {
+		auto victim = model.begin();
+		std::advance( victim, rng() % model.size() );
+		if ( EXIT_SUCCESS != rem_key( hash, model, victim->first, round % 2, "tombstones" ) )
+			return EXIT_FAILURE;
+		if ( EXIT_SUCCESS != add_key( hash, model, nextKey, nextKey * 3, "tombstones" ) )
+			return EXIT_FAILURE;
+		++nextKey;
+
+		if ( ( 0 == ( round % 1000 ) ) && ( EXIT_SUCCESS != check_model( hash, model, nextKey, "tombstones" ) ) )
+			return EXIT_FAILURE;
+	}
+
+	if ( 128 != hash.sizeMax() ) {
+		log_error( nullptr, "tombstones: 56 keys ended up in %u buckets, should be 128", hash.sizeMax() );
+		return EXIT_FAILURE;
+	}
+
+	return check_model( hash, model, nextKey, "tombstones" );
+}
+
+
+/// @internal Grow a small table to many keys, remove every other key and add them again
+static int test_growth() {
+	const int32_t count = 50000;
+	hash_t        hash( 16, 0U );
+	model_t       model;
+
+	for ( int32_t key = 0; key < count; ++key ) {
+		if ( EXIT_SUCCESS != add_key( hash, model, key, key * 3, "growth" ) )
+			return EXIT_FAILURE;
+	}
+
+	uint32_t tabSize = hash.sizeMax();
+	if ( ( tabSize & ( tabSize - 1 ) ) || ( static_cast<uint64_t>( hash.size() ) * 8 > static_cast<uint64_t>( tabSize ) * 7 ) ) {
+		log_error( nullptr, "growth: %u keys in %u buckets", hash.size(), tabSize );
+		return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_model( hash, model, count, "growth" ) )
+		return EXIT_FAILURE;
+
+	for ( int32_t key = 0; key < count; key += 2 ) {
+		if ( EXIT_SUCCESS != rem_key( hash, model, key, key % 4, "growth" ) )
+			return EXIT_FAILURE;
+	}
+	if ( EXIT_SUCCESS != check_model( hash, model, count, "growth, halved" ) )
+		return EXIT_FAILURE;
+
+	for ( int32_t key = 0; key < count; key += 2 ) {
+		if ( EXIT_SUCCESS != add_key( hash, model, key, -key, "growth" ) )
+			return EXIT_FAILURE;
+	}
+
+	return check_model( hash, model, count, "growth, refilled" );
+}
+
+
+/// @internal reserve(), clear() and getData() of missing keys
+static int test_reserve_clear() {
+	hash_t  hash;
+	model_t model;
+
+	uint32_t tabSize = hash.reserve( 1000 );
+	if ( tabSize < 1000 * 8 / 7 ) {
+		log_error( nullptr, "reserve: 1000 keys got %u buckets", tabSize );
+		return EXIT_FAILURE;
+	}
+	for ( int32_t key = 0; key < 1000; ++key )
+		add_key( hash, model, key, key, "reserve" );
+	if ( tabSize != hash.sizeMax() ) {
+		log_error( nullptr, "reserve: the table grew from %u to %u buckets", tabSize, hash.sizeMax() );
+		return EXIT_FAILURE;
+	}
+
+	hash.clear();
+	model.clear();
+	if ( !hash.empty() || ( EXIT_SUCCESS != check_model( hash, model, 1000, "clear" ) ) )
+		return EXIT_FAILURE;
+
+	bool thrown = false;
+	try {
+		hash.getData( 5 );
+	} catch ( pwx::CException &e ) {
+		thrown = ( 0 == strcmp( "NullDataException", e.name() ) );
+	}
+	if ( !thrown ) {
+		log_error( nullptr, "%s", "getData() of a missing key did not throw NullDataException" );
+		return EXIT_FAILURE;
+	}
+
+	for ( int32_t key = 500; key < 600; ++key )
+		add_key( hash, model, key, key * 2, "clear" );
+
+	return check_model( hash, model, 1000, "refill after clear" );
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	if ( EXIT_SUCCESS != test_random_ops( 16, 64, 20000, "small range" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_random_ops( 16, 2000, 60000, "large range" ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_tombstones() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_growth() )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_reserve_clear() )
+		result = EXIT_FAILURE;
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
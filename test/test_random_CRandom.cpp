@@ -0,0 +1,346 @@
+/**
+  * This file is part of the PrydeWorX Library (pwxLib).
+  *
+  * (c)  2007 - 2021 PrydeWorX
+  * @author Sven Eden, PrydeWorX - Adendorf, Germany
+  *         sven.eden@prydeworx.com
+  *         https://github.com/Yamakuzure/pwxlib ; https://pwxlib.prydeworx.com
+  *
+  * The PrydeWorX Library is free software under MIT License
+  *
+  * History and change log are maintained in pwxlib.h
+**/
+
+
+#include <PRandom>
+#include <PLog>
+#include <RNG>
+using pwx::RNG;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+
+/// @internal Number of values drawn for each distribution check
+static const uint32_t drawCount = 100000;
+
+
+/** @internal Largest chi-square value accepted for 9 degrees of freedom
+  * A fair engine exceeds it with a probability of about 1e-5.
+**/
+static const double maxChiSquare9 = 40.;
+
+
+/// @internal Return the name of @a engine
+static char const* engine_name( pwx::eRandomEngine engine ) {
+	switch ( engine ) {
+		case pwx::RE_PCG64:
+			return "PCG64";
+		case pwx::RE_SPLITMIX64:
+			return "SplitMix64";
+		default:
+			return "xoshiro256**";
+	}
+}
+
+
+/// @internal Return the chi-square value of @a counts against an equal distribution of @a total values
+static double chi_square( std::vector<uint32_t> const &counts, uint32_t total ) {
+	double const expected = static_cast<double>( total ) / static_cast<double>( counts.size() );
+	double       result   = 0.;
+
+	for ( uint32_t count : counts ) {
+		double const diff = static_cast<double>( count ) - expected;
+		result += diff * diff / expected;
+	}
+
+	return result;
+}
+
+
+/** @internal The first values from a fixed seed must be known answers
+  *
+  * The expected values were calculated from the published reference
+  * algorithms, with the seeding random_fill_par() uses: xoshiro256** gets
+  * four SplitMix64 values of the seed, PCG64 gets initstate and initseq
+  * from four SplitMix64 values of the inverted seed, and SplitMix64
+  * starts at the seed xor 0x5851f42d4c957f2d.
+**/
+static int test_known_answer( pwx::eRandomEngine engine, uint64_t const expected[4] ) {
+	uint64_t values[4] = { 0, 0, 0, 0 };
+
+	RNG.setEngine( engine );
+	RNG.random_fill_par( values, 4, static_cast<uint64_t>( 0 ), std::numeric_limits<uint64_t>::max(), 42, 1 );
+
+	for ( int32_t i = 0; i < 4; ++i ) {
+		if ( expected[i] != values[i] ) {
+			log_error( nullptr, "%s: value %d of seed 42 is 0x%016lx, should be 0x%016lx", engine_name( engine ), i,
+			           static_cast<unsigned long>( values[i] ), static_cast<unsigned long>( expected[i] ) );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal random() must stay in range and be evenly distributed, whichever engine is selected
+static int test_distribution( pwx::eRandomEngine engine ) {
+	char const* name = engine_name( engine );
+
+	RNG.setEngine( engine );
+	if ( engine != RNG.getEngine() ) {
+		log_error( nullptr, "%s: getEngine() returns %d", name, static_cast<int32_t>( RNG.getEngine() ) );
+		return EXIT_FAILURE;
+	}
+
+	// Small integer range, both borders must show up, and swapped borders must work the same
+	std::vector<uint32_t> counts( 10, 0 );
+	for ( uint32_t i = 0; i < drawCount; ++i ) {
+		int32_t const value = ( i % 2 ) ? RNG.random( -5, 4 ) : RNG.random( 4, -5 );
+		if ( ( value < -5 ) || ( value > 4 ) ) {
+			log_error( nullptr, "%s: random(-5, 4) returned %d", name, value );
+			return EXIT_FAILURE;
+		}
+		++counts[static_cast<size_t>( value + 5 )];
+	}
+	double chi = chi_square( counts, drawCount );
+	if ( chi > maxChiSquare9 ) {
+		log_error( nullptr, "%s: random(-5, 4) is skewed, chi-square %g", name, chi );
+		return EXIT_FAILURE;
+	}
+
+	// Floating point values, ten buckets and the mean
+	std::fill( counts.begin(), counts.end(), 0 );
+	double sum = 0.;
+	for ( uint32_t i = 0; i < drawCount; ++i ) {
+		double const value = RNG.random( 1., 3. );
+		if ( ( value < 1. ) || ( value > 3. ) ) {
+			log_error( nullptr, "%s: random(1., 3.) returned %g", name, value );
+			return EXIT_FAILURE;
+		}
+		sum += value;
+		++counts[std::min( static_cast<size_t>( ( value - 1. ) * 5. ), counts.size() - 1 )];
+	}
+	chi = chi_square( counts, drawCount );
+	if ( ( chi > maxChiSquare9 ) || ( std::abs( sum / drawCount - 2. ) > 0.02 ) ) {
+		log_error( nullptr, "%s: random(1., 3.) is skewed, chi-square %g, mean %g", name, chi, sum / drawCount );
+		return EXIT_FAILURE;
+	}
+
+	// Every bit of the full 64 bit range must be set in about half of the values
+	std::vector<uint32_t> bits( 64, 0 );
+	for ( uint32_t i = 0; i < drawCount; ++i ) {
+		uint64_t const value = RNG.random( static_cast<uint64_t>( 0 ), std::numeric_limits<uint64_t>::max() );
+		for ( uint32_t bit = 0; bit < 64; ++bit ) {
+			if ( value & ( 1ULL << bit ) )
+				++bits[bit];
+		}
+	}
+	for ( uint32_t bit = 0; bit < 64; ++bit ) {
+		if ( std::abs( static_cast<double>( bits[bit] ) / drawCount - 0.5 ) > 0.02 ) {
+			log_error( nullptr, "%s: bit %u is set in %u of %u values", name, bit, bits[bit], drawCount );
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Wide signed ranges
+	for ( uint32_t i = 0; i < drawCount; ++i ) {
+		int64_t const value = RNG.random( static_cast<int64_t>( -1000000000000LL ), static_cast<int64_t>( 1000000000000LL ) );
+		if ( ( value < -1000000000000LL ) || ( value > 1000000000000LL ) ) {
+			log_error( nullptr, "%s: random(-1e12, 1e12) returned %ld", name, static_cast<long>( value ) );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/// @internal random_fill() must follow the same rules as random() does
+static int test_fill( pwx::eRandomEngine engine ) {
+	char const* name = engine_name( engine );
+
+	RNG.setEngine( engine );
+
+	// Small integer range, the borders are swapped
+	std::vector<int32_t>  ints( drawCount, 100 );
+	std::vector<uint32_t> counts( 10, 0 );
+	RNG.random_fill( ints.data(), ints.size(), 4, -5 );
+	for ( int32_t value : ints ) {
+		if ( ( value < -5 ) || ( value > 4 ) ) {
+			log_error( nullptr, "%s: random_fill(-5, 4) wrote %d", name, value );
+			return EXIT_FAILURE;
+		}
+		++counts[static_cast<size_t>( value + 5 )];
+	}
+	double chi = chi_square( counts, drawCount );
+	if ( chi > maxChiSquare9 ) {
+		log_error( nullptr, "%s: random_fill(-5, 4) is skewed, chi-square %g", name, chi );
+		return EXIT_FAILURE;
+	}
+
+	// Floating point values, the mean must fit
+	std::vector<double> doubles( drawCount, 0. );
+	double              sum = 0.;
+	RNG.random_fill( doubles.data(), doubles.size(), 1., 3. );
+	for ( double value : doubles ) {
+		if ( ( value < 1. ) || ( value > 3. ) ) {
+			log_error( nullptr, "%s: random_fill(1., 3.) wrote %g", name, value );
+			return EXIT_FAILURE;
+		}
+		sum += value;
+	}
+	if ( std::abs( sum / drawCount - 2. ) > 0.02 ) {
+		log_error( nullptr, "%s: random_fill(1., 3.) is skewed, mean %g", name, sum / drawCount );
+		return EXIT_FAILURE;
+	}
+
+	// Equal borders fill, nothing to fill writes nothing
+	ints[10] = 100;
+	RNG.random_fill( ints.data(), 10, 7, 7 );
+	RNG.random_fill( ints.data() + 10, 0, 0, 1 );
+	RNG.random_fill( static_cast<int32_t*>( nullptr ), 10, 0, 1 );
+	if ( ( 10 != std::count( ints.begin(), ints.begin() + 10, 7 ) ) || ( 100 != ints[10] ) ) {
+		log_error( nullptr, "%s: random_fill() with equal borders or no values is wrong", name );
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+/** @internal random_fill_par() must give the same values for the same seed and thread count
+  *
+  * Slice 0 of every thread count is the unjumped stream, so it must match
+  * the start of the single threaded result. The large array makes sure
+  * several threads are actually started.
+**/
+static int test_fill_par( pwx::eRandomEngine engine ) {
+	char const*          name   = engine_name( engine );
+	size_t const         count  = 4 * 65536 + 3;
+	size_t const         slice  = count / 4;
+	std::vector<int64_t> single( count );
+	std::vector<int64_t> first( count );
+	std::vector<int64_t> second( count );
+
+	RNG.setEngine( engine );
+
+	RNG.random_fill_par( single.data(), count, static_cast<int64_t>( -1000 ), static_cast<int64_t>( 1000 ), 4711, 1 );
+	RNG.random_fill_par( first.data(), count, static_cast<int64_t>( -1000 ), static_cast<int64_t>( 1000 ), 4711, 4 );
+	RNG.random_fill_par( second.data(), count, static_cast<int64_t>( -1000 ), static_cast<int64_t>( 1000 ), 4711, 4 );
+
+	if ( first != second ) {
+		log_error( nullptr, "%s: random_fill_par() with the same seed and threads differs", name );
+		return EXIT_FAILURE;
+	}
+	if ( !std::equal( first.begin(), first.begin() + slice, single.begin() ) ) {
+		log_error( nullptr, "%s: random_fill_par() slice 0 differs from the single stream", name );
+		return EXIT_FAILURE;
+	}
+	if ( std::equal( first.begin() + slice, first.begin() + 2 * slice, single.begin() + slice ) ) {
+		log_error( nullptr, "%s: random_fill_par() slice 1 repeats the single stream", name );
+		return EXIT_FAILURE;
+	}
+	for ( int64_t value : first ) {
+		if ( ( value < -1000 ) || ( value > 1000 ) ) {
+			log_error( nullptr, "%s: random_fill_par(-1000, 1000) wrote %ld", name, static_cast<long>( value ) );
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Another seed gives other values
+	RNG.random_fill_par( second.data(), count, static_cast<int64_t>( -1000 ), static_cast<int64_t>( 1000 ), 4712, 4 );
+	if ( first == second ) {
+		log_error( nullptr, "%s: random_fill_par() ignores the seed", name );
+		return EXIT_FAILURE;
+	}
+
+	// No thread count means one per core, which only reproduces on the same machine
+	uint32_t const cores = std::max( std::thread::hardware_concurrency(), 1U );
+	RNG.random_fill_par( first.data(), count, static_cast<int64_t>( -1000 ), static_cast<int64_t>( 1000 ), 4711, cores );
+	RNG.random_fill_par( second.data(), count, static_cast<int64_t>( -1000 ), static_cast<int64_t>( 1000 ), 4711 );
+	if ( first != second ) {
+		log_error( nullptr, "%s: random_fill_par() with 0 threads does not use %u streams", name, cores );
+		return EXIT_FAILURE;
+	}
+
+	// Floating point values
+	std::vector<float> floats( count );
+	RNG.random_fill_par( floats.data(), count, -1.f, 1.f, 4711, 3 );
+	for ( float value : floats ) {
+		if ( ( value < -1.f ) || ( value > 1.f ) ) {
+			log_error( nullptr, "%s: random_fill_par(-1.f, 1.f) wrote %g", name, static_cast<double>( value ) );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
+
+
+int main() {
+	int result = EXIT_SUCCESS;
+
+	pwx::init( true, nullptr, 0 );
+
+	static uint64_t const xoshiroSeed42[4] = {
+		0x15780b2e0c2ec716ULL, 0x6104d9866d113a7eULL, 0xae17533239e499a1ULL, 0xecb8ad4703b360a1ULL
+	};
+	static uint64_t const pcgSeed42[4] = {
+		0x821ddd4d7756848cULL, 0xe6362bde9375ecc7ULL, 0x2acbc845f35d63b7ULL, 0x1db28e5b8c551d03ULL
+	};
+	static uint64_t const splitmixSeed42[4] = {
+		0xdb26f2b8006be934ULL, 0x1a5d397a7335284aULL, 0x67b3f7cb97d01b12ULL, 0xa22d35a2de6ab51aULL
+	};
+
+	if ( EXIT_SUCCESS != test_known_answer( pwx::RE_XOSHIRO256SS, xoshiroSeed42 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_known_answer( pwx::RE_PCG64, pcgSeed42 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_known_answer( pwx::RE_SPLITMIX64, splitmixSeed42 ) )
+		result = EXIT_FAILURE;
+
+	if ( EXIT_SUCCESS != test_distribution( pwx::RE_XOSHIRO256SS ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_distribution( pwx::RE_PCG64 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_distribution( pwx::RE_SPLITMIX64 ) )
+		result = EXIT_FAILURE;
+
+	if ( EXIT_SUCCESS != test_fill( pwx::RE_XOSHIRO256SS ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_fill( pwx::RE_PCG64 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_fill( pwx::RE_SPLITMIX64 ) )
+		result = EXIT_FAILURE;
+
+	if ( EXIT_SUCCESS != test_fill_par( pwx::RE_XOSHIRO256SS ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_fill_par( pwx::RE_PCG64 ) )
+		result = EXIT_FAILURE;
+	if ( EXIT_SUCCESS != test_fill_par( pwx::RE_SPLITMIX64 ) )
+		result = EXIT_FAILURE;
+
+	// An invalid engine must be ignored
+	RNG.setEngine( pwx::RE_PCG64 );
+	RNG.setEngine( pwx::RE_NUM_ENGINES );
+	if ( pwx::RE_PCG64 != RNG.getEngine() ) {
+		log_error( nullptr, "%s", "setEngine( RE_NUM_ENGINES ) was not ignored" );
+		result = EXIT_FAILURE;
+	}
+	RNG.setEngine( pwx::RE_XOSHIRO256SS );
+
+	pwx::finish();
+
+	if ( EXIT_SUCCESS == result )
+		log_info( nullptr, "%s", "Test successful" );
+	else
+		log_error( nullptr, "%s", "Test FAILED" );
+
+	return result;
+}
@@ -4,11 +4,22 @@
 #include <PStreamHelpers>
 #include <PStringUtils>
 
+#include <atomic>
+#include <iomanip>
+#include <vector>
+
+typedef std::chrono::high_resolution_clock             hrClock;
+typedef std::chrono::high_resolution_clock::time_point hrTime_t;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
 
 // --- Prototypes, the implementations are below main() ---
 static int32_t setNumThreads( char const* chNum, uint32_t &numThreads );
 static int32_t setTestType( char const* chType, eTestType &testType );
 static int32_t startTest( uint32_t numThreads, eTestType testType );
+static int32_t benchQueues( uint32_t numThreads );
+static int32_t benchStacks( uint32_t numThreads );
 
 
 int32_t main( int32_t argc, char** argv ) {
@@ -45,10 +56,12 @@ int32_t main( int32_t argc, char** argv ) {
 			cout << "       list   : Test TSingleList and TDoubleList\n";
 			cout << "       list_d : Test TDoubleList\n";
 			cout << "       list_s : Test TSingleList\n";
+			cout << "       qbench : Benchmark TQueue against TBoundedQueue and TLockFreeQueue\n";
 			cout << "       queue  : Test TQueue\n";
 			cout << "       ring   : Test TSingleRing and TDoubleRing\n";
 			cout << "       ring_d : Test TDoubleRing\n";
 			cout << "       ring_s : Test TSingleRing\n";
+			cout << "       sbench : Benchmark TStack against TLockFreeStack\n";
 			cout << "       set    : Test TSet\n";
 			cout << "       stack  : Test TStack\n";
 			cout << "  -h / --help : Show this help and exit\n";
@@ -116,6 +129,8 @@ static int32_t setTestType( char const* chType, eTestType &testType ) {
 		testType = E_TEST_LIST_D;
 	} else if ( STREQ( "list_s", chType ) ) {
 		testType = E_TEST_LIST_S;
+	} else if ( STREQ( "qbench", chType ) ) {
+		testType = E_TEST_QBENCH;
 	} else if ( STREQ( "queue", chType ) ) {
 		testType = E_TEST_QUEUE;
 	} else if ( STREQ( "ring", chType ) ) {
@@ -124,6 +139,8 @@ static int32_t setTestType( char const* chType, eTestType &testType ) {
 		testType = E_TEST_RING_D;
 	} else if ( STREQ( "ring_s", chType ) ) {
 		testType = E_TEST_RING_S;
+	} else if ( STREQ( "sbench", chType ) ) {
+		testType = E_TEST_SBENCH;
 	} else if ( STREQ( "set", chType ) ) {
 		testType = E_TEST_SET;
 	} else if ( STREQ( "stack", chType ) ) {
@@ -194,6 +211,241 @@ static int32_t startTest( uint32_t numThreads, eTestType testType ) {
 		cout << " === Testing TStack === " << endl;
 		PWX_TRY_PWX_FURTHER( result = do_test< pwx::TStack< data_t>>( numThreads ) )
 	}
+	if ( ( EXIT_SUCCESS == result )
+	     && ( ( testType == E_TEST_ALL )
+	          || ( testType == E_TEST_QBENCH )
+	     ) ) {
+		cout << " === Benchmarking queues === " << endl;
+		PWX_TRY_PWX_FURTHER( result = benchQueues( numThreads ) )
+	}
+	if ( ( EXIT_SUCCESS == result )
+	     && ( ( testType == E_TEST_ALL )
+	          || ( testType == E_TEST_SBENCH )
+	     ) ) {
+		cout << " === Benchmarking stacks === " << endl;
+		PWX_TRY_PWX_FURTHER( result = benchStacks( numThreads ) )
+	}
+
+	return result;
+}
+
+
+// --- queue and stack benchmarks ---
+
+typedef pwx::TQueue< data_t >          bench_queue_t;   //!< The list based queue
+typedef bench_queue_t::elem_t          bench_elem_t;    //!< Its elements, deleted after each run
+typedef std::vector< bench_elem_t* >   bench_trash_t;   //!< Popped elements of one consumer
+typedef pwx::TStack< data_t >          bench_stack_t;   //!< The list based stack
+typedef bench_stack_t::elem_t          bench_selem_t;   //!< Its elements, deleted after each run
+typedef std::vector< bench_selem_t* >  bench_strash_t;  //!< Popped stack elements of one consumer
+
+const uint32_t              benchItems  = 100000; //!< Number of data pointers handed over in each run
+const uint32_t              benchItemsQ = 5000;   //!< TQueue and TStack need O(n) per pop(), so they get less
+static std::vector< data_t > benchValues;         //!< The data points into this, nothing is allocated
+
+
+/// @internal The data is owned by `benchValues`, nothing to destroy
+static void benchNoDestroy( data_t* ) { }
+
+
+/// @internal TQueue hands out elements, which are kept until the run is over
+static data_t* benchTryPop( bench_queue_t &queue, bench_trash_t &trash ) {
+	if ( queue.empty() )
+		return nullptr;
+
+	bench_elem_t* elem = nullptr;
+	PWX_TRY( elem = queue.pop() )
+	catch ( pwx::CException & ) {
+		return nullptr; // Emptied by someone else
+	}
+
+	trash.push_back( elem );
+	return elem->data.get();
+}
+
+
+/// @internal TStack hands out elements, too
+static data_t* benchTryPop( bench_stack_t &stack, bench_strash_t &trash ) {
+	if ( stack.empty() )
+		return nullptr;
+
+	bench_selem_t* elem = nullptr;
+	PWX_TRY( elem = stack.pop() )
+	catch ( pwx::CException & ) {
+		return nullptr; // Emptied by someone else
+	}
+
+	trash.push_back( elem );
+	return elem->data.get();
+}
+
+
+/// @internal The lock-free containers hand out the data directly
+template< typename cont_t, typename trash_t >
+static data_t* benchTryPop( cont_t &cont, trash_t & ) {
+	return cont.try_pop();
+}
+
+
+/** @internal Hand @a numItems benchmark values from @a numProd producers to @a numCons consumers
+  *
+  * Popped elements of list based containers are collected in `trash_t`
+  * vectors and deleted after the measurement. If @a takeTurns is set,
+  * the consumers only start when all producers are finished, as the list
+  * based containers do not survive concurrent push()es and pop()s.
+  *
+  * @return million data pointers per second that went through @a queue or stack, or -1. on errors
+**/
+template< typename trash_t, typename queue_t >
+static double benchHandOver( queue_t &queue, uint32_t numProd, uint32_t numCons, uint32_t numItems,
+                             bool takeTurns ) {
+	std::vector< std::thread >   threads;
+	std::vector< trash_t >       trash( numCons );
+	std::atomic_bool             go( false );
+	std::atomic_uint             popped( 0 );
+	std::atomic_uint             produced( 0 );
+	std::atomic< uint64_t >      checksum( 0 );
+	uint32_t                     perProd = numItems / numProd;
+	uint32_t                     total   = perProd * numProd;
+
+	for ( uint32_t nr = 0 ; nr < numProd ; ++nr ) {
+		threads.emplace_back( [ &queue, &go, &produced, nr, perProd ]() {
+			while ( !go.load() )
+				std::this_thread::yield();
+			for ( uint32_t i = 0 ; i < perProd ; ++i )
+				queue.push( &benchValues[nr * perProd + i] );
+			produced.fetch_add( 1 );
+		} );
+	}
+
+	for ( uint32_t nr = 0 ; nr < numCons ; ++nr ) {
+		threads.emplace_back( [ &queue, &go, &popped, &produced, &checksum, &trash, nr, total, numProd, takeTurns ]() {
+			uint64_t sum = 0;
+			while ( !go.load() || ( takeTurns && ( produced.load() < numProd ) ) )
+				std::this_thread::yield();
+			while ( popped.load( std::memory_order_relaxed ) < total ) {
+				data_t* data = benchTryPop( queue, trash[nr] );
+				if ( data ) {
+					sum += static_cast< uint64_t >( *data );
+					popped.fetch_add( 1, std::memory_order_relaxed );
+				} else
+					std::this_thread::yield();
+			}
+			checksum.fetch_add( sum );
+		} );
+	}
+
+	hrTime_t tStart = hrClock::now();
+	go.store( true );
+	for ( auto &thr : threads )
+		thr.join();
+	hrTime_t tEnd = hrClock::now();
+
+	for ( auto &elems : trash ) {
+		for ( auto* elem : elems )
+			delete elem;
+	}
+
+	// Every value must have come through exactly once
+	uint64_t expected = static_cast< uint64_t >( total ) * ( total - 1 ) / 2;
+	if ( ( checksum.load() != expected ) || !queue.empty() ) {
+		cerr << "\nERROR: checksum " << checksum.load() << " (expected " << expected;
+		cerr << "), " << queue.size() << " data pointers left over" << endl;
+		return -1.;
+	}
+
+	int64_t usecs = duration_cast< microseconds >( tEnd - tStart ).count();
+	return usecs > 0 ? static_cast< double >( total ) / static_cast< double >( usecs ) : 0.;
+}
+
+
+/** @brief benchmark TQueue against TBoundedQueue and TLockFreeQueue
+  *
+  * TQueue is only measured with one producer and one consumer taking
+  * turns, as concurrent access on it is not reliable. And as each pop()
+  * renumbers the remaining elements, it only gets `benchItemsQ` data pointers.
+**/
+static int32_t benchQueues( uint32_t numThreads ) {
+	int32_t result = EXIT_SUCCESS;
+
+	benchValues.resize( benchItems );
+	for ( uint32_t i = 0 ; i < benchItems ; ++i )
+		benchValues[i] = static_cast< data_t >( i );
+
+	cout << "Million data pointers handed over per second, " << benchItems << " per run";
+	cout << " (TQueue: " << benchItemsQ << ")." << endl;
+	cout << "The bounded queue holds 1024 data pointers.\n" << endl;
+	cout << "Producers/Consumers |   TQueue | TBoundedQueue | TLockFreeQueue" << endl;
+	cout << "--------------------+----------+---------------+---------------" << endl;
+	cout << std::fixed << std::setprecision( 3 );
+
+	for ( uint32_t num = 1 ; ( EXIT_SUCCESS == result ) && ( ( num * 2 ) <= numThreads ) ; num *= 2 ) {
+		pwx::TBoundedQueue< data_t >  b_queue( 1024, benchNoDestroy );
+		pwx::TLockFreeQueue< data_t > lf_queue( benchNoDestroy );
+		double                        q_mops = 0.;
+
+		if ( 1 == num ) {
+			bench_queue_t queue( benchNoDestroy );
+			q_mops = benchHandOver< bench_trash_t >( queue, num, num, benchItemsQ, true );
+		}
+		double b_mops  = benchHandOver< bench_trash_t >( b_queue, num, num, benchItems, false );
+		double lf_mops = benchHandOver< bench_trash_t >( lf_queue, num, num, benchItems, false );
+
+		if ( ( q_mops < 0. ) || ( b_mops < 0. ) || ( lf_mops < 0. ) )
+			result = EXIT_FAILURE;
+
+		cout << std::setw( 9 ) << num << " / " << std::left << std::setw( 7 ) << num << std::right << " | ";
+		if ( 1 == num )
+			cout << std::setw( 8 ) << q_mops;
+		else
+			cout << "     n/a";
+		cout << " | " << std::setw( 13 ) << b_mops;
+		cout << " | " << std::setw( 14 ) << lf_mops << endl;
+	}
+
+	return result;
+}
+
+
+/** @brief benchmark TStack against TLockFreeStack
+  *
+  * TStack is only measured with one producer and one consumer taking
+  * turns, as concurrent access on it is not reliable. And as each pop() has to
+  * search the new top, it only gets `benchItemsQ` data pointers.
+**/
+static int32_t benchStacks( uint32_t numThreads ) {
+	int32_t result = EXIT_SUCCESS;
+
+	benchValues.resize( benchItems );
+	for ( uint32_t i = 0 ; i < benchItems ; ++i )
+		benchValues[i] = static_cast< data_t >( i );
+
+	cout << "Million data pointers handed over per second, " << benchItems << " per run";
+	cout << " (TStack: " << benchItemsQ << ").\n" << endl;
+	cout << "Producers/Consumers |   TStack | TLockFreeStack" << endl;
+	cout << "--------------------+----------+---------------" << endl;
+	cout << std::fixed << std::setprecision( 3 );
+
+	for ( uint32_t num = 1 ; ( EXIT_SUCCESS == result ) && ( ( num * 2 ) <= numThreads ) ; num *= 2 ) {
+		pwx::TLockFreeStack< data_t > lf_stack( benchNoDestroy );
+		double                        s_mops = 0.;
+
+		if ( 1 == num ) {
+			bench_stack_t stack( benchNoDestroy );
+			s_mops = benchHandOver< bench_strash_t >( stack, num, num, benchItemsQ, true );
+		}
+		double lf_mops = benchHandOver< bench_strash_t >( lf_stack, num, num, benchItems, false );
+
+		if ( ( s_mops < 0. ) || ( lf_mops < 0. ) )
+			result = EXIT_FAILURE;
+
+		cout << std::setw( 9 ) << num << " / " << std::left << std::setw( 7 ) << num << std::right << " | ";
+		if ( 1 == num )
+			cout << std::setw( 8 ) << s_mops;
+		else
+			cout << "     n/a";
+		cout << " | " << std::setw( 14 ) << lf_mops << endl;
+	}
 
 	return result;
 }
@@ -145,6 +145,8 @@ enum eTestType {
 	E_TEST_RING_S = 8,
 	E_TEST_SET    = 9,
 	E_TEST_STACK  = 10,
+	E_TEST_QBENCH = 11,
+	E_TEST_SBENCH = 12,
 };
 
 